@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file bench/bench.h
+//! @brief Benchmark runner.
+
+#ifndef ROC_BENCH_H_
+#define ROC_BENCH_H_
+
+#include "roc_core/attributes.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+
+//! Define benchmark.
+//! @remarks
+//!  Defines a function that performs one or more measurements using
+//!  the Runner object named @c runner. Benchmarks are executed in the
+//!  order of definition within a file.
+#define ROC_BENCHMARK(name)                                                              \
+    static void bench_##name(::roc::bench::Runner&);                                     \
+    static ::roc::bench::Registration bench_registration_##name(bench_##name);           \
+    static void bench_##name(::roc::bench::Runner& runner)
+
+namespace roc {
+namespace bench {
+
+//! Measures and reports benchmark results.
+//!
+//! Every measurement is started with begin(). Then the measured code is
+//! executed n_runs() times, and the duration of every run is passed to add().
+//! Finally, end() prints the results. The first run is a warm-up and is
+//! not accounted.
+//!
+//! Results are printed as a table, or as a JSON document if enabled.
+class Runner : public core::NonCopyable<> {
+public:
+    enum {
+        //! Maximum number of runs.
+        MaxRuns = 1000,
+
+        //! Maximum number of counters per measurement.
+        MaxCounters = 4,
+
+        //! Maximum length of measurement name.
+        MaxName = 128
+    };
+
+    //! Initialize.
+    //!
+    //! @b Parameters
+    //!  - @p suite is a suite name, reported in JSON output
+    //!  - @p filter is a substring that measurement name should contain, or NULL
+    //!  - @p n_runs is the number of accounted runs per measurement
+    //!  - @p json enables JSON output
+    Runner(const char* suite, const char* filter, size_t n_runs, bool json);
+
+    //! Finish output.
+    ~Runner();
+
+    //! Get number of runs to perform for every measurement.
+    //! @remarks
+    //!  Includes warm-up run.
+    size_t n_runs() const;
+
+    //! Start measurement.
+    //!
+    //! @b Parameters
+    //!  - @p n_ops is the number of operations performed in every run
+    //!  - @p n_bytes is the number of bytes processed in every run, or zero
+    //!  - @p format and the rest arguments define measurement name
+    //!
+    //! @returns
+    //!  false if the measurement is disabled by filter and should be skipped.
+    bool begin(size_t n_ops, size_t n_bytes, const char* format, ...)
+        ROC_ATTR_PRINTF(4, 5);
+
+    //! Add duration of a single run.
+    void add(core::nanoseconds_t elapsed);
+
+    //! Report additional value with measurement results.
+    //! @remarks
+    //!  @p name should be a string literal.
+    void set_counter(const char* name, double value);
+
+    //! Finish measurement and print results.
+    void end();
+
+private:
+    double ns_per_op_(core::nanoseconds_t elapsed) const;
+
+    void print_text_();
+    void print_json_();
+
+    const char* suite_;
+    const char* filter_;
+    const size_t n_runs_;
+    const bool json_;
+
+    char name_[MaxName];
+    size_t n_ops_;
+    size_t n_bytes_;
+
+    core::nanoseconds_t samples_[MaxRuns];
+    size_t n_samples_;
+    size_t n_skipped_;
+
+    const char* counter_names_[MaxCounters];
+    double counter_values_[MaxCounters];
+    size_t n_counters_;
+
+    size_t n_reported_;
+};
+
+//! Benchmark function.
+typedef void (*BenchmarkFunc)(Runner& runner);
+
+//! Benchmark registration.
+//! @remarks
+//!  Should be used as a static object, see ROC_BENCHMARK().
+class Registration : public core::NonCopyable<> {
+public:
+    //! Register benchmark.
+    explicit Registration(BenchmarkFunc func);
+
+    //! Get first registered benchmark.
+    static Registration* first();
+
+    //! Get next registered benchmark.
+    Registration* next() const;
+
+    //! Run benchmark.
+    void run(Runner& runner) const;
+
+private:
+    BenchmarkFunc func_;
+    Registration* next_;
+};
+
+} // namespace bench
+} // namespace roc
+
+#endif // ROC_BENCH_H_
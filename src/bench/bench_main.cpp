@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+#include "bench.h"
+
+namespace roc {
+namespace bench {
+
+namespace {
+
+enum { DefaultRuns = 10 };
+
+Registration* g_first;
+Registration* g_last;
+
+void sort(core::nanoseconds_t* samples, size_t n_samples) {
+    for (size_t i = 1; i < n_samples; i++) {
+        const core::nanoseconds_t s = samples[i];
+        size_t j = i;
+        for (; j > 0 && samples[j - 1] > s; j--) {
+            samples[j] = samples[j - 1];
+        }
+        samples[j] = s;
+    }
+}
+
+void print_json_string(const char* str) {
+    putchar('"');
+    for (; *str; str++) {
+        if (*str == '"' || *str == '\\') {
+            putchar('\\');
+        }
+        putchar(*str);
+    }
+    putchar('"');
+}
+
+const char* program_name(const char* path) {
+    const char* slash = strrchr(path, '/');
+    return slash ? slash + 1 : path;
+}
+
+void print_usage(const char* program) {
+    fprintf(stderr,
+            "usage: %s [--help] [--json] [--runs=N] [--filter=STR]\n"
+            "  --json        print results as JSON\n"
+            "  --runs=N      number of runs per measurement (default %d)\n"
+            "  --filter=STR  run only measurements which names contain STR\n",
+            program, (int)DefaultRuns);
+}
+
+} // namespace
+
+Runner::Runner(const char* suite, const char* filter, size_t n_runs, bool json)
+    : suite_(suite)
+    , filter_(filter)
+    , n_runs_(n_runs)
+    , json_(json)
+    , n_ops_(0)
+    , n_bytes_(0)
+    , n_samples_(0)
+    , n_skipped_(0)
+    , n_counters_(0)
+    , n_reported_(0) {
+    if (n_runs_ == 0 || n_runs_ > MaxRuns) {
+        roc_panic("bench: invalid number of runs: n_runs=%lu max=%lu",
+                  (unsigned long)n_runs_, (unsigned long)MaxRuns);
+    }
+
+    name_[0] = '\0';
+
+    if (json_) {
+        printf("{\n  \"suite\": ");
+        print_json_string(suite_);
+        printf(",\n  \"runs\": %lu,\n  \"benchmarks\": [", (unsigned long)n_runs_);
+    } else {
+        printf("%-56s %12s %12s %12s %10s\n", "name", "ns/op", "min", "max", "MB/s");
+    }
+    fflush(stdout);
+}
+
+Runner::~Runner() {
+    if (json_) {
+        printf("%s]\n}\n", n_reported_ ? "\n  " : "");
+    }
+    fflush(stdout);
+}
+
+size_t Runner::n_runs() const {
+    return n_runs_ + 1;
+}
+
+bool Runner::begin(size_t n_ops, size_t n_bytes, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    vsnprintf(name_, sizeof(name_), format, args);
+    va_end(args);
+
+    if (filter_ && !strstr(name_, filter_)) {
+        return false;
+    }
+
+    n_ops_ = n_ops;
+    n_bytes_ = n_bytes;
+    n_samples_ = 0;
+    n_skipped_ = 0;
+    n_counters_ = 0;
+
+    return true;
+}
+
+void Runner::add(core::nanoseconds_t elapsed) {
+    if (n_skipped_ == 0) {
+        n_skipped_++;
+        return;
+    }
+
+    if (n_samples_ == n_runs_) {
+        roc_panic("bench: too many runs: name=%s n_runs=%lu", name_,
+                  (unsigned long)n_runs_);
+    }
+
+    samples_[n_samples_++] = elapsed;
+}
+
+void Runner::set_counter(const char* name, double value) {
+    for (size_t n = 0; n < n_counters_; n++) {
+        if (strcmp(counter_names_[n], name) == 0) {
+            counter_values_[n] = value;
+            return;
+        }
+    }
+
+    if (n_counters_ == MaxCounters) {
+        roc_panic("bench: too many counters: name=%s", name_);
+    }
+
+    counter_names_[n_counters_] = name;
+    counter_values_[n_counters_] = value;
+    n_counters_++;
+}
+
+void Runner::end() {
+    if (n_samples_ == 0) {
+        roc_panic("bench: no runs: name=%s", name_);
+    }
+
+    sort(samples_, n_samples_);
+
+    if (json_) {
+        print_json_();
+    } else {
+        print_text_();
+    }
+    fflush(stdout);
+
+    n_reported_++;
+}
+
+double Runner::ns_per_op_(core::nanoseconds_t elapsed) const {
+    if (n_ops_ == 0) {
+        return 0;
+    }
+    return double(elapsed) / n_ops_;
+}
+
+void Runner::print_text_() {
+    const core::nanoseconds_t median = samples_[n_samples_ / 2];
+
+    printf("%-56s %12.1f %12.1f %12.1f", name_, ns_per_op_(median),
+           ns_per_op_(samples_[0]), ns_per_op_(samples_[n_samples_ - 1]));
+
+    if (n_bytes_ != 0 && median != 0) {
+        printf(" %10.1f", double(n_bytes_) / (1024 * 1024) / (double(median) / 1e9));
+    } else {
+        printf(" %10s", "-");
+    }
+
+    for (size_t n = 0; n < n_counters_; n++) {
+        printf(" %s=%g", counter_names_[n], counter_values_[n]);
+    }
+
+    printf("\n");
+}
+
+void Runner::print_json_() {
+    const core::nanoseconds_t median = samples_[n_samples_ / 2];
+
+    printf("%s\n    {\"name\": ", n_reported_ ? "," : "");
+    print_json_string(name_);
+
+    printf(", \"ops\": %lu, \"bytes\": %lu", (unsigned long)n_ops_,
+           (unsigned long)n_bytes_);
+
+    printf(", \"ns_per_op\": {\"median\": %.3f, \"min\": %.3f, \"max\": %.3f}",
+           ns_per_op_(median), ns_per_op_(samples_[0]),
+           ns_per_op_(samples_[n_samples_ - 1]));
+
+    if (n_bytes_ != 0 && median != 0) {
+        printf(", \"mb_per_sec\": %.3f",
+               double(n_bytes_) / (1024 * 1024) / (double(median) / 1e9));
+    }
+
+    if (n_counters_ != 0) {
+        printf(", \"counters\": {");
+        for (size_t n = 0; n < n_counters_; n++) {
+            printf("%s", n ? ", " : "");
+            print_json_string(counter_names_[n]);
+            printf(": %g", counter_values_[n]);
+        }
+        printf("}");
+    }
+
+    printf("}");
+}
+
+Registration::Registration(BenchmarkFunc func)
+    : func_(func)
+    , next_(NULL) {
+    if (g_last) {
+        g_last->next_ = this;
+    } else {
+        g_first = this;
+    }
+    g_last = this;
+}
+
+Registration* Registration::first() {
+    return g_first;
+}
+
+Registration* Registration::next() const {
+    return next_;
+}
+
+void Registration::run(Runner& runner) const {
+    func_(runner);
+}
+
+} // namespace bench
+} // namespace roc
+
+int main(int argc, char** argv) {
+    using namespace roc;
+
+    core::set_log_level(LogNone);
+
+    const char* filter = NULL;
+    size_t n_runs = bench::DefaultRuns;
+    bool json = false;
+
+    for (int n = 1; n < argc; n++) {
+        if (strcmp(argv[n], "--help") == 0) {
+            bench::print_usage(argv[0]);
+            return 0;
+        } else if (strcmp(argv[n], "--json") == 0) {
+            json = true;
+        } else if (strncmp(argv[n], "--filter=", 9) == 0) {
+            filter = argv[n] + 9;
+        } else if (strncmp(argv[n], "--runs=", 7) == 0) {
+            const long runs = atol(argv[n] + 7);
+            if (runs <= 0 || runs > bench::Runner::MaxRuns) {
+                fprintf(stderr, "invalid number of runs: %s\n", argv[n] + 7);
+                return 1;
+            }
+            n_runs = (size_t)runs;
+        } else {
+            bench::print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    bench::Runner runner(bench::program_name(argv[0]), filter, n_runs, json);
+
+    for (bench::Registration* reg = bench::Registration::first(); reg;
+         reg = reg->next()) {
+        reg->run(runner);
+    }
+
+    return 0;
+}
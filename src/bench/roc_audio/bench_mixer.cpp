@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/mixer.h"
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+
+#include "bench.h"
+
+using namespace roc;
+
+namespace {
+
+enum { FrameSize = 640, NumFrames = 100, MaxInputs = 256 };
+
+core::HeapAllocator allocator;
+core::BufferPool<audio::sample_t> buffer_pool(allocator, FrameSize, 2);
+
+// fills frame with constant value, so that the mixer dominates
+class InputReader : public audio::IReader {
+public:
+    virtual void read(audio::Frame& frame) {
+        audio::sample_t* samples = frame.samples.data();
+        for (size_t n = 0; n < frame.samples.size(); n++) {
+            samples[n] = 0.001f;
+        }
+    }
+};
+
+InputReader inputs[MaxInputs];
+
+} // namespace
+
+ROC_BENCHMARK(audio_mixer) {
+    audio::Frame frame;
+    frame.samples = core::Slice<audio::sample_t>(
+        new (buffer_pool) core::Buffer<audio::sample_t>(buffer_pool));
+
+    for (size_t n_inputs = 1; n_inputs <= MaxInputs; n_inputs *= 2) {
+        if (!runner.begin(NumFrames * FrameSize,
+                          NumFrames * FrameSize * sizeof(audio::sample_t) * n_inputs,
+                          "audio/mixer/inputs=%lu", (unsigned long)n_inputs)) {
+            continue;
+        }
+
+        audio::Mixer mixer(buffer_pool);
+
+        for (size_t i = 0; i < n_inputs; i++) {
+            mixer.add(inputs[i]);
+        }
+
+        for (size_t r = 0; r < runner.n_runs(); r++) {
+            const core::nanoseconds_t start = core::timestamp();
+
+            for (size_t n = 0; n < NumFrames; n++) {
+                frame.samples.resize(FrameSize);
+                mixer.read(frame);
+            }
+
+            runner.add(core::timestamp() - start);
+        }
+
+        runner.end();
+
+        for (size_t i = 0; i < n_inputs; i++) {
+            mixer.remove(inputs[i]);
+        }
+    }
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/resampler.h"
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+
+#include "bench.h"
+
+using namespace roc;
+
+namespace {
+
+enum {
+    ChannelMask = 0x3,
+    NumChannels = 2,
+    ResamplerFrameSize = 512,
+    FrameSize = 640,
+    NumFrames = 100
+};
+
+const size_t window_sizes[] = { 16, 32, 64, 128 };
+
+const float scalings[] = { 1.0f, 0.995f, 1.005f };
+
+core::HeapAllocator allocator;
+core::BufferPool<audio::sample_t> buffer_pool(allocator, FrameSize, 4);
+
+// produces non-zero signal without any computations
+class InputReader : public audio::IReader {
+public:
+    virtual void read(audio::Frame& frame) {
+        audio::sample_t* samples = frame.samples.data();
+        for (size_t n = 0; n < frame.samples.size(); n++) {
+            samples[n] = audio::sample_t(n % 64) / 128;
+        }
+    }
+};
+
+} // namespace
+
+ROC_BENCHMARK(audio_resampler) {
+    audio::Frame frame;
+    frame.samples = core::Slice<audio::sample_t>(
+        new (buffer_pool) core::Buffer<audio::sample_t>(buffer_pool));
+
+    for (size_t w = 0; w < sizeof(window_sizes) / sizeof(window_sizes[0]); w++) {
+        for (size_t s = 0; s < sizeof(scalings) / sizeof(scalings[0]); s++) {
+            audio::ResamplerConfig config;
+            config.window_size = window_sizes[w];
+            config.frame_size = ResamplerFrameSize;
+
+            InputReader reader;
+            audio::Resampler resampler(reader, buffer_pool, allocator, config,
+                                       ChannelMask);
+
+            if (!resampler.set_scaling(scalings[s])) {
+                continue;
+            }
+
+            if (!runner.begin(NumFrames * FrameSize / NumChannels,
+                              NumFrames * FrameSize * sizeof(audio::sample_t),
+                              "audio/resampler/window=%lu/scaling=%.3f",
+                              (unsigned long)window_sizes[w], (double)scalings[s])) {
+                continue;
+            }
+
+            for (size_t r = 0; r < runner.n_runs(); r++) {
+                const core::nanoseconds_t start = core::timestamp();
+
+                for (size_t n = 0; n < NumFrames; n++) {
+                    frame.samples.resize(FrameSize);
+                    resampler.read(frame);
+                }
+
+                runner.add(core::timestamp() - start);
+            }
+
+            runner.end();
+        }
+    }
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/atomic.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/pool.h"
+#include "roc_core/thread.h"
+
+#include "bench.h"
+
+using namespace roc;
+
+namespace {
+
+enum {
+    ObjectSize = 256,
+    ChunkSize = 64,
+    MaxThreads = 8,
+    NumOps = 100000,
+    BatchSize = 16
+};
+
+struct Object {
+    char data[ObjectSize];
+};
+
+core::HeapAllocator allocator;
+
+// allocates and deallocates objects in batches, like pipeline does with
+// packets and buffers
+class Worker : public core::Thread {
+public:
+    Worker()
+        : pool_(NULL)
+        , go_(NULL)
+        , n_failed_(0) {
+    }
+
+    void init(core::Pool<Object>& pool, core::Atomic& go) {
+        pool_ = &pool;
+        go_ = &go;
+        n_failed_ = 0;
+    }
+
+    size_t n_failed() const {
+        return n_failed_;
+    }
+
+private:
+    virtual void run() {
+        while (*go_ == 0) {
+        }
+
+        void* objects[BatchSize];
+
+        for (size_t n = 0; n < NumOps; n += BatchSize) {
+            for (size_t i = 0; i < BatchSize; i++) {
+                if (!(objects[i] = pool_->allocate())) {
+                    n_failed_++;
+                }
+            }
+            for (size_t i = 0; i < BatchSize; i++) {
+                if (objects[i]) {
+                    pool_->deallocate(objects[i]);
+                }
+            }
+        }
+    }
+
+    core::Pool<Object>* pool_;
+    core::Atomic* go_;
+    size_t n_failed_;
+};
+
+Worker workers[MaxThreads];
+
+} // namespace
+
+// every thread performs NumOps allocations and deallocations; reported time per
+// operation is the wall time divided by the total number of operations
+ROC_BENCHMARK(core_pool) {
+    for (size_t n_threads = 1; n_threads <= MaxThreads; n_threads *= 2) {
+        if (!runner.begin(NumOps * n_threads, 0, "core/pool/threads=%lu",
+                          (unsigned long)n_threads)) {
+            continue;
+        }
+
+        core::Pool<Object> pool(allocator, sizeof(Object), ChunkSize);
+
+        size_t n_failed = 0;
+
+        for (size_t r = 0; r < runner.n_runs(); r++) {
+            core::Atomic go;
+
+            for (size_t t = 0; t < n_threads; t++) {
+                workers[t].init(pool, go);
+                workers[t].start();
+            }
+
+            const core::nanoseconds_t start = core::timestamp();
+
+            go = true;
+
+            for (size_t t = 0; t < n_threads; t++) {
+                workers[t].join();
+                n_failed += workers[t].n_failed();
+            }
+
+            runner.add(core::timestamp() - start);
+        }
+
+        runner.set_counter("failed", double(n_failed));
+        runner.end();
+    }
+}
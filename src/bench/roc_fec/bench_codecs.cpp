@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/random.h"
+#include "roc_core/unique_ptr.h"
+#include "roc_fec/codec_factory.h"
+
+#include "bench.h"
+
+using namespace roc;
+
+namespace {
+
+enum { PayloadSize = 1024, MaxBlockLength = 1100, NumBlocks = 20 };
+
+struct Codec {
+    fec::CodecType type;
+    const char* name;
+};
+
+const Codec codecs[] = {
+    { fec::ReedSolomon8m, "rs8m" },
+    { fec::LDPCStaircase, "ldpc" },
+    { fec::XORParity, "parity" },
+    { fec::RandomLinear, "rlc" },
+};
+
+struct Block {
+    size_t n_source;
+    size_t n_repair;
+};
+
+const Block blocks[] = {
+    { 20, 10 },
+    { 100, 20 },
+    { 200, 50 },
+    { 1000, 100 },
+};
+
+enum Loss {
+    // no packets are lost
+    LossNone,
+
+    // n_repair / 2 consecutive source packets are lost
+    LossBurst,
+
+    // n_repair / 2 random source packets are lost
+    LossRandom
+};
+
+const char* loss_name(Loss loss) {
+    switch (loss) {
+    case LossNone:
+        return "none";
+    case LossBurst:
+        return "burst";
+    case LossRandom:
+        return "random";
+    }
+    return "?";
+}
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, PayloadSize, MaxBlockLength * 2);
+
+core::Slice<uint8_t> buffers[MaxBlockLength];
+bool lost[MaxBlockLength];
+
+core::Slice<uint8_t> make_buffer() {
+    core::Slice<uint8_t> buf = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+    if (!buf) {
+        return buf;
+    }
+    buf.resize(PayloadSize);
+    for (size_t j = 0; j < buf.size(); ++j) {
+        buf.data()[j] = (uint8_t)core::random(0, 0xff);
+    }
+    return buf;
+}
+
+void make_losses(Loss loss, const Block& block) {
+    for (size_t i = 0; i < block.n_source + block.n_repair; i++) {
+        lost[i] = false;
+    }
+
+    const size_t n_lost = loss == LossNone ? 0 : block.n_repair / 2;
+
+    for (size_t n = 0; n < n_lost; n++) {
+        if (loss == LossBurst) {
+            lost[n] = true;
+        } else {
+            size_t i;
+            do {
+                i = core::random((unsigned)block.n_source);
+            } while (lost[i]);
+            lost[i] = true;
+        }
+    }
+}
+
+void encode(fec::IEncoder& encoder, const Block& block) {
+    for (size_t i = 0; i < block.n_source + block.n_repair; i++) {
+        encoder.set(i, buffers[i]);
+    }
+    encoder.commit();
+    encoder.reset();
+}
+
+size_t decode(fec::IDecoder& decoder, const Block& block) {
+    size_t n_failed = 0;
+
+    for (size_t i = 0; i < block.n_source + block.n_repair; i++) {
+        if (!lost[i]) {
+            decoder.set(i, buffers[i]);
+        }
+    }
+    for (size_t i = 0; i < block.n_source; i++) {
+        if (lost[i] && !decoder.repair(i)) {
+            n_failed++;
+        }
+    }
+    decoder.reset();
+
+    return n_failed;
+}
+
+// measures throughput for source data; every run encodes or decodes NumBlocks
+// blocks of the same data
+void bench_codec(bench::Runner& runner, const Codec& codec, const Block& block) {
+    fec::Config config;
+    config.codec = codec.type;
+    config.n_source_packets = block.n_source;
+    config.n_repair_packets = block.n_repair;
+
+    core::UniquePtr<fec::IEncoder> encoder(
+        fec::new_encoder(config, PayloadSize, allocator), allocator);
+    if (!encoder) {
+        return;
+    }
+
+    core::UniquePtr<fec::IDecoder> decoder(
+        fec::new_decoder(config, PayloadSize, buffer_pool, allocator), allocator);
+    if (!decoder) {
+        return;
+    }
+
+    const size_t n_packets = block.n_source + block.n_repair;
+    const size_t n_bytes = NumBlocks * block.n_source * PayloadSize;
+
+    for (size_t i = 0; i < n_packets; i++) {
+        buffers[i] = make_buffer();
+    }
+
+    encode(*encoder, block);
+
+    if (runner.begin(NumBlocks, n_bytes, "fec/encode/codec=%s/k=%lu/r=%lu", codec.name,
+                     (unsigned long)block.n_source, (unsigned long)block.n_repair)) {
+        for (size_t r = 0; r < runner.n_runs(); r++) {
+            const core::nanoseconds_t start = core::timestamp();
+
+            for (size_t n = 0; n < NumBlocks; n++) {
+                encode(*encoder, block);
+            }
+
+            runner.add(core::timestamp() - start);
+        }
+        runner.end();
+    }
+
+    const Loss losses[] = { LossNone, LossBurst, LossRandom };
+
+    for (size_t l = 0; l < sizeof(losses) / sizeof(losses[0]); l++) {
+        if (!runner.begin(NumBlocks, n_bytes, "fec/decode/codec=%s/k=%lu/r=%lu/loss=%s",
+                          codec.name, (unsigned long)block.n_source,
+                          (unsigned long)block.n_repair, loss_name(losses[l]))) {
+            continue;
+        }
+
+        size_t n_failed = 0;
+
+        for (size_t r = 0; r < runner.n_runs(); r++) {
+            make_losses(losses[l], block);
+
+            const core::nanoseconds_t start = core::timestamp();
+
+            for (size_t n = 0; n < NumBlocks; n++) {
+                n_failed += decode(*decoder, block);
+            }
+
+            runner.add(core::timestamp() - start);
+        }
+
+        runner.set_counter("failed", double(n_failed));
+        runner.end();
+    }
+
+    for (size_t i = 0; i < n_packets; i++) {
+        buffers[i] = core::Slice<uint8_t>();
+    }
+}
+
+} // namespace
+
+ROC_BENCHMARK(fec_codecs) {
+    for (size_t c = 0; c < sizeof(codecs) / sizeof(codecs[0]); c++) {
+        if (!fec::codec_supported(codecs[c].type)) {
+            continue;
+        }
+        for (size_t b = 0; b < sizeof(blocks) / sizeof(blocks[0]); b++) {
+            bench_codec(runner, codecs[c], blocks[b]);
+        }
+    }
+}
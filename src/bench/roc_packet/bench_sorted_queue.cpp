@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/heap_allocator.h"
+#include "roc_core/macros.h"
+#include "roc_core/random.h"
+#include "roc_packet/packet_pool.h"
+#include "roc_packet/sorted_queue.h"
+
+#include "bench.h"
+
+using namespace roc;
+
+namespace {
+
+enum {
+    NumPackets = 10000,
+
+    // number of packets kept in queue, like in receiver
+    QueueDepth = 64,
+
+    // maximum distance of reordered packet from its position
+    JitterWindow = 16
+};
+
+enum Pattern {
+    // packets arrive in order
+    PatternInOrder,
+
+    // every two adjacent packets are swapped
+    PatternSwap,
+
+    // packets are shuffled within fixed-size windows
+    PatternJitter,
+
+    // every tenth packet is lost
+    PatternLoss,
+
+    // every packet is duplicated
+    PatternDuplicate
+};
+
+const char* pattern_name(Pattern pattern) {
+    switch (pattern) {
+    case PatternInOrder:
+        return "inorder";
+    case PatternSwap:
+        return "swap";
+    case PatternJitter:
+        return "jitter";
+    case PatternLoss:
+        return "loss";
+    case PatternDuplicate:
+        return "duplicate";
+    }
+    return "?";
+}
+
+core::HeapAllocator allocator;
+packet::PacketPool pool(allocator, NumPackets);
+
+packet::PacketPtr packets[NumPackets];
+
+// indices of packets in arrival order
+size_t order[NumPackets * 2];
+
+// assigns seqnums starting from base and fills arrival order; returns number of
+// writes
+size_t make_pattern(Pattern pattern, packet::seqnum_t base) {
+    size_t n_writes = 0;
+
+    for (size_t i = 0; i < NumPackets; i++) {
+        switch (pattern) {
+        case PatternInOrder:
+        case PatternJitter:
+        case PatternLoss:
+            order[n_writes++] = i;
+            break;
+
+        case PatternSwap:
+            order[n_writes++] = (i ^ 1) < NumPackets ? (i ^ 1) : i;
+            break;
+
+        case PatternDuplicate:
+            order[n_writes++] = i;
+            order[n_writes++] = i;
+            break;
+        }
+    }
+
+    if (pattern == PatternJitter) {
+        for (size_t begin = 0; begin < NumPackets; begin += JitterWindow) {
+            const size_t size = ROC_MIN((size_t)JitterWindow, NumPackets - begin);
+            for (size_t i = size - 1; i > 0; i--) {
+                const size_t j = core::random((unsigned)i + 1);
+                const size_t tmp = order[begin + i];
+                order[begin + i] = order[begin + j];
+                order[begin + j] = tmp;
+            }
+        }
+    }
+
+    if (pattern == PatternLoss) {
+        n_writes = 0;
+        for (size_t i = 0; i < NumPackets; i++) {
+            if (i % 10 != 9) {
+                order[n_writes++] = i;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < NumPackets; i++) {
+        packets[i]->rtp()->seqnum = packet::seqnum_t(base + i);
+    }
+
+    return n_writes;
+}
+
+} // namespace
+
+ROC_BENCHMARK(packet_sorted_queue) {
+    for (size_t i = 0; i < NumPackets; i++) {
+        packets[i] = new (pool) packet::Packet(pool);
+        packets[i]->add_flags(packet::Packet::FlagRTP);
+    }
+
+    const Pattern patterns[] = { PatternInOrder, PatternSwap, PatternJitter, PatternLoss,
+                                 PatternDuplicate };
+
+    for (size_t p = 0; p < sizeof(patterns) / sizeof(patterns[0]); p++) {
+        const size_t n_writes = make_pattern(patterns[p], 0);
+
+        if (!runner.begin(n_writes, 0, "packet/sorted_queue/%s",
+                          pattern_name(patterns[p]))) {
+            continue;
+        }
+
+        packet::seqnum_t base = 0;
+
+        // number of duplicates dropped during one run, to match ops
+        size_t n_duplicates = 0;
+
+        for (size_t r = 0; r < runner.n_runs(); r++) {
+            packet::SortedQueue queue(allocator, 0);
+
+            // seqnums continue from run to run and wrap around
+            make_pattern(patterns[p], base);
+            base = packet::seqnum_t(base + NumPackets);
+
+            const core::nanoseconds_t start = core::timestamp();
+
+            for (size_t n = 0; n < n_writes; n++) {
+                queue.write(packets[order[n]]);
+
+                if (queue.size() > QueueDepth) {
+                    queue.read();
+                }
+            }
+
+            while (queue.read()) {
+            }
+
+            runner.add(core::timestamp() - start);
+
+            n_duplicates = queue.n_duplicates();
+        }
+
+        runner.set_counter("duplicates", double(n_duplicates));
+        runner.end();
+    }
+
+    for (size_t i = 0; i < NumPackets; i++) {
+        packets[i] = packet::PacketPtr();
+    }
+}
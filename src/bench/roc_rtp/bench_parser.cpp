@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_packet/packet_pool.h"
+#include "roc_rtp/format_map.h"
+#include "roc_rtp/headers.h"
+#include "roc_rtp/parser.h"
+
+#include "bench.h"
+
+using namespace roc;
+
+namespace {
+
+enum { PayloadSize = 1280, NumPackets = 10000 };
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, sizeof(rtp::Header) + PayloadSize, 1);
+packet::PacketPool packet_pool(allocator, 1);
+
+core::Slice<uint8_t> make_buffer() {
+    core::Slice<uint8_t> buf = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+    buf.resize(sizeof(rtp::Header) + PayloadSize);
+
+    rtp::Header& header = *(rtp::Header*)buf.data();
+    header.clear();
+    header.set_version(rtp::V2);
+    header.set_payload_type(rtp::PayloadType_L16_Stereo);
+    header.set_seqnum(1);
+    header.set_timestamp(1000);
+    header.set_ssrc(123);
+
+    return buf;
+}
+
+} // namespace
+
+ROC_BENCHMARK(rtp_parser) {
+    if (!runner.begin(NumPackets, NumPackets * (sizeof(rtp::Header) + PayloadSize),
+                      "rtp/parser")) {
+        return;
+    }
+
+    rtp::FormatMap format_map;
+    rtp::Parser parser(format_map, NULL);
+
+    core::Slice<uint8_t> buffer = make_buffer();
+
+    size_t n_failed = 0;
+
+    for (size_t r = 0; r < runner.n_runs(); r++) {
+        const core::nanoseconds_t start = core::timestamp();
+
+        // like in receiver, every packet is allocated from pool and parsed once
+        for (size_t n = 0; n < NumPackets; n++) {
+            packet::PacketPtr packet = new (packet_pool) packet::Packet(packet_pool);
+            if (!packet || !parser.parse(*packet, buffer)) {
+                n_failed++;
+            }
+        }
+
+        runner.add(core::timestamp() - start);
+    }
+
+    runner.set_counter("failed", double(n_failed));
+    runner.end();
+}
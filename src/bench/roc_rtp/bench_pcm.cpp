@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_rtp/pcm_helpers.h"
+
+#include "bench.h"
+
+using namespace roc;
+
+namespace {
+
+enum { NumSamples = 320, NumChannels = 2, NumPackets = 1000 };
+
+struct Layout {
+    packet::channel_mask_t mask;
+    const char* name;
+};
+
+// stereo frames are copied directly, mono frames are spread between channels
+const Layout layouts[] = {
+    { 0x3, "stereo" },
+    { 0x1, "mono" },
+};
+
+audio::sample_t samples[NumSamples * NumChannels];
+int16_t payload[NumSamples * NumChannels];
+
+} // namespace
+
+ROC_BENCHMARK(rtp_pcm_write) {
+    for (size_t n = 0; n < NumSamples * NumChannels; n++) {
+        samples[n] = audio::sample_t(n % 100) / 200;
+    }
+
+    for (size_t l = 0; l < sizeof(layouts) / sizeof(layouts[0]); l++) {
+        const size_t n_channels = packet::num_channels(layouts[l].mask);
+
+        if (!runner.begin(NumPackets * NumSamples, NumPackets * NumSamples * n_channels
+                              * sizeof(audio::sample_t),
+                          "rtp/pcm_write/s16/%s", layouts[l].name)) {
+            continue;
+        }
+
+        for (size_t r = 0; r < runner.n_runs(); r++) {
+            const core::nanoseconds_t start = core::timestamp();
+
+            for (size_t n = 0; n < NumPackets; n++) {
+                rtp::pcm_write<int16_t, NumChannels>(payload, sizeof(payload), 0,
+                                                     samples, NumSamples,
+                                                     layouts[l].mask);
+            }
+
+            runner.add(core::timestamp() - start);
+        }
+
+        runner.end();
+    }
+}
+
+ROC_BENCHMARK(rtp_pcm_read) {
+    for (size_t n = 0; n < NumSamples * NumChannels; n++) {
+        payload[n] = int16_t(n * 97);
+    }
+
+    for (size_t l = 0; l < sizeof(layouts) / sizeof(layouts[0]); l++) {
+        if (!runner.begin(NumPackets * NumSamples, NumPackets * sizeof(payload),
+                          "rtp/pcm_read/s16/%s", layouts[l].name)) {
+            continue;
+        }
+
+        for (size_t r = 0; r < runner.n_runs(); r++) {
+            const core::nanoseconds_t start = core::timestamp();
+
+            for (size_t n = 0; n < NumPackets; n++) {
+                rtp::pcm_read<int16_t, NumChannels>(payload, sizeof(payload), 0, samples,
+                                                    NumSamples, layouts[l].mask);
+            }
+
+            runner.add(core::timestamp() - start);
+        }
+
+        runner.end();
+    }
+}
@@ -30,7 +30,12 @@ enum {
     //! Turn on timing in receiver or sender.
     //! Timer is used to constrain the sender or receiver speed to its sample
     //! rate using a CPU timer.
-    ROC_FLAG_ENABLE_TIMER = (1 << 2)
+    ROC_FLAG_ENABLE_TIMER = (1 << 2),
+
+    //! Lock preallocated packets and frames in RAM.
+    //! Prevents preallocated memory from being swapped out. Requires enough
+    //! RLIMIT_MEMLOCK.
+    ROC_FLAG_LOCK_MEMORY = (1 << 3)
 };
 
 //! Network protocol.
@@ -48,7 +53,21 @@ typedef enum roc_protocol {
     ROC_PROTO_RTP_LDPC_SOURCE = 3,
 
     //! FEC repair packet + FECFRAME LDPC header.
-    ROC_PROTO_LDPC_REPAIR = 4
+    ROC_PROTO_LDPC_REPAIR = 4,
+
+    //! RTP source packet + FECFRAME XOR parity footer.
+    ROC_PROTO_RTP_PARITY_SOURCE = 5,
+
+    //! FEC repair packet + FECFRAME XOR parity header.
+    ROC_PROTO_PARITY_REPAIR = 6,
+
+    //! RTP source packet + FECFRAME random linear code footer.
+    //! Experimental, see ROC_FEC_RLC.
+    ROC_PROTO_RTP_RLC_SOURCE = 7,
+
+    //! FEC repair packet + FECFRAME random linear code header.
+    //! Experimental, see ROC_FEC_RLC.
+    ROC_PROTO_RLC_REPAIR = 8
 } roc_protocol;
 
 //! FEC scheme type.
@@ -62,7 +81,19 @@ typedef enum roc_fec_scheme {
     ROC_FEC_LDPC_STAIRCASE = 1,
 
     //! Disable FEC.
-    ROC_FEC_NONE = 2
+    ROC_FEC_NONE = 2,
+
+    //! XOR parity FEC code.
+    //! Very cheap to encode and decode, good for low-power devices, but
+    //! repairs fewer loss patterns than Reed-Solomon.
+    ROC_FEC_XOR_PARITY = 3,
+
+    //! Random linear FEC code over GF(2^8).
+    //! Good for large block sizes on lossy links (up to 8192 packets).
+    //! Experimental: this is not RFC 6330 RaptorQ or any other standard code,
+    //! and its wire format may change in future versions, so sender and
+    //! receiver should use the same version of the library.
+    ROC_FEC_RLC = 4
 } roc_fec_scheme;
 
 //! Sender configuration.
@@ -79,6 +110,30 @@ typedef struct roc_sender_config {
     //! Number of repair packets per FEC block.
     unsigned int n_repair_packets;
 
+    //! Number of packets to preallocate.
+    //! If zero, packets are allocated on demand.
+    unsigned int packet_pool_size;
+
+    //! Number of frames to preallocate.
+    //! If zero, frames are allocated on demand.
+    unsigned int frame_pool_size;
+
+    //! Maximum number of packets.
+    //! If zero, the number of packets is not limited. If non-zero, new packets
+    //! are dropped when all packets are in use.
+    unsigned int max_packets;
+
+    //! Maximum packet size in bytes.
+    //! Packet buffers are allocated of this size. Should be large enough to hold
+    //! a packet with samples_per_packet samples, including RTP and FEC headers.
+    //! If zero, default value is used.
+    unsigned int max_packet_size;
+
+    //! Maximum frame size, number of samples for all channels.
+    //! Frame buffers are allocated of this size. Larger reads and writes are
+    //! split into several frames. If zero, default value is used.
+    unsigned int max_frame_size;
+
     //! A bitmask of ROC_FLAG_* constants.
     unsigned int flags;
 } roc_sender_config;
@@ -103,6 +158,30 @@ typedef struct roc_receiver_config {
     //! Number of repair packets per FEC block.
     unsigned int n_repair_packets;
 
+    //! Number of packets to preallocate.
+    //! If zero, packets are allocated on demand.
+    unsigned int packet_pool_size;
+
+    //! Number of frames to preallocate.
+    //! If zero, frames are allocated on demand.
+    unsigned int frame_pool_size;
+
+    //! Maximum number of packets.
+    //! If zero, the number of packets is not limited. If non-zero, new packets
+    //! are dropped when all packets are in use.
+    unsigned int max_packets;
+
+    //! Maximum packet size in bytes.
+    //! Packet buffers are allocated of this size. Should be large enough to hold
+    //! a packet with samples_per_packet samples, including RTP and FEC headers.
+    //! If zero, default value is used.
+    unsigned int max_packet_size;
+
+    //! Maximum frame size, number of samples for all channels.
+    //! Frame buffers are allocated of this size. Larger reads and writes are
+    //! split into several frames. If zero, default value is used.
+    unsigned int max_frame_size;
+
     //! A bitmask of ROC_FLAG_* constants.
     unsigned int flags;
 } roc_receiver_config;
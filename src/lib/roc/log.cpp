@@ -20,3 +20,7 @@ void roc_log_set_level(roc_log_level level) {
 void roc_log_set_handler(roc_log_handler handler) {
     core::set_log_handler(core::LogHandler(handler));
 }
+
+void roc_log_set_async(int enabled) {
+    core::set_log_async(enabled != 0);
+}
@@ -43,6 +43,14 @@ ROC_API void roc_log_set_level(roc_log_level level);
 //! messages are printed to stderr by default.
 ROC_API void roc_log_set_handler(roc_log_handler handler);
 
+//! Enable or disable asynchronous logging.
+//! If @p enabled is non-zero, messages are queued to a lock-free ring buffer
+//! and printed or passed to the log handler from a background thread, so that
+//! logging doesn't block the calling thread. If the ring buffer is full,
+//! messages are dropped. Disabling flushes pending messages. Asynchronous
+//! logging is disabled by default.
+ROC_API void roc_log_set_async(int enabled);
+
 #ifdef __cplusplus
 }
 #endif
@@ -11,6 +11,7 @@
 
 #include "roc_core/heap_allocator.h"
 #include "roc_core/log.h"
+#include "roc_fec/codec_factory.h"
 #include "roc_netio/transceiver.h"
 #include "roc_packet/address_to_str.h"
 #include "roc_packet/parse_address.h"
@@ -20,8 +21,35 @@ using namespace roc;
 
 namespace {
 
-// TODO: make this configurable
-enum { MaxPacketSize = 2048, MaxFrameSize = 65 * 1024 };
+enum { DefaultMaxPacketSize = 2048, DefaultMaxFrameSize = 4096 };
+
+size_t max_packet_size(const roc_receiver_config* in) {
+    return in->max_packet_size ? in->max_packet_size : (size_t)DefaultMaxPacketSize;
+}
+
+size_t max_frame_size(const roc_receiver_config* in) {
+    return in->max_frame_size ? in->max_frame_size : (size_t)DefaultMaxFrameSize;
+}
+
+size_t min_packet_size(const pipeline::SessionConfig& config) {
+    rtp::FormatMap format_map;
+
+    const rtp::Format* format = format_map.format(config.payload_type);
+    if (!format) {
+        return 0;
+    }
+
+    return format->size(config.samples_per_packet)
+        + fec::packet_overhead(config.fec.codec);
+}
+
+void make_latency(roc_latency* out, const core::HistogramSnapshot& in) {
+    out->count = (unsigned long)in.count();
+    out->p50_ns = in.quantile(0.5);
+    out->p99_ns = in.quantile(0.99);
+    out->p999_ns = in.quantile(0.999);
+    out->max_ns = in.quantile(1);
+}
 
 bool make_receiver_config(pipeline::ReceiverConfig& out, const roc_receiver_config* in) {
     out.default_session.latency = in->latency;
@@ -35,6 +63,12 @@ bool make_receiver_config(pipeline::ReceiverConfig& out, const roc_receiver_conf
     case ROC_FEC_LDPC_STAIRCASE:
         out.default_session.fec.codec = fec::LDPCStaircase;
         break;
+    case ROC_FEC_XOR_PARITY:
+        out.default_session.fec.codec = fec::XORParity;
+        break;
+    case ROC_FEC_RLC:
+        out.default_session.fec.codec = fec::RandomLinear;
+        break;
     case ROC_FEC_NONE:
         out.default_session.fec.codec = fec::NoCodec;
         break;
@@ -45,8 +79,31 @@ bool make_receiver_config(pipeline::ReceiverConfig& out, const roc_receiver_conf
     out.default_session.fec.n_source_packets = in->n_source_packets;
     out.default_session.fec.n_repair_packets = in->n_repair_packets;
 
+    // packets are received into buffers of this size
+    if (max_packet_size(in) < min_packet_size(out.default_session)) {
+        roc_log(LogError, "roc receiver: packet size is too small: size=%lu min=%lu",
+                (unsigned long)max_packet_size(in),
+                (unsigned long)min_packet_size(out.default_session));
+        return false;
+    }
+
     out.default_session.resampling = !(in->flags & ROC_FLAG_DISABLE_RESAMPLER);
 
+    if (max_frame_size(in) < packet::num_channels(out.channels)) {
+        roc_log(LogError, "roc receiver: frame size is too small: size=%lu",
+                (unsigned long)max_frame_size(in));
+        return false;
+    }
+
+    // resampler allocates its window from frame buffers
+    if (out.default_session.resampling
+        && max_frame_size(in) < out.default_session.resampler.frame_size) {
+        roc_log(LogError, "roc receiver: frame size is too small: size=%lu min=%lu",
+                (unsigned long)max_frame_size(in),
+                (unsigned long)out.default_session.resampler.frame_size);
+        return false;
+    }
+
     out.timing = (in->flags & ROC_FLAG_ENABLE_TIMER);
 
     return true;
@@ -71,6 +128,18 @@ bool make_port_config(pipeline::PortConfig& out,
     case ROC_PROTO_LDPC_REPAIR:
         out.protocol = pipeline::Proto_LDPC_Repair;
         break;
+    case ROC_PROTO_RTP_PARITY_SOURCE:
+        out.protocol = pipeline::Proto_RTP_Parity_Source;
+        break;
+    case ROC_PROTO_PARITY_REPAIR:
+        out.protocol = pipeline::Proto_Parity_Repair;
+        break;
+    case ROC_PROTO_RTP_RLC_SOURCE:
+        out.protocol = pipeline::Proto_RTP_RLC_Source;
+        break;
+    case ROC_PROTO_RLC_REPAIR:
+        out.protocol = pipeline::Proto_RLC_Repair;
+        break;
     default:
         return false;
     }
@@ -96,17 +165,44 @@ struct roc_receiver {
     pipeline::Receiver receiver;
     netio::Transceiver trx;
 
-    roc_receiver(pipeline::ReceiverConfig& config)
+    // number of samples per frame, multiple of the number of channels
+    size_t frame_size;
+
+    roc_receiver(pipeline::ReceiverConfig& config,
+                 size_t max_packet_size,
+                 size_t max_frame_size)
         : packet_pool(allocator, 1)
-        , byte_buffer_pool(allocator, MaxPacketSize, 1)
-        , sample_buffer_pool(allocator, MaxFrameSize, 1)
+        , byte_buffer_pool(allocator, max_packet_size, 1)
+        , sample_buffer_pool(allocator, max_frame_size, 1)
         , receiver(config,
                    format_map,
                    packet_pool,
                    byte_buffer_pool,
                    sample_buffer_pool,
                    allocator)
-        , trx(packet_pool, byte_buffer_pool, allocator) {
+        , trx(packet_pool, byte_buffer_pool, allocator)
+        , frame_size(max_frame_size
+                     - max_frame_size % packet::num_channels(config.channels)) {
+    }
+
+    bool setup_pools(const roc_receiver_config& cfg) {
+        const bool lock = (cfg.flags & ROC_FLAG_LOCK_MEMORY);
+
+        packet_pool.set_limit(cfg.max_packets);
+        byte_buffer_pool.set_limit(cfg.max_packets);
+
+        return packet_pool.reserve(cfg.packet_pool_size, lock)
+            && byte_buffer_pool.reserve(cfg.packet_pool_size, lock)
+            && sample_buffer_pool.reserve(cfg.frame_pool_size, lock);
+    }
+
+    size_t num_alloc_failures() const {
+        return packet_pool.num_failures() + byte_buffer_pool.num_failures()
+            + sample_buffer_pool.num_failures();
+    }
+
+    size_t trim_pools() {
+        return packet_pool.trim() + byte_buffer_pool.trim() + sample_buffer_pool.trim();
     }
 };
 
@@ -118,7 +214,17 @@ roc_receiver* roc_receiver_new(const roc_receiver_config* config) {
     }
 
     roc_log(LogInfo, "roc receiver: creating receiver");
-    return new roc_receiver(c);
+
+    roc_receiver* receiver =
+        new roc_receiver(c, max_packet_size(config), max_frame_size(config));
+
+    if (!receiver->setup_pools(*config)) {
+        roc_log(LogError, "roc receiver: can't preallocate memory");
+        delete receiver;
+        return NULL;
+    }
+
+    return receiver;
 }
 
 int roc_receiver_bind(roc_receiver* receiver, roc_protocol proto, struct sockaddr* addr) {
@@ -154,17 +260,143 @@ roc_receiver_read(roc_receiver* receiver, float* samples, const size_t n_samples
     roc_panic_if(!receiver);
     roc_panic_if(!samples && n_samples != 0);
 
-    audio::Frame frame;
-    frame.samples = new (receiver->sample_buffer_pool)
+    roc_panic_if(sizeof(float) != sizeof(audio::sample_t));
+
+    size_t n_read = 0;
+
+    while (n_read < n_samples) {
+        const size_t n = ROC_MIN(receiver->frame_size, n_samples - n_read);
+
+        audio::Frame frame;
+        frame.samples = new (receiver->sample_buffer_pool)
+            core::Buffer<audio::sample_t>(receiver->sample_buffer_pool);
+
+        if (!frame.samples) {
+            roc_log(LogError, "roc receiver: can't allocate frame");
+            return n_read ? (ssize_t)n_read : -1;
+        }
+
+        frame.samples.resize(n);
+        receiver->receiver.read(frame);
+
+        memcpy(samples + n_read, frame.samples.data(), n * sizeof(audio::sample_t));
+
+        n_read += n;
+    }
+
+    return (ssize_t)n_samples;
+}
+
+const float* roc_receiver_begin_read(roc_receiver* receiver, const size_t n_samples) {
+    roc_panic_if(!receiver);
+
+    if (n_samples > receiver->frame_size) {
+        roc_log(LogError, "roc receiver: too many samples: n_samples=%lu max=%lu",
+                (unsigned long)n_samples, (unsigned long)receiver->frame_size);
+        return NULL;
+    }
+
+    core::Buffer<audio::sample_t>* buffer = new (receiver->sample_buffer_pool)
         core::Buffer<audio::sample_t>(receiver->sample_buffer_pool);
 
+    if (!buffer) {
+        roc_log(LogError, "roc receiver: can't allocate frame");
+        return NULL;
+    }
+
+    audio::Frame frame;
+    frame.samples = buffer;
     frame.samples.resize(n_samples);
+
     receiver->receiver.read(frame);
 
+    // the reference is held by the caller until roc_receiver_end_read()
+    buffer->incref();
+
     roc_panic_if(sizeof(float) != sizeof(audio::sample_t));
-    memcpy(samples, frame.samples.data(), n_samples * sizeof(audio::sample_t));
+    return buffer->data();
+}
 
-    return (ssize_t)n_samples;
+void roc_receiver_end_read(roc_receiver* receiver, const float* samples) {
+    roc_panic_if(!receiver);
+    roc_panic_if(!samples);
+
+    core::Buffer<audio::sample_t>::container_of(const_cast<float*>(samples))->decref();
+}
+
+int roc_receiver_get_stats(roc_receiver* receiver, roc_receiver_stats* stats) {
+    roc_panic_if(!receiver);
+    roc_panic_if(!stats);
+
+    const pipeline::ReceiverStats s = receiver->receiver.stats();
+
+    stats->n_sessions = (unsigned int)s.n_sessions;
+    stats->n_packets_received = (unsigned long)s.n_packets_received;
+    stats->n_packets_late = (unsigned long)s.sessions.n_packets_late;
+    stats->n_packets_duplicate = (unsigned long)s.sessions.n_packets_duplicate;
+    stats->n_packets_repaired = (unsigned long)s.sessions.n_packets_repaired;
+    stats->n_samples_concealed = (unsigned long)s.sessions.n_samples_concealed;
+    stats->n_alloc_failures = (unsigned long)receiver->num_alloc_failures();
+    stats->queue_size = (unsigned int)s.sessions.queue_size;
+    stats->resampler_scaling = s.sessions.resampler_scaling;
+    stats->n_frames = (unsigned long)s.n_frames;
+    stats->n_timed_frames = (unsigned long)s.n_timed_frames;
+    stats->fetch_time_ns = s.fetch_time;
+    stats->mix_time_ns = s.mix_time;
+    stats->update_time_ns = s.update_time;
+
+    return 0;
+}
+
+int roc_receiver_get_latency(roc_receiver* receiver,
+                             roc_receiver_stage stage,
+                             roc_latency* latency) {
+    roc_panic_if(!receiver);
+    roc_panic_if(!latency);
+
+    pipeline::ReceiverStage pipeline_stage;
+
+    switch ((unsigned)stage) {
+    case ROC_RECEIVER_STAGE_FETCH:
+        pipeline_stage = pipeline::ReceiverStage_Fetch;
+        break;
+    case ROC_RECEIVER_STAGE_DEPACKETIZE:
+        pipeline_stage = pipeline::ReceiverStage_Depacketize;
+        break;
+    case ROC_RECEIVER_STAGE_SESSION:
+        pipeline_stage = pipeline::ReceiverStage_Session;
+        break;
+    case ROC_RECEIVER_STAGE_MIX:
+        pipeline_stage = pipeline::ReceiverStage_Mix;
+        break;
+    case ROC_RECEIVER_STAGE_UPDATE:
+        pipeline_stage = pipeline::ReceiverStage_Update;
+        break;
+    case ROC_RECEIVER_STAGE_FRAME:
+        pipeline_stage = pipeline::ReceiverStage_Frame;
+        break;
+    default:
+        roc_log(LogError, "roc receiver: invalid stage");
+        return -1;
+    }
+
+    core::HistogramSnapshot snapshot;
+    if (!receiver->receiver.latency(pipeline_stage, snapshot)) {
+        roc_log(LogError, "roc receiver: latency histograms are disabled");
+        return -1;
+    }
+
+    make_latency(latency, snapshot);
+    return 0;
+}
+
+void roc_receiver_trim(roc_receiver* receiver) {
+    roc_panic_if(!receiver);
+
+    const size_t n_released = receiver->trim_pools();
+
+    roc_log(LogDebug, "roc receiver: trimmed pools: released=%lu",
+            (unsigned long)n_released);
 }
 
 void roc_receiver_stop(roc_receiver* receiver) {
@@ -22,6 +22,79 @@ extern "C" {
 //! Receiver.
 typedef struct roc_receiver roc_receiver;
 
+//! Receiver statistics.
+//! Counters are accumulated since the receiver was created.
+typedef struct roc_receiver_stats {
+    //! Number of active sessions.
+    unsigned int n_sessions;
+
+    //! Number of packets received from network.
+    unsigned long n_packets_received;
+
+    //! Number of packets dropped because they arrived too late.
+    unsigned long n_packets_late;
+
+    //! Number of dropped duplicate packets.
+    unsigned long n_packets_duplicate;
+
+    //! Number of packets repaired using FEC.
+    unsigned long n_packets_repaired;
+
+    //! Number of samples per channel filled in place of lost packets.
+    unsigned long n_samples_concealed;
+
+    //! Number of failed allocations of packets, packet buffers, and frames.
+    //! Non-zero if max_packets limit was reached or memory is exhausted. The
+    //! corresponding packets are dropped.
+    unsigned long n_alloc_failures;
+
+    //! Number of packets waiting in jitter buffers of all sessions.
+    unsigned int queue_size;
+
+    //! Resampler scaling factor averaged over sessions.
+    float resampler_scaling;
+
+    //! Number of frames read from receiver.
+    unsigned long n_frames;
+
+    //! Number of frames for which time of individual stages was measured.
+    //! Stages are timed, and statistics are updated, a few times per second.
+    unsigned long n_timed_frames;
+
+    //! Total time spent fetching and routing incoming packets in timed frames,
+    //! in nanoseconds.
+    uint64_t fetch_time_ns;
+
+    //! Total time spent producing timed frames, in nanoseconds.
+    uint64_t mix_time_ns;
+
+    //! Total time spent updating sessions in timed frames, in nanoseconds.
+    uint64_t update_time_ns;
+} roc_receiver_stats;
+
+//! Receiver pipeline stage.
+//! Time of every stage includes time of the stages it calls. Fetch, mix, and
+//! update stages are recorded only for timed frames.
+typedef enum roc_receiver_stage {
+    //! Fetching, parsing, and routing incoming packets.
+    ROC_RECEIVER_STAGE_FETCH = 0,
+
+    //! Depacketizing frame of one session, including FEC decoding.
+    ROC_RECEIVER_STAGE_DEPACKETIZE = 1,
+
+    //! Reading frame of one session, including depacketizing and resampling.
+    ROC_RECEIVER_STAGE_SESSION = 2,
+
+    //! Producing frame mixed from all sessions.
+    ROC_RECEIVER_STAGE_MIX = 3,
+
+    //! Updating sessions.
+    ROC_RECEIVER_STAGE_UPDATE = 4,
+
+    //! Whole frame, excluding waiting for the clock.
+    ROC_RECEIVER_STAGE_FRAME = 5
+} roc_receiver_stage;
+
 //! Create a new receiver.
 //! This function allocates memory, but the receiver is not started.
 //! Returns a new object on success or NULL on error.
@@ -42,6 +115,38 @@ ROC_API ssize_t roc_receiver_read(roc_receiver* receiver,
                                   float* samples,
                                   const size_t n_samples);
 
+//! Read samples from receiver into a frame buffer owned by receiver.
+//! Allows to read samples without copying them. n_samples should not exceed
+//! max_frame_size. The buffer remains valid until it's passed to
+//! roc_receiver_end_read().
+//! Returns a pointer to n_samples samples on success or NULL on error.
+ROC_API const float* roc_receiver_begin_read(roc_receiver* receiver,
+                                             const size_t n_samples);
+
+//! Release a frame buffer obtained from roc_receiver_begin_read().
+ROC_API void roc_receiver_end_read(roc_receiver* receiver, const float* samples);
+
+//! Get receiver statistics.
+//! May be called from any thread, doesn't block reading.
+//! Returns 0 on success or -1 on error.
+ROC_API int roc_receiver_get_stats(roc_receiver* receiver, roc_receiver_stats* stats);
+
+//! Release unused memory.
+//! Returns memory of packets and frames that were allocated on demand and are
+//! not used anymore. Memory preallocated according to packet_pool_size and
+//! frame_pool_size is kept. May be called from any thread. It briefly locks
+//! the memory pools, so it should be called rarely, e.g. after a traffic burst
+//! or when there are no sessions.
+ROC_API void roc_receiver_trim(roc_receiver* receiver);
+
+//! Get latency distribution of receiver pipeline stage.
+//! May be called from any thread, doesn't block reading.
+//! Returns 0 on success or -1 on error, e.g. if histograms were disabled
+//! at compile time.
+ROC_API int roc_receiver_get_latency(roc_receiver* receiver,
+                                     roc_receiver_stage stage,
+                                     roc_latency* latency);
+
 //! Stop the receiver.
 ROC_API void roc_receiver_stop(roc_receiver* receiver);
 
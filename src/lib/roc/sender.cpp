@@ -11,6 +11,7 @@
 
 #include "roc_core/heap_allocator.h"
 #include "roc_core/log.h"
+#include "roc_fec/codec_factory.h"
 #include "roc_netio/transceiver.h"
 #include "roc_packet/address_to_str.h"
 #include "roc_packet/parse_address.h"
@@ -20,12 +21,45 @@ using namespace roc;
 
 namespace {
 
-// TODO: make this configurable
-enum { MaxPacketSize = 2048, MaxFrameSize = 65 * 1024 };
+enum { DefaultMaxPacketSize = 2048, DefaultMaxFrameSize = 4096 };
+
+size_t max_packet_size(const roc_sender_config* in) {
+    return in->max_packet_size ? in->max_packet_size : (size_t)DefaultMaxPacketSize;
+}
+
+size_t max_frame_size(const roc_sender_config* in) {
+    return in->max_frame_size ? in->max_frame_size : (size_t)DefaultMaxFrameSize;
+}
+
+size_t min_packet_size(const pipeline::SenderConfig& config) {
+    rtp::FormatMap format_map;
+
+    const rtp::Format* format = format_map.format(config.payload_type);
+    if (!format) {
+        return 0;
+    }
+
+    return format->size(config.samples_per_packet)
+        + fec::packet_overhead(config.fec.codec);
+}
+
+void make_latency(roc_latency* out, const core::HistogramSnapshot& in) {
+    out->count = (unsigned long)in.count();
+    out->p50_ns = in.quantile(0.5);
+    out->p99_ns = in.quantile(0.99);
+    out->p999_ns = in.quantile(0.999);
+    out->max_ns = in.quantile(1);
+}
 
 bool make_sender_config(pipeline::SenderConfig& out, const roc_sender_config* in) {
     out.samples_per_packet = in->samples_per_packet;
 
+    if (max_frame_size(in) < packet::num_channels(out.channels)) {
+        roc_log(LogError, "roc sender: frame size is too small: size=%lu",
+                (unsigned long)max_frame_size(in));
+        return false;
+    }
+
     switch ((unsigned)in->fec_scheme) {
     case ROC_FEC_RS8M:
         out.fec.codec = fec::ReedSolomon8m;
@@ -33,6 +67,12 @@ bool make_sender_config(pipeline::SenderConfig& out, const roc_sender_config* in
     case ROC_FEC_LDPC_STAIRCASE:
         out.fec.codec = fec::LDPCStaircase;
         break;
+    case ROC_FEC_XOR_PARITY:
+        out.fec.codec = fec::XORParity;
+        break;
+    case ROC_FEC_RLC:
+        out.fec.codec = fec::RandomLinear;
+        break;
     case ROC_FEC_NONE:
         out.fec.codec = fec::NoCodec;
         break;
@@ -43,6 +83,13 @@ bool make_sender_config(pipeline::SenderConfig& out, const roc_sender_config* in
     out.fec.n_source_packets = in->n_source_packets;
     out.fec.n_repair_packets = in->n_repair_packets;
 
+    // packets are composed in buffers of this size
+    if (max_packet_size(in) < min_packet_size(out)) {
+        roc_log(LogError, "roc sender: packet size is too small: size=%lu min=%lu",
+                (unsigned long)max_packet_size(in), (unsigned long)min_packet_size(out));
+        return false;
+    }
+
     out.interleaving = !(in->flags & ROC_FLAG_DISABLE_INTERLEAVER);
     out.timing = (in->flags & ROC_FLAG_ENABLE_TIMER);
 
@@ -68,6 +115,18 @@ bool make_port_config(pipeline::PortConfig& out,
     case ROC_PROTO_LDPC_REPAIR:
         out.protocol = pipeline::Proto_LDPC_Repair;
         break;
+    case ROC_PROTO_RTP_PARITY_SOURCE:
+        out.protocol = pipeline::Proto_RTP_Parity_Source;
+        break;
+    case ROC_PROTO_PARITY_REPAIR:
+        out.protocol = pipeline::Proto_Parity_Repair;
+        break;
+    case ROC_PROTO_RTP_RLC_SOURCE:
+        out.protocol = pipeline::Proto_RTP_RLC_Source;
+        break;
+    case ROC_PROTO_RLC_REPAIR:
+        out.protocol = pipeline::Proto_RLC_Repair;
+        break;
     default:
         return false;
     }
@@ -97,13 +156,38 @@ struct roc_sender {
 
     packet::IWriter* udp_sender;
 
-    roc_sender(pipeline::SenderConfig& cfg)
+    // number of samples per frame, multiple of the number of channels
+    size_t frame_size;
+
+    roc_sender(pipeline::SenderConfig& cfg, size_t max_packet_size, size_t max_frame_size)
         : packet_pool(allocator, 1)
-        , byte_buffer_pool(allocator, MaxPacketSize, 1)
-        , sample_buffer_pool(allocator, MaxFrameSize, 1)
+        , byte_buffer_pool(allocator, max_packet_size, 1)
+        , sample_buffer_pool(allocator, max_frame_size, 1)
         , config(cfg)
         , trx(packet_pool, byte_buffer_pool, allocator)
-        , udp_sender(NULL) {
+        , udp_sender(NULL)
+        , frame_size(max_frame_size
+                     - max_frame_size % packet::num_channels(cfg.channels)) {
+    }
+
+    bool setup_pools(const roc_sender_config& cfg) {
+        const bool lock = (cfg.flags & ROC_FLAG_LOCK_MEMORY);
+
+        packet_pool.set_limit(cfg.max_packets);
+        byte_buffer_pool.set_limit(cfg.max_packets);
+
+        return packet_pool.reserve(cfg.packet_pool_size, lock)
+            && byte_buffer_pool.reserve(cfg.packet_pool_size, lock)
+            && sample_buffer_pool.reserve(cfg.frame_pool_size, lock);
+    }
+
+    size_t num_alloc_failures() const {
+        return packet_pool.num_failures() + byte_buffer_pool.num_failures()
+            + sample_buffer_pool.num_failures();
+    }
+
+    size_t trim_pools() {
+        return packet_pool.trim() + byte_buffer_pool.trim() + sample_buffer_pool.trim();
     }
 };
 
@@ -115,7 +199,17 @@ roc_sender* roc_sender_new(const roc_sender_config* config) {
     }
 
     roc_log(LogInfo, "roc sender: creating sender");
-    return new roc_sender(c);
+
+    roc_sender* sender =
+        new roc_sender(c, max_packet_size(config), max_frame_size(config));
+
+    if (!sender->setup_pools(*config)) {
+        roc_log(LogError, "roc sender: can't preallocate memory");
+        delete sender;
+        return NULL;
+    }
+
+    return sender;
 }
 
 int roc_sender_bind(roc_sender* sender, struct sockaddr* src_addr) {
@@ -152,11 +246,15 @@ int roc_sender_connect(roc_sender* sender,
     case pipeline::Proto_RTP:
     case pipeline::Proto_RTP_RSm8_Source:
     case pipeline::Proto_RTP_LDPC_Source:
+    case pipeline::Proto_RTP_Parity_Source:
+    case pipeline::Proto_RTP_RLC_Source:
         sender->config.source_port = port;
         break;
 
     case pipeline::Proto_RSm8_Repair:
     case pipeline::Proto_LDPC_Repair:
+    case pipeline::Proto_Parity_Repair:
+    case pipeline::Proto_RLC_Repair:
         sender->config.repair_port = port;
         break;
 
@@ -187,19 +285,148 @@ roc_sender_write(roc_sender* sender, const float* samples, const size_t n_sample
     roc_panic_if(!sender->sender);
     roc_panic_if(!samples && n_samples != 0);
 
-    audio::Frame frame;
-    frame.samples = new (sender->sample_buffer_pool)
+    roc_panic_if(sizeof(float) != sizeof(audio::sample_t));
+
+    size_t n_written = 0;
+
+    while (n_written < n_samples) {
+        const size_t n = ROC_MIN(sender->frame_size, n_samples - n_written);
+
+        audio::Frame frame;
+        frame.samples = new (sender->sample_buffer_pool)
+            core::Buffer<audio::sample_t>(sender->sample_buffer_pool);
+
+        if (!frame.samples) {
+            roc_log(LogError, "roc sender: can't allocate frame");
+            return n_written ? (ssize_t)n_written : -1;
+        }
+
+        frame.samples.resize(n);
+        memcpy(frame.samples.data(), samples + n_written, n * sizeof(audio::sample_t));
+
+        sender->sender->write(frame);
+
+        n_written += n;
+    }
+
+    return (ssize_t)n_samples;
+}
+
+float* roc_sender_begin_write(roc_sender* sender, size_t* n_samples) {
+    roc_panic_if(!sender);
+    roc_panic_if(!sender->sender);
+    roc_panic_if(!n_samples);
+
+    core::Buffer<audio::sample_t>* buffer = new (sender->sample_buffer_pool)
         core::Buffer<audio::sample_t>(sender->sample_buffer_pool);
 
-    frame.samples.resize(n_samples);
+    if (!buffer) {
+        roc_log(LogError, "roc sender: can't allocate frame");
+        return NULL;
+    }
+
+    // the reference is held by the caller until roc_sender_end_write()
+    buffer->incref();
+
     roc_panic_if(sizeof(float) != sizeof(audio::sample_t));
-    memcpy(frame.samples.data(), samples, n_samples * sizeof(audio::sample_t));
 
-    sender->sender->write(frame);
+    *n_samples = sender->frame_size;
+    return buffer->data();
+}
+
+ssize_t roc_sender_end_write(roc_sender* sender, float* samples, const size_t n_samples) {
+    roc_panic_if(!sender);
+    roc_panic_if(!sender->sender);
+    roc_panic_if(!samples);
+
+    core::Buffer<audio::sample_t>* buffer =
+        core::Buffer<audio::sample_t>::container_of(samples);
+
+    if (n_samples > sender->frame_size) {
+        roc_log(LogError, "roc sender: too many samples: n_samples=%lu max=%lu",
+                (unsigned long)n_samples, (unsigned long)sender->frame_size);
+        buffer->decref();
+        return -1;
+    }
+
+    if (n_samples != 0) {
+        audio::Frame frame;
+        frame.samples = buffer;
+        frame.samples.resize(n_samples);
+
+        sender->sender->write(frame);
+    }
+
+    buffer->decref();
 
     return (ssize_t)n_samples;
 }
 
+int roc_sender_get_stats(roc_sender* sender, roc_sender_stats* stats) {
+    roc_panic_if(!sender);
+    roc_panic_if(!stats);
+
+    if (!sender->sender) {
+        return -1;
+    }
+
+    const pipeline::SenderStats s = sender->sender->stats();
+
+    stats->n_frames = (unsigned long)s.n_frames;
+    stats->n_source_packets = (unsigned long)s.n_source_packets;
+    stats->n_repair_packets = (unsigned long)s.n_repair_packets;
+    stats->n_alloc_failures = (unsigned long)sender->num_alloc_failures();
+    stats->write_time_ns = s.write_time;
+
+    return 0;
+}
+
+int roc_sender_get_latency(roc_sender* sender,
+                           roc_sender_stage stage,
+                           roc_latency* latency) {
+    roc_panic_if(!sender);
+    roc_panic_if(!latency);
+
+    if (!sender->sender) {
+        return -1;
+    }
+
+    pipeline::SenderStage pipeline_stage;
+
+    switch ((unsigned)stage) {
+    case ROC_SENDER_STAGE_FEC:
+        pipeline_stage = pipeline::SenderStage_FEC;
+        break;
+    case ROC_SENDER_STAGE_SEND:
+        pipeline_stage = pipeline::SenderStage_Send;
+        break;
+    case ROC_SENDER_STAGE_FRAME:
+        pipeline_stage = pipeline::SenderStage_Frame;
+        break;
+    default:
+        roc_log(LogError, "roc sender: invalid stage");
+        return -1;
+    }
+
+    core::HistogramSnapshot snapshot;
+    if (!sender->sender->latency(pipeline_stage, snapshot)) {
+        roc_log(LogError, "roc sender: latency histograms are disabled");
+        return -1;
+    }
+
+    make_latency(latency, snapshot);
+    return 0;
+}
+
+void roc_sender_trim(roc_sender* sender) {
+    roc_panic_if(!sender);
+
+    const size_t n_released = sender->trim_pools();
+
+    roc_log(LogDebug, "roc sender: trimmed pools: released=%lu",
+            (unsigned long)n_released);
+}
+
 void roc_sender_stop(roc_sender* sender) {
     roc_panic_if(!sender);
     roc_panic_if(!sender->sender);
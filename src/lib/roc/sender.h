@@ -22,6 +22,40 @@ extern "C" {
 //! Sender.
 typedef struct roc_sender roc_sender;
 
+//! Sender statistics.
+//! Counters are accumulated since the sender was started.
+typedef struct roc_sender_stats {
+    //! Number of frames written to sender.
+    unsigned long n_frames;
+
+    //! Number of source packets sent.
+    unsigned long n_source_packets;
+
+    //! Number of repair packets sent.
+    unsigned long n_repair_packets;
+
+    //! Number of failed allocations of packets, packet buffers, and frames.
+    //! Non-zero if max_packets limit was reached or memory is exhausted. The
+    //! corresponding packets and frames are dropped.
+    unsigned long n_alloc_failures;
+
+    //! Total time spent processing frames, in nanoseconds.
+    uint64_t write_time_ns;
+} roc_sender_stats;
+
+//! Sender pipeline stage.
+//! Time of every stage includes time of the stages it calls.
+typedef enum roc_sender_stage {
+    //! Writing packet to FEC encoder, including encoding and sending.
+    ROC_SENDER_STAGE_FEC = 0,
+
+    //! Sending packet.
+    ROC_SENDER_STAGE_SEND = 1,
+
+    //! Whole frame, excluding waiting for the clock.
+    ROC_SENDER_STAGE_FRAME = 2
+} roc_sender_stage;
+
 //! Create a new sender.
 //! This function allocates memory, but the sender is not started.
 //! Returns a new object on success or NULL on error.
@@ -47,6 +81,40 @@ ROC_API ssize_t roc_sender_write(roc_sender* sender,
                                  const float* samples,
                                  const size_t n_samples);
 
+//! Get a frame buffer to be filled by the caller.
+//! Allows to write samples without copying them. The buffer can hold up to
+//! max_frame_size samples; its capacity is written to n_samples. The buffer
+//! should be passed to roc_sender_end_write().
+//! Returns a pointer to the buffer on success or NULL on error.
+ROC_API float* roc_sender_begin_write(roc_sender* sender, size_t* n_samples);
+
+//! Write a frame buffer obtained from roc_sender_begin_write() to sender.
+//! Writes first n_samples samples of the buffer and releases the buffer.
+//! If n_samples is zero, the buffer is released without writing.
+//! Returns number of samples on success or -1 on error.
+ROC_API ssize_t
+roc_sender_end_write(roc_sender* sender, float* samples, const size_t n_samples);
+
+//! Get sender statistics.
+//! May be called from any thread, doesn't block writing.
+//! Returns 0 on success or -1 on error.
+ROC_API int roc_sender_get_stats(roc_sender* sender, roc_sender_stats* stats);
+
+//! Get latency distribution of sender pipeline stage.
+//! May be called from any thread, doesn't block writing.
+//! Returns 0 on success or -1 on error, e.g. if histograms were disabled
+//! at compile time.
+ROC_API int
+roc_sender_get_latency(roc_sender* sender, roc_sender_stage stage, roc_latency* latency);
+
+//! Release unused memory.
+//! Returns memory of packets and frames that were allocated on demand and are
+//! not used anymore. Memory preallocated according to packet_pool_size and
+//! frame_pool_size is kept. May be called from any thread. It briefly locks
+//! the memory pools, so it should be called rarely, e.g. after a traffic burst
+//! or when the stream is paused.
+ROC_API void roc_sender_trim(roc_sender* sender);
+
 //! Stop the sender.
 ROC_API void roc_sender_stop(roc_sender* sender);
 
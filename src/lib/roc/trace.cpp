@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc/trace.h"
+
+#include "roc_core/log.h"
+#include "roc_core/tracer.h"
+
+using namespace roc;
+
+int roc_trace_start(size_t events_per_thread) {
+    if (!core::tracer().start(events_per_thread)) {
+        return -1;
+    }
+    return 0;
+}
+
+void roc_trace_stop(void) {
+    core::tracer().stop();
+}
+
+int roc_trace_dump(const char* path) {
+    if (!path) {
+        roc_log(LogError, "roc trace: invalid path");
+        return -1;
+    }
+
+    if (core::tracer().enabled()) {
+        roc_log(LogError, "roc trace: tracing should be stopped before dumping");
+        return -1;
+    }
+
+    if (!core::tracer().dump(path)) {
+        return -1;
+    }
+    return 0;
+}
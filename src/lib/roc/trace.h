@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc/trace.h
+//! @brief Roc packet tracing.
+
+#ifndef ROC_TRACE_H_
+#define ROC_TRACE_H_
+
+#include "roc/types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! Start packet tracing.
+//! Every thread records packet lifecycle events, like kernel receive time,
+//! enqueueing, routing, FEC repair, and depacketizing, into its own ring
+//! buffer, keeping last @p events_per_thread events.
+//! Returns 0 on success or -1 on error.
+ROC_API int roc_trace_start(size_t events_per_thread);
+
+//! Stop packet tracing.
+ROC_API void roc_trace_stop(void);
+
+//! Write recorded events to file in Chrome trace event format.
+//! The file can be opened in chrome://tracing or Perfetto UI.
+//! Should be called after roc_trace_stop().
+//! Returns 0 on success or -1 on error.
+ROC_API int roc_trace_dump(const char* path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ROC_TRACE_H_
@@ -13,8 +13,28 @@
 #define ROC_TYPES_H_
 
 #include <stddef.h>
+#include <stdint.h>
 #include <unistd.h>
 
 #define ROC_API __attribute__((visibility("default")))
 
+//! Latency distribution of pipeline stage.
+//! Quantiles are accurate within about 3%.
+typedef struct roc_latency {
+    //! Number of measurements.
+    unsigned long count;
+
+    //! Median, in nanoseconds.
+    uint64_t p50_ns;
+
+    //! 99th percentile, in nanoseconds.
+    uint64_t p99_ns;
+
+    //! 99.9th percentile, in nanoseconds.
+    uint64_t p999_ns;
+
+    //! Maximum, in nanoseconds.
+    uint64_t max_ns;
+} roc_latency;
+
 #endif // ROC_TYPES_H_
@@ -12,6 +12,7 @@
 #include "roc_core/macros.h"
 #include "roc_core/panic.h"
 #include "roc_core/stddefs.h"
+#include "roc_core/tracer.h"
 
 namespace roc {
 namespace audio {
@@ -45,6 +46,7 @@ Depacketizer::Depacketizer(packet::IReader& reader,
     , zero_samples_(0)
     , missing_samples_(0)
     , packet_samples_(0)
+    , n_late_packets_(0)
     , rate_limiter_(LogRate)
     , first_packet_(true)
     , beep_(beep) {
@@ -76,6 +78,14 @@ void Depacketizer::read(Frame& frame) {
     }
 }
 
+size_t Depacketizer::n_late_packets() const {
+    return n_late_packets_;
+}
+
+size_t Depacketizer::n_missing_samples() const {
+    return (size_t)missing_samples_;
+}
+
 sample_t* Depacketizer::read_samples_(sample_t* buff_ptr, sample_t* buff_end) {
     update_packet_();
 
@@ -167,18 +177,23 @@ void Depacketizer::update_packet_() {
         roc_log(LogDebug, "depacketizer: dropping late packet: ts=%lu pkt_ts=%lu",
                 (unsigned long)timestamp_, (unsigned long)pkt_timestamp);
 
+        roc_trace("late", packet_->trace_id());
+
         n_dropped++;
     }
 
     if (n_dropped != 0) {
         roc_log(LogInfo, "depacketizer: fetched=%d dropped=%u", (int)!!packet_,
                 n_dropped);
+        n_late_packets_ += n_dropped;
     }
 
     if (!packet_) {
         return;
     }
 
+    roc_trace("depacketize", packet_->trace_id());
+
     if (first_packet_) {
         roc_log(LogDebug, "depacketizer: got first packet: zero_samples=%lu",
                 (unsigned long)zero_samples_);
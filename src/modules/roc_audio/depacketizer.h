@@ -44,6 +44,12 @@ public:
     //! Read audio frame.
     virtual void read(Frame& frame);
 
+    //! Get number of packets dropped because they were late.
+    size_t n_late_packets() const;
+
+    //! Get number of samples per channel filled in place of lost packets.
+    size_t n_missing_samples() const;
+
 private:
     sample_t* read_samples_(sample_t* buff_ptr, sample_t* buff_end);
 
@@ -68,6 +74,8 @@ private:
     packet::timestamp_t missing_samples_;
     packet::timestamp_t packet_samples_;
 
+    size_t n_late_packets_;
+
     core::RateLimiter rate_limiter_;
 
     bool first_packet_;
@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/mac_kernel.h"
+#include "roc_core/cpu_features.h"
+#include "roc_core/panic.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ROC_AUDIO_MAC_X86
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define ROC_AUDIO_MAC_NEON
+#include <arm_neon.h>
+#endif
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+void mac_generic(const sample_t* samples,
+                 const sample_t* coeffs,
+                 size_t n_samples,
+                 size_t n_channels,
+                 sample_t* accum) {
+    for (size_t n = 0; n < n_samples; n += n_channels) {
+        for (size_t ch = 0; ch < n_channels; ch++) {
+            accum[ch] += samples[n + ch] * coeffs[n + ch];
+        }
+    }
+}
+
+// Vector lanes are folded into accumulators by lane index, so the number of
+// lanes should be a multiple of the number of channels.
+void fold_lanes(const sample_t* lanes,
+                size_t n_lanes,
+                size_t n_channels,
+                sample_t* accum) {
+    for (size_t n = 0; n < n_lanes; n++) {
+        accum[n % n_channels] += lanes[n];
+    }
+}
+
+void mac_tail(const sample_t* samples,
+              const sample_t* coeffs,
+              size_t begin,
+              size_t end,
+              size_t n_channels,
+              sample_t* accum) {
+    for (size_t n = begin; n < end; n++) {
+        accum[n % n_channels] += samples[n] * coeffs[n];
+    }
+}
+
+#ifdef ROC_AUDIO_MAC_X86
+
+#ifdef __SSE2__
+
+void mac_sse2(const sample_t* samples,
+              const sample_t* coeffs,
+              size_t n_samples,
+              size_t n_channels,
+              sample_t* accum) {
+    __m128 sum0 = _mm_setzero_ps();
+    __m128 sum1 = _mm_setzero_ps();
+
+    size_t n = 0;
+
+    for (; n + 8 <= n_samples; n += 8) {
+        sum0 = _mm_add_ps(
+            sum0, _mm_mul_ps(_mm_loadu_ps(samples + n), _mm_loadu_ps(coeffs + n)));
+        sum1 = _mm_add_ps(sum1,
+                          _mm_mul_ps(_mm_loadu_ps(samples + n + 4),
+                                     _mm_loadu_ps(coeffs + n + 4)));
+    }
+
+    for (; n + 4 <= n_samples; n += 4) {
+        sum0 = _mm_add_ps(
+            sum0, _mm_mul_ps(_mm_loadu_ps(samples + n), _mm_loadu_ps(coeffs + n)));
+    }
+
+    sample_t lanes[4];
+    _mm_storeu_ps(lanes, _mm_add_ps(sum0, sum1));
+
+    fold_lanes(lanes, 4, n_channels, accum);
+    mac_tail(samples, coeffs, n, n_samples, n_channels, accum);
+}
+
+#endif // __SSE2__
+
+__attribute__((target("avx"))) void mac_avx(const sample_t* samples,
+                                            const sample_t* coeffs,
+                                            size_t n_samples,
+                                            size_t n_channels,
+                                            sample_t* accum) {
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+
+    size_t n = 0;
+
+    for (; n + 16 <= n_samples; n += 16) {
+        sum0 = _mm256_add_ps(sum0,
+                             _mm256_mul_ps(_mm256_loadu_ps(samples + n),
+                                           _mm256_loadu_ps(coeffs + n)));
+        sum1 = _mm256_add_ps(sum1,
+                             _mm256_mul_ps(_mm256_loadu_ps(samples + n + 8),
+                                           _mm256_loadu_ps(coeffs + n + 8)));
+    }
+
+    for (; n + 8 <= n_samples; n += 8) {
+        sum0 = _mm256_add_ps(sum0,
+                             _mm256_mul_ps(_mm256_loadu_ps(samples + n),
+                                           _mm256_loadu_ps(coeffs + n)));
+    }
+
+    sample_t lanes[8];
+    _mm256_storeu_ps(lanes, _mm256_add_ps(sum0, sum1));
+
+    fold_lanes(lanes, 8, n_channels, accum);
+    mac_tail(samples, coeffs, n, n_samples, n_channels, accum);
+}
+
+#endif // ROC_AUDIO_MAC_X86
+
+#ifdef ROC_AUDIO_MAC_NEON
+
+void mac_neon(const sample_t* samples,
+              const sample_t* coeffs,
+              size_t n_samples,
+              size_t n_channels,
+              sample_t* accum) {
+    float32x4_t sum0 = vdupq_n_f32(0);
+    float32x4_t sum1 = vdupq_n_f32(0);
+
+    size_t n = 0;
+
+    for (; n + 8 <= n_samples; n += 8) {
+        sum0 = vmlaq_f32(sum0, vld1q_f32(samples + n), vld1q_f32(coeffs + n));
+        sum1 = vmlaq_f32(sum1, vld1q_f32(samples + n + 4), vld1q_f32(coeffs + n + 4));
+    }
+
+    for (; n + 4 <= n_samples; n += 4) {
+        sum0 = vmlaq_f32(sum0, vld1q_f32(samples + n), vld1q_f32(coeffs + n));
+    }
+
+    sample_t lanes[4];
+    vst1q_f32(lanes, vaddq_f32(sum0, sum1));
+
+    fold_lanes(lanes, 4, n_channels, accum);
+    mac_tail(samples, coeffs, n, n_samples, n_channels, accum);
+}
+
+#endif // ROC_AUDIO_MAC_NEON
+
+} // namespace
+
+MacKernel mac_kernel_select(size_t n_channels) {
+    if (mac_kernel_supported(MacKernel_AVX, n_channels)) {
+        return MacKernel_AVX;
+    }
+    if (mac_kernel_supported(MacKernel_SSE2, n_channels)) {
+        return MacKernel_SSE2;
+    }
+    if (mac_kernel_supported(MacKernel_NEON, n_channels)) {
+        return MacKernel_NEON;
+    }
+    return MacKernel_Generic;
+}
+
+bool mac_kernel_supported(MacKernel kernel, size_t n_channels) {
+    if (n_channels == 0) {
+        return false;
+    }
+
+    switch (kernel) {
+    case MacKernel_Generic:
+        return true;
+
+    case MacKernel_SSE2:
+#if defined(ROC_AUDIO_MAC_X86) && defined(__SSE2__)
+        return 4 % n_channels == 0 && core::cpu_supports(core::CpuFeature_SSE2);
+#else
+        return false;
+#endif
+
+    case MacKernel_AVX:
+#if defined(ROC_AUDIO_MAC_X86)
+        return 8 % n_channels == 0 && core::cpu_supports(core::CpuFeature_AVX);
+#else
+        return false;
+#endif
+
+    case MacKernel_NEON:
+#if defined(ROC_AUDIO_MAC_NEON)
+        return 4 % n_channels == 0 && core::cpu_supports(core::CpuFeature_NEON);
+#else
+        return false;
+#endif
+    }
+
+    return false;
+}
+
+mac_func_t mac_kernel_func(MacKernel kernel) {
+    switch (kernel) {
+    case MacKernel_Generic:
+        return mac_generic;
+
+#if defined(ROC_AUDIO_MAC_X86) && defined(__SSE2__)
+    case MacKernel_SSE2:
+        return mac_sse2;
+#endif
+
+#if defined(ROC_AUDIO_MAC_X86)
+    case MacKernel_AVX:
+        return mac_avx;
+#endif
+
+#if defined(ROC_AUDIO_MAC_NEON)
+    case MacKernel_NEON:
+        return mac_neon;
+#endif
+
+    default:
+        break;
+    }
+
+    roc_panic("mac kernel: kernel is not supported: %s", mac_kernel_name(kernel));
+
+    return NULL;
+}
+
+const char* mac_kernel_name(MacKernel kernel) {
+    switch (kernel) {
+    case MacKernel_Generic:
+        return "generic";
+    case MacKernel_SSE2:
+        return "sse2";
+    case MacKernel_AVX:
+        return "avx";
+    case MacKernel_NEON:
+        return "neon";
+    }
+
+    return "<invalid>";
+}
+
+} // namespace audio
+} // namespace roc
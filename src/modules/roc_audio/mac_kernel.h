@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/mac_kernel.h
+//! @brief Multiply-accumulate kernels.
+
+#ifndef ROC_AUDIO_MAC_KERNEL_H_
+#define ROC_AUDIO_MAC_KERNEL_H_
+
+#include "roc_audio/units.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Multiply-accumulate kernel implementation.
+enum MacKernel {
+    //! Portable scalar implementation.
+    MacKernel_Generic,
+
+    //! SSE2 implementation.
+    MacKernel_SSE2,
+
+    //! AVX implementation.
+    MacKernel_AVX,
+
+    //! NEON implementation.
+    MacKernel_NEON
+};
+
+//! Multiply-accumulate function for interleaved samples.
+//!
+//! @b Parameters
+//!  - @p samples and @p coeffs are two arrays of @p n_samples interleaved values
+//!  - @p n_channels is the number of interleaved channels
+//!  - @p accum is an array of @p n_channels accumulators
+//!
+//! For every sample, adds samples[n] * coeffs[n] to accum[n % n_channels].
+//!
+//! @pre
+//!  @p n_samples should be a multiple of @p n_channels.
+typedef void (*mac_func_t)(const sample_t* samples,
+                           const sample_t* coeffs,
+                           size_t n_samples,
+                           size_t n_channels,
+                           sample_t* accum);
+
+//! Select the fastest kernel supported by CPU for given number of channels.
+//! @remarks
+//!  The check is performed at run time.
+MacKernel mac_kernel_select(size_t n_channels);
+
+//! Check if the kernel is supported by CPU for given number of channels.
+bool mac_kernel_supported(MacKernel kernel, size_t n_channels);
+
+//! Get kernel function.
+//! @pre
+//!  The kernel should be supported.
+mac_func_t mac_kernel_func(MacKernel kernel);
+
+//! Get kernel name.
+const char* mac_kernel_name(MacKernel kernel);
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_MAC_KERNEL_H_
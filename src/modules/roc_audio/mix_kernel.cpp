@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/mix_kernel.h"
+#include "roc_core/cpu_features.h"
+#include "roc_core/panic.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ROC_AUDIO_MIX_X86
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define ROC_AUDIO_MIX_NEON
+#include <arm_neon.h>
+#endif
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+void add_generic(sample_t* accum, const sample_t* samples, size_t n_samples) {
+    for (size_t n = 0; n < n_samples; n++) {
+        accum[n] += samples[n];
+    }
+}
+
+// Branchless min/max, so that the compiler is free to vectorize the loop.
+void clamp_generic(sample_t* samples, size_t n_samples) {
+    for (size_t n = 0; n < n_samples; n++) {
+        sample_t x = samples[n];
+        x = x < SampleMax ? x : SampleMax;
+        x = x > SampleMin ? x : SampleMin;
+        samples[n] = x;
+    }
+}
+
+#ifdef ROC_AUDIO_MIX_X86
+
+#ifdef __SSE2__
+
+void add_sse2(sample_t* accum, const sample_t* samples, size_t n_samples) {
+    size_t n = 0;
+
+    for (; n + 4 <= n_samples; n += 4) {
+        _mm_storeu_ps(accum + n,
+                      _mm_add_ps(_mm_loadu_ps(accum + n), _mm_loadu_ps(samples + n)));
+    }
+
+    add_generic(accum + n, samples + n, n_samples - n);
+}
+
+void clamp_sse2(sample_t* samples, size_t n_samples) {
+    const __m128 max = _mm_set1_ps(SampleMax);
+    const __m128 min = _mm_set1_ps(SampleMin);
+
+    size_t n = 0;
+
+    for (; n + 4 <= n_samples; n += 4) {
+        _mm_storeu_ps(samples + n,
+                      _mm_max_ps(_mm_min_ps(_mm_loadu_ps(samples + n), max), min));
+    }
+
+    clamp_generic(samples + n, n_samples - n);
+}
+
+#endif // __SSE2__
+
+__attribute__((target("avx"))) void
+add_avx(sample_t* accum, const sample_t* samples, size_t n_samples) {
+    size_t n = 0;
+
+    for (; n + 8 <= n_samples; n += 8) {
+        _mm256_storeu_ps(accum + n,
+                         _mm256_add_ps(_mm256_loadu_ps(accum + n),
+                                       _mm256_loadu_ps(samples + n)));
+    }
+
+    add_generic(accum + n, samples + n, n_samples - n);
+}
+
+__attribute__((target("avx"))) void clamp_avx(sample_t* samples, size_t n_samples) {
+    const __m256 max = _mm256_set1_ps(SampleMax);
+    const __m256 min = _mm256_set1_ps(SampleMin);
+
+    size_t n = 0;
+
+    for (; n + 8 <= n_samples; n += 8) {
+        _mm256_storeu_ps(
+            samples + n,
+            _mm256_max_ps(_mm256_min_ps(_mm256_loadu_ps(samples + n), max), min));
+    }
+
+    clamp_generic(samples + n, n_samples - n);
+}
+
+#endif // ROC_AUDIO_MIX_X86
+
+#ifdef ROC_AUDIO_MIX_NEON
+
+void add_neon(sample_t* accum, const sample_t* samples, size_t n_samples) {
+    size_t n = 0;
+
+    for (; n + 4 <= n_samples; n += 4) {
+        vst1q_f32(accum + n, vaddq_f32(vld1q_f32(accum + n), vld1q_f32(samples + n)));
+    }
+
+    add_generic(accum + n, samples + n, n_samples - n);
+}
+
+void clamp_neon(sample_t* samples, size_t n_samples) {
+    const float32x4_t max = vdupq_n_f32(SampleMax);
+    const float32x4_t min = vdupq_n_f32(SampleMin);
+
+    size_t n = 0;
+
+    for (; n + 4 <= n_samples; n += 4) {
+        vst1q_f32(samples + n, vmaxq_f32(vminq_f32(vld1q_f32(samples + n), max), min));
+    }
+
+    clamp_generic(samples + n, n_samples - n);
+}
+
+#endif // ROC_AUDIO_MIX_NEON
+
+} // namespace
+
+MixKernel mix_kernel_select() {
+    if (mix_kernel_supported(MixKernel_AVX)) {
+        return MixKernel_AVX;
+    }
+    if (mix_kernel_supported(MixKernel_SSE2)) {
+        return MixKernel_SSE2;
+    }
+    if (mix_kernel_supported(MixKernel_NEON)) {
+        return MixKernel_NEON;
+    }
+    return MixKernel_Generic;
+}
+
+bool mix_kernel_supported(MixKernel kernel) {
+    switch (kernel) {
+    case MixKernel_Generic:
+        return true;
+
+    case MixKernel_SSE2:
+#if defined(ROC_AUDIO_MIX_X86) && defined(__SSE2__)
+        return core::cpu_supports(core::CpuFeature_SSE2);
+#else
+        return false;
+#endif
+
+    case MixKernel_AVX:
+#if defined(ROC_AUDIO_MIX_X86)
+        return core::cpu_supports(core::CpuFeature_AVX);
+#else
+        return false;
+#endif
+
+    case MixKernel_NEON:
+#if defined(ROC_AUDIO_MIX_NEON)
+        return core::cpu_supports(core::CpuFeature_NEON);
+#else
+        return false;
+#endif
+    }
+
+    return false;
+}
+
+mix_add_func_t mix_kernel_add_func(MixKernel kernel) {
+    switch (kernel) {
+    case MixKernel_Generic:
+        return add_generic;
+
+#if defined(ROC_AUDIO_MIX_X86) && defined(__SSE2__)
+    case MixKernel_SSE2:
+        return add_sse2;
+#endif
+
+#if defined(ROC_AUDIO_MIX_X86)
+    case MixKernel_AVX:
+        return add_avx;
+#endif
+
+#if defined(ROC_AUDIO_MIX_NEON)
+    case MixKernel_NEON:
+        return add_neon;
+#endif
+
+    default:
+        break;
+    }
+
+    roc_panic("mix kernel: kernel is not supported: %s", mix_kernel_name(kernel));
+
+    return NULL;
+}
+
+mix_clamp_func_t mix_kernel_clamp_func(MixKernel kernel) {
+    switch (kernel) {
+    case MixKernel_Generic:
+        return clamp_generic;
+
+#if defined(ROC_AUDIO_MIX_X86) && defined(__SSE2__)
+    case MixKernel_SSE2:
+        return clamp_sse2;
+#endif
+
+#if defined(ROC_AUDIO_MIX_X86)
+    case MixKernel_AVX:
+        return clamp_avx;
+#endif
+
+#if defined(ROC_AUDIO_MIX_NEON)
+    case MixKernel_NEON:
+        return clamp_neon;
+#endif
+
+    default:
+        break;
+    }
+
+    roc_panic("mix kernel: kernel is not supported: %s", mix_kernel_name(kernel));
+
+    return NULL;
+}
+
+const char* mix_kernel_name(MixKernel kernel) {
+    switch (kernel) {
+    case MixKernel_Generic:
+        return "generic";
+    case MixKernel_SSE2:
+        return "sse2";
+    case MixKernel_AVX:
+        return "avx";
+    case MixKernel_NEON:
+        return "neon";
+    }
+
+    return "<invalid>";
+}
+
+} // namespace audio
+} // namespace roc
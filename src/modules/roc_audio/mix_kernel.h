@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/mix_kernel.h
+//! @brief Mixing kernels.
+
+#ifndef ROC_AUDIO_MIX_KERNEL_H_
+#define ROC_AUDIO_MIX_KERNEL_H_
+
+#include "roc_audio/units.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Mixing kernel implementation.
+enum MixKernel {
+    //! Portable scalar implementation.
+    MixKernel_Generic,
+
+    //! SSE2 implementation.
+    MixKernel_SSE2,
+
+    //! AVX implementation.
+    MixKernel_AVX,
+
+    //! NEON implementation.
+    MixKernel_NEON
+};
+
+//! Accumulate function.
+//! @remarks
+//!  For every sample, adds samples[n] to accum[n]. Doesn't clamp the result.
+typedef void (*mix_add_func_t)(sample_t* accum,
+                               const sample_t* samples,
+                               size_t n_samples);
+
+//! Clamp function.
+//! @remarks
+//!  Clamps every sample to [SampleMin; SampleMax] range in place.
+typedef void (*mix_clamp_func_t)(sample_t* samples, size_t n_samples);
+
+//! Select the fastest kernel supported by CPU.
+//! @remarks
+//!  The check is performed at run time.
+MixKernel mix_kernel_select();
+
+//! Check if the kernel is supported by CPU.
+bool mix_kernel_supported(MixKernel kernel);
+
+//! Get accumulate function.
+//! @pre
+//!  The kernel should be supported.
+mix_add_func_t mix_kernel_add_func(MixKernel kernel);
+
+//! Get clamp function.
+//! @pre
+//!  The kernel should be supported.
+mix_clamp_func_t mix_kernel_clamp_func(MixKernel kernel);
+
+//! Get kernel name.
+const char* mix_kernel_name(MixKernel kernel);
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_MIX_KERNEL_H_
@@ -15,33 +15,19 @@
 namespace roc {
 namespace audio {
 
-namespace {
-
-sample_t clamp(const sample_t x) {
-    if (x > SampleMax) {
-        return SampleMax;
-    } else if (x < SampleMin) {
-        return SampleMin;
-    } else {
-        return x;
-    }
-}
+Mixer::Mixer(core::BufferPool<sample_t>& buffer_pool)
+    : buffer_pool_(buffer_pool)
+    , add_func_(NULL)
+    , clamp_func_(NULL) {
+    const MixKernel kernel = mix_kernel_select();
 
-} // namespace
+    add_func_ = mix_kernel_add_func(kernel);
+    clamp_func_ = mix_kernel_clamp_func(kernel);
 
-Mixer::Mixer(core::BufferPool<sample_t>& buffer_pool)
-    : buffer_pool_(buffer_pool) {
+    roc_log(LogDebug, "mixer: using %s kernel", mix_kernel_name(kernel));
 }
 
 void Mixer::read(Frame& frame) {
-    if (!temp_.samples) {
-        temp_.samples = new (buffer_pool_) core::Buffer<sample_t>(buffer_pool_);
-        if (!temp_.samples) {
-            roc_log(LogError, "mixer: can't allocate temporary buffer");
-            return;
-        }
-    }
-
     const size_t out_sz = frame.samples.size();
     if (out_sz == 0) {
         return;
@@ -52,19 +38,35 @@ void Mixer::read(Frame& frame) {
         roc_panic("mixer: null data");
     }
 
-    temp_.samples.resize(out_sz);
-    memset(out_data, 0, out_sz * sizeof(sample_t));
+    IReader* rp = readers_.front();
+    if (!rp) {
+        memset(out_data, 0, out_sz * sizeof(sample_t));
+        return;
+    }
+
+    // The first reader writes directly to the output frame, so that a single
+    // reader requires neither a copy nor a temporary buffer.
+    rp->read(frame);
+    roc_panic_if(frame.samples.size() != out_sz);
+
+    for (rp = readers_.nextof(*rp); rp; rp = readers_.nextof(*rp)) {
+        if (!temp_.samples) {
+            temp_.samples = new (buffer_pool_) core::Buffer<sample_t>(buffer_pool_);
+            if (!temp_.samples) {
+                roc_log(LogError, "mixer: can't allocate temporary buffer");
+                break;
+            }
+        }
+
+        temp_.samples.resize(out_sz);
 
-    for (IReader* rp = readers_.front(); rp; rp = readers_.nextof(*rp)) {
         rp->read(temp_);
         roc_panic_if(temp_.samples.size() != out_sz);
 
-        const sample_t* temp_data = temp_.samples.data();
-
-        for (size_t n = 0; n < out_sz; n++) {
-            out_data[n] = clamp(out_data[n] + temp_data[n]);
-        }
+        add_func_(out_data, temp_.samples.data(), out_sz);
     }
+
+    clamp_func_(out_data, out_sz);
 }
 
 void Mixer::add(IReader& reader) {
@@ -14,6 +14,7 @@
 #define ROC_AUDIO_MIXER_H_
 
 #include "roc_audio/ireader.h"
+#include "roc_audio/mix_kernel.h"
 #include "roc_audio/units.h"
 #include "roc_core/buffer_pool.h"
 #include "roc_core/list.h"
@@ -35,6 +36,10 @@ namespace audio {
 //! @code
 //!  5, 7, 9, ...
 //! @endcode
+//!
+//! Samples are accumulated without clamping, and the sum is clamped once
+//! when all inputs are mixed. If there is only one input, it's read directly
+//! into the output frame.
 class Mixer : public IReader, public core::NonCopyable<> {
 public:
     //! Initialize.
@@ -60,6 +65,9 @@ private:
 
     core::List<IReader, core::NoOwnership> readers_;
     Frame temp_;
+
+    mix_add_func_t add_func_;
+    mix_clamp_func_t clamp_func_;
 };
 
 } // namespace audio
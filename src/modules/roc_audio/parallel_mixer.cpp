@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/parallel_mixer.h"
+#include "roc_core/log.h"
+#include "roc_core/macros.h"
+#include "roc_core/panic.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+ParallelMixer::Task::Task(IReader& source, core::BufferPool<sample_t>& buffer_pool)
+    : source_(source) {
+    frame_.samples = new (buffer_pool) core::Buffer<sample_t>(buffer_pool);
+}
+
+bool ParallelMixer::Task::valid() const {
+    return frame_.samples;
+}
+
+IReader& ParallelMixer::Task::source() {
+    return source_;
+}
+
+void ParallelMixer::Task::fetch(size_t size) {
+    frame_.samples.resize(size);
+    source_.read(frame_);
+    roc_panic_if(frame_.samples.size() != size);
+}
+
+void ParallelMixer::Task::read(Frame& frame) {
+    if (frame.samples.size() != frame_.samples.size()) {
+        roc_panic("parallel mixer: frame size mismatch: expected=%lu actual=%lu",
+                  (unsigned long)frame_.samples.size(),
+                  (unsigned long)frame.samples.size());
+    }
+
+    memcpy(frame.samples.data(), frame_.samples.data(),
+           frame_.samples.size() * sizeof(sample_t));
+}
+
+ParallelMixer::Worker::Worker(ParallelMixer& mixer, size_t index)
+    : mixer_(mixer)
+    , index_(index)
+    , sem_(0) {
+}
+
+void ParallelMixer::Worker::wakeup() {
+    sem_.post();
+}
+
+void ParallelMixer::Worker::run() {
+    roc_log(LogDebug, "parallel mixer: starting worker %lu", (unsigned long)index_);
+
+    for (;;) {
+        sem_.pend();
+
+        if (mixer_.stop_) {
+            break;
+        }
+
+        if (mixer_.run_tasks_(index_)) {
+            mixer_.done_sem_.post();
+        }
+    }
+
+    roc_log(LogDebug, "parallel mixer: stopping worker %lu", (unsigned long)index_);
+}
+
+ParallelMixer::ParallelMixer(core::BufferPool<sample_t>& buffer_pool,
+                             core::IAllocator& allocator,
+                             size_t num_threads)
+    : buffer_pool_(buffer_pool)
+    , allocator_(allocator)
+    , mixer_(buffer_pool)
+    , workers_(allocator, num_threads)
+    , shards_(allocator, num_threads + 1)
+    , n_shards_(0)
+    , tasks_(NULL)
+    , n_tasks_(0)
+    , max_tasks_(0)
+    , frame_size_(0)
+    , done_sem_(0)
+    , valid_(false) {
+    shards_.resize(num_threads + 1);
+
+    for (size_t n = 0; n < num_threads; n++) {
+        Worker* worker = new (allocator_) Worker(*this, n);
+        if (!worker) {
+            roc_log(LogError, "parallel mixer: can't allocate worker");
+            return;
+        }
+        workers_.push_back(worker);
+        worker->start();
+    }
+
+    valid_ = true;
+}
+
+ParallelMixer::~ParallelMixer() {
+    stop_workers_();
+
+    for (size_t n = 0; n < n_tasks_; n++) {
+        mixer_.remove(*tasks_[n]);
+        allocator_.destroy(*tasks_[n]);
+    }
+
+    if (tasks_) {
+        allocator_.deallocate(tasks_);
+    }
+}
+
+bool ParallelMixer::valid() const {
+    return valid_;
+}
+
+void ParallelMixer::read(Frame& frame) {
+    if (n_tasks_ != 0) {
+        fetch_tasks_(frame.samples.size());
+    }
+
+    mixer_.read(frame);
+}
+
+bool ParallelMixer::add(IReader& reader) {
+    if (workers_.size() == 0) {
+        mixer_.add(reader);
+        return true;
+    }
+
+    if (n_tasks_ == max_tasks_) {
+        if (!grow_tasks_()) {
+            roc_log(LogError, "parallel mixer: can't allocate task list");
+            return false;
+        }
+    }
+
+    Task* task = new (allocator_) Task(reader, buffer_pool_);
+    if (!task) {
+        roc_log(LogError, "parallel mixer: can't allocate task");
+        return false;
+    }
+
+    if (!task->valid()) {
+        roc_log(LogError, "parallel mixer: can't allocate task buffer");
+        allocator_.destroy(*task);
+        return false;
+    }
+
+    tasks_[n_tasks_++] = task;
+    mixer_.add(*task);
+
+    return true;
+}
+
+void ParallelMixer::remove(IReader& reader) {
+    if (workers_.size() == 0) {
+        mixer_.remove(reader);
+        return;
+    }
+
+    size_t pos = 0;
+    Task* task = find_task_(reader, pos);
+    if (!task) {
+        roc_panic("parallel mixer: attempting to remove unknown reader");
+    }
+
+    mixer_.remove(*task);
+
+    // order of tasks doesn't matter, mixing order is defined by mixer_
+    tasks_[pos] = tasks_[--n_tasks_];
+    tasks_[n_tasks_] = NULL;
+
+    allocator_.destroy(*task);
+}
+
+void ParallelMixer::stop_workers_() {
+    stop_ = true;
+
+    for (size_t n = 0; n < workers_.size(); n++) {
+        workers_[n]->wakeup();
+    }
+
+    for (size_t n = 0; n < workers_.size(); n++) {
+        workers_[n]->join();
+        allocator_.destroy(*workers_[n]);
+    }
+
+    workers_.resize(0);
+}
+
+void ParallelMixer::fetch_tasks_(size_t frame_size) {
+    // wake up only workers that will get at least one task
+    const size_t n_workers = n_tasks_ > 1 ? ROC_MIN(workers_.size(), n_tasks_ - 1) : 0;
+
+    if (n_workers == 0) {
+        for (size_t n = 0; n < n_tasks_; n++) {
+            tasks_[n]->fetch(frame_size);
+        }
+        return;
+    }
+
+    const size_t n_shards = n_workers + 1;
+
+    for (size_t n = 0; n < n_shards; n++) {
+        shards_[n].next.store(long(n_tasks_ * n / n_shards));
+        shards_[n].end = n_tasks_ * (n + 1) / n_shards;
+    }
+
+    n_shards_ = n_shards;
+    frame_size_ = frame_size;
+    n_running_.store((long)n_shards);
+
+    for (size_t n = 0; n < n_workers; n++) {
+        workers_[n]->wakeup();
+    }
+
+    // calling thread uses the last shard
+    if (!run_tasks_(n_shards - 1)) {
+        done_sem_.pend();
+    }
+}
+
+bool ParallelMixer::run_tasks_(size_t index) {
+    const size_t n_shards = n_shards_;
+
+    // start from own shard and then steal from others
+    for (size_t n = 0; n < n_shards; n++) {
+        Shard& shard = shards_[(index + n) % n_shards];
+
+        for (;;) {
+            const size_t pos = (size_t)(++shard.next - 1);
+            if (pos >= shard.end) {
+                break;
+            }
+            tasks_[pos]->fetch(frame_size_);
+        }
+    }
+
+    return --n_running_ == 0;
+}
+
+ParallelMixer::Task* ParallelMixer::find_task_(IReader& source, size_t& pos) {
+    for (size_t n = 0; n < n_tasks_; n++) {
+        if (&tasks_[n]->source() == &source) {
+            pos = n;
+            return tasks_[n];
+        }
+    }
+    return NULL;
+}
+
+bool ParallelMixer::grow_tasks_() {
+    const size_t new_max_tasks = max_tasks_ ? max_tasks_ * 2 : 8;
+
+    Task** new_tasks = (Task**)allocator_.allocate(new_max_tasks * sizeof(Task*));
+    if (!new_tasks) {
+        return false;
+    }
+
+    for (size_t n = 0; n < n_tasks_; n++) {
+        new_tasks[n] = tasks_[n];
+    }
+
+    if (tasks_) {
+        allocator_.deallocate(tasks_);
+    }
+
+    tasks_ = new_tasks;
+    max_tasks_ = new_max_tasks;
+
+    return true;
+}
+
+} // namespace audio
+} // namespace roc
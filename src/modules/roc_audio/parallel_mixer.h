@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/parallel_mixer.h
+//! @brief Parallel mixer.
+
+#ifndef ROC_AUDIO_PARALLEL_MIXER_H_
+#define ROC_AUDIO_PARALLEL_MIXER_H_
+
+#include "roc_audio/ireader.h"
+#include "roc_audio/mixer.h"
+#include "roc_audio/units.h"
+#include "roc_core/array.h"
+#include "roc_core/atomic.h"
+#include "roc_core/buffer_pool.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/semaphore.h"
+#include "roc_core/thread.h"
+
+namespace roc {
+namespace audio {
+
+//! Parallel mixer.
+//!
+//! Same as Mixer, but reads input streams concurrently using a pool of worker
+//! threads. Every input reader is read into its own frame by one of the workers
+//! or by the calling thread, and then the frames are mixed on the calling thread
+//! in the order in which the readers were added. Hence, the output is exactly the
+//! same as if Mixer was used.
+//!
+//! @remarks
+//!  Input readers are distributed between threads in equal contiguous shards. A
+//!  thread that has finished its own shard steals remaining readers from others.
+//!  Only as many workers are woken up as there are readers beyond the one read
+//!  by the calling thread, so a single reader is read without any wakeups.
+//!
+//!  If the number of threads is zero, no threads are started and every reader is
+//!  read on the calling thread.
+//!
+//!  Input readers should not share state that is not thread-safe.
+class ParallelMixer : public IReader, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //!
+    //! @b Parameters
+    //!  - @p buffer_pool is used to allocate a chunk of samples for every reader
+    //!  - @p allocator is used to allocate workers and bookkeeping for readers
+    //!  - @p num_threads defines the number of worker threads
+    ParallelMixer(core::BufferPool<sample_t>& buffer_pool,
+                  core::IAllocator& allocator,
+                  size_t num_threads);
+
+    ~ParallelMixer();
+
+    //! Check if the mixer was successfully constructed.
+    bool valid() const;
+
+    //! Read audio frame.
+    //! @remarks
+    //!  Reads samples from every input reader in parallel, mixes them, and fills
+    //!  @p frame with the result.
+    virtual void read(Frame& frame);
+
+    //! Add input reader.
+    //! @returns
+    //!  false if allocation failed.
+    bool add(IReader&);
+
+    //! Remove input reader.
+    void remove(IReader&);
+
+private:
+    class Task : public IReader {
+    public:
+        Task(IReader& source, core::BufferPool<sample_t>& buffer_pool);
+
+        bool valid() const;
+
+        IReader& source();
+
+        void fetch(size_t size);
+
+        virtual void read(Frame& frame);
+
+    private:
+        IReader& source_;
+        Frame frame_;
+    };
+
+    class Worker : public core::Thread {
+    public:
+        Worker(ParallelMixer& mixer, size_t index);
+
+        void wakeup();
+
+    private:
+        virtual void run();
+
+        ParallelMixer& mixer_;
+        const size_t index_;
+        core::Semaphore sem_;
+    };
+
+    struct Shard {
+        core::Atomic next;
+        size_t end;
+
+        Shard()
+            : end(0) {
+        }
+    };
+
+    void stop_workers_();
+
+    void fetch_tasks_(size_t frame_size);
+    bool run_tasks_(size_t index);
+
+    Task* find_task_(IReader& source, size_t& pos);
+    bool grow_tasks_();
+
+    core::BufferPool<sample_t>& buffer_pool_;
+    core::IAllocator& allocator_;
+
+    Mixer mixer_;
+
+    core::Array<Worker*> workers_;
+    core::Array<Shard> shards_;
+
+    // number of shards used for current frame, the last one is for calling thread
+    size_t n_shards_;
+
+    Task** tasks_;
+    size_t n_tasks_;
+    size_t max_tasks_;
+
+    size_t frame_size_;
+
+    core::Atomic n_running_;
+    core::Semaphore done_sem_;
+
+    core::Atomic stop_;
+
+    bool valid_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_PARALLEL_MIXER_H_
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/polyphase_bank.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+// Cutoff frequency relative to Nyquist frequency of the lower rate.
+const double Cutoff = 0.9;
+
+// Bounds for the number of phases.
+enum { MinPhases = 256, MaxPhases = 1024 };
+
+size_t gcd(size_t a, size_t b) {
+    while (b != 0) {
+        const size_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+double calc_cutoff(size_t input_rate, size_t output_rate) {
+    if (output_rate < input_rate) {
+        return Cutoff * (double)output_rate / (double)input_rate;
+    }
+    return Cutoff;
+}
+
+size_t calc_num_taps(size_t input_rate, size_t output_rate, size_t window_size) {
+    const double half = (double)window_size / calc_cutoff(input_rate, output_rate);
+    return 2 * (size_t)ceil(half);
+}
+
+size_t calc_num_phases(size_t input_rate, size_t output_rate) {
+    const size_t denom = output_rate / gcd(input_rate, output_rate);
+
+    if (denom > MaxPhases) {
+        return MaxPhases;
+    }
+
+    return denom * ((MinPhases + denom - 1) / denom);
+}
+
+double sinc(double x) {
+    if (fabs(x) < 1e-9) {
+        return 1.0;
+    }
+    return sin(M_PI * x) / (M_PI * x);
+}
+
+} // namespace
+
+PolyphaseBank::PolyphaseBank(size_t input_rate,
+                             size_t output_rate,
+                             size_t window_size,
+                             core::IAllocator& allocator)
+    : allocator_(allocator)
+    , input_rate_(input_rate)
+    , output_rate_(output_rate)
+    , window_size_(window_size)
+    , cutoff_(calc_cutoff(input_rate, output_rate))
+    , num_taps_(calc_num_taps(input_rate, output_rate, window_size))
+    , num_phases_(calc_num_phases(input_rate, output_rate))
+    , filters_(allocator, (num_phases_ + 1) * num_taps_) {
+    roc_panic_if(input_rate == 0 || output_rate == 0 || window_size == 0);
+
+    fill_();
+
+    roc_log(LogDebug,
+            "polyphase bank: initialized: in_rate=%lu out_rate=%lu n_taps=%lu "
+            "n_phases=%lu",
+            (unsigned long)input_rate_, (unsigned long)output_rate_,
+            (unsigned long)num_taps_, (unsigned long)num_phases_);
+}
+
+void PolyphaseBank::destroy() {
+    allocator_.destroy(*this);
+}
+
+size_t PolyphaseBank::input_rate() const {
+    return input_rate_;
+}
+
+size_t PolyphaseBank::output_rate() const {
+    return output_rate_;
+}
+
+size_t PolyphaseBank::window_size() const {
+    return window_size_;
+}
+
+size_t PolyphaseBank::num_taps() const {
+    return num_taps_;
+}
+
+size_t PolyphaseBank::num_phases() const {
+    return num_phases_;
+}
+
+const sample_t* PolyphaseBank::filter(size_t phase) const {
+    roc_panic_if(phase > num_phases_);
+    return &filters_[phase * num_taps_];
+}
+
+void PolyphaseBank::fill_() {
+    filters_.resize(filters_.max_size());
+
+    const double half = (double)(num_taps_ / 2);
+
+    for (size_t p = 0; p <= num_phases_; p++) {
+        sample_t* filter = &filters_[p * num_taps_];
+
+        const double delay = (double)p / (double)num_phases_;
+
+        double sum = 0;
+
+        for (size_t n = 0; n < num_taps_; n++) {
+            // distance between the output instant and the input sample
+            const double x = (double)n - (half - 1) - delay;
+
+            // Hamming window
+            const double window = 0.54 + 0.46 * cos(M_PI * x / half);
+
+            const double h = sinc(cutoff_ * x) * window;
+
+            filter[n] = (sample_t)h;
+            sum += h;
+        }
+
+        // normalize to unity gain at DC
+        for (size_t n = 0; n < num_taps_; n++) {
+            filter[n] = (sample_t)((double)filter[n] / sum);
+        }
+    }
+}
+
+} // namespace audio
+} // namespace roc
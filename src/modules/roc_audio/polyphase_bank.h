@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/polyphase_bank.h
+//! @brief Polyphase filter bank.
+
+#ifndef ROC_AUDIO_POLYPHASE_BANK_H_
+#define ROC_AUDIO_POLYPHASE_BANK_H_
+
+#include "roc_audio/units.h"
+#include "roc_core/array.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/list_node.h"
+#include "roc_core/refcnt.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Polyphase filter bank for fixed-ratio sample rate conversion.
+//!
+//! Contains precomputed windowed sinc low-pass filters for a number of
+//! equidistant fractional delays (phases) between two input samples. The
+//! number of phases is a multiple of the denominator of the reduced rate
+//! ratio when possible, so that every output instant of an exact conversion
+//! hits a precomputed phase. Other instants, e.g. when the ratio is adjusted
+//! for clock drift, are handled by interpolating between adjacent phases.
+//!
+//! The filter cutoff is chosen for the lower of two rates, so the bank is
+//! suitable for both upsampling and downsampling.
+class PolyphaseBank : public core::RefCnt<PolyphaseBank>, public core::ListNode {
+public:
+    //! Initialize.
+    //!
+    //! @b Parameters
+    //!  - @p input_rate and @p output_rate define conversion ratio
+    //!  - @p window_size defines number of sinc zero crossings on every side
+    //!  - @p allocator is used to allocate the bank
+    PolyphaseBank(size_t input_rate,
+                  size_t output_rate,
+                  size_t window_size,
+                  core::IAllocator& allocator);
+
+    //! Get input sample rate.
+    size_t input_rate() const;
+
+    //! Get output sample rate.
+    size_t output_rate() const;
+
+    //! Get window size.
+    size_t window_size() const;
+
+    //! Get number of filter taps.
+    //! @remarks
+    //!  Always even. Tap @c n is applied to input sample
+    //!  @c floor(t) @c - @c num_taps()/2 @c + @c 1 @c + @c n, where @c t is
+    //!  the output instant.
+    size_t num_taps() const;
+
+    //! Get number of phases.
+    size_t num_phases() const;
+
+    //! Get filter for given phase.
+    //! @remarks
+    //!  Phase @c p corresponds to the fractional delay @c p/num_phases().
+    //!  @p phase may be equal to num_phases(), which is the same as phase zero
+    //!  shifted by one tap and is provided for interpolation.
+    const sample_t* filter(size_t phase) const;
+
+private:
+    friend class core::RefCnt<PolyphaseBank>;
+
+    void destroy();
+
+    void fill_();
+
+    core::IAllocator& allocator_;
+
+    const size_t input_rate_;
+    const size_t output_rate_;
+    const size_t window_size_;
+
+    double cutoff_;
+    size_t num_taps_;
+    size_t num_phases_;
+
+    core::Array<sample_t> filters_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_POLYPHASE_BANK_H_
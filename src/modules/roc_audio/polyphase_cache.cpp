@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/polyphase_cache.h"
+#include "roc_core/log.h"
+
+namespace roc {
+namespace audio {
+
+PolyphaseCache::PolyphaseCache(core::IAllocator& allocator)
+    : allocator_(allocator) {
+}
+
+core::SharedPtr<PolyphaseBank>
+PolyphaseCache::get(size_t input_rate, size_t output_rate, size_t window_size) {
+    core::Mutex::Lock lock(mutex_);
+
+    core::SharedPtr<PolyphaseBank> bank;
+
+    for (bank = banks_.front(); bank; bank = banks_.nextof(*bank)) {
+        if (bank->input_rate() == input_rate && bank->output_rate() == output_rate
+            && bank->window_size() == window_size) {
+            return bank;
+        }
+    }
+
+    bank = new (allocator_)
+        PolyphaseBank(input_rate, output_rate, window_size, allocator_);
+    if (!bank) {
+        roc_log(LogError, "polyphase cache: can't allocate bank");
+        return NULL;
+    }
+
+    banks_.push_back(*bank);
+
+    return bank;
+}
+
+size_t PolyphaseCache::size() const {
+    core::Mutex::Lock lock(mutex_);
+
+    return banks_.size();
+}
+
+} // namespace audio
+} // namespace roc
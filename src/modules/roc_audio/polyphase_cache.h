@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/polyphase_cache.h
+//! @brief Polyphase filter bank cache.
+
+#ifndef ROC_AUDIO_POLYPHASE_CACHE_H_
+#define ROC_AUDIO_POLYPHASE_CACHE_H_
+
+#include "roc_audio/polyphase_bank.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/list.h"
+#include "roc_core/mutex.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/shared_ptr.h"
+
+namespace roc {
+namespace audio {
+
+//! Polyphase filter bank cache.
+//!
+//! Keeps a filter bank for every requested combination of rates and window
+//! size, so that resamplers with the same parameters share one bank and the
+//! bank is computed only once. Thread-safe.
+class PolyphaseCache : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    explicit PolyphaseCache(core::IAllocator& allocator);
+
+    //! Get filter bank for given parameters.
+    //! @remarks
+    //!  Creates a new bank if there is no cached one.
+    //! @returns
+    //!  NULL if allocation failed.
+    core::SharedPtr<PolyphaseBank>
+    get(size_t input_rate, size_t output_rate, size_t window_size);
+
+    //! Get number of cached banks.
+    size_t size() const;
+
+private:
+    core::IAllocator& allocator_;
+
+    core::List<PolyphaseBank> banks_;
+    core::Mutex mutex_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_POLYPHASE_CACHE_H_
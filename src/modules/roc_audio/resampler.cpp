@@ -80,6 +80,9 @@ Resampler::Resampler(IReader& reader,
     , window_interp_(512)
     , window_interp_bits_(9)
     , sinc_table_(allocator, window_len_ * window_interp_ + 2)
+    , coeffs_(allocator, frame_size_ * 3)
+    , mac_func_(NULL)
+    , bank_ratio_(1.0)
     , qt_half_window_len_(float_to_fixedpoint((float)window_len_ / scaling_))
     , qt_epsilon_(float_to_fixedpoint(5e-8f))
     , default_sample_(float_to_fixedpoint(0))
@@ -92,13 +95,21 @@ Resampler::Resampler(IReader& reader,
     roc_panic_if(channels_num_ < 1);
     init_window_(buffer_pool);
     fill_sinc();
+
+    coeffs_.resize(coeffs_.max_size());
+
+    const MacKernel kernel = mac_kernel_select(channels_num_);
+    mac_func_ = mac_kernel_func(kernel);
+
+    roc_log(LogDebug, "resampler: using %s kernel", mac_kernel_name(kernel));
+
     roc_panic_if_not(set_scaling(1.0f));
 }
 
 bool Resampler::set_scaling(float scaling) {
     // Window's size changes according to scaling. If new window size
     // doesnt fit to the frames size -- deny changes.
-    if (window_len_ * scaling >= channel_len_) {
+    if (!fits_(scaling)) {
         return false;
     }
     scaling_ = scaling;
@@ -118,6 +129,35 @@ bool Resampler::set_scaling(float scaling) {
     return true;
 }
 
+bool Resampler::set_bank(PolyphaseBank& bank) {
+    roc_panic_if(curr_frame_ != NULL);
+
+    // First and last taps should stay within previous and next frames.
+    if (bank.num_taps() / 2 >= channel_len_) {
+        roc_log(LogError,
+                "resampler: polyphase bank doesn't fit into frame: n_taps=%lu "
+                "channel_len=%lu",
+                (unsigned long)bank.num_taps(), (unsigned long)channel_len_);
+        return false;
+    }
+
+    bank_ = &bank;
+    bank_ratio_ = (double)bank.input_rate() / (double)bank.output_rate();
+
+    return true;
+}
+
+bool Resampler::fits_(float scaling) const {
+    if (bank_) {
+        // Bank filters have fixed length, and scaling changes only the step,
+        // which should not skip whole frames.
+        return bank_->num_taps() / 2 < channel_len_
+            && (double)scaling * bank_ratio_ < (double)channel_len_;
+    }
+
+    return window_len_ * scaling < channel_len_;
+}
+
 void Resampler::read(Frame& frame) {
     sample_t* buff_data = frame.samples.data();
     roc_panic_if(buff_data == NULL);
@@ -142,8 +182,10 @@ void Resampler::read(Frame& frame) {
             qt_sample_ += G_qt_one;
         }
 
-        for (size_t channel = 0; channel < channels_num_; ++channel) {
-            buff_data[n + channel] = resample_(channel);
+        if (bank_) {
+            resample_bank_(buff_data + n);
+        } else {
+            resample_(buff_data + n);
         }
         qt_sample_ += qt_dt_;
     }
@@ -166,10 +208,14 @@ void Resampler::init_window_(core::BufferPool<sample_t>& buffer_pool) {
 }
 
 void Resampler::renew_window_() {
-    roc_panic_if(window_len_ * scaling_ >= channel_len_);
+    roc_panic_if(!fits_(scaling_));
 
     // scaling_ may change every frame so it have to be smooth.
-    qt_dt_ = float_to_fixedpoint(scaling_);
+    if (bank_) {
+        qt_dt_ = fixedpoint_t((double)scaling_ * bank_ratio_ * (double)G_qt_one + 0.5);
+    } else {
+        qt_dt_ = float_to_fixedpoint(scaling_);
+    }
 
     if (curr_frame_ == NULL) {
         reader_.read(window_[0]);
@@ -228,45 +274,40 @@ sample_t Resampler::sinc_(const fixedpoint_t x, const float fract_x) {
     return scaling_ > 1.0f ? result / scaling_ : result;
 }
 
-sample_t Resampler::resample_(const size_t channel_offset) {
-    // Index of first input sample in window.
-    size_t ind_begin_prev;
+void Resampler::push_coeff_(size_t& pos, const sample_t coeff) {
+    roc_panic_if(pos + channels_num_ > coeffs_.size());
 
-    // Window lasts till that index.
-    const size_t ind_end_prev = channelize_index(channel_len_, channel_offset);
-
-    size_t ind_begin_cur;
-    size_t ind_end_cur;
-
-    const size_t ind_begin_next = channelize_index(0, channel_offset);
-    size_t ind_end_next;
+    for (size_t ch = 0; ch < channels_num_; ch++) {
+        coeffs_[pos++] = coeff;
+    }
+}
 
-    ind_begin_prev = (qt_sample_ >= qt_half_window_len_)
+void Resampler::compute_coeffs_(size_t& prev_begin,
+                                size_t& n_prev,
+                                size_t& cur_begin,
+                                size_t& n_cur,
+                                size_t& n_next) {
+    // All indices below are in terms of per-channel sample numbers.
+    prev_begin = (qt_sample_ >= qt_half_window_len_)
         ? channel_len_
         : fixedpoint_to_size(qceil(qt_sample_ + (qt_frame_size_ - qt_half_window_len_)));
-    // ind_begin_prev is comparable with channel_len_ till we'll convert it to channalyzed
-    // presentation.
-    roc_panic_if(ind_begin_prev > channel_len_);
-    ind_begin_prev = channelize_index(ind_begin_prev, channel_offset);
+    roc_panic_if(prev_begin > channel_len_);
 
-    ind_begin_cur = (qt_sample_ >= qt_half_window_len_)
+    cur_begin = (qt_sample_ >= qt_half_window_len_)
         ? fixedpoint_to_size(qceil(qt_sample_ - qt_half_window_len_))
         : 0;
-    roc_panic_if(ind_begin_cur > channel_len_);
-    ind_begin_cur = channelize_index(ind_begin_cur, channel_offset);
+    roc_panic_if(cur_begin > channel_len_);
 
-    ind_end_cur = ((qt_sample_ + qt_half_window_len_) > qt_frame_size_)
+    const size_t cur_end = ((qt_sample_ + qt_half_window_len_) > qt_frame_size_)
         ? channel_len_ - 1
         : fixedpoint_to_size(qfloor(qt_sample_ + qt_half_window_len_));
-    roc_panic_if(ind_end_cur > channel_len_);
-    ind_end_cur = channelize_index(ind_end_cur, channel_offset);
+    roc_panic_if(cur_end > channel_len_);
 
-    ind_end_next = ((qt_sample_ + qt_half_window_len_) > qt_frame_size_)
+    n_next = ((qt_sample_ + qt_half_window_len_) > qt_frame_size_)
         ? fixedpoint_to_size(qfloor(qt_sample_ + qt_half_window_len_ - qt_frame_size_))
             + 1
         : 0;
-    roc_panic_if(ind_end_next > channel_len_);
-    ind_end_next = channelize_index(ind_end_next, channel_offset);
+    roc_panic_if(n_next > channel_len_);
 
     // Counter inside window.
     // t_sinc = (t_sample - ceil( t_sample - window_len/cutoff*scale )) * sinc_step
@@ -283,29 +324,30 @@ sample_t Resampler::resample_(const size_t channel_offset) {
     // Compute fractional part of time position at the begining. It wont change during
     // the run.
     float f_sinc_cur_fract = fractional(qt_sinc_cur << window_interp_bits_);
-    sample_t accumulator = 0;
 
+    size_t pos = 0;
     size_t i;
 
     // Run through previous frame.
-    for (i = ind_begin_prev; i < ind_end_prev; i += channels_num_) {
-        accumulator += prev_frame_[i] * sinc_(qt_sinc_cur, f_sinc_cur_fract);
+    for (i = prev_begin; i < channel_len_; i++) {
+        push_coeff_(pos, sinc_(qt_sinc_cur, f_sinc_cur_fract));
         qt_sinc_cur -= qt_sinc_inc;
     }
+    n_prev = channel_len_ - prev_begin;
 
     // Run through current frame through the left windows side. qt_sinc_cur is decreasing.
-    i = ind_begin_cur;
+    i = cur_begin;
 
-    accumulator += curr_frame_[i] * sinc_(qt_sinc_cur, f_sinc_cur_fract);
+    push_coeff_(pos, sinc_(qt_sinc_cur, f_sinc_cur_fract));
     while (qt_sinc_cur >= qt_sinc_step_) {
-        i += channels_num_;
+        i++;
         qt_sinc_cur -= qt_sinc_inc;
-        accumulator += curr_frame_[i] * sinc_(qt_sinc_cur, f_sinc_cur_fract);
+        push_coeff_(pos, sinc_(qt_sinc_cur, f_sinc_cur_fract));
     }
 
-    i += channels_num_;
+    i++;
 
-    roc_panic_if(i > channelize_index(channel_len_, channel_offset));
+    roc_panic_if(i > channel_len_);
 
     // Crossing zero -- we just need to switch qt_sinc_cur.
     // -1 ------------ 0 ------------- +1
@@ -316,18 +358,104 @@ sample_t Resampler::resample_(const size_t channel_offset) {
     f_sinc_cur_fract = fractional(qt_sinc_cur << window_interp_bits_);
 
     // Run through right side of the window, increasing qt_sinc_cur.
-    for (; i <= ind_end_cur; i += channels_num_) {
-        accumulator += curr_frame_[i] * sinc_(qt_sinc_cur, f_sinc_cur_fract);
+    for (; i <= cur_end; i++) {
+        push_coeff_(pos, sinc_(qt_sinc_cur, f_sinc_cur_fract));
         qt_sinc_cur += qt_sinc_inc;
     }
+    n_cur = i - cur_begin;
 
     // Next frames run.
-    for (i = ind_begin_next; i < ind_end_next; i += channels_num_) {
-        accumulator += next_frame_[i] * sinc_(qt_sinc_cur, f_sinc_cur_fract);
+    for (i = 0; i < n_next; i++) {
+        push_coeff_(pos, sinc_(qt_sinc_cur, f_sinc_cur_fract));
         qt_sinc_cur += qt_sinc_inc;
     }
+}
+
+void Resampler::resample_(sample_t* out) {
+    size_t prev_begin = 0, n_prev = 0;
+    size_t cur_begin = 0, n_cur = 0;
+    size_t n_next = 0;
+
+    // Coefficients don't depend on channel, so they're computed once for all
+    // channels and then applied to every channel by the kernel.
+    compute_coeffs_(prev_begin, n_prev, cur_begin, n_cur, n_next);
+
+    for (size_t ch = 0; ch < channels_num_; ch++) {
+        out[ch] = 0;
+    }
+
+    const sample_t* coeffs = &coeffs_[0];
+
+    mac_func_(prev_frame_ + channelize_index(prev_begin, 0), coeffs,
+              n_prev * channels_num_, channels_num_, out);
+    coeffs += n_prev * channels_num_;
+
+    mac_func_(curr_frame_ + channelize_index(cur_begin, 0), coeffs,
+              n_cur * channels_num_, channels_num_, out);
+    coeffs += n_cur * channels_num_;
+
+    mac_func_(next_frame_, coeffs, n_next * channels_num_, channels_num_, out);
+}
+
+void Resampler::resample_bank_(sample_t* out) {
+    const size_t n_taps = bank_->num_taps();
+    const size_t n_phases = bank_->num_phases();
+
+    // Position between two input samples in terms of bank phases.
+    const long_fixedpoint_t qt_phase =
+        (long_fixedpoint_t)(qt_sample_ & FRACT_PART_MASK) * n_phases;
+
+    const size_t phase = (size_t)(qt_phase >> FRACT_BIT_COUNT);
+    const float phase_fract = fractional((fixedpoint_t)(qt_phase & FRACT_PART_MASK));
+
+    // Interpolate between two adjacent phases. If the position is exactly on
+    // a phase, which is always the case without clock drift compensation,
+    // this gives the precomputed filter as is.
+    const sample_t* lo = bank_->filter(phase);
+    const sample_t* hi = bank_->filter(phase + 1);
+
+    size_t pos = 0;
+    for (size_t n = 0; n < n_taps; n++) {
+        push_coeff_(pos, lo[n] + phase_fract * (hi[n] - lo[n]));
+    }
+
+    for (size_t ch = 0; ch < channels_num_; ch++) {
+        out[ch] = 0;
+    }
+
+    const sample_t* coeffs = &coeffs_[0];
+
+    // Index of the first tap relative to the beginning of current frame.
+    long index = (long)fixedpoint_to_size(qt_sample_) - (long)(n_taps / 2) + 1;
+    size_t remain = n_taps;
+
+    // Run through previous frame.
+    if (index < 0) {
+        const size_t n = ROC_MIN((size_t)-index, remain);
+        mac_func_(prev_frame_ + channelize_index(channel_len_ - (size_t)-index, 0),
+                  coeffs, n * channels_num_, channels_num_, out);
+        coeffs += n * channels_num_;
+        index += (long)n;
+        remain -= n;
+    }
 
-    return accumulator;
+    // Run through current frame.
+    if (remain != 0 && (size_t)index < channel_len_) {
+        const size_t n = ROC_MIN(channel_len_ - (size_t)index, remain);
+        mac_func_(curr_frame_ + channelize_index((size_t)index, 0), coeffs,
+                  n * channels_num_, channels_num_, out);
+        coeffs += n * channels_num_;
+        index += (long)n;
+        remain -= n;
+    }
+
+    // Run through next frame.
+    if (remain != 0) {
+        const size_t begin = (size_t)index - channel_len_;
+        roc_panic_if(begin + remain > channel_len_);
+        mac_func_(next_frame_ + channelize_index(begin, 0), coeffs,
+                  remain * channels_num_, channels_num_, out);
+    }
 }
 
 } // namespace audio
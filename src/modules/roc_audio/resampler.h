@@ -15,9 +15,12 @@
 
 #include "roc_audio/frame.h"
 #include "roc_audio/ireader.h"
+#include "roc_audio/mac_kernel.h"
+#include "roc_audio/polyphase_bank.h"
 #include "roc_audio/units.h"
 #include "roc_core/array.h"
 #include "roc_core/noncopyable.h"
+#include "roc_core/shared_ptr.h"
 #include "roc_core/stddefs.h"
 #include "roc_packet/units.h"
 
@@ -41,6 +44,10 @@ struct ResamplerConfig {
 //! Resamples audio stream with non-integer dynamically changing factor.
 //! @remarks
 //!  Typicaly being used with factor close to 1 ( 0.9 < factor < 1.1 ).
+//!
+//!  Optionally, resampler may also perform fixed-ratio sample rate conversion,
+//!  see set_bank(). In this case the scaling factor is applied on top of the
+//!  fixed ratio, so that both conversions are done in a single pass.
 class Resampler : public IReader, public core::NonCopyable<> {
 public:
     //! Initialize.
@@ -67,9 +74,21 @@ public:
     //!  (length of sinc impulse response) is a compromise between SNR and speed. It
     //!  depends on current resampling factor. So we choose length of input buffers to let
     //!  it handle maximum length of input. If new scaling factor breaks equation this
-    //!  function returns false.
+    //!  function returns false. When polyphase bank is enabled, the window is defined
+    //!  by the bank filters, and scaling changes only the step between samples.
     bool set_scaling(float);
 
+    //! Enable fixed-ratio sample rate conversion.
+    //! @remarks
+    //!  Uses precomputed filters from @p bank instead of computing them for
+    //!  every output sample. The input stream is expected to have bank input
+    //!  rate, and the output stream will have bank output rate, additionally
+    //!  scaled by the factor passed to set_scaling(). Should be called before
+    //!  the first read().
+    //! @returns
+    //!  false if the bank filters don't fit into resampler frame.
+    bool set_bank(PolyphaseBank& bank);
+
 private:
     typedef uint32_t fixedpoint_t;
     typedef uint64_t long_fixedpoint_t;
@@ -79,20 +98,36 @@ private:
     const packet::channel_mask_t channel_mask_;
     const size_t channels_num_;
 
-    //! Computes single sample of the particular audio channel.
+    //! Computes single sample of every audio channel.
+    //!
+    //! @param out points to channels_num_ interleaved output samples.
+    void resample_(sample_t* out);
+
+    //! Computes single sample of every audio channel using polyphase bank.
+    void resample_bank_(sample_t* out);
+
+    //! Computes sinc coefficients for current time position.
     //!
-    //! @param channel_offset a serial number of the channel
-    //!  (e.g. left -- 0, right -- 1, etc.).
-    sample_t resample_(const size_t channel_offset);
+    //! Fills coeffs_ with one coefficient per window tap, repeated for every
+    //! channel, and sets the number of taps in every frame of the window.
+    void compute_coeffs_(size_t& prev_begin,
+                         size_t& n_prev,
+                         size_t& cur_begin,
+                         size_t& n_cur,
+                         size_t& n_next);
 
     inline size_t channelize_index(const size_t i, const size_t ch_offset) const {
         return i * channels_num_ + ch_offset;
     }
 
+    //! Check if the window for given scaling fits into the frame.
+    bool fits_(float scaling) const;
+
     void init_window_(core::BufferPool<sample_t>&);
     void renew_window_();
     void fill_sinc();
     inline sample_t sinc_(const fixedpoint_t x, const float fract_x);
+    inline void push_coeff_(size_t& pos, const sample_t coeff);
 
     // Input stream.
     IReader& reader_;
@@ -121,6 +156,18 @@ private:
     const size_t window_interp_bits_; //!< The number of bits in window_interp_.
     core::Array<sample_t> sinc_table_;
 
+    // Coefficients for all window taps, interleaved like input samples.
+    core::Array<sample_t> coeffs_;
+
+    // Multiply-accumulate kernel applying coeffs_ to input samples.
+    mac_func_t mac_func_;
+
+    // Polyphase bank for fixed-ratio conversion, if enabled.
+    core::SharedPtr<PolyphaseBank> bank_;
+
+    // Input rate to output rate ratio of the bank.
+    double bank_ratio_;
+
     // half window len in Q8.24 in terms of input signal.
     fixedpoint_t qt_half_window_len_;
     const fixedpoint_t qt_epsilon_;
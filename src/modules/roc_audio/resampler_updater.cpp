@@ -105,5 +105,9 @@ bool ResamplerUpdater::update(packet::timestamp_t time) {
     return resampler_->set_scaling(fe_.freq_coeff());
 }
 
+float ResamplerUpdater::scaling() const {
+    return fe_.freq_coeff();
+}
+
 } // namespace audio
 } // namespace roc
@@ -57,6 +57,9 @@ public:
     //!  false if the calculated freq coeff gone beyond the boundaries.
     bool update(packet::timestamp_t time);
 
+    //! Get current resampler scaling factor.
+    float scaling() const;
+
 private:
     packet::IWriter* writer_;
     packet::IReader* reader_;
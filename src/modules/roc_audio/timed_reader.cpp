@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/timed_reader.h"
+
+namespace roc {
+namespace audio {
+
+TimedReader::TimedReader(IReader& reader, core::Histogram& histogram)
+    : reader_(reader)
+    , histogram_(histogram) {
+}
+
+void TimedReader::read(Frame& frame) {
+    const core::nanoseconds_t start = core::timestamp();
+
+    reader_.read(frame);
+
+    histogram_.record(core::timestamp() - start);
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/timed_reader.h
+//! @brief Timed reader.
+
+#ifndef ROC_AUDIO_TIMED_READER_H_
+#define ROC_AUDIO_TIMED_READER_H_
+
+#include "roc_audio/ireader.h"
+#include "roc_core/histogram.h"
+#include "roc_core/noncopyable.h"
+
+namespace roc {
+namespace audio {
+
+//! Timed reader.
+//! @remarks
+//!  Reads frames from the input reader and records time spent in every
+//!  read into a histogram.
+class TimedReader : public IReader, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    TimedReader(IReader& reader, core::Histogram& histogram);
+
+    //! Read audio frame.
+    virtual void read(Frame& frame);
+
+private:
+    IReader& reader_;
+    core::Histogram& histogram_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_TIMED_READER_H_
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+
+//! @file roc_core/hash_map.h
+//! @brief Open addressing hash map.
+
+#ifndef ROC_CORE_HASH_MAP_H_
+#define ROC_CORE_HASH_MAP_H_
+
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/panic.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+//! Open addressing hash map.
+//!
+//! Maps keys to non-owning pointers to values. Uses linear probing and
+//! backward shift deletion, so there are no tombstones and lookup cost
+//! doesn't degrade after many insertions and removals.
+//!
+//! @tparam K defines key type. It should be copyable and provide operator==()
+//!  and hash() method returning size_t.
+//! @tparam V defines value type.
+//!
+//! @remarks
+//!  The table is grown when it becomes half full. Memory is allocated only
+//!  during insertion.
+template <class K, class V> class HashMap : public NonCopyable<> {
+public:
+    //! Initialize empty map.
+    explicit HashMap(IAllocator& allocator)
+        : allocator_(allocator)
+        , slots_(NULL)
+        , n_slots_(0)
+        , size_(0) {
+    }
+
+    ~HashMap() {
+        release_(slots_, n_slots_);
+    }
+
+    //! Get number of elements.
+    size_t size() const {
+        return size_;
+    }
+
+    //! Find value by key.
+    //! @returns
+    //!  value pointer or NULL if there is no such key.
+    V* find(const K& key) const {
+        if (size_ == 0) {
+            return NULL;
+        }
+
+        const size_t hash = key.hash();
+
+        for (size_t i = hash & (n_slots_ - 1);; i = (i + 1) & (n_slots_ - 1)) {
+            const Slot& slot = slots_[i];
+            if (!slot.value) {
+                return NULL;
+            }
+            if (slot.hash == hash && slot.key == key) {
+                return slot.value;
+            }
+        }
+    }
+
+    //! Insert value.
+    //! @returns
+    //!  false if the key is already present or allocation failed.
+    bool insert(const K& key, V& value) {
+        if ((size_ + 1) * 2 > n_slots_) {
+            if (!grow_()) {
+                return false;
+            }
+        }
+
+        const size_t hash = key.hash();
+
+        size_t i = hash & (n_slots_ - 1);
+        for (; slots_[i].value; i = (i + 1) & (n_slots_ - 1)) {
+            if (slots_[i].hash == hash && slots_[i].key == key) {
+                return false;
+            }
+        }
+
+        slots_[i].key = key;
+        slots_[i].hash = hash;
+        slots_[i].value = &value;
+
+        size_++;
+
+        return true;
+    }
+
+    //! Remove value by key.
+    //! @returns
+    //!  false if there is no such key.
+    bool remove(const K& key) {
+        if (size_ == 0) {
+            return false;
+        }
+
+        const size_t mask = n_slots_ - 1;
+        const size_t hash = key.hash();
+
+        size_t i = hash & mask;
+        for (;; i = (i + 1) & mask) {
+            if (!slots_[i].value) {
+                return false;
+            }
+            if (slots_[i].hash == hash && slots_[i].key == key) {
+                break;
+            }
+        }
+
+        // shift subsequent elements of the same probe sequence back to
+        // fill the hole, so that lookups don't stop early on it
+        for (size_t j = (i + 1) & mask; slots_[j].value; j = (j + 1) & mask) {
+            const size_t home = slots_[j].hash & mask;
+
+            const bool in_range =
+                (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+
+            if (!in_range) {
+                slots_[i] = slots_[j];
+                i = j;
+            }
+        }
+
+        slots_[i].key = K();
+        slots_[i].hash = 0;
+        slots_[i].value = NULL;
+
+        size_--;
+
+        return true;
+    }
+
+private:
+    enum { MinSlots = 16 };
+
+    struct Slot {
+        K key;
+        size_t hash;
+        V* value;
+
+        Slot()
+            : hash(0)
+            , value(NULL) {
+        }
+    };
+
+    bool grow_() {
+        const size_t new_n_slots = n_slots_ ? n_slots_ * 2 : (size_t)MinSlots;
+
+        Slot* new_slots = (Slot*)allocator_.allocate(new_n_slots * sizeof(Slot));
+        if (!new_slots) {
+            return false;
+        }
+
+        for (size_t n = 0; n < new_n_slots; n++) {
+            new (new_slots + n) Slot();
+        }
+
+        for (size_t n = 0; n < n_slots_; n++) {
+            if (!slots_[n].value) {
+                continue;
+            }
+            size_t i = slots_[n].hash & (new_n_slots - 1);
+            while (new_slots[i].value) {
+                i = (i + 1) & (new_n_slots - 1);
+            }
+            new_slots[i] = slots_[n];
+        }
+
+        release_(slots_, n_slots_);
+
+        slots_ = new_slots;
+        n_slots_ = new_n_slots;
+
+        return true;
+    }
+
+    void release_(Slot* slots, size_t n_slots) {
+        if (!slots) {
+            return;
+        }
+        for (size_t n = 0; n < n_slots; n++) {
+            slots[n].~Slot();
+        }
+        allocator_.deallocate(slots);
+    }
+
+    IAllocator& allocator_;
+
+    Slot* slots_;
+    size_t n_slots_;
+    size_t size_;
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_HASH_MAP_H_
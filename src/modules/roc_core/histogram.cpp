@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/histogram.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace core {
+
+HistogramSnapshot::HistogramSnapshot()
+    : count_(0) {
+    memset(buckets_, 0, sizeof(buckets_));
+}
+
+size_t HistogramSnapshot::count() const {
+    return count_;
+}
+
+nanoseconds_t HistogramSnapshot::quantile(double q) const {
+    if (count_ == 0) {
+        return 0;
+    }
+
+    if (q < 0) {
+        q = 0;
+    }
+    if (q > 1) {
+        q = 1;
+    }
+
+    // rank of the value, i.e. ceil(q * count), starting from 1
+    size_t rank = (size_t)(q * (double)count_);
+    if ((double)rank < q * (double)count_) {
+        rank++;
+    }
+    if (rank == 0) {
+        rank = 1;
+    }
+
+    size_t n = 0;
+    for (size_t i = 0; i < HistogramBuckets; i++) {
+        n += buckets_[i];
+        if (n >= rank) {
+            return Histogram::bucket_max(i);
+        }
+    }
+
+    return Histogram::bucket_max(HistogramBuckets - 1);
+}
+
+Histogram::Histogram() {
+}
+
+void Histogram::record(nanoseconds_t value) {
+    ++buckets_[bucket_index(value)];
+}
+
+void Histogram::snapshot(HistogramSnapshot& snapshot) const {
+    snapshot.count_ = 0;
+
+    for (size_t i = 0; i < HistogramBuckets; i++) {
+        snapshot.buckets_[i] = (size_t)(long)buckets_[i];
+        snapshot.count_ += snapshot.buckets_[i];
+    }
+}
+
+size_t Histogram::bucket_index(nanoseconds_t value) {
+    const nanoseconds_t max_value = ((nanoseconds_t)1 << HistogramValueBits) - 1;
+
+    if (value > max_value) {
+        value = max_value;
+    }
+
+    if (value < HistogramSubBuckets) {
+        return (size_t)value;
+    }
+
+    size_t msb = HistogramSubBucketBits;
+    while ((value >> (msb + 1)) != 0) {
+        msb++;
+    }
+
+    const size_t shift = msb - HistogramSubBucketBits;
+    const size_t sub = (size_t)(value >> shift) - HistogramSubBuckets;
+
+    return (shift + 1) * HistogramSubBuckets + sub;
+}
+
+nanoseconds_t Histogram::bucket_max(size_t index) {
+    roc_panic_if(index >= HistogramBuckets);
+
+    const size_t range = index / HistogramSubBuckets;
+    const size_t sub = index % HistogramSubBuckets;
+
+    if (range == 0) {
+        return (nanoseconds_t)sub;
+    }
+
+    const size_t shift = range - 1;
+    const nanoseconds_t min = (nanoseconds_t)(HistogramSubBuckets + sub) << shift;
+
+    return min + ((nanoseconds_t)1 << shift) - 1;
+}
+
+} // namespace core
+} // namespace roc
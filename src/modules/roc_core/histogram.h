@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/histogram.h
+//! @brief Latency histogram.
+
+#ifndef ROC_CORE_HISTOGRAM_H_
+#define ROC_CORE_HISTOGRAM_H_
+
+#include "roc_core/atomic.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+
+namespace roc {
+namespace core {
+
+//! Histogram parameters.
+enum {
+    //! Number of bits of value resolved exactly within every power of two.
+    HistogramSubBucketBits = 5,
+
+    //! Number of buckets within every power of two.
+    HistogramSubBuckets = 1 << HistogramSubBucketBits,
+
+    //! Values of this number of bits and larger are put into the last bucket.
+    HistogramValueBits = 36,
+
+    //! Total number of buckets.
+    HistogramBuckets =
+        (HistogramValueBits - HistogramSubBucketBits + 1) * HistogramSubBuckets
+};
+
+//! Histogram snapshot.
+//! @remarks
+//!  A consistent copy of bucket counters, used to compute quantiles.
+class HistogramSnapshot {
+public:
+    HistogramSnapshot();
+
+    //! Get number of recorded values.
+    size_t count() const;
+
+    //! Get quantile.
+    //! @remarks
+    //!  @p q should be in range [0; 1], e.g. 0.99 for 99th percentile.
+    //! @returns
+    //!  the highest value that falls into the same bucket as the quantile,
+    //!  or zero if no values were recorded.
+    nanoseconds_t quantile(double q) const;
+
+private:
+    friend class Histogram;
+
+    size_t count_;
+    size_t buckets_[HistogramBuckets];
+};
+
+//! Histogram of durations.
+//!
+//! Buckets are log-bucketed like in HdrHistogram: values below
+//! HistogramSubBuckets have their own buckets, and every next power of two
+//! is split into HistogramSubBuckets buckets of equal width. Hence relative
+//! error of reported quantiles doesn't exceed 1 / HistogramSubBuckets for
+//! any value.
+//!
+//! Recording a value is a single atomic increment, so record() never blocks
+//! and may be called concurrently from any number of threads, including
+//! concurrently with snapshot().
+class Histogram : public NonCopyable<> {
+public:
+    Histogram();
+
+    //! Record value.
+    void record(nanoseconds_t value);
+
+    //! Copy current counters to snapshot.
+    void snapshot(HistogramSnapshot& snapshot) const;
+
+    //! Get index of bucket for value.
+    static size_t bucket_index(nanoseconds_t value);
+
+    //! Get the highest value of the bucket.
+    static nanoseconds_t bucket_max(size_t index);
+
+private:
+    Atomic buckets_[HistogramBuckets];
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_HISTOGRAM_H_
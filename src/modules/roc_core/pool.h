@@ -14,12 +14,16 @@
 #define ROC_CORE_POOL_H_
 
 #include "roc_core/alignment.h"
+#include "roc_core/atomic.h"
 #include "roc_core/iallocator.h"
 #include "roc_core/list.h"
+#include "roc_core/log.h"
 #include "roc_core/macros.h"
+#include "roc_core/memory_lock.h"
 #include "roc_core/mutex.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/panic.h"
+#include "roc_core/thread.h"
 
 namespace roc {
 namespace core {
@@ -32,6 +36,29 @@ namespace core {
 //! sized objects. Maintains a list of free objects.
 //!
 //! The memory is always maximum aligned. Thread-safe.
+//!
+//! Free objects are cached in a fixed array of magazines, small stacks of free
+//! objects. Allocations and deallocations are served from a magazine without
+//! taking the mutex; the shared list of free objects is locked only when a
+//! magazine becomes empty or full, to move half of its capacity at once.
+//!
+//! Magazines are not thread-local: every pool has NumMagazines of them, and a
+//! thread uses the one selected by a hash of its thread ID. Different threads
+//! may map to the same magazine. Every magazine is guarded by a busy flag taken
+//! with a single compare-and-swap; if the flag is already taken by a thread
+//! sharing the magazine, the caller doesn't wait and falls back to the shared
+//! list under the mutex, so a collision costs at most the old locking path.
+//! When the shared list is exhausted and the limit is reached, allocation scans
+//! all magazines to reach objects cached by other threads.
+//!
+//! Real thread-local caches (e.g. __thread) are not used, because a cache per
+//! pool instance per thread would need registration and draining on thread
+//! exit, otherwise objects cached by exited threads would be lost to the pool.
+//!
+//! By default, the pool grows on demand and never returns memory until it's
+//! destroyed. Objects may be preallocated using reserve(), the number of objects
+//! may be limited using set_limit(), and unused chunks may be released using
+//! trim().
 template <class T> class Pool : public NonCopyable<> {
 public:
     //! Initialization.
@@ -43,7 +70,8 @@ public:
         : allocator_(allocator)
         , obj_off_(max_align(sizeof(Chunk)))
         , obj_sz_(max_align(ROC_MAX(sizeof(Elem), obj_sz)))
-        , n_objs_(n_objs) {
+        , n_objs_(n_objs)
+        , max_objs_(0) {
     }
 
     ~Pool() {
@@ -55,8 +83,27 @@ public:
     //!  pointer to a maximum aligned uninitialized memory for a new object
     //!  or NULL if memory can't be allocated.
     void* allocate() {
-        Elem* elem = get_elem_();
+        Elem* elem = NULL;
+
+        Magazine& mag = magazines_[magazine_index_()];
+        if (mag.busy.test_and_set() == 0) {
+            if (mag.n_elems == 0) {
+                refill_(mag);
+            }
+            if (mag.n_elems != 0) {
+                elem = mag.elems[--mag.n_elems];
+            }
+            mag.busy = false;
+        } else {
+            elem = get_elem_();
+        }
+
+        if (elem == NULL) {
+            elem = steal_elem_();
+        }
+
         if (elem == NULL) {
+            ++num_failures_;
             return NULL;
         }
         elem->~Elem();
@@ -69,7 +116,17 @@ public:
             roc_panic("pool: null pointer");
         }
         Elem* elem = new (memory) Elem;
-        put_elem_(elem);
+
+        Magazine& mag = magazines_[magazine_index_()];
+        if (mag.busy.test_and_set() == 0) {
+            if (mag.n_elems == MagazineSize) {
+                flush_(mag);
+            }
+            mag.elems[mag.n_elems++] = elem;
+            mag.busy = false;
+        } else {
+            put_elem_(elem);
+        }
     }
 
     //! Destroy object and deallocate its memory.
@@ -78,15 +135,184 @@ public:
         deallocate(&object);
     }
 
+    //! Preallocate objects.
+    //! @remarks
+    //!  Allocates chunks until the pool has at least @p n_objs objects, and
+    //!  writes to their memory, so that there are no page faults when these
+    //!  objects are used. If @p lock is true, the memory is also locked in RAM.
+    //!  Chunks allocated here are never released by trim().
+    //! @returns
+    //!  false if memory can't be allocated or locked, or if the limit set by
+    //!  set_limit() is exceeded.
+    bool reserve(size_t n_objs, bool lock) {
+        Mutex::Lock guard(mutex_);
+
+        while (chunks_.size() * n_objs_ < n_objs) {
+            if (!allocate_chunk_(true, lock)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    //! Set maximum number of objects.
+    //! @remarks
+    //!  When all objects are allocated and the limit is reached, allocate()
+    //!  returns NULL and increments the number of failed allocations. Zero
+    //!  means no limit. The limit is rounded down to the chunk size.
+    void set_limit(size_t max_objs) {
+        Mutex::Lock lock(mutex_);
+        max_objs_ = max_objs;
+    }
+
+    //! Release unused chunks.
+    //! @remarks
+    //!  Returns chunks with no allocated objects to the allocator, except
+    //!  chunks allocated by reserve(). Scans all free objects for every
+    //!  chunk, so it should be called rarely, e.g. when the pool is idle.
+    //! @returns
+    //!  number of released objects.
+    size_t trim() {
+        Mutex::Lock lock(mutex_);
+
+        for (size_t n = 0; n < NumMagazines; n++) {
+            Magazine& mag = magazines_[n];
+            if (mag.busy.test_and_set() != 0) {
+                continue;
+            }
+            while (mag.n_elems != 0) {
+                free_elems_.push_back(*mag.elems[--mag.n_elems]);
+            }
+            mag.busy = false;
+        }
+
+        size_t n_released = 0;
+
+        for (Chunk* chunk = chunks_.front(); chunk != NULL;) {
+            Chunk* next = chunks_.nextof(*chunk);
+
+            if (!chunk->reserved && count_free_elems_(*chunk) == n_objs_) {
+                release_chunk_(*chunk);
+                n_released += n_objs_;
+            }
+
+            chunk = next;
+        }
+
+        if (n_released != 0) {
+            roc_log(LogDebug, "pool: released unused objects: released=%lu, total=%lu",
+                    (unsigned long)n_released,
+                    (unsigned long)(chunks_.size() * n_objs_));
+        }
+
+        return n_released;
+    }
+
+    //! Get number of objects in allocated chunks.
+    size_t capacity() const {
+        Mutex::Lock lock(mutex_);
+        return chunks_.size() * n_objs_;
+    }
+
+    //! Get number of failed allocations.
+    size_t num_failures() const {
+        return (size_t)num_failures_;
+    }
+
 private:
-    struct Chunk : ListNode {};
+    enum {
+        // number of objects cached in magazine
+        MagazineSize = 32,
+
+        // number of objects moved between magazine and shared list at once
+        MagazineBatch = MagazineSize / 2,
+
+        // number of magazines shared by all threads; the pipeline has a few
+        // threads per pool, so collisions are rare
+        NumMagazines = 8
+    };
+
+    struct Chunk : ListNode {
+        Chunk(bool r, bool l)
+            : reserved(r)
+            , locked(l) {
+        }
+
+        bool reserved;
+        bool locked;
+    };
     struct Elem : ListNode {};
 
+    struct Magazine {
+        Magazine()
+            : n_elems(0) {
+        }
+
+        Atomic busy;
+        size_t n_elems;
+        Elem* elems[MagazineSize];
+    };
+
+    // selects magazine by thread ID; threads with colliding hashes share it
+    static size_t magazine_index_() {
+        uint64_t tid = Thread::get_tid();
+        // thread IDs are often aligned addresses, so mix high bits in
+        tid ^= tid >> 32;
+        tid ^= tid >> 16;
+        tid ^= tid >> 8;
+        return size_t(tid % NumMagazines);
+    }
+
+    void refill_(Magazine& mag) {
+        Mutex::Lock lock(mutex_);
+
+        if (free_elems_.size() == 0) {
+            allocate_chunk_(false, false);
+        }
+
+        while (mag.n_elems < MagazineBatch) {
+            Elem* elem = free_elems_.back();
+            if (elem == NULL) {
+                break;
+            }
+            free_elems_.remove(*elem);
+            mag.elems[mag.n_elems++] = elem;
+        }
+    }
+
+    void flush_(Magazine& mag) {
+        Mutex::Lock lock(mutex_);
+
+        while (mag.n_elems > MagazineSize - MagazineBatch) {
+            free_elems_.push_back(*mag.elems[--mag.n_elems]);
+        }
+    }
+
+    // used when shared list is empty and no more chunks can be allocated,
+    // to reach objects cached in magazines of other threads
+    Elem* steal_elem_() {
+        Elem* elem = NULL;
+
+        for (size_t n = 0; n < NumMagazines && elem == NULL; n++) {
+            Magazine& mag = magazines_[n];
+            if (mag.busy.test_and_set() != 0) {
+                continue;
+            }
+            if (mag.n_elems != 0) {
+                elem = mag.elems[--mag.n_elems];
+            }
+            mag.busy = false;
+        }
+
+        return elem;
+    }
+
     Elem* get_elem_() {
         Mutex::Lock lock(mutex_);
 
         if (free_elems_.size() == 0) {
-            allocate_chunk_();
+            allocate_chunk_(false, false);
         }
 
         Elem* elem = free_elems_.back();
@@ -102,22 +328,81 @@ private:
         free_elems_.push_back(*elem);
     }
 
-    void allocate_chunk_() {
-        void* memory = allocator_.allocate(obj_off_ + obj_sz_ * n_objs_);
+    bool allocate_chunk_(bool reserve, bool lock) {
+        if (max_objs_ != 0 && (chunks_.size() + 1) * n_objs_ > max_objs_) {
+            return false;
+        }
+
+        const size_t size = obj_off_ + obj_sz_ * n_objs_;
+
+        void* memory = allocator_.allocate(size);
         if (memory == NULL) {
-            return;
+            return false;
+        }
+
+        if (reserve) {
+            memset(memory, 0, size);
+        }
+
+        if (lock && !lock_memory(memory, size)) {
+            allocator_.deallocate(memory);
+            return false;
         }
 
-        Chunk* chunk = new (memory) Chunk;
+        Chunk* chunk = new (memory) Chunk(reserve, lock);
         chunks_.push_back(*chunk);
 
         for (size_t n = 0; n < n_objs_; n++) {
             Elem* elem = new ((char*)chunk + obj_off_ + obj_sz_ * n) Elem;
             free_elems_.push_back(*elem);
         }
+
+        return true;
+    }
+
+    void release_chunk_(Chunk& chunk) {
+        const char* begin = (const char*)&chunk + obj_off_;
+        const char* end = begin + obj_sz_ * n_objs_;
+
+        for (Elem* elem = free_elems_.front(); elem != NULL;) {
+            Elem* next = free_elems_.nextof(*elem);
+            if ((const char*)elem >= begin && (const char*)elem < end) {
+                free_elems_.remove(*elem);
+            }
+            elem = next;
+        }
+
+        chunks_.remove(chunk);
+
+        if (chunk.locked) {
+            unlock_memory(&chunk, obj_off_ + obj_sz_ * n_objs_);
+        }
+        allocator_.deallocate(&chunk);
+    }
+
+    size_t count_free_elems_(const Chunk& chunk) const {
+        const char* begin = (const char*)&chunk + obj_off_;
+        const char* end = begin + obj_sz_ * n_objs_;
+
+        size_t n_free = 0;
+        for (Elem* elem = free_elems_.front(); elem != NULL;
+             elem = free_elems_.nextof(*elem)) {
+            if ((const char*)elem >= begin && (const char*)elem < end) {
+                n_free++;
+            }
+        }
+
+        return n_free;
     }
 
     void deallocate_all_() {
+        for (size_t n = 0; n < NumMagazines; n++) {
+            Magazine& mag = magazines_[n];
+            while (mag.n_elems != 0) {
+                free_elems_.push_back(*mag.elems[--mag.n_elems]);
+            }
+        }
+
         if (free_elems_.size() != chunks_.size() * n_objs_) {
             roc_panic("pool: detected leak, avail=%lu, total=%lu",
                       (unsigned long)free_elems_.size(),
@@ -130,10 +415,15 @@ private:
 
         while (Chunk* chunk = chunks_.front()) {
             chunks_.remove(*chunk);
+            if (chunk->locked) {
+                unlock_memory(chunk, obj_off_ + obj_sz_ * n_objs_);
+            }
             allocator_.deallocate(chunk);
         }
     }
 
+    Magazine magazines_[NumMagazines];
+
     Mutex mutex_;
 
     List<Chunk, NoOwnership> chunks_;
@@ -143,6 +433,9 @@ private:
     size_t obj_off_;
     size_t obj_sz_;
     size_t n_objs_;
+    size_t max_objs_;
+
+    Atomic num_failures_;
 };
 
 } // namespace core
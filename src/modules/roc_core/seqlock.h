@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/seqlock.h
+//! @brief Seqlock.
+
+#ifndef ROC_CORE_SEQLOCK_H_
+#define ROC_CORE_SEQLOCK_H_
+
+#include "roc_core/atomic.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+//! Seqlock.
+//!
+//! @tparam T defines value type, should be copyable using memcpy().
+//!
+//! Allows a single writer to publish a value, and any number of readers to
+//! fetch a consistent copy of it, without locks. The writer never waits.
+//! Readers retry if the value was modified while they were copying it.
+//!
+//! The value is stored word by word using atomic operations, so there is no
+//! data race even when a reader has to retry.
+template <class T> class Seqlock : public NonCopyable<> {
+public:
+    //! Initialize with given value.
+    explicit Seqlock(const T& value) {
+        store(value);
+    }
+
+    //! Store value.
+    //! @remarks
+    //!  Should not be called concurrently from multiple threads.
+    void store(const T& value) {
+        long words[NumWords] = {};
+        memcpy(words, &value, sizeof(T));
+
+        ++version_;
+        for (size_t n = 0; n < NumWords; n++) {
+            words_[n].store(words[n]);
+        }
+        ++version_;
+    }
+
+    //! Try to load value.
+    //! @returns
+    //!  false if the value is being modified concurrently.
+    bool try_load(T& value) const {
+        const long version = version_;
+        if (version & 1) {
+            return false;
+        }
+
+        long words[NumWords];
+        for (size_t n = 0; n < NumWords; n++) {
+            words[n] = words_[n];
+        }
+
+        if (version_ != version) {
+            return false;
+        }
+
+        memcpy(&value, words, sizeof(T));
+        return true;
+    }
+
+    //! Load value.
+    //! @remarks
+    //!  Spins while the value is being modified concurrently.
+    T load() const {
+        T value;
+        while (!try_load(value)) {
+        }
+        return value;
+    }
+
+private:
+    enum { NumWords = (sizeof(T) + sizeof(long) - 1) / sizeof(long) };
+
+    Atomic version_;
+    Atomic words_[NumWords];
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_SEQLOCK_H_
@@ -31,6 +31,15 @@ public:
         return __sync_add_and_fetch(&value_, 0);
     }
 
+    //! Atomic load with acquire semantics.
+    //! @remarks
+    //!  Unlike operator long(), doesn't perform read-modify-write and so
+    //!  doesn't take exclusive ownership of the cache line. Suitable for
+    //!  values that are read often from many threads and rarely written.
+    long load_acquire() const {
+        return __atomic_load_n(&value_, __ATOMIC_ACQUIRE);
+    }
+
     //! Atomic store.
     //! @remarks
     //!  Only boolean values may be implemented in a cross-platform way
@@ -44,6 +53,21 @@ public:
         return v;
     }
 
+    //! Atomic store of arbitrary value.
+    //! @remarks
+    //!  Implemented using compare-and-swap loop, since __sync builtins
+    //!  don't provide a portable store operation.
+    void store(long v) {
+        long old = __sync_add_and_fetch(&value_, 0);
+        for (;;) {
+            const long cur = __sync_val_compare_and_swap(&value_, old, v);
+            if (cur == old) {
+                return;
+            }
+            old = cur;
+        }
+    }
+
     //! Atomic increment.
     long operator++() {
         return __sync_add_and_fetch(&value_, 1);
@@ -54,6 +78,29 @@ public:
         return __sync_sub_and_fetch(&value_, 1);
     }
 
+    //! Atomic addition.
+    //! @returns
+    //!  new value.
+    long operator+=(long v) {
+        return __sync_add_and_fetch(&value_, v);
+    }
+
+    //! Atomic subtraction.
+    //! @returns
+    //!  new value.
+    long operator-=(long v) {
+        return __sync_sub_and_fetch(&value_, v);
+    }
+
+    //! Atomic compare-and-swap.
+    //! @remarks
+    //!  Atomically sets value to @p desired if it's equal to @p expected.
+    //! @returns
+    //!  true if the value was updated.
+    bool compare_exchange(long expected, long desired) {
+        return __sync_bool_compare_and_swap(&value_, expected, desired);
+    }
+
     //! Atomic test-and-set.
     //! @remarks
     //!  Atomically sets value to non-zero and returns '0' if previous value
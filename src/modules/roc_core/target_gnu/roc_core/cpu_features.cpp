@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/cpu_features.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ROC_CORE_CPU_X86
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define ROC_CORE_CPU_NEON
+#endif
+
+namespace roc {
+namespace core {
+
+namespace {
+
+#ifdef ROC_CORE_CPU_X86
+
+bool x86_supports(CpuFeature feature) {
+    __builtin_cpu_init();
+
+    switch (feature) {
+    case CpuFeature_SSE2:
+        return __builtin_cpu_supports("sse2");
+    case CpuFeature_SSSE3:
+        return __builtin_cpu_supports("ssse3");
+    case CpuFeature_AVX:
+        return __builtin_cpu_supports("avx");
+    case CpuFeature_AVX2:
+        return __builtin_cpu_supports("avx2");
+    default:
+        break;
+    }
+
+    return false;
+}
+
+#endif // ROC_CORE_CPU_X86
+
+} // namespace
+
+bool cpu_supports(CpuFeature feature) {
+    if (feature == CpuFeature_NEON) {
+#ifdef ROC_CORE_CPU_NEON
+        return true;
+#else
+        return false;
+#endif
+    }
+
+#ifdef ROC_CORE_CPU_X86
+    return x86_supports(feature);
+#else
+    return false;
+#endif
+}
+
+const char* cpu_feature_name(CpuFeature feature) {
+    switch (feature) {
+    case CpuFeature_SSE2:
+        return "sse2";
+    case CpuFeature_SSSE3:
+        return "ssse3";
+    case CpuFeature_AVX:
+        return "avx";
+    case CpuFeature_AVX2:
+        return "avx2";
+    case CpuFeature_NEON:
+        return "neon";
+    }
+
+    return "<invalid>";
+}
+
+} // namespace core
+} // namespace roc
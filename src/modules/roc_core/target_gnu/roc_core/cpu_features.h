@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/target_gnu/roc_core/cpu_features.h
+//! @brief CPU feature detection.
+
+#ifndef ROC_CORE_CPU_FEATURES_H_
+#define ROC_CORE_CPU_FEATURES_H_
+
+namespace roc {
+namespace core {
+
+//! CPU instruction set extension.
+enum CpuFeature {
+    //! x86 SSE2.
+    CpuFeature_SSE2,
+
+    //! x86 SSSE3.
+    CpuFeature_SSSE3,
+
+    //! x86 AVX.
+    CpuFeature_AVX,
+
+    //! x86 AVX2.
+    CpuFeature_AVX2,
+
+    //! ARM NEON.
+    CpuFeature_NEON
+};
+
+//! Check if instruction set extension may be used.
+//! @remarks
+//!  On x86, the check is performed at run time, so that kernels compiled
+//!  with per-function target attributes can be selected only on CPUs that
+//!  support them. On ARM, NEON can't be detected portably at run time, so
+//!  it's reported as supported if it's enabled at compile time.
+bool cpu_supports(CpuFeature feature);
+
+//! Get instruction set extension name.
+const char* cpu_feature_name(CpuFeature feature);
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_CPU_FEATURES_H_
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <sys/mman.h>
+
+#include "roc_core/errno_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/memory_lock.h"
+
+namespace roc {
+namespace core {
+
+bool lock_memory(const void* ptr, size_t size) {
+    if (mlock(ptr, size) != 0) {
+        roc_log(LogError, "memory lock: mlock: %s", errno_to_str().c_str());
+        return false;
+    }
+    return true;
+}
+
+void unlock_memory(const void* ptr, size_t size) {
+    if (munlock(ptr, size) != 0) {
+        roc_log(LogError, "memory lock: munlock: %s", errno_to_str().c_str());
+    }
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/target_posix/roc_core/memory_lock.h
+//! @brief Lock memory in RAM.
+
+#ifndef ROC_CORE_MEMORY_LOCK_H_
+#define ROC_CORE_MEMORY_LOCK_H_
+
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+//! Lock memory region in RAM.
+//! @remarks
+//!  Locked pages are never swapped out. May fail if the process exceeds
+//!  RLIMIT_MEMLOCK.
+//! @returns
+//!  false if memory can't be locked.
+bool lock_memory(const void* ptr, size_t size);
+
+//! Unlock memory region previously locked by lock_memory().
+void unlock_memory(const void* ptr, size_t size);
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_MEMORY_LOCK_H_
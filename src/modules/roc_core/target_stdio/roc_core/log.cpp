@@ -10,16 +10,203 @@
 #include <stdarg.h>
 #include <stdio.h>
 
+#include "roc_core/atomic.h"
 #include "roc_core/log.h"
+#include "roc_core/semaphore.h"
+#include "roc_core/thread.h"
+#include "roc_core/time.h"
 
 namespace roc {
 namespace core {
 
 namespace {
 
+enum {
+    // Maximum message length, including terminating zero.
+    MaxMessage = 256,
+
+    // Number of records in asynchronous ring buffer, power of two.
+    RingSize = 1024
+};
+
+// How long stop() sleeps while waiting for in-progress push() calls.
+const nanoseconds_t StopPollInterval = 1000 * 1000;
+
 LogLevel g_log_level = LogError;
 LogHandler g_log_handler = NULL;
 
+void write_message(LogLevel level, const char* module, const char* message) {
+    if (g_log_handler) {
+        g_log_handler(level, module, message);
+    } else {
+        const char* prefix = "?";
+
+        switch (level) {
+        case LogNone:
+            break;
+        case LogError:
+            prefix = "error";
+            break;
+        case LogInfo:
+            prefix = "info";
+            break;
+        case LogDebug:
+            prefix = "debug";
+            break;
+        case LogTrace:
+            prefix = "trace";
+            break;
+        }
+
+        fprintf(stderr, "[%s] %s: %s\n", prefix, module, message);
+    }
+}
+
+// Bounded multiple-producer single-consumer ring of formatted messages.
+//
+// Every record has a sequence number. The record at position pos is free for
+// writing when its sequence is pos, and ready for reading when its sequence
+// is pos + 1. Producers claim positions by CAS on write_pos_, and the
+// background thread consumes them in order and marks records free for the
+// next lap. Producers post a semaphore after publishing a record, so the
+// background thread sleeps while the ring is empty.
+class AsyncLogger : public Thread {
+public:
+    AsyncLogger()
+        : write_pos_(0)
+        , read_pos_(0)
+        , sem_(0) {
+        for (long n = 0; n < RingSize; n++) {
+            records_[n].seq.store(n);
+        }
+    }
+
+    ~AsyncLogger() {
+        stop();
+    }
+
+    bool enabled() const {
+        return enabled_ != 0;
+    }
+
+    void start() {
+        stop_ = false;
+        enabled_ = true;
+        Thread::start();
+    }
+
+    void stop() {
+        if (!joinable()) {
+            return;
+        }
+
+        // After enabled_ is cleared, new calls to push() fail, so we only
+        // need to wait until in-progress calls publish their records.
+        enabled_ = false;
+        while (busy_ != 0) {
+            sleep_for(StopPollInterval);
+        }
+
+        stop_ = true;
+        sem_.post();
+        join();
+    }
+
+    bool push(LogLevel level, const char* module, const char* format, va_list args) {
+        ++busy_;
+
+        if (!enabled_) {
+            --busy_;
+            return false;
+        }
+
+        long pos = write_pos_;
+        Record* rec = NULL;
+
+        for (;;) {
+            rec = &records_[pos & (RingSize - 1)];
+
+            const long diff = (long)rec->seq - pos;
+
+            if (diff == 0) {
+                if (write_pos_.compare_exchange(pos, pos + 1)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                ++dropped_;
+                --busy_;
+                return true;
+            }
+
+            pos = write_pos_;
+        }
+
+        rec->level = level;
+        rec->module = module;
+        vsnprintf(rec->message, sizeof(rec->message), format, args);
+        rec->seq.store(pos + 1);
+
+        sem_.post();
+
+        --busy_;
+        return true;
+    }
+
+private:
+    struct Record {
+        Atomic seq;
+        LogLevel level;
+        const char* module;
+        char message[MaxMessage];
+    };
+
+    virtual void run() {
+        while (!stop_) {
+            sem_.pend();
+            drain_();
+        }
+        drain_();
+    }
+
+    void drain_() {
+        for (;;) {
+            Record& rec = records_[read_pos_ & (RingSize - 1)];
+            if ((long)rec.seq != read_pos_ + 1) {
+                break;
+            }
+
+            write_message(rec.level, rec.module, rec.message);
+
+            rec.seq.store(read_pos_ + RingSize);
+            read_pos_++;
+        }
+
+        if (const long n_dropped = dropped_) {
+            dropped_ -= n_dropped;
+
+            char message[MaxMessage] = {};
+            snprintf(message, sizeof(message), "log: dropped %ld messages", n_dropped);
+
+            write_message(LogError, ROC_STRINGIZE(ROC_MODULE), message);
+        }
+    }
+
+    Record records_[RingSize];
+
+    Atomic write_pos_;
+    long read_pos_;
+
+    Semaphore sem_;
+
+    Atomic dropped_;
+    Atomic busy_;
+
+    Atomic enabled_;
+    Atomic stop_;
+};
+
+AsyncLogger g_async_logger;
+
 } // namespace
 
 LogLevel get_log_level() {
@@ -44,42 +231,38 @@ LogHandler set_log_handler(LogHandler handler) {
     return ret;
 }
 
+bool set_log_async(bool enabled) {
+    const bool ret = g_async_logger.enabled();
+    if (enabled && !ret) {
+        g_async_logger.start();
+    }
+    if (!enabled && ret) {
+        g_async_logger.stop();
+    }
+    return ret;
+}
+
 void log(const char* module, LogLevel level, const char* format, ...) {
     if (level > g_log_level || level == LogNone) {
         return;
     }
 
-    char message[256] = {};
-
     va_list args;
     va_start(args, format);
-    vsnprintf(message, sizeof(message) - 1, format, args);
+    const bool pushed = g_async_logger.push(level, module, format, args);
     va_end(args);
 
-    if (g_log_handler) {
-        g_log_handler(level, module, message);
-    } else {
-        const char* prefix = "?";
+    if (pushed) {
+        return;
+    }
 
-        switch (level) {
-        case LogNone:
-            break;
-        case LogError:
-            prefix = "error";
-            break;
-        case LogInfo:
-            prefix = "info";
-            break;
-        case LogDebug:
-            prefix = "debug";
-            break;
-        case LogTrace:
-            prefix = "trace";
-            break;
-        }
+    char message[MaxMessage] = {};
 
-        fprintf(stderr, "[%s] %s: %s\n", prefix, module, message);
-    }
+    va_start(args, format);
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+
+    write_message(level, module, message);
 }
 
 } // namespace core
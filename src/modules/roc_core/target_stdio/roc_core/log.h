@@ -21,8 +21,24 @@
 #error "ROC_MODULE not defined"
 #endif
 
+#ifndef ROC_MAX_LOG_LEVEL
+//! Maximum log level compiled in.
+//! @remarks
+//!  Messages with higher log level are removed at compile time.
+#define ROC_MAX_LOG_LEVEL LogTrace
+#endif
+
 //! Print message to log.
-#define roc_log(...) ::roc::core::log(ROC_STRINGIZE(ROC_MODULE), __VA_ARGS__)
+//! @remarks
+//!  Arguments are evaluated only if @p level is not filtered out, neither
+//!  by ROC_MAX_LOG_LEVEL, nor by the current log level.
+#define roc_log(level, ...)                                                              \
+    do {                                                                                 \
+        if ((level) <= ::roc::ROC_MAX_LOG_LEVEL                                          \
+            && (level) <= ::roc::core::get_log_level()) {                                \
+            ::roc::core::log(ROC_STRINGIZE(ROC_MODULE), (level), __VA_ARGS__);           \
+        }                                                                                \
+    } while (0)
 
 namespace roc {
 
@@ -73,6 +89,24 @@ LogLevel set_log_level(LogLevel);
 //!  stderr by default.
 LogHandler set_log_handler(LogHandler handler);
 
+//! Enable or disable asynchronous logging.
+//!
+//! @remarks
+//!  In asynchronous mode, log() formats the message into a lock-free ring
+//!  buffer and returns, and a background thread prints it to stderr or passes
+//!  it to the log handler. The calling thread never blocks and never performs
+//!  I/O; if the ring buffer is full, the message is dropped, and the number
+//!  of dropped messages is reported later. When asynchronous mode is
+//!  disabled, pending messages are flushed before returning.
+//!
+//! @returns
+//!  previous mode.
+//!
+//! @note
+//!  Asynchronous mode is disabled by default. Log handler is invoked from
+//!  the background thread when it's enabled.
+bool set_log_async(bool enabled);
+
 } // namespace core
 } // namespace roc
 
@@ -9,11 +9,22 @@
 
 #include "roc_core/thread.h"
 #include "roc_core/errno_to_str.h"
+#include "roc_core/macros.h"
 #include "roc_core/panic.h"
 
 namespace roc {
 namespace core {
 
+uint64_t Thread::get_tid() {
+    const uv_thread_t self = uv_thread_self();
+
+    // uv_thread_t is an integer on some platforms and a pointer on others
+    uint64_t tid = 0;
+    memcpy(&tid, &self, ROC_MIN(sizeof(tid), sizeof(self)));
+
+    return tid;
+}
+
 Thread::Thread()
     : joinable_(false) {
 }
@@ -17,6 +17,7 @@
 
 #include "roc_core/noncopyable.h"
 #include "roc_core/panic.h"
+#include "roc_core/stddefs.h"
 
 namespace roc {
 namespace core {
@@ -24,6 +25,12 @@ namespace core {
 //! Base class for thread objects.
 class Thread : public NonCopyable<Thread> {
 public:
+    //! Get numeric identifier of the calling thread.
+    //! @remarks
+    //!  Identifiers of running threads are distinct, but may be reused after
+    //!  a thread terminates.
+    static uint64_t get_tid();
+
     //! Check if thread was started and can be joined.
     //! @returns
     //!  true if start() was called and join() was not called yet.
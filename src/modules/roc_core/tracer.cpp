@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <stdio.h>
+
+#include "roc_core/heap_allocator.h"
+#include "roc_core/log.h"
+#include "roc_core/macros.h"
+#include "roc_core/panic.h"
+#include "roc_core/thread.h"
+#include "roc_core/tracer.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+HeapAllocator g_allocator;
+Tracer g_tracer(g_allocator);
+
+} // namespace
+
+Tracer& tracer() {
+    return g_tracer;
+}
+
+Tracer::Tracer(IAllocator& allocator)
+    : allocator_(allocator)
+    , events_(NULL)
+    , events_per_thread_(0) {
+    for (size_t n = 0; n < MaxThreads; n++) {
+        rings_[n].pos = 0;
+    }
+}
+
+Tracer::~Tracer() {
+    stop();
+
+    if (events_) {
+        allocator_.deallocate(events_);
+    }
+}
+
+bool Tracer::enabled() const {
+    return enabled_.load_acquire() != 0;
+}
+
+bool Tracer::start(size_t events_per_thread) {
+    if (enabled_) {
+        roc_log(LogError, "tracer: tracing is already enabled");
+        return false;
+    }
+
+    if (events_per_thread == 0) {
+        roc_log(LogError, "tracer: number of events should be non-zero");
+        return false;
+    }
+
+    if (events_per_thread != events_per_thread_) {
+        if (events_) {
+            allocator_.deallocate(events_);
+            events_ = NULL;
+            events_per_thread_ = 0;
+        }
+
+        events_ = (TraceEvent*)allocator_.allocate(MaxThreads * events_per_thread
+                                                   * sizeof(TraceEvent));
+        if (!events_) {
+            roc_log(LogError, "tracer: can't allocate ring buffers");
+            return false;
+        }
+
+        events_per_thread_ = events_per_thread;
+    }
+
+    for (size_t n = 0; n < MaxThreads; n++) {
+        rings_[n].pos = 0;
+    }
+
+    roc_log(LogDebug, "tracer: enabling tracing: events_per_thread=%lu",
+            (unsigned long)events_per_thread_);
+
+    enabled_ = true;
+    return true;
+}
+
+void Tracer::stop() {
+    if (!enabled_) {
+        return;
+    }
+
+    enabled_ = false;
+
+    // wait for threads that have seen enabled flag before we reset it
+    for (size_t n = 0; n < MaxThreads; n++) {
+        while (rings_[n].busy != 0) {
+        }
+    }
+
+    roc_log(LogDebug, "tracer: disabled tracing: num_events=%lu",
+            (unsigned long)num_events());
+}
+
+void Tracer::record(const char* name, uint64_t id, nanoseconds_t timestamp) {
+    Ring* ring = acquire_ring_();
+    if (!ring) {
+        return;
+    }
+
+    // the busy counter is incremented before checking the enabled flag, and
+    // stop() resets the flag before waiting for the counter, so that stop()
+    // never misses a thread that is going to write to the ring buffer
+    ++ring->busy;
+
+    if (enabled_) {
+        TraceEvent& event =
+            events_[size_t(ring - rings_) * events_per_thread_
+                    + ring->pos % events_per_thread_];
+
+        event.timestamp = timestamp;
+        event.name = name;
+        event.id = id;
+
+        ring->pos++;
+    }
+
+    --ring->busy;
+}
+
+uint64_t Tracer::new_id() {
+    return (uint64_t)(unsigned long)++last_id_;
+}
+
+size_t Tracer::num_events() const {
+    roc_panic_if(enabled_);
+
+    size_t n_events = 0;
+    for (size_t n = 0; n < MaxThreads; n++) {
+        n_events += ring_size_(n);
+    }
+
+    return n_events;
+}
+
+const TraceEvent& Tracer::event(size_t index, size_t* thread) const {
+    roc_panic_if(enabled_);
+
+    for (size_t n = 0; n < MaxThreads; n++) {
+        const size_t size = ring_size_(n);
+
+        if (index < size) {
+            if (thread) {
+                *thread = n;
+            }
+            return events_[n * events_per_thread_
+                           + (ring_begin_(n) + index) % events_per_thread_];
+        }
+
+        index -= size;
+    }
+
+    roc_panic("tracer: event index out of bounds");
+}
+
+bool Tracer::dump(const char* path) const {
+    roc_panic_if(enabled_);
+
+    FILE* fp = fopen(path, "w");
+    if (!fp) {
+        roc_log(LogError, "tracer: can't open file: %s", path);
+        return false;
+    }
+
+    fprintf(fp, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+
+    const size_t n_events = num_events();
+
+    for (size_t n = 0; n < n_events; n++) {
+        size_t thread = 0;
+        const TraceEvent& ev = event(n, &thread);
+
+        fprintf(fp,
+                "%s\n{\"name\":\"%s\",\"cat\":\"roc\",\"ph\":\"i\",\"s\":\"t\","
+                "\"ts\":%lu.%03u,\"pid\":1,\"tid\":%u,\"args\":{\"id\":%lu}}",
+                n == 0 ? "" : ",", ev.name, (unsigned long)(ev.timestamp / 1000),
+                (unsigned)(ev.timestamp % 1000), (unsigned)thread + 1,
+                (unsigned long)ev.id);
+    }
+
+    fprintf(fp, "\n]}\n");
+
+    if (fclose(fp) != 0) {
+        roc_log(LogError, "tracer: can't write file: %s", path);
+        return false;
+    }
+
+    roc_log(LogInfo, "tracer: dumped %lu events to %s", (unsigned long)n_events, path);
+
+    return true;
+}
+
+Tracer::Ring* Tracer::acquire_ring_() {
+    long tid = (long)Thread::get_tid();
+    if (tid == 0) {
+        tid = -1;
+    }
+
+    const size_t start = (size_t)((uint64_t)tid % MaxThreads);
+
+    for (size_t n = 0; n < MaxThreads; n++) {
+        Ring& ring = rings_[(start + n) % MaxThreads];
+
+        if (ring.owner == tid) {
+            return &ring;
+        }
+
+        if (ring.owner == 0 && ring.owner.compare_exchange(0, tid)) {
+            return &ring;
+        }
+    }
+
+    return NULL;
+}
+
+size_t Tracer::ring_size_(size_t ring) const {
+    return ROC_MIN(rings_[ring].pos, events_per_thread_);
+}
+
+size_t Tracer::ring_begin_(size_t ring) const {
+    return rings_[ring].pos - ring_size_(ring);
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/tracer.h
+//! @brief Event tracer.
+
+#ifndef ROC_CORE_TRACER_H_
+#define ROC_CORE_TRACER_H_
+
+#include "roc_core/atomic.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+
+//! Record trace event with current time, if tracing is enabled.
+//! @remarks
+//!  @p name should be a string literal. @p id is evaluated only if tracing
+//!  is enabled.
+#define roc_trace(name, id) roc_trace_at(name, id, ::roc::core::timestamp())
+
+//! Record trace event with given time, if tracing is enabled.
+//! @remarks
+//!  Same as roc_trace(), but @p ts is used as event time. @p ts is
+//!  evaluated only if tracing is enabled.
+#define roc_trace_at(name, id, ts)                                                      \
+    do {                                                                                \
+        if (::roc::core::tracer().enabled()) {                                          \
+            ::roc::core::tracer().record((name), (uint64_t)(id), (ts));                 \
+        }                                                                               \
+    } while (0)
+
+namespace roc {
+namespace core {
+
+//! Trace event.
+struct TraceEvent {
+    //! Event time.
+    nanoseconds_t timestamp;
+
+    //! Event name, a string literal.
+    const char* name;
+
+    //! Object identifier, e.g. packet identifier.
+    uint64_t id;
+};
+
+//! Event tracer.
+//!
+//! Every thread records events into its own ring buffer, so recording
+//! doesn't contend with other threads and doesn't allocate. When a ring
+//! buffer is full, the oldest events of the thread are overwritten.
+//!
+//! Events may be dumped in Chrome trace event format, which can be opened
+//! in chrome://tracing or Perfetto UI.
+class Tracer : public NonCopyable<> {
+public:
+    enum {
+        //! Maximum number of threads that may record events.
+        MaxThreads = 16
+    };
+
+    //! Initialize.
+    explicit Tracer(IAllocator& allocator);
+
+    ~Tracer();
+
+    //! Check if tracing is enabled.
+    bool enabled() const;
+
+    //! Enable tracing.
+    //! @remarks
+    //!  Drops previously recorded events and allocates ring buffers large
+    //!  enough to keep last @p events_per_thread events of every thread.
+    //!  Should not be called concurrently with stop() or dump().
+    //! @returns
+    //!  false if tracing is already enabled or allocation failed.
+    bool start(size_t events_per_thread);
+
+    //! Disable tracing.
+    //! @remarks
+    //!  Waits until threads that are recording events right now finish.
+    void stop();
+
+    //! Record event.
+    //! @remarks
+    //!  Does nothing if tracing is disabled, or if there are already
+    //!  MaxThreads other threads recording events.
+    void record(const char* name, uint64_t id, nanoseconds_t timestamp);
+
+    //! Generate new object identifier.
+    //! @remarks
+    //!  Identifiers are unique and non-zero.
+    uint64_t new_id();
+
+    //! Get number of recorded events.
+    //! @pre
+    //!  Tracing should be disabled.
+    size_t num_events() const;
+
+    //! Get recorded event.
+    //! @remarks
+    //!  Events of every thread are ordered from oldest to newest, and
+    //!  events of different threads follow each other.
+    //! @pre
+    //!  Tracing should be disabled.
+    const TraceEvent& event(size_t index, size_t* thread = NULL) const;
+
+    //! Write recorded events to file in Chrome trace event format.
+    //! @pre
+    //!  Tracing should be disabled.
+    bool dump(const char* path) const;
+
+private:
+    struct Ring {
+        Atomic owner;
+        Atomic busy;
+        size_t pos;
+    };
+
+    Ring* acquire_ring_();
+
+    size_t ring_size_(size_t ring) const;
+    size_t ring_begin_(size_t ring) const;
+
+    IAllocator& allocator_;
+
+    Atomic enabled_;
+    Atomic last_id_;
+
+    Ring rings_[MaxThreads];
+
+    TraceEvent* events_;
+    size_t events_per_thread_;
+};
+
+//! Get global tracer.
+Tracer& tracer();
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_TRACER_H_
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/codec_factory.h"
+#include "roc_core/alignment.h"
+#include "roc_core/log.h"
+#include "roc_core/macros.h"
+#include "roc_fec/headers.h"
+#include "roc_fec/parity_code.h"
+#include "roc_fec/parity_decoder.h"
+#include "roc_fec/parity_encoder.h"
+#include "roc_fec/rlc_code.h"
+#include "roc_fec/rlc_decoder.h"
+#include "roc_fec/rlc_encoder.h"
+#include "roc_fec/rs8m_code.h"
+#include "roc_fec/rs8m_decoder.h"
+#include "roc_fec/rs8m_encoder.h"
+
+#ifdef ROC_TARGET_OPENFEC
+#include "roc_fec/of_decoder.h"
+#include "roc_fec/of_encoder.h"
+#endif
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+// maximum alignment of repair payload required by encoders
+enum { MaxPayloadAlignment = 8 };
+
+template <class SourceID, class RepairID> size_t overhead() {
+    const size_t source_size = sizeof(SourceID);
+    const size_t repair_size =
+        sizeof(RepairID) + core::padding(sizeof(RepairID), MaxPayloadAlignment);
+
+    return ROC_MAX(source_size, repair_size);
+}
+
+bool check_config(const Config& config) {
+    if (config.n_source_packets == 0) {
+        roc_log(LogError, "fec codec: number of source packets should be positive");
+        return false;
+    }
+
+    if (config.codec == ReedSolomon8m) {
+        if (config.rs_m != 8) {
+            roc_log(LogError, "fec codec: unsupported reed-solomon parameter: m=%u",
+                    (unsigned)config.rs_m);
+            return false;
+        }
+        if (config.n_source_packets + config.n_repair_packets
+            > RS8mCode::MaxBlockLength) {
+            roc_log(LogError,
+                    "fec codec: too many packets in reed-solomon block:"
+                    " n_source=%lu n_repair=%lu max=%lu",
+                    (unsigned long)config.n_source_packets,
+                    (unsigned long)config.n_repair_packets,
+                    (unsigned long)RS8mCode::MaxBlockLength);
+            return false;
+        }
+    }
+
+    if (config.codec == RandomLinear) {
+        if (config.n_source_packets + config.n_repair_packets
+            > RLCCode::MaxBlockLength) {
+            roc_log(LogError,
+                    "fec codec: too many packets in random linear code block:"
+                    " n_source=%lu n_repair=%lu max=%lu",
+                    (unsigned long)config.n_source_packets,
+                    (unsigned long)config.n_repair_packets,
+                    (unsigned long)RLCCode::MaxBlockLength);
+            return false;
+        }
+    }
+
+    if (config.codec == XORParity) {
+        if (!ParityCode::supported(config.n_source_packets, config.n_repair_packets)) {
+            roc_log(LogError,
+                    "fec codec: unsupported parity block geometry:"
+                    " n_source=%lu n_repair=%lu",
+                    (unsigned long)config.n_source_packets,
+                    (unsigned long)config.n_repair_packets);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+bool codec_supported(CodecType codec) {
+    switch ((unsigned)codec) {
+    case ReedSolomon8m:
+    case XORParity:
+    case RandomLinear:
+        return true;
+
+    case LDPCStaircase:
+#ifdef ROC_TARGET_OPENFEC
+        return true;
+#else
+        return false;
+#endif
+
+    default:
+        return false;
+    }
+}
+
+size_t packet_overhead(CodecType codec) {
+    switch ((unsigned)codec) {
+    case ReedSolomon8m:
+        return overhead<RSm8_PayloadID, RSm8_PayloadID>();
+
+    case LDPCStaircase:
+        return overhead<LDPC_Source_PayloadID, LDPC_Repair_PayloadID>();
+
+    case XORParity:
+        return overhead<Parity_PayloadID, Parity_PayloadID>();
+
+    case RandomLinear:
+        return overhead<RLC_PayloadID, RLC_PayloadID>();
+
+    default:
+        break;
+    }
+
+    return 0;
+}
+
+IEncoder*
+new_encoder(const Config& config, size_t payload_size, core::IAllocator& allocator) {
+    if (!codec_supported(config.codec)) {
+        roc_log(LogError, "fec codec: codec is not supported in this build");
+        return NULL;
+    }
+
+    if (!check_config(config)) {
+        return NULL;
+    }
+
+    switch ((unsigned)config.codec) {
+    case ReedSolomon8m:
+        return new (allocator) RS8mEncoder(config, payload_size, allocator);
+
+    case XORParity:
+        return new (allocator) ParityEncoder(config, payload_size, allocator);
+
+    case RandomLinear:
+        return new (allocator) RLCEncoder(config, payload_size, allocator);
+
+#ifdef ROC_TARGET_OPENFEC
+    case LDPCStaircase:
+        return new (allocator) OFEncoder(config, payload_size, allocator);
+#endif
+
+    default:
+        break;
+    }
+
+    return NULL;
+}
+
+IDecoder* new_decoder(const Config& config,
+                      size_t payload_size,
+                      core::BufferPool<uint8_t>& buffer_pool,
+                      core::IAllocator& allocator) {
+    if (!codec_supported(config.codec)) {
+        roc_log(LogError, "fec codec: codec is not supported in this build");
+        return NULL;
+    }
+
+    if (!check_config(config)) {
+        return NULL;
+    }
+
+    switch ((unsigned)config.codec) {
+    case ReedSolomon8m:
+        return new (allocator)
+            RS8mDecoder(config, payload_size, buffer_pool, allocator);
+
+    case XORParity:
+        return new (allocator)
+            ParityDecoder(config, payload_size, buffer_pool, allocator);
+
+    case RandomLinear:
+        return new (allocator) RLCDecoder(config, payload_size, buffer_pool, allocator);
+
+#ifdef ROC_TARGET_OPENFEC
+    case LDPCStaircase:
+        return new (allocator) OFDecoder(config, payload_size, buffer_pool, allocator);
+#endif
+
+    default:
+        break;
+    }
+
+    return NULL;
+}
+
+} // namespace fec
+} // namespace roc
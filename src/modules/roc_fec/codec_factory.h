@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/codec_factory.h
+//! @brief FEC codec factory.
+
+#ifndef ROC_FEC_CODEC_FACTORY_H_
+#define ROC_FEC_CODEC_FACTORY_H_
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/stddefs.h"
+#include "roc_fec/config.h"
+#include "roc_fec/idecoder.h"
+#include "roc_fec/iencoder.h"
+
+namespace roc {
+namespace fec {
+
+//! Check if the codec is available in this build.
+bool codec_supported(CodecType codec);
+
+//! Get maximum number of bytes added by the codec to a packet.
+//! @remarks
+//!  Source packets get a FECFRAME footer, and repair packets get a FECFRAME
+//!  header preceded by padding that aligns repair payload; returns the larger
+//!  of the two. Returns zero for NoCodec.
+size_t packet_overhead(CodecType codec);
+
+//! Create encoder for given configuration.
+//! @returns
+//!  NULL if the codec is not supported, if the configuration is invalid for the
+//!  codec, or if allocation failed. The encoder is allocated using @p allocator.
+IEncoder*
+new_encoder(const Config& config, size_t payload_size, core::IAllocator& allocator);
+
+//! Create decoder for given configuration.
+//! @returns
+//!  NULL if the codec is not supported, if the configuration is invalid for the
+//!  codec, or if allocation failed. The decoder is allocated using @p allocator.
+IDecoder* new_decoder(const Config& config,
+                      size_t payload_size,
+                      core::BufferPool<uint8_t>& buffer_pool,
+                      core::IAllocator& allocator);
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_CODEC_FACTORY_H_
@@ -23,12 +23,28 @@ enum CodecType {
     //! FEC is disabled.
     NoCodec,
 
-    //! OpenFEC Reed-Solomon.
+    //! Reed-Solomon over GF(2^8).
+    //! @remarks
+    //!  Implemented in-tree. Uses the same systematic Vandermonde generator
+    //!  matrix as OpenFEC Reed-Solomon codec, so repair packets are exchangeable
+    //!  with it; this is checked by rs8m_interop tests when OpenFEC is enabled.
     ReedSolomon8m,
 
     //! OpenFEC LDPC-Staircase.
     LDPCStaircase,
 
+    //! XOR parity, one- or two-dimensional.
+    //! @remarks
+    //!  Implemented in-tree. Much cheaper than Reed-Solomon, but repairs
+    //!  only some loss patterns.
+    XORParity,
+
+    //! Random linear code over GF(2^8).
+    //! @remarks
+    //!  Implemented in-tree. Supports larger blocks than Reed-Solomon, with
+    //!  small reception overhead.
+    RandomLinear,
+
     //! Maximum for iterating through the enum.
     CodecTypeMax
 };
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/gf256.h
+//! @brief GF(2^8) arithmetic.
+
+#ifndef ROC_FEC_GF256_H_
+#define ROC_FEC_GF256_H_
+
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace fec {
+
+//! Number of non-zero elements in GF(2^8).
+const size_t GF256_Order = 255;
+
+//! Exponent table.
+//! @remarks
+//!  Contains powers of the generator (alpha = 2) modulo x^8+x^4+x^3+x^2+1,
+//!  which is the field polynomial used by RFC 5510 and OpenFEC. The table is
+//!  doubled, so that exp[log[a] + log[b]] doesn't need a modulo.
+extern const uint8_t gf256_exp[GF256_Order * 2];
+
+//! Logarithm table.
+//! @remarks
+//!  log[0] is undefined and set to zero.
+extern const uint8_t gf256_log[GF256_Order + 1];
+
+//! Multiply two field elements.
+inline uint8_t gf256_mul(uint8_t a, uint8_t b) {
+    if (a == 0 || b == 0) {
+        return 0;
+    }
+    return gf256_exp[gf256_log[a] + gf256_log[b]];
+}
+
+//! Get multiplicative inverse of a non-zero field element.
+inline uint8_t gf256_inv(uint8_t a) {
+    return gf256_exp[GF256_Order - gf256_log[a]];
+}
+
+//! Get alpha raised to the power of @p n.
+inline uint8_t gf256_pow(size_t n) {
+    return gf256_exp[n % GF256_Order];
+}
+
+//! Invert square matrix.
+//!
+//! @b Parameters
+//!  - @p matrix is a row-major @p n x @p n matrix; it's destroyed during inversion
+//!  - @p inverse is a row-major @p n x @p n matrix to store the result
+//!
+//! @returns
+//!  false if the matrix is singular.
+bool gf256_invert_matrix(uint8_t* matrix, uint8_t* inverse, size_t n);
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_GF256_H_
@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/gf_kernel.h"
+#include "roc_core/cpu_features.h"
+#include "roc_core/panic.h"
+#include "roc_fec/gf256.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ROC_FEC_GF_X86
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define ROC_FEC_GF_NEON
+#include <arm_neon.h>
+#endif
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+// lo[x] = coeff * x, hi[x] = coeff * (x << 4), for every nibble x.
+void make_tables(uint8_t coeff, uint8_t* lo, uint8_t* hi) {
+    for (uint8_t x = 0; x < 16; x++) {
+        lo[x] = gf256_mul(coeff, x);
+        hi[x] = gf256_mul(coeff, uint8_t(x << 4));
+    }
+}
+
+void add_tail(uint8_t* dst, const uint8_t* src, size_t size) {
+    for (size_t n = 0; n < size; n++) {
+        dst[n] ^= src[n];
+    }
+}
+
+// regions may be unaligned, so words are accessed via memcpy, which is
+// compiled to plain loads and stores
+void add_generic(uint8_t* dst, const uint8_t* src, size_t size) {
+    size_t n = 0;
+
+    for (; n + sizeof(uint64_t) <= size; n += sizeof(uint64_t)) {
+        uint64_t d, s;
+        memcpy(&d, dst + n, sizeof(d));
+        memcpy(&s, src + n, sizeof(s));
+        d ^= s;
+        memcpy(dst + n, &d, sizeof(d));
+    }
+
+    add_tail(dst + n, src + n, size - n);
+}
+
+void muladd_tail(uint8_t* dst,
+                 const uint8_t* src,
+                 const uint8_t* lo,
+                 const uint8_t* hi,
+                 size_t size) {
+    for (size_t n = 0; n < size; n++) {
+        dst[n] ^= uint8_t(lo[src[n] & 0xf] ^ hi[src[n] >> 4]);
+    }
+}
+
+void muladd_generic(uint8_t* dst, const uint8_t* src, uint8_t coeff, size_t size) {
+    if (coeff == 0) {
+        return;
+    }
+    if (coeff == 1) {
+        add_generic(dst, src, size);
+        return;
+    }
+
+    uint8_t lo[16], hi[16];
+    make_tables(coeff, lo, hi);
+
+    muladd_tail(dst, src, lo, hi, size);
+}
+
+#ifdef ROC_FEC_GF_X86
+
+__attribute__((target("sse2"))) void
+add_ssse3(uint8_t* dst, const uint8_t* src, size_t size) {
+    size_t n = 0;
+
+    for (; n + 16 <= size; n += 16) {
+        const __m128i s = _mm_loadu_si128((const __m128i*)(const void*)(src + n));
+        const __m128i d = _mm_loadu_si128((const __m128i*)(const void*)(dst + n));
+
+        _mm_storeu_si128((__m128i*)(void*)(dst + n), _mm_xor_si128(d, s));
+    }
+
+    add_tail(dst + n, src + n, size - n);
+}
+
+__attribute__((target("avx2"))) void
+add_avx2(uint8_t* dst, const uint8_t* src, size_t size) {
+    size_t n = 0;
+
+    for (; n + 32 <= size; n += 32) {
+        const __m256i s = _mm256_loadu_si256((const __m256i*)(const void*)(src + n));
+        const __m256i d = _mm256_loadu_si256((const __m256i*)(const void*)(dst + n));
+
+        _mm256_storeu_si256((__m256i*)(void*)(dst + n), _mm256_xor_si256(d, s));
+    }
+
+    add_tail(dst + n, src + n, size - n);
+}
+
+__attribute__((target("ssse3"))) void
+muladd_ssse3(uint8_t* dst, const uint8_t* src, uint8_t coeff, size_t size) {
+    if (coeff == 0) {
+        return;
+    }
+    if (coeff == 1) {
+        add_ssse3(dst, src, size);
+        return;
+    }
+
+    uint8_t lo[16], hi[16];
+    make_tables(coeff, lo, hi);
+
+    const __m128i tlo = _mm_loadu_si128((const __m128i*)(const void*)lo);
+    const __m128i thi = _mm_loadu_si128((const __m128i*)(const void*)hi);
+    const __m128i mask = _mm_set1_epi8(0x0f);
+
+    size_t n = 0;
+
+    for (; n + 16 <= size; n += 16) {
+        const __m128i s = _mm_loadu_si128((const __m128i*)(const void*)(src + n));
+        const __m128i d = _mm_loadu_si128((const __m128i*)(const void*)(dst + n));
+
+        const __m128i p = _mm_xor_si128(
+            _mm_shuffle_epi8(tlo, _mm_and_si128(s, mask)),
+            _mm_shuffle_epi8(thi, _mm_and_si128(_mm_srli_epi64(s, 4), mask)));
+
+        _mm_storeu_si128((__m128i*)(void*)(dst + n), _mm_xor_si128(d, p));
+    }
+
+    muladd_tail(dst + n, src + n, lo, hi, size - n);
+}
+
+__attribute__((target("avx2"))) void
+muladd_avx2(uint8_t* dst, const uint8_t* src, uint8_t coeff, size_t size) {
+    if (coeff == 0) {
+        return;
+    }
+    if (coeff == 1) {
+        add_avx2(dst, src, size);
+        return;
+    }
+
+    uint8_t lo[16], hi[16];
+    make_tables(coeff, lo, hi);
+
+    // vpshufb shuffles within 128-bit lanes, so tables are duplicated
+    const __m256i tlo =
+        _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(const void*)lo));
+    const __m256i thi =
+        _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(const void*)hi));
+    const __m256i mask = _mm256_set1_epi8(0x0f);
+
+    size_t n = 0;
+
+    for (; n + 32 <= size; n += 32) {
+        const __m256i s = _mm256_loadu_si256((const __m256i*)(const void*)(src + n));
+        const __m256i d = _mm256_loadu_si256((const __m256i*)(const void*)(dst + n));
+
+        const __m256i p = _mm256_xor_si256(
+            _mm256_shuffle_epi8(tlo, _mm256_and_si256(s, mask)),
+            _mm256_shuffle_epi8(thi, _mm256_and_si256(_mm256_srli_epi64(s, 4), mask)));
+
+        _mm256_storeu_si256((__m256i*)(void*)(dst + n), _mm256_xor_si256(d, p));
+    }
+
+    muladd_tail(dst + n, src + n, lo, hi, size - n);
+}
+
+#endif // ROC_FEC_GF_X86
+
+#ifdef ROC_FEC_GF_NEON
+
+void add_neon(uint8_t* dst, const uint8_t* src, size_t size) {
+    size_t n = 0;
+
+    for (; n + 16 <= size; n += 16) {
+        vst1q_u8(dst + n, veorq_u8(vld1q_u8(dst + n), vld1q_u8(src + n)));
+    }
+
+    add_tail(dst + n, src + n, size - n);
+}
+
+void muladd_neon(uint8_t* dst, const uint8_t* src, uint8_t coeff, size_t size) {
+    if (coeff == 0) {
+        return;
+    }
+    if (coeff == 1) {
+        add_neon(dst, src, size);
+        return;
+    }
+
+    uint8_t lo[16], hi[16];
+    make_tables(coeff, lo, hi);
+
+    const uint8x16_t tlo = vld1q_u8(lo);
+    const uint8x16_t thi = vld1q_u8(hi);
+    const uint8x16_t mask = vdupq_n_u8(0x0f);
+
+    size_t n = 0;
+
+    for (; n + 16 <= size; n += 16) {
+        const uint8x16_t s = vld1q_u8(src + n);
+        const uint8x16_t d = vld1q_u8(dst + n);
+
+        const uint8x16_t p = veorq_u8(vqtbl1q_u8(tlo, vandq_u8(s, mask)),
+                                      vqtbl1q_u8(thi, vshrq_n_u8(s, 4)));
+
+        vst1q_u8(dst + n, veorq_u8(d, p));
+    }
+
+    muladd_tail(dst + n, src + n, lo, hi, size - n);
+}
+
+#endif // ROC_FEC_GF_NEON
+
+} // namespace
+
+GFKernel gf_kernel_select() {
+    if (gf_kernel_supported(GFKernel_AVX2)) {
+        return GFKernel_AVX2;
+    }
+    if (gf_kernel_supported(GFKernel_SSSE3)) {
+        return GFKernel_SSSE3;
+    }
+    if (gf_kernel_supported(GFKernel_NEON)) {
+        return GFKernel_NEON;
+    }
+    return GFKernel_Generic;
+}
+
+bool gf_kernel_supported(GFKernel kernel) {
+    switch (kernel) {
+    case GFKernel_Generic:
+        return true;
+
+    case GFKernel_SSSE3:
+#if defined(ROC_FEC_GF_X86)
+        return core::cpu_supports(core::CpuFeature_SSSE3);
+#else
+        return false;
+#endif
+
+    case GFKernel_AVX2:
+#if defined(ROC_FEC_GF_X86)
+        return core::cpu_supports(core::CpuFeature_AVX2);
+#else
+        return false;
+#endif
+
+    case GFKernel_NEON:
+#if defined(ROC_FEC_GF_NEON)
+        return core::cpu_supports(core::CpuFeature_NEON);
+#else
+        return false;
+#endif
+    }
+
+    return false;
+}
+
+gf_muladd_func_t gf_kernel_muladd(GFKernel kernel) {
+    switch (kernel) {
+    case GFKernel_Generic:
+        return muladd_generic;
+
+#if defined(ROC_FEC_GF_X86)
+    case GFKernel_SSSE3:
+        return muladd_ssse3;
+
+    case GFKernel_AVX2:
+        return muladd_avx2;
+#endif
+
+#if defined(ROC_FEC_GF_NEON)
+    case GFKernel_NEON:
+        return muladd_neon;
+#endif
+
+    default:
+        break;
+    }
+
+    roc_panic("gf kernel: kernel is not supported: %s", gf_kernel_name(kernel));
+
+    return NULL;
+}
+
+gf_add_func_t gf_kernel_add(GFKernel kernel) {
+    switch (kernel) {
+    case GFKernel_Generic:
+        return add_generic;
+
+#if defined(ROC_FEC_GF_X86)
+    case GFKernel_SSSE3:
+        return add_ssse3;
+
+    case GFKernel_AVX2:
+        return add_avx2;
+#endif
+
+#if defined(ROC_FEC_GF_NEON)
+    case GFKernel_NEON:
+        return add_neon;
+#endif
+
+    default:
+        break;
+    }
+
+    roc_panic("gf kernel: kernel is not supported: %s", gf_kernel_name(kernel));
+
+    return NULL;
+}
+
+const char* gf_kernel_name(GFKernel kernel) {
+    switch (kernel) {
+    case GFKernel_Generic:
+        return "generic";
+    case GFKernel_SSSE3:
+        return "ssse3";
+    case GFKernel_AVX2:
+        return "avx2";
+    case GFKernel_NEON:
+        return "neon";
+    }
+
+    return "<invalid>";
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/gf_kernel.h
+//! @brief GF(2^8) region kernels.
+
+#ifndef ROC_FEC_GF_KERNEL_H_
+#define ROC_FEC_GF_KERNEL_H_
+
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace fec {
+
+//! GF(2^8) region kernel implementation.
+enum GFKernel {
+    //! Portable scalar implementation.
+    GFKernel_Generic,
+
+    //! SSSE3 implementation.
+    GFKernel_SSSE3,
+
+    //! AVX2 implementation.
+    GFKernel_AVX2,
+
+    //! NEON implementation.
+    GFKernel_NEON
+};
+
+//! Multiply-accumulate function for byte regions.
+//!
+//! @b Parameters
+//!  - @p dst and @p src are two regions of @p size bytes
+//!  - @p coeff is a field element
+//!
+//! For every byte, adds (XORs) coeff * src[n] to dst[n].
+//!
+//! @remarks
+//!  The product is computed by splitting every byte into two nibbles and
+//!  looking up each nibble in a 16-entry table of products, which maps to
+//!  a single byte shuffle instruction on SIMD targets.
+typedef void (*gf_muladd_func_t)(uint8_t* dst,
+                                 const uint8_t* src,
+                                 uint8_t coeff,
+                                 size_t size);
+
+//! Addition function for byte regions.
+//!
+//! @b Parameters
+//!  - @p dst and @p src are two regions of @p size bytes
+//!
+//! For every byte, adds (XORs) src[n] to dst[n]. Same as multiply-accumulate
+//! with coeff = 1, but processes whole machine or SIMD words at once.
+typedef void (*gf_add_func_t)(uint8_t* dst, const uint8_t* src, size_t size);
+
+//! Select the fastest kernel supported by CPU.
+//! @remarks
+//!  The check is performed at run time.
+GFKernel gf_kernel_select();
+
+//! Check if the kernel is supported by CPU.
+bool gf_kernel_supported(GFKernel kernel);
+
+//! Get multiply-accumulate function.
+//! @pre
+//!  The kernel should be supported.
+gf_muladd_func_t gf_kernel_muladd(GFKernel kernel);
+
+//! Get addition function.
+//! @pre
+//!  The kernel should be supported.
+gf_add_func_t gf_kernel_add(GFKernel kernel);
+
+//! Get kernel name.
+const char* gf_kernel_name(GFKernel kernel);
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_GF_KERNEL_H_
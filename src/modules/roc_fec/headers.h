@@ -164,6 +164,124 @@ public:
     }
 };
 
+//! XOR Parity Source or Repair Payload ID.
+//!
+//! @code
+//!    0                   1                   2                   3
+//!    0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |   Source Block Number (SBN)   |   Encoding Symbol ID (ESI)    |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |    Source Block Length (k)    |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! @endcode
+class ROC_ATTR_PACKED Parity_PayloadID {
+private:
+    //! Source block number.
+    uint16_t sbn_;
+
+    //! Encoding symbol ID.
+    uint16_t esi_;
+
+    //! Source block length.
+    uint16_t k_;
+
+public:
+    //! Clear header.
+    void clear() {
+        memset(this, 0, sizeof(*this));
+    }
+
+    //! Get source block number.
+    uint16_t sbn() const {
+        return ROC_NTOH_16(sbn_);
+    }
+
+    //! Set source block number.
+    void set_sbn(uint16_t val) {
+        sbn_ = ROC_HTON_16(val);
+    }
+
+    //! Get encoding symbol ID.
+    uint16_t esi() const {
+        return ROC_NTOH_16(esi_);
+    }
+
+    //! Set encoding symbol ID.
+    void set_esi(uint16_t val) {
+        esi_ = ROC_HTON_16(val);
+    }
+
+    //! Get source block length.
+    uint16_t k() const {
+        return ROC_NTOH_16(k_);
+    }
+
+    //! Set source block length.
+    void set_k(uint16_t val) {
+        k_ = ROC_HTON_16(val);
+    }
+};
+
+//! Random Linear Code Source or Repair Payload ID.
+//!
+//! @code
+//!    0                   1                   2                   3
+//!    0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |   Source Block Number (SBN)   |   Encoding Symbol ID (ESI)    |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |    Source Block Length (k)    |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! @endcode
+class ROC_ATTR_PACKED RLC_PayloadID {
+private:
+    //! Source block number.
+    uint16_t sbn_;
+
+    //! Encoding symbol ID.
+    uint16_t esi_;
+
+    //! Source block length.
+    uint16_t k_;
+
+public:
+    //! Clear header.
+    void clear() {
+        memset(this, 0, sizeof(*this));
+    }
+
+    //! Get source block number.
+    uint16_t sbn() const {
+        return ROC_NTOH_16(sbn_);
+    }
+
+    //! Set source block number.
+    void set_sbn(uint16_t val) {
+        sbn_ = ROC_HTON_16(val);
+    }
+
+    //! Get encoding symbol ID.
+    uint16_t esi() const {
+        return ROC_NTOH_16(esi_);
+    }
+
+    //! Set encoding symbol ID.
+    void set_esi(uint16_t val) {
+        esi_ = ROC_HTON_16(val);
+    }
+
+    //! Get source block length.
+    uint16_t k() const {
+        return ROC_NTOH_16(k_);
+    }
+
+    //! Set source block length.
+    void set_k(uint16_t val) {
+        k_ = ROC_HTON_16(val);
+    }
+};
+
 //! Reed-Solomon Source or Repair Payload ID (for m=8).
 //!
 //! @code
@@ -25,9 +25,16 @@ public:
     virtual ~IDecoder();
 
     //! Store source or repair packet buffer for current block.
+    //! @remarks
+    //!  Panics if a packet with this index was already stored. A packet that
+    //!  was only repaired, either by repair() or while repairing another
+    //!  packet, is replaced by the stored one.
     virtual void set(size_t index, const core::Slice<uint8_t>& buffer) = 0;
 
     //! Repair source packet buffer.
+    //! @remarks
+    //!  Decoder may restore other lost packets on the way. They are kept until
+    //!  reset() and may be replaced by set() if their originals arrive later.
     virtual core::Slice<uint8_t> repair(size_t index) = 0;
 
     //! Reset current block.
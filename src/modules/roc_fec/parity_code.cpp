@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/parity_code.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace fec {
+
+bool ParityCode::supported(size_t n_source_symbols, size_t n_repair_symbols) {
+    return find_columns_(n_source_symbols, n_repair_symbols) != 0;
+}
+
+ParityCode::ParityCode(size_t n_source_symbols, size_t n_repair_symbols)
+    : n_source_(n_source_symbols)
+    , n_repair_(n_repair_symbols)
+    , n_cols_(find_columns_(n_source_symbols, n_repair_symbols))
+    , n_rows_(0)
+    , add_(NULL) {
+    if (n_cols_ == 0) {
+        roc_panic("parity code: unsupported block size: n_source=%lu n_repair=%lu",
+                  (unsigned long)n_source_, (unsigned long)n_repair_);
+    }
+
+    n_rows_ = n_source_ / n_cols_;
+
+    const GFKernel kernel = gf_kernel_select();
+    add_ = gf_kernel_add(kernel);
+
+    roc_log(LogDebug,
+            "parity code: initialized: n_source=%lu n_repair=%lu"
+            " columns=%lu rows=%lu dims=%d kernel=%s",
+            (unsigned long)n_source_, (unsigned long)n_repair_, (unsigned long)n_cols_,
+            (unsigned long)n_rows_, n_repair_ == n_cols_ ? 1 : 2,
+            gf_kernel_name(kernel));
+}
+
+size_t ParityCode::n_source_symbols() const {
+    return n_source_;
+}
+
+size_t ParityCode::n_repair_symbols() const {
+    return n_repair_;
+}
+
+size_t ParityCode::n_columns() const {
+    return n_cols_;
+}
+
+size_t ParityCode::n_rows() const {
+    return n_rows_;
+}
+
+size_t ParityCode::group_size(size_t repair) const {
+    roc_panic_if(repair >= n_repair_);
+
+    return repair < n_cols_ ? n_rows_ : n_cols_;
+}
+
+size_t ParityCode::group_member(size_t repair, size_t n) const {
+    roc_panic_if(repair >= n_repair_);
+    roc_panic_if(n >= group_size(repair));
+
+    if (repair < n_cols_) {
+        return n * n_cols_ + repair;
+    } else {
+        return (repair - n_cols_) * n_cols_ + n;
+    }
+}
+
+void ParityCode::add(uint8_t* dst, const uint8_t* src, size_t size) const {
+    add_(dst, src, size);
+}
+
+// returns zero if there is no suitable geometry; if there are several
+// two-dimensional ones, prefers more columns to protect against longer bursts
+size_t ParityCode::find_columns_(size_t n_source_symbols, size_t n_repair_symbols) {
+    if (n_source_symbols == 0 || n_repair_symbols == 0) {
+        return 0;
+    }
+
+    if (n_source_symbols % n_repair_symbols == 0) {
+        return n_repair_symbols;
+    }
+
+    for (size_t n_cols = n_repair_symbols; n_cols > 0; n_cols--) {
+        if (n_source_symbols % n_cols != 0) {
+            continue;
+        }
+        if (n_cols + n_source_symbols / n_cols == n_repair_symbols) {
+            return n_cols;
+        }
+    }
+
+    return 0;
+}
+
+} // namespace fec
+} // namespace roc
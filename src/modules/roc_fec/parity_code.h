@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/parity_code.h
+//! @brief XOR parity code.
+
+#ifndef ROC_FEC_PARITY_CODE_H_
+#define ROC_FEC_PARITY_CODE_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_fec/gf_kernel.h"
+
+namespace roc {
+namespace fec {
+
+//! XOR parity code.
+//!
+//! Source symbols of a block are arranged row by row in a matrix with L columns
+//! and D rows, k = L * D. Every repair symbol is the XOR of a column or a row:
+//!
+//!  - repair symbols 0 .. L-1 are column parities; column j holds source symbols
+//!    j, j + L, j + 2L, ..., so a burst of up to L lost symbols is recovered;
+//!  - if there are L + D repair symbols, repair symbols L .. L+D-1 are row
+//!    parities; row i holds source symbols i*L .. i*L + L-1.
+//!
+//! The geometry is defined by the number of source and repair symbols. If k is
+//! a multiple of r, the code is one-dimensional with L = r columns. Otherwise,
+//! the code is two-dimensional with L and D such that L + D = r.
+class ParityCode : public core::NonCopyable<> {
+public:
+    //! Check if the code may be built for given number of symbols.
+    static bool supported(size_t n_source_symbols, size_t n_repair_symbols);
+
+    //! Initialize.
+    //! @pre
+    //!  supported() should return true for given number of symbols.
+    ParityCode(size_t n_source_symbols, size_t n_repair_symbols);
+
+    //! Get number of source symbols in block.
+    size_t n_source_symbols() const;
+
+    //! Get number of repair symbols in block.
+    size_t n_repair_symbols() const;
+
+    //! Get number of columns.
+    size_t n_columns() const;
+
+    //! Get number of rows.
+    size_t n_rows() const;
+
+    //! Get number of source symbols covered by repair symbol.
+    //! @remarks
+    //!  @p repair is an index of repair symbol, starting from zero.
+    size_t group_size(size_t repair) const;
+
+    //! Get index of n-th source symbol covered by repair symbol.
+    size_t group_member(size_t repair, size_t n) const;
+
+    //! XOR @p src into @p dst.
+    void add(uint8_t* dst, const uint8_t* src, size_t size) const;
+
+private:
+    static size_t find_columns_(size_t n_source_symbols, size_t n_repair_symbols);
+
+    const size_t n_source_;
+    const size_t n_repair_;
+
+    size_t n_cols_;
+    size_t n_rows_;
+
+    gf_add_func_t add_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_PARITY_CODE_H_
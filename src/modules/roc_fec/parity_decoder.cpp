@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/parity_decoder.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace fec {
+
+ParityDecoder::ParityDecoder(const Config& config,
+                             size_t payload_size,
+                             core::BufferPool<uint8_t>& buffer_pool,
+                             core::IAllocator& allocator)
+    : blk_source_packets_(config.n_source_packets)
+    , blk_repair_packets_(config.n_repair_packets)
+    , payload_size_(payload_size)
+    , code_(config.n_source_packets, config.n_repair_packets)
+    , buffer_pool_(buffer_pool)
+    , buff_tab_(allocator, blk_source_packets_ + blk_repair_packets_)
+    , recv_tab_(allocator, blk_source_packets_ + blk_repair_packets_)
+    , status_(allocator, blk_source_packets_ + blk_repair_packets_ + 2)
+    , n_received_(0)
+    , has_new_packets_(false) {
+    if (config.codec != XORParity) {
+        roc_panic("parity decoder: unsupported codec configuration");
+    }
+
+    buff_tab_.resize(buff_tab_.max_size());
+    recv_tab_.resize(recv_tab_.max_size());
+    status_.resize(status_.max_size());
+
+    ParityDecoder::reset(); // non-virtual call from ctor
+}
+
+void ParityDecoder::set(size_t index, const core::Slice<uint8_t>& buffer) {
+    if (index >= blk_source_packets_ + blk_repair_packets_) {
+        roc_panic("parity decoder: index out of bounds: index=%lu, size=%lu",
+                  (unsigned long)index,
+                  (unsigned long)(blk_source_packets_ + blk_repair_packets_));
+    }
+
+    if (!buffer) {
+        roc_panic("parity decoder: null buffer");
+    }
+
+    if (buffer.size() != payload_size_) {
+        roc_panic("parity decoder: invalid payload size: size=%lu, expected=%lu",
+                  (unsigned long)buffer.size(), (unsigned long)payload_size_);
+    }
+
+    // a packet restored while repairing another one may still arrive later,
+    // in which case the received buffer replaces the restored one
+    if (recv_tab_[index]) {
+        roc_panic("parity decoder: can't overwrite buffer: index=%lu",
+                  (unsigned long)index);
+    }
+
+    buff_tab_[index] = buffer;
+    recv_tab_[index] = true;
+
+    n_received_++;
+    has_new_packets_ = true;
+}
+
+core::Slice<uint8_t> ParityDecoder::repair(size_t index) {
+    if (index >= blk_source_packets_ + blk_repair_packets_) {
+        roc_panic("parity decoder: index out of bounds: index=%lu, size=%lu",
+                  (unsigned long)index,
+                  (unsigned long)(blk_source_packets_ + blk_repair_packets_));
+    }
+
+    if (buff_tab_[index]) {
+        return buff_tab_[index];
+    }
+
+    if (index >= blk_source_packets_) {
+        return compute_repair_(index - blk_source_packets_);
+    }
+
+    if (has_new_packets_) {
+        decode_(index);
+    }
+
+    return buff_tab_[index];
+}
+
+void ParityDecoder::reset() {
+    report_();
+
+    for (size_t i = 0; i < buff_tab_.size(); ++i) {
+        buff_tab_[i] = core::Slice<uint8_t>();
+        recv_tab_[i] = false;
+    }
+
+    n_received_ = 0;
+    has_new_packets_ = false;
+}
+
+// repeatedly restores source packets that are the only lost packet in their
+// column or row, until the requested packet is restored or nothing changes;
+// other packets restored on the way are kept for the next calls, but are not
+// marked as received, so their originals may still be set() later
+void ParityDecoder::decode_(size_t index) {
+    for (;;) {
+        bool restored = false;
+
+        for (size_t r = 0; r < blk_repair_packets_; r++) {
+            if (!buff_tab_[blk_source_packets_ + r]) {
+                continue;
+            }
+
+            const size_t lost = find_lost_(r);
+            if (lost == blk_source_packets_) {
+                continue;
+            }
+
+            if (!restore_(lost, r)) {
+                return;
+            }
+
+            if (lost == index) {
+                // other packets may be restored later if needed
+                return;
+            }
+
+            restored = true;
+        }
+
+        if (!restored) {
+            break;
+        }
+    }
+
+    has_new_packets_ = false;
+}
+
+// returns index of the only lost source packet covered by repair packet,
+// or n_source_packets if there are no or several lost packets
+size_t ParityDecoder::find_lost_(size_t repair) const {
+    size_t lost = blk_source_packets_;
+
+    for (size_t n = 0; n < code_.group_size(repair); n++) {
+        const size_t index = code_.group_member(repair, n);
+        if (buff_tab_[index]) {
+            continue;
+        }
+        if (lost != blk_source_packets_) {
+            return blk_source_packets_;
+        }
+        lost = index;
+    }
+
+    return lost;
+}
+
+bool ParityDecoder::restore_(size_t index, size_t repair) {
+    core::Slice<uint8_t> buffer = new (buffer_pool_) core::Buffer<uint8_t>(buffer_pool_);
+    if (!buffer) {
+        roc_log(LogDebug, "parity decoder: can't allocate buffer");
+        return false;
+    }
+    buffer.resize(payload_size_);
+
+    memcpy(buffer.data(), buff_tab_[blk_source_packets_ + repair].data(),
+           payload_size_);
+
+    for (size_t n = 0; n < code_.group_size(repair); n++) {
+        const size_t member = code_.group_member(repair, n);
+        if (member == index) {
+            continue;
+        }
+        code_.add(buffer.data(), buff_tab_[member].data(), payload_size_);
+    }
+
+    buff_tab_[index] = buffer;
+    return true;
+}
+
+core::Slice<uint8_t> ParityDecoder::compute_repair_(size_t repair) {
+    for (size_t n = 0; n < code_.group_size(repair); n++) {
+        if (!buff_tab_[code_.group_member(repair, n)]) {
+            return core::Slice<uint8_t>();
+        }
+    }
+
+    core::Slice<uint8_t> buffer = new (buffer_pool_) core::Buffer<uint8_t>(buffer_pool_);
+    if (!buffer) {
+        roc_log(LogDebug, "parity decoder: can't allocate buffer");
+        return buffer;
+    }
+    buffer.resize(payload_size_);
+
+    memcpy(buffer.data(), buff_tab_[code_.group_member(repair, 0)].data(),
+           payload_size_);
+
+    for (size_t n = 1; n < code_.group_size(repair); n++) {
+        code_.add(buffer.data(), buff_tab_[code_.group_member(repair, n)].data(),
+                  payload_size_);
+    }
+
+    buff_tab_[blk_source_packets_ + repair] = buffer;
+    return buffer;
+}
+
+void ParityDecoder::report_() {
+    size_t n_lost = 0, n_repaired = 0;
+
+    for (size_t i = 0; i < buff_tab_.size(); ++i) {
+        char* status = (i < blk_source_packets_ ? &status_[i] : &status_[i + 1]);
+
+        if (buff_tab_[i]) {
+            if (recv_tab_[i]) {
+                *status = '.';
+            } else {
+                *status = 'r';
+                n_repaired++;
+                n_lost++;
+            }
+        } else {
+            if (i < blk_source_packets_) {
+                *status = 'X';
+            } else {
+                *status = 'x';
+            }
+            n_lost++;
+        }
+    }
+
+    if (n_lost == 0 || n_received_ == 0) {
+        return;
+    }
+
+    status_[blk_source_packets_] = ' ';
+    status_[status_.size() - 1] = '\0';
+
+    roc_log(LogDebug, "parity decoder: repaired %u/%u/%u %s", (unsigned)n_repaired,
+            (unsigned)n_lost, (unsigned)buff_tab_.size(), &status_[0]);
+}
+
+} // namespace fec
+} // namespace roc
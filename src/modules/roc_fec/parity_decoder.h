@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/parity_decoder.h
+//! @brief XOR parity decoder.
+
+#ifndef ROC_FEC_PARITY_DECODER_H_
+#define ROC_FEC_PARITY_DECODER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/buffer_pool.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_fec/config.h"
+#include "roc_fec/idecoder.h"
+#include "roc_fec/parity_code.h"
+
+namespace roc {
+namespace fec {
+
+//! XOR parity decoder.
+//! @remarks
+//!  Repairs packets produced by ParityEncoder. A source packet is repaired when
+//!  it's the only lost packet in a column or row which parity is received. With
+//!  two-dimensional code, repaired packets are used to repair the rest, so some
+//!  patterns with several losses in a column and a row are repaired too.
+//!  Packets restored on the way may be replaced by set() if they arrive later.
+class ParityDecoder : public IDecoder, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    explicit ParityDecoder(const Config& config,
+                           size_t payload_size,
+                           core::BufferPool<uint8_t>& buffer_pool,
+                           core::IAllocator& allocator);
+
+    //! Store source or repair packet buffer for current block.
+    virtual void set(size_t index, const core::Slice<uint8_t>& buffer);
+
+    //! Repair source packet buffer.
+    virtual core::Slice<uint8_t> repair(size_t index);
+
+    //! Reset current block.
+    virtual void reset();
+
+private:
+    void decode_(size_t index);
+
+    size_t find_lost_(size_t repair) const;
+    bool restore_(size_t index, size_t repair);
+
+    core::Slice<uint8_t> compute_repair_(size_t repair);
+
+    void report_();
+
+    const size_t blk_source_packets_;
+    const size_t blk_repair_packets_;
+    const size_t payload_size_;
+
+    ParityCode code_;
+
+    core::BufferPool<uint8_t>& buffer_pool_;
+
+    // received and repaired source and repair packets
+    core::Array<core::Slice<uint8_t> > buff_tab_;
+
+    // true if packet is received, false if it's lost or repaired
+    core::Array<bool> recv_tab_;
+
+    // for debug logging
+    core::Array<char> status_;
+
+    size_t n_received_;
+
+    // true if there are packets that were not used for decoding yet
+    bool has_new_packets_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_PARITY_DECODER_H_
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/parity_encoder.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace fec {
+
+ParityEncoder::ParityEncoder(const Config& config,
+                             size_t payload_size,
+                             core::IAllocator& allocator)
+    : blk_source_packets_(config.n_source_packets)
+    , blk_repair_packets_(config.n_repair_packets)
+    , payload_size_(payload_size)
+    , code_(config.n_source_packets, config.n_repair_packets)
+    , buff_tab_(allocator, config.n_source_packets + config.n_repair_packets) {
+    if (config.codec != XORParity) {
+        roc_panic("parity encoder: unsupported codec configuration");
+    }
+    buff_tab_.resize(buff_tab_.max_size());
+}
+
+size_t ParityEncoder::alignment() const {
+    return Alignment;
+}
+
+void ParityEncoder::set(size_t index, const core::Slice<uint8_t>& buffer) {
+    if (index >= blk_source_packets_ + blk_repair_packets_) {
+        roc_panic("parity encoder: index out of bounds: index=%lu, size=%lu",
+                  (unsigned long)index,
+                  (unsigned long)(blk_source_packets_ + blk_repair_packets_));
+    }
+
+    if (!buffer) {
+        roc_panic("parity encoder: null buffer");
+    }
+
+    if (buffer.size() != payload_size_) {
+        roc_panic("parity encoder: invalid payload size: size=%lu, expected=%lu",
+                  (unsigned long)buffer.size(), (unsigned long)payload_size_);
+    }
+
+    buff_tab_[index] = buffer;
+}
+
+void ParityEncoder::commit() {
+    for (size_t i = 0; i < blk_source_packets_; i++) {
+        if (!buff_tab_[i]) {
+            roc_panic("parity encoder: source packet is not set: index=%lu",
+                      (unsigned long)i);
+        }
+    }
+
+    for (size_t r = 0; r < blk_repair_packets_; r++) {
+        if (!buff_tab_[blk_source_packets_ + r]) {
+            continue;
+        }
+
+        uint8_t* repair = buff_tab_[blk_source_packets_ + r].data();
+
+        memcpy(repair, buff_tab_[code_.group_member(r, 0)].data(), payload_size_);
+
+        for (size_t n = 1; n < code_.group_size(r); n++) {
+            code_.add(repair, buff_tab_[code_.group_member(r, n)].data(),
+                      payload_size_);
+        }
+    }
+}
+
+void ParityEncoder::reset() {
+    for (size_t i = 0; i < buff_tab_.size(); ++i) {
+        buff_tab_[i] = core::Slice<uint8_t>();
+    }
+}
+
+} // namespace fec
+} // namespace roc
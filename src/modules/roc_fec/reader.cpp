@@ -11,6 +11,7 @@
 #include "roc_core/log.h"
 #include "roc_core/macros.h"
 #include "roc_core/panic.h"
+#include "roc_core/tracer.h"
 
 namespace roc {
 namespace fec {
@@ -43,10 +44,11 @@ Reader::Reader(const Config& config,
     , repair_reader_(repair_reader)
     , parser_(parser)
     , packet_pool_(packet_pool)
-    , source_queue_(0)
-    , repair_queue_(0)
+    , source_queue_(allocator, 0)
+    , repair_queue_(allocator, 0)
     , source_block_(allocator, config.n_source_packets)
     , repair_block_(allocator, config.n_repair_packets)
+    , repaired_block_(allocator, config.n_source_packets)
     , is_alive_(true)
     , is_started_(false)
     , can_repair_(false)
@@ -54,9 +56,17 @@ Reader::Reader(const Config& config,
     , cur_block_sn_(0)
     , has_source_(false)
     , source_(0)
-    , n_packets_(0) {
+    , n_packets_(0)
+    , n_repairs_attempted_(0)
+    , n_repairs_succeeded_(0)
+    , n_repairs_wasted_(0) {
     source_block_.resize(source_block_.max_size());
     repair_block_.resize(repair_block_.max_size());
+    repaired_block_.resize(repaired_block_.max_size());
+
+    for (size_t n = 0; n < repaired_block_.size(); n++) {
+        repaired_block_[n] = false;
+    }
 }
 
 bool Reader::is_started() const {
@@ -67,6 +77,18 @@ bool Reader::is_alive() const {
     return is_alive_;
 }
 
+size_t Reader::n_repairs_attempted() const {
+    return n_repairs_attempted_;
+}
+
+size_t Reader::n_repairs_succeeded() const {
+    return n_repairs_succeeded_;
+}
+
+size_t Reader::n_repairs_wasted() const {
+    return n_repairs_wasted_;
+}
+
 packet::PacketPtr Reader::read() {
     if (!is_alive_) {
         return NULL;
@@ -114,10 +136,11 @@ packet::PacketPtr Reader::get_next_packet_() {
 
     do {
         if (!pp) {
-            try_repair_();
-
             size_t pos;
             for (pos = next_packet_; pos < source_block_.size(); pos++) {
+                if (!source_block_[pos]) {
+                    try_repair_(pos);
+                }
                 if (source_block_[pos]) {
                     break;
                 }
@@ -155,6 +178,12 @@ void Reader::next_block_() {
         repair_block_[n] = NULL;
     }
 
+    for (size_t n = 0; n < repaired_block_.size(); n++) {
+        repaired_block_[n] = false;
+    }
+
+    decoder_.reset();
+
     cur_block_sn_ += source_block_.size();
     next_packet_ = 0;
 
@@ -162,58 +191,52 @@ void Reader::next_block_() {
     update_packets_();
 }
 
-void Reader::try_repair_() {
+// repairs only the packet at given position, which the reader is going to
+// return right now; other missing packets of the block are left alone, since
+// they may still arrive in time
+void Reader::try_repair_(size_t pos) {
     if (!can_repair_) {
         return;
     }
 
-    for (size_t n = 0; n < source_block_.size(); n++) {
-        if (!source_block_[n]) {
-            continue;
-        }
-        decoder_.set(n, source_block_[n]->fec()->payload);
-    }
+    n_repairs_attempted_++;
 
-    for (size_t n = 0; n < repair_block_.size(); n++) {
-        if (!repair_block_[n]) {
-            continue;
-        }
-        decoder_.set(source_block_.size() + n, repair_block_[n]->fec()->payload);
+    core::Slice<uint8_t> buffer = decoder_.repair(pos);
+    if (!buffer) {
+        // further attempts will fail as well until new packets arrive
+        can_repair_ = false;
+        return;
     }
 
-    for (size_t n = 0; n < source_block_.size(); n++) {
-        if (source_block_[n]) {
-            continue;
-        }
+    // decoder now holds a buffer for this position, so it shouldn't be set again
+    repaired_block_[pos] = true;
 
-        core::Slice<uint8_t> buffer = decoder_.repair(n);
-        if (!buffer) {
-            continue;
-        }
+    packet::PacketPtr pp = new (packet_pool_) packet::Packet(packet_pool_);
+    if (!pp) {
+        roc_log(LogError, "fec reader: can't allocate packet");
+        return;
+    }
 
-        packet::PacketPtr pp = new (packet_pool_) packet::Packet(packet_pool_);
-        if (!pp) {
-            roc_log(LogError, "fec reader: can't allocate packet");
-            continue;
-        }
+    if (!parser_.parse(*pp, buffer)) {
+        roc_log(LogDebug, "fec reader: can't parse repaired packet");
+        return;
+    }
 
-        if (!parser_.parse(*pp, buffer)) {
-            roc_log(LogDebug, "fec reader: can't parse repaired packet");
-            continue;
-        }
+    pp->set_data(buffer);
 
-        pp->set_data(buffer);
+    if (!check_packet_(pp, pos)) {
+        roc_log(LogDebug, "fec reader: dropping unexpected repaired packet");
+        return;
+    }
 
-        if (!check_packet_(pp, n)) {
-            roc_log(LogDebug, "fec reader: dropping unexpected repaired packet");
-            continue;
-        }
+    source_block_[pos] = pp;
 
-        source_block_[n] = pp;
-    }
+    n_repairs_succeeded_++;
 
-    decoder_.reset();
-    can_repair_ = false;
+    if (core::tracer().enabled()) {
+        pp->set_trace_id(core::tracer().new_id());
+        roc_trace("fec_repair", pp->trace_id());
+    }
 }
 
 bool Reader::check_packet_(const packet::PacketPtr& pp, size_t pos) {
@@ -309,7 +332,17 @@ void Reader::update_source_packets_() {
         if (!source_block_[p_num]) {
             can_repair_ = true;
             source_block_[p_num] = pp;
+            if (!repaired_block_[p_num]) {
+                decoder_.set(p_num, pp->fec()->payload);
+            }
+            repaired_block_[p_num] = false;
             n_added++;
+        } else if (repaired_block_[p_num]) {
+            roc_log(LogDebug, "fec reader: got source packet after repairing it:"
+                              " pkt_sn=%lu",
+                    (unsigned long)rtp->seqnum);
+            repaired_block_[p_num] = false;
+            n_repairs_wasted_++;
         }
     }
 
@@ -367,6 +400,7 @@ void Reader::update_repair_packets_() {
         if (!repair_block_[p_num]) {
             can_repair_ = true;
             repair_block_[p_num] = pp;
+            decoder_.set(source_block_.size() + p_num, pp->fec()->payload);
             n_added++;
         }
     }
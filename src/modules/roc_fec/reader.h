@@ -39,7 +39,7 @@ public:
     //!  - @p source_reader specifies input queue with data packets;
     //!  - @p repair_reader specifies input queue with FEC packets;
     //!  - @p parser specifies packet parser for restored packets.
-    //!  - @p allocator is used to initialize a packet array
+    //!  - @p allocator is used to initialize packet arrays and queues
     Reader(const Config& config,
            IDecoder& decoder,
            packet::IReader& source_reader,
@@ -50,7 +50,9 @@ public:
 
     //! Read packet.
     //! @remarks
-    //!  When a packet loss is detected, try to restore it from repair packets.
+    //!  When the next packet is missing, try to restore it from repair packets.
+    //!  Only the packet being returned is restored; other missing packets of the
+    //!  block are restored when their turn comes, if they didn't arrive by then.
     virtual packet::PacketPtr read();
 
     //! Did decoder catch block beginning?
@@ -59,12 +61,21 @@ public:
     //! Is decoder alive?
     bool is_alive() const;
 
+    //! Get number of attempts to repair a missing packet.
+    size_t n_repairs_attempted() const;
+
+    //! Get number of packets repaired successfully.
+    size_t n_repairs_succeeded() const;
+
+    //! Get number of repaired packets that were received later anyway.
+    size_t n_repairs_wasted() const;
+
 private:
     packet::PacketPtr read_();
     packet::PacketPtr get_next_packet_();
 
     void next_block_();
-    void try_repair_();
+    void try_repair_(size_t pos);
     bool check_packet_(const packet::PacketPtr&, size_t pos);
 
     void fetch_packets_();
@@ -89,6 +100,7 @@ private:
 
     core::Array<packet::PacketPtr> source_block_;
     core::Array<packet::PacketPtr> repair_block_;
+    core::Array<bool> repaired_block_;
 
     bool is_alive_;
     bool is_started_;
@@ -101,6 +113,10 @@ private:
     packet::source_t source_;
 
     unsigned n_packets_;
+
+    size_t n_repairs_attempted_;
+    size_t n_repairs_succeeded_;
+    size_t n_repairs_wasted_;
 };
 
 } // namespace fec
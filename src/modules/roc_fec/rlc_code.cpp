@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/rlc_code.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+// integer hash with good avalanche, defined only in terms of 32-bit
+// unsigned arithmetic, so that all platforms produce same coefficients
+uint32_t hash32(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+}
+
+// coefficient of source symbol j in symbol with encoding symbol ID esi;
+// coefficients are part of wire format and are pinned by tests, so this
+// function can't be changed without breaking interoperability
+uint8_t coefficient(size_t k, size_t esi, size_t j) {
+    const uint32_t key =
+        (uint32_t(esi) << 16 | uint32_t(j)) ^ hash32(uint32_t(k) * 0x9e3779b9U);
+
+    return uint8_t(1 + hash32(key) % 255);
+}
+
+} // namespace
+
+RLCCode::RLCCode(size_t n_source_symbols,
+                 size_t n_repair_symbols,
+                 core::IAllocator& allocator)
+    : n_source_(n_source_symbols)
+    , n_repair_(n_repair_symbols)
+    , matrix_(allocator, n_source_symbols * n_repair_symbols)
+    , muladd_(NULL) {
+    if (n_source_ == 0 || n_source_ + n_repair_ > MaxBlockLength) {
+        roc_panic("rlc code: invalid block size: n_source=%lu n_repair=%lu max=%lu",
+                  (unsigned long)n_source_, (unsigned long)n_repair_,
+                  (unsigned long)MaxBlockLength);
+    }
+
+    matrix_.resize(n_source_ * n_repair_);
+
+    for (size_t i = 0; i < n_repair_; i++) {
+        for (size_t j = 0; j < n_source_; j++) {
+            matrix_[i * n_source_ + j] = coefficient(n_source_, n_source_ + i, j);
+        }
+    }
+
+    const GFKernel kernel = gf_kernel_select();
+    muladd_ = gf_kernel_muladd(kernel);
+
+    roc_log(LogDebug, "rlc code: initialized: n_source=%lu n_repair=%lu kernel=%s",
+            (unsigned long)n_source_, (unsigned long)n_repair_, gf_kernel_name(kernel));
+}
+
+size_t RLCCode::n_source_symbols() const {
+    return n_source_;
+}
+
+size_t RLCCode::n_repair_symbols() const {
+    return n_repair_;
+}
+
+const uint8_t* RLCCode::row(size_t repair) const {
+    roc_panic_if(repair >= n_repair_);
+    return &matrix_[repair * n_source_];
+}
+
+void RLCCode::muladd(uint8_t* dst,
+                     const uint8_t* src,
+                     uint8_t coeff,
+                     size_t size) const {
+    muladd_(dst, src, coeff, size);
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rlc_code.h
+//! @brief Random linear code over GF(2^8).
+
+#ifndef ROC_FEC_RLC_CODE_H_
+#define ROC_FEC_RLC_CODE_H_
+
+#include "roc_core/array.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_fec/gf_kernel.h"
+
+namespace roc {
+namespace fec {
+
+//! Random linear code over GF(2^8).
+//!
+//! Systematic code where every repair symbol is a linear combination of all
+//! source symbols with pseudo-random non-zero coefficients. Coefficients are
+//! derived from the block length and symbol index only, so the encoder and
+//! the decoder build the same matrix independently.
+//!
+//! Unlike Reed-Solomon, block length is not limited by the field size, and
+//! any number of repair symbols may be generated. The code is not MDS, but
+//! k received symbols are enough to decode with probability above 99%, and
+//! every extra symbol reduces the failure probability about 256 times.
+class RLCCode : public core::NonCopyable<> {
+public:
+    enum {
+        //! Maximum number of source and repair symbols in block.
+        MaxBlockLength = 8192
+    };
+
+    //! Build encoding matrix.
+    //! @pre
+    //!  n_source_symbols + n_repair_symbols should not exceed MaxBlockLength.
+    RLCCode(size_t n_source_symbols,
+            size_t n_repair_symbols,
+            core::IAllocator& allocator);
+
+    //! Get number of source symbols in block.
+    size_t n_source_symbols() const;
+
+    //! Get number of repair symbols in block.
+    size_t n_repair_symbols() const;
+
+    //! Get encoding coefficients for repair symbol.
+    //! @remarks
+    //!  @p repair is an index of repair symbol, starting from zero.
+    //! @returns
+    //!  array of n_source_symbols() coefficients.
+    const uint8_t* row(size_t repair) const;
+
+    //! Add @p coeff * @p src to @p dst.
+    void muladd(uint8_t* dst, const uint8_t* src, uint8_t coeff, size_t size) const;
+
+private:
+    const size_t n_source_;
+    const size_t n_repair_;
+
+    core::Array<uint8_t> matrix_;
+
+    gf_muladd_func_t muladd_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RLC_CODE_H_
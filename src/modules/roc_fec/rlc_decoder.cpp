@@ -0,0 +1,387 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/rlc_decoder.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_fec/gf256.h"
+
+namespace roc {
+namespace fec {
+
+RLCDecoder::RLCDecoder(const Config& config,
+                       size_t payload_size,
+                       core::BufferPool<uint8_t>& buffer_pool,
+                       core::IAllocator& allocator)
+    : blk_source_packets_(config.n_source_packets)
+    , blk_repair_packets_(config.n_repair_packets)
+    , payload_size_(payload_size)
+    , code_(config.n_source_packets, config.n_repair_packets, allocator)
+    , buffer_pool_(buffer_pool)
+    , buff_tab_(allocator, blk_source_packets_ + blk_repair_packets_)
+    , recv_tab_(allocator, blk_source_packets_ + blk_repair_packets_)
+    , used_tab_(allocator, blk_source_packets_ + blk_repair_packets_)
+    , eq_coeffs_(allocator, blk_repair_packets_ * blk_source_packets_)
+    , eq_payload_(allocator, blk_repair_packets_)
+    , eq_pivot_(allocator, blk_repair_packets_)
+    , status_(allocator, blk_source_packets_ + blk_repair_packets_ + 2)
+    , n_received_(0)
+    , n_equations_(0)
+    , has_new_packets_(false) {
+    if (config.codec != RandomLinear) {
+        roc_panic("rlc decoder: unsupported codec configuration");
+    }
+
+    buff_tab_.resize(buff_tab_.max_size());
+    recv_tab_.resize(recv_tab_.max_size());
+    used_tab_.resize(used_tab_.max_size());
+    eq_coeffs_.resize(eq_coeffs_.max_size());
+    eq_payload_.resize(eq_payload_.max_size());
+    eq_pivot_.resize(eq_pivot_.max_size());
+    status_.resize(status_.max_size());
+
+    RLCDecoder::reset(); // non-virtual call from ctor
+}
+
+void RLCDecoder::set(size_t index, const core::Slice<uint8_t>& buffer) {
+    if (index >= blk_source_packets_ + blk_repair_packets_) {
+        roc_panic("rlc decoder: index out of bounds: index=%lu, size=%lu",
+                  (unsigned long)index,
+                  (unsigned long)(blk_source_packets_ + blk_repair_packets_));
+    }
+
+    if (!buffer) {
+        roc_panic("rlc decoder: null buffer");
+    }
+
+    if (buffer.size() != payload_size_) {
+        roc_panic("rlc decoder: invalid payload size: size=%lu, expected=%lu",
+                  (unsigned long)buffer.size(), (unsigned long)payload_size_);
+    }
+
+    // a repaired packet is replaced when its original arrives late
+    if (recv_tab_[index]) {
+        roc_panic("rlc decoder: can't overwrite buffer: index=%lu",
+                  (unsigned long)index);
+    }
+
+    buff_tab_[index] = buffer;
+    recv_tab_[index] = true;
+
+    n_received_++;
+    has_new_packets_ = true;
+}
+
+core::Slice<uint8_t> RLCDecoder::repair(size_t index) {
+    if (index >= blk_source_packets_ + blk_repair_packets_) {
+        roc_panic("rlc decoder: index out of bounds: index=%lu, size=%lu",
+                  (unsigned long)index,
+                  (unsigned long)(blk_source_packets_ + blk_repair_packets_));
+    }
+
+    if (buff_tab_[index]) {
+        return buff_tab_[index];
+    }
+
+    if (index >= blk_source_packets_) {
+        return compute_repair_(index - blk_source_packets_);
+    }
+
+    return solve_(index);
+}
+
+void RLCDecoder::reset() {
+    report_();
+
+    for (size_t i = 0; i < buff_tab_.size(); ++i) {
+        buff_tab_[i] = core::Slice<uint8_t>();
+        recv_tab_[i] = false;
+        used_tab_[i] = false;
+    }
+
+    for (size_t i = 0; i < n_equations_; ++i) {
+        eq_payload_[i] = core::Slice<uint8_t>();
+    }
+
+    n_received_ = 0;
+    n_equations_ = 0;
+    has_new_packets_ = false;
+}
+
+// accounts packets received since last call; source packets are substituted
+// first, so that new equations are built only over lost source packets
+void RLCDecoder::update_() {
+    for (size_t i = 0; i < blk_source_packets_; i++) {
+        if (recv_tab_[i] && !used_tab_[i]) {
+            substitute_(i);
+            used_tab_[i] = true;
+        }
+    }
+
+    for (size_t i = 0; i < blk_repair_packets_; i++) {
+        const size_t index = blk_source_packets_ + i;
+
+        if (recv_tab_[index] && !used_tab_[index]) {
+            used_tab_[index] = true;
+            if (!add_equation_(i)) {
+                return;
+            }
+        }
+    }
+
+    has_new_packets_ = false;
+}
+
+// removes source packet from all equations, and assigns new pivots to
+// equations that used it as a pivot
+void RLCDecoder::substitute_(size_t index) {
+    bool lost_pivot = false;
+
+    for (size_t eq = 0; eq < n_equations_; eq++) {
+        uint8_t* coeffs = coeffs_(eq);
+        if (coeffs[index] == 0) {
+            continue;
+        }
+
+        code_.muladd(eq_payload_[eq].data(), buff_tab_[index].data(), coeffs[index],
+                     payload_size_);
+        coeffs[index] = 0;
+
+        if (eq_pivot_[eq] == index) {
+            eq_pivot_[eq] = blk_source_packets_;
+            lost_pivot = true;
+        }
+    }
+
+    if (!lost_pivot) {
+        return;
+    }
+
+    for (size_t eq = 0; eq < n_equations_;) {
+        const size_t n_equations = n_equations_;
+
+        if (eq_pivot_[eq] == blk_source_packets_) {
+            pivot_(eq);
+        }
+
+        if (n_equations == n_equations_) {
+            eq++;
+        }
+    }
+}
+
+bool RLCDecoder::add_equation_(size_t repair) {
+    roc_panic_if(n_equations_ >= blk_repair_packets_);
+
+    core::Slice<uint8_t> payload = new (buffer_pool_) core::Buffer<uint8_t>(buffer_pool_);
+    if (!payload) {
+        roc_log(LogDebug, "rlc decoder: can't allocate buffer");
+        return false;
+    }
+    payload.resize(payload_size_);
+
+    memcpy(payload.data(), buff_tab_[blk_source_packets_ + repair].data(),
+           payload_size_);
+
+    const size_t eq = n_equations_++;
+
+    uint8_t* coeffs = coeffs_(eq);
+    memcpy(coeffs, code_.row(repair), blk_source_packets_);
+
+    eq_payload_[eq] = payload;
+    eq_pivot_[eq] = blk_source_packets_;
+
+    // move known source packets to the right-hand side
+    for (size_t j = 0; j < blk_source_packets_; j++) {
+        if (!used_tab_[j] || !buff_tab_[j]) {
+            continue;
+        }
+        code_.muladd(payload.data(), buff_tab_[j].data(), coeffs[j], payload_size_);
+        coeffs[j] = 0;
+    }
+
+    // eliminate pivots of other equations
+    for (size_t other = 0; other < n_equations_; other++) {
+        const size_t col = eq_pivot_[other];
+        if (other == eq || col == blk_source_packets_ || coeffs[col] == 0) {
+            continue;
+        }
+
+        const uint8_t f = gf256_mul(coeffs[col], gf256_inv(coeffs_(other)[col]));
+
+        code_.muladd(coeffs, coeffs_(other), f, blk_source_packets_);
+        code_.muladd(payload.data(), eq_payload_[other].data(), f, payload_size_);
+    }
+
+    pivot_(eq);
+
+    return true;
+}
+
+// selects pivot for equation and eliminates it from other equations;
+// removes equation if it became empty, i.e. the repair packet was redundant
+void RLCDecoder::pivot_(size_t eq) {
+    uint8_t* coeffs = coeffs_(eq);
+
+    size_t col = 0;
+    while (col < blk_source_packets_ && coeffs[col] == 0) {
+        col++;
+    }
+
+    if (col == blk_source_packets_) {
+        remove_equation_(eq);
+        return;
+    }
+
+    eq_pivot_[eq] = col;
+
+    const uint8_t inv = gf256_inv(coeffs[col]);
+
+    for (size_t other = 0; other < n_equations_; other++) {
+        uint8_t* other_coeffs = coeffs_(other);
+        if (other == eq || other_coeffs[col] == 0) {
+            continue;
+        }
+
+        const uint8_t f = gf256_mul(other_coeffs[col], inv);
+
+        code_.muladd(other_coeffs, coeffs, f, blk_source_packets_);
+        code_.muladd(eq_payload_[other].data(), eq_payload_[eq].data(), f,
+                     payload_size_);
+    }
+}
+
+void RLCDecoder::remove_equation_(size_t eq) {
+    const size_t last = n_equations_ - 1;
+
+    if (eq != last) {
+        memcpy(coeffs_(eq), coeffs_(last), blk_source_packets_);
+        eq_payload_[eq] = eq_payload_[last];
+        eq_pivot_[eq] = eq_pivot_[last];
+    }
+
+    eq_payload_[last] = core::Slice<uint8_t>();
+    n_equations_--;
+}
+
+// the packet is solved when its equation has no other unknowns
+core::Slice<uint8_t> RLCDecoder::solve_(size_t index) {
+    if (has_new_packets_) {
+        update_();
+    }
+
+    size_t eq = 0;
+    while (eq < n_equations_ && eq_pivot_[eq] != index) {
+        eq++;
+    }
+
+    if (eq == n_equations_) {
+        return core::Slice<uint8_t>();
+    }
+
+    const uint8_t* coeffs = coeffs_(eq);
+
+    for (size_t j = 0; j < blk_source_packets_; j++) {
+        if (j != index && coeffs[j] != 0) {
+            return core::Slice<uint8_t>();
+        }
+    }
+
+    core::Slice<uint8_t> buffer = eq_payload_[eq];
+
+    if (coeffs[index] != 1) {
+        buffer = new (buffer_pool_) core::Buffer<uint8_t>(buffer_pool_);
+        if (!buffer) {
+            roc_log(LogDebug, "rlc decoder: can't allocate buffer");
+            return buffer;
+        }
+        buffer.resize(payload_size_);
+
+        memset(buffer.data(), 0, payload_size_);
+        code_.muladd(buffer.data(), eq_payload_[eq].data(), gf256_inv(coeffs[index]),
+                     payload_size_);
+    }
+
+    // other equations don't depend on the packet, since it's a pivot
+    remove_equation_(eq);
+
+    buff_tab_[index] = buffer;
+    used_tab_[index] = true;
+
+    return buffer;
+}
+
+core::Slice<uint8_t> RLCDecoder::compute_repair_(size_t repair) {
+    for (size_t j = 0; j < blk_source_packets_; j++) {
+        if (!buff_tab_[j] && !solve_(j)) {
+            return core::Slice<uint8_t>();
+        }
+    }
+
+    core::Slice<uint8_t> buffer = new (buffer_pool_) core::Buffer<uint8_t>(buffer_pool_);
+    if (!buffer) {
+        roc_log(LogDebug, "rlc decoder: can't allocate buffer");
+        return buffer;
+    }
+    buffer.resize(payload_size_);
+
+    memset(buffer.data(), 0, payload_size_);
+
+    const uint8_t* coeffs = code_.row(repair);
+    for (size_t j = 0; j < blk_source_packets_; j++) {
+        code_.muladd(buffer.data(), buff_tab_[j].data(), coeffs[j], payload_size_);
+    }
+
+    buff_tab_[blk_source_packets_ + repair] = buffer;
+    used_tab_[blk_source_packets_ + repair] = true;
+
+    return buffer;
+}
+
+uint8_t* RLCDecoder::coeffs_(size_t eq) {
+    return &eq_coeffs_[eq * blk_source_packets_];
+}
+
+void RLCDecoder::report_() {
+    size_t n_lost = 0, n_repaired = 0;
+
+    for (size_t i = 0; i < buff_tab_.size(); ++i) {
+        char* status = (i < blk_source_packets_ ? &status_[i] : &status_[i + 1]);
+
+        if (buff_tab_[i]) {
+            if (recv_tab_[i]) {
+                *status = '.';
+            } else {
+                *status = 'r';
+                n_repaired++;
+                n_lost++;
+            }
+        } else {
+            if (i < blk_source_packets_) {
+                *status = 'X';
+            } else {
+                *status = 'x';
+            }
+            n_lost++;
+        }
+    }
+
+    if (n_lost == 0 || n_received_ == 0) {
+        return;
+    }
+
+    status_[blk_source_packets_] = ' ';
+    status_[status_.size() - 1] = '\0';
+
+    roc_log(LogDebug, "rlc decoder: repaired %u/%u/%u %s", (unsigned)n_repaired,
+            (unsigned)n_lost, (unsigned)buff_tab_.size(), &status_[0]);
+}
+
+} // namespace fec
+} // namespace roc
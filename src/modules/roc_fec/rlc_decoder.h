@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rlc_decoder.h
+//! @brief Random linear code decoder.
+
+#ifndef ROC_FEC_RLC_DECODER_H_
+#define ROC_FEC_RLC_DECODER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/buffer_pool.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_fec/config.h"
+#include "roc_fec/idecoder.h"
+#include "roc_fec/rlc_code.h"
+
+namespace roc {
+namespace fec {
+
+//! Random linear code decoder.
+//! @remarks
+//!  Repairs packets produced by RLCEncoder. The decoder keeps a system of
+//!  equations in reduced row echelon form. Every received repair packet adds
+//!  an equation over the lost source packets, and every received source packet
+//!  is substituted into existing equations, so the system is updated
+//!  incrementally instead of being solved from scratch for every repair.
+class RLCDecoder : public IDecoder, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    explicit RLCDecoder(const Config& config,
+                        size_t payload_size,
+                        core::BufferPool<uint8_t>& buffer_pool,
+                        core::IAllocator& allocator);
+
+    //! Store source or repair packet buffer for current block.
+    virtual void set(size_t index, const core::Slice<uint8_t>& buffer);
+
+    //! Repair source packet buffer.
+    virtual core::Slice<uint8_t> repair(size_t index);
+
+    //! Reset current block.
+    virtual void reset();
+
+private:
+    void update_();
+
+    void substitute_(size_t index);
+    bool add_equation_(size_t repair);
+    void pivot_(size_t eq);
+    void remove_equation_(size_t eq);
+
+    core::Slice<uint8_t> solve_(size_t index);
+    core::Slice<uint8_t> compute_repair_(size_t repair);
+
+    uint8_t* coeffs_(size_t eq);
+
+    void report_();
+
+    const size_t blk_source_packets_;
+    const size_t blk_repair_packets_;
+    const size_t payload_size_;
+
+    RLCCode code_;
+
+    core::BufferPool<uint8_t>& buffer_pool_;
+
+    // received and repaired source and repair packets
+    core::Array<core::Slice<uint8_t> > buff_tab_;
+
+    // true if packet is received, false if it's lost or repaired
+    core::Array<bool> recv_tab_;
+
+    // true if packet is already accounted in equations
+    core::Array<bool> used_tab_;
+
+    // equations: coefficients over source packets and right-hand side
+    core::Array<uint8_t> eq_coeffs_;
+    core::Array<core::Slice<uint8_t> > eq_payload_;
+
+    // pivot column of every equation, or n_source_packets if there is none
+    core::Array<size_t> eq_pivot_;
+
+    // for debug logging
+    core::Array<char> status_;
+
+    size_t n_received_;
+    size_t n_equations_;
+
+    // true if there are packets that were not used for decoding yet
+    bool has_new_packets_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RLC_DECODER_H_
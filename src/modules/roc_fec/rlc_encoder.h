@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rlc_encoder.h
+//! @brief Random linear code encoder.
+
+#ifndef ROC_FEC_RLC_ENCODER_H_
+#define ROC_FEC_RLC_ENCODER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_fec/config.h"
+#include "roc_fec/iencoder.h"
+#include "roc_fec/rlc_code.h"
+
+namespace roc {
+namespace fec {
+
+//! Random linear code encoder.
+//! @remarks
+//!  Every repair packet is a linear combination of all source packets of the
+//!  block over GF(2^8), with coefficients defined by RLCCode.
+class RLCEncoder : public IEncoder, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    explicit RLCEncoder(const Config& config,
+                         size_t payload_size,
+                         core::IAllocator& allocator);
+
+    //! Get buffer alignment requirement.
+    virtual size_t alignment() const;
+
+    //! Store packet data for current block.
+    virtual void set(size_t index, const core::Slice<uint8_t>& buffer);
+
+    //! Fill repair packets.
+    virtual void commit();
+
+    //! Reset current block.
+    virtual void reset();
+
+private:
+    enum { Alignment = 8 };
+
+    const size_t blk_source_packets_;
+    const size_t blk_repair_packets_;
+    const size_t payload_size_;
+
+    RLCCode code_;
+
+    core::Array<core::Slice<uint8_t> > buff_tab_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RLC_ENCODER_H_
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/rs8m_code.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_fec/gf256.h"
+
+namespace roc {
+namespace fec {
+
+RS8mCode::RS8mCode(size_t n_source_symbols,
+                   size_t n_repair_symbols,
+                   core::IAllocator& allocator)
+    : n_source_(n_source_symbols)
+    , n_repair_(n_repair_symbols)
+    , matrix_(allocator, (n_source_symbols + n_repair_symbols) * n_source_symbols)
+    , muladd_(NULL) {
+    const size_t k = n_source_;
+    const size_t n = n_source_ + n_repair_;
+
+    if (k == 0 || n > MaxBlockLength) {
+        roc_panic("rs8m code: invalid block size: n_source=%lu n_repair=%lu max=%lu",
+                  (unsigned long)n_source_, (unsigned long)n_repair_,
+                  (unsigned long)MaxBlockLength);
+    }
+
+    matrix_.resize(n * k);
+
+    // Vandermonde matrix V[i][j] = x_i ^ j, evaluated at points
+    // x_0 = 0, x_1 = alpha^0, ..., x_(n-1) = alpha^(n-2)
+    core::Array<uint8_t> vdm(allocator, n * k);
+    vdm.resize(n * k);
+
+    for (size_t j = 0; j < k; j++) {
+        vdm[j] = (j == 0);
+    }
+    for (size_t i = 1; i < n; i++) {
+        for (size_t j = 0; j < k; j++) {
+            vdm[i * k + j] = gf256_pow((i - 1) * j);
+        }
+    }
+
+    // make it systematic: E = V * inv(V_top), where V_top is the first k rows
+    core::Array<uint8_t> inv(allocator, k * k);
+    inv.resize(k * k);
+
+    if (!gf256_invert_matrix(&vdm[0], &inv[0], k)) {
+        roc_panic("rs8m code: vandermonde matrix is singular");
+    }
+
+    for (size_t i = 0; i < k; i++) {
+        for (size_t j = 0; j < k; j++) {
+            matrix_[i * k + j] = (i == j);
+        }
+    }
+    for (size_t i = k; i < n; i++) {
+        for (size_t j = 0; j < k; j++) {
+            uint8_t acc = 0;
+            for (size_t m = 0; m < k; m++) {
+                acc ^= gf256_mul(vdm[i * k + m], inv[m * k + j]);
+            }
+            matrix_[i * k + j] = acc;
+        }
+    }
+
+    const GFKernel kernel = gf_kernel_select();
+    muladd_ = gf_kernel_muladd(kernel);
+
+    roc_log(LogDebug, "rs8m code: initialized: n_source=%lu n_repair=%lu kernel=%s",
+            (unsigned long)n_source_, (unsigned long)n_repair_, gf_kernel_name(kernel));
+}
+
+size_t RS8mCode::n_source_symbols() const {
+    return n_source_;
+}
+
+size_t RS8mCode::n_repair_symbols() const {
+    return n_repair_;
+}
+
+const uint8_t* RS8mCode::row(size_t index) const {
+    roc_panic_if(index >= n_source_ + n_repair_);
+    return &matrix_[index * n_source_];
+}
+
+void RS8mCode::muladd(uint8_t* dst,
+                      const uint8_t* src,
+                      uint8_t coeff,
+                      size_t size) const {
+    muladd_(dst, src, coeff, size);
+}
+
+} // namespace fec
+} // namespace roc
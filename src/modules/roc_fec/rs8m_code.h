@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rs8m_code.h
+//! @brief Reed-Solomon code over GF(2^8).
+
+#ifndef ROC_FEC_RS8M_CODE_H_
+#define ROC_FEC_RS8M_CODE_H_
+
+#include "roc_core/array.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_fec/gf_kernel.h"
+
+namespace roc {
+namespace fec {
+
+//! Reed-Solomon code over GF(2^8).
+//!
+//! Systematic code built from a Vandermonde matrix, the same way as in
+//! RFC 5510 and in the OpenFEC "Reed-Solomon GF(2^m)" codec with m = 8, so
+//! repair symbols are interchangeable with the ones produced by OpenFEC.
+//!
+//! The encoding matrix has n = k + r rows and k columns. Row i holds the
+//! coefficients of symbol i as a linear combination of the k source symbols.
+//! The first k rows form the identity matrix.
+class RS8mCode : public core::NonCopyable<> {
+public:
+    enum {
+        //! Maximum number of source and repair symbols in block.
+        MaxBlockLength = 255
+    };
+
+    //! Build encoding matrix.
+    //! @pre
+    //!  n_source_symbols + n_repair_symbols should not exceed MaxBlockLength.
+    RS8mCode(size_t n_source_symbols,
+             size_t n_repair_symbols,
+             core::IAllocator& allocator);
+
+    //! Get number of source symbols in block.
+    size_t n_source_symbols() const;
+
+    //! Get number of repair symbols in block.
+    size_t n_repair_symbols() const;
+
+    //! Get encoding coefficients for symbol.
+    //! @returns
+    //!  array of n_source_symbols() coefficients.
+    const uint8_t* row(size_t index) const;
+
+    //! Add @p coeff * @p src to @p dst.
+    void muladd(uint8_t* dst, const uint8_t* src, uint8_t coeff, size_t size) const;
+
+private:
+    const size_t n_source_;
+    const size_t n_repair_;
+
+    core::Array<uint8_t> matrix_;
+
+    gf_muladd_func_t muladd_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RS8M_CODE_H_
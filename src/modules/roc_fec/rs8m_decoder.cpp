@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/rs8m_decoder.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_fec/gf256.h"
+
+namespace roc {
+namespace fec {
+
+RS8mDecoder::RS8mDecoder(const Config& config,
+                         size_t payload_size,
+                         core::BufferPool<uint8_t>& buffer_pool,
+                         core::IAllocator& allocator)
+    : blk_source_packets_(config.n_source_packets)
+    , blk_repair_packets_(config.n_repair_packets)
+    , payload_size_(payload_size)
+    , code_(config.n_source_packets, config.n_repair_packets, allocator)
+    , buffer_pool_(buffer_pool)
+    , buff_tab_(allocator, blk_source_packets_ + blk_repair_packets_)
+    , recv_tab_(allocator, blk_source_packets_ + blk_repair_packets_)
+    , decode_index_(allocator, blk_source_packets_)
+    , decode_matrix_(allocator, blk_source_packets_ * blk_source_packets_)
+    , temp_matrix_(allocator, blk_source_packets_ * blk_source_packets_)
+    , coeffs_(allocator, blk_source_packets_)
+    , status_(allocator, blk_source_packets_ + blk_repair_packets_ + 2)
+    , n_received_(0)
+    , has_matrix_(false) {
+    if (config.codec != ReedSolomon8m || config.rs_m != 8) {
+        roc_panic("rs8m decoder: unsupported codec configuration");
+    }
+
+    buff_tab_.resize(buff_tab_.max_size());
+    recv_tab_.resize(recv_tab_.max_size());
+    decode_index_.resize(decode_index_.max_size());
+    decode_matrix_.resize(decode_matrix_.max_size());
+    temp_matrix_.resize(temp_matrix_.max_size());
+    coeffs_.resize(coeffs_.max_size());
+    status_.resize(status_.max_size());
+
+    RS8mDecoder::reset(); // non-virtual call from ctor
+}
+
+void RS8mDecoder::set(size_t index, const core::Slice<uint8_t>& buffer) {
+    if (index >= blk_source_packets_ + blk_repair_packets_) {
+        roc_panic("rs8m decoder: index out of bounds: index=%lu, size=%lu",
+                  (unsigned long)index,
+                  (unsigned long)(blk_source_packets_ + blk_repair_packets_));
+    }
+
+    if (!buffer) {
+        roc_panic("rs8m decoder: null buffer");
+    }
+
+    if (buffer.size() != payload_size_) {
+        roc_panic("rs8m decoder: invalid payload size: size=%lu, expected=%lu",
+                  (unsigned long)buffer.size(), (unsigned long)payload_size_);
+    }
+
+    // a repaired packet is replaced when its original arrives late
+    if (recv_tab_[index]) {
+        roc_panic("rs8m decoder: can't overwrite buffer: index=%lu",
+                  (unsigned long)index);
+    }
+
+    buff_tab_[index] = buffer;
+    recv_tab_[index] = true;
+
+    n_received_++;
+}
+
+core::Slice<uint8_t> RS8mDecoder::repair(size_t index) {
+    if (index >= blk_source_packets_ + blk_repair_packets_) {
+        roc_panic("rs8m decoder: index out of bounds: index=%lu, size=%lu",
+                  (unsigned long)index,
+                  (unsigned long)(blk_source_packets_ + blk_repair_packets_));
+    }
+
+    if (buff_tab_[index]) {
+        return buff_tab_[index];
+    }
+
+    const size_t single_repair = find_single_loss_repair_(index);
+
+    if (!single_repair && !has_matrix_ && !prepare_()) {
+        return core::Slice<uint8_t>();
+    }
+
+    core::Slice<uint8_t> buffer = new (buffer_pool_) core::Buffer<uint8_t>(buffer_pool_);
+    if (!buffer) {
+        roc_log(LogDebug, "rs8m decoder: can't allocate buffer");
+        return buffer;
+    }
+    buffer.resize(payload_size_);
+
+    if (single_repair) {
+        repair_single_loss_(index, single_repair, buffer.data());
+        buff_tab_[index] = buffer;
+        return buffer;
+    }
+
+    // symbol = row(index) * source = row(index) * decode_matrix * received
+    const size_t k = blk_source_packets_;
+    const uint8_t* row = code_.row(index);
+
+    for (size_t j = 0; j < k; j++) {
+        uint8_t c = 0;
+        for (size_t m = 0; m < k; m++) {
+            c ^= gf256_mul(row[m], decode_matrix_[m * k + j]);
+        }
+        coeffs_[j] = c;
+    }
+
+    memset(buffer.data(), 0, payload_size_);
+
+    for (size_t j = 0; j < k; j++) {
+        code_.muladd(buffer.data(), buff_tab_[decode_index_[j]].data(), coeffs_[j],
+                     payload_size_);
+    }
+
+    buff_tab_[index] = buffer;
+    return buffer;
+}
+
+void RS8mDecoder::reset() {
+    report_();
+
+    for (size_t i = 0; i < buff_tab_.size(); ++i) {
+        buff_tab_[i] = core::Slice<uint8_t>();
+        recv_tab_[i] = false;
+    }
+
+    n_received_ = 0;
+    has_matrix_ = false;
+}
+
+// if the requested source packet is the only one missing in the block, returns
+// index of a received repair packet which alone is enough to recover it, or 0
+size_t RS8mDecoder::find_single_loss_repair_(size_t index) const {
+    if (index >= blk_source_packets_) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < blk_source_packets_; i++) {
+        if (i != index && !buff_tab_[i]) {
+            return 0;
+        }
+    }
+
+    for (size_t i = blk_source_packets_; i < buff_tab_.size(); i++) {
+        if (recv_tab_[i]) {
+            return i;
+        }
+    }
+
+    return 0;
+}
+
+// repair = sum(row[j] * source[j]), hence the lost symbol is
+// source[index] = (repair + sum(row[j] * source[j], j != index)) / row[index];
+// no matrix inversion is needed, and for unit coefficients it's a plain XOR
+void RS8mDecoder::repair_single_loss_(size_t index,
+                                      size_t repair_index,
+                                      uint8_t* data) {
+    const uint8_t* row = code_.row(repair_index);
+    const uint8_t inv = gf256_inv(row[index]);
+
+    memset(data, 0, payload_size_);
+
+    code_.muladd(data, buff_tab_[repair_index].data(), inv, payload_size_);
+
+    for (size_t j = 0; j < blk_source_packets_; j++) {
+        if (j == index) {
+            continue;
+        }
+        code_.muladd(data, buff_tab_[j].data(), gf256_mul(row[j], inv), payload_size_);
+    }
+}
+
+// selects n_source_packets received packets, preferring source packets since
+// their rows are trivial, and inverts the corresponding encoding submatrix
+bool RS8mDecoder::prepare_() {
+    const size_t k = blk_source_packets_;
+
+    if (n_received_ < k) {
+        return false;
+    }
+
+    size_t n = 0;
+    for (size_t i = 0; i < blk_source_packets_ + blk_repair_packets_ && n < k; i++) {
+        if (!recv_tab_[i]) {
+            continue;
+        }
+        decode_index_[n] = i;
+        memcpy(&temp_matrix_[n * k], code_.row(i), k);
+        n++;
+    }
+
+    if (!gf256_invert_matrix(&temp_matrix_[0], &decode_matrix_[0], k)) {
+        roc_log(LogError, "rs8m decoder: decoding matrix is singular");
+        return false;
+    }
+
+    has_matrix_ = true;
+    return true;
+}
+
+void RS8mDecoder::report_() {
+    size_t n_lost = 0, n_repaired = 0;
+
+    for (size_t i = 0; i < buff_tab_.size(); ++i) {
+        char* status = (i < blk_source_packets_ ? &status_[i] : &status_[i + 1]);
+
+        if (buff_tab_[i]) {
+            if (recv_tab_[i]) {
+                *status = '.';
+            } else {
+                *status = 'r';
+                n_repaired++;
+                n_lost++;
+            }
+        } else {
+            if (i < blk_source_packets_) {
+                *status = 'X';
+            } else {
+                *status = 'x';
+            }
+            n_lost++;
+        }
+    }
+
+    if (n_lost == 0 || n_received_ == 0) {
+        return;
+    }
+
+    status_[blk_source_packets_] = ' ';
+    status_[status_.size() - 1] = '\0';
+
+    roc_log(LogDebug, "rs8m decoder: repaired %u/%u/%u %s", (unsigned)n_repaired,
+            (unsigned)n_lost, (unsigned)buff_tab_.size(), &status_[0]);
+}
+
+} // namespace fec
+} // namespace roc
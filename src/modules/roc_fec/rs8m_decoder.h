@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rs8m_decoder.h
+//! @brief Reed-Solomon GF(2^8) decoder.
+
+#ifndef ROC_FEC_RS8M_DECODER_H_
+#define ROC_FEC_RS8M_DECODER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/buffer_pool.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_fec/config.h"
+#include "roc_fec/idecoder.h"
+#include "roc_fec/rs8m_code.h"
+
+namespace roc {
+namespace fec {
+
+//! Reed-Solomon GF(2^8) decoder.
+//! @remarks
+//!  Repairs packets produced by RS8mEncoder or by OpenFEC Reed-Solomon encoder
+//!  with m = 8. Any n_source_packets of the block are enough to repair the rest.
+//!  When only one source packet of the block is lost, it is recovered from a
+//!  single repair packet without inverting the decoding matrix.
+class RS8mDecoder : public IDecoder, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    explicit RS8mDecoder(const Config& config,
+                         size_t payload_size,
+                         core::BufferPool<uint8_t>& buffer_pool,
+                         core::IAllocator& allocator);
+
+    //! Store source or repair packet buffer for current block.
+    virtual void set(size_t index, const core::Slice<uint8_t>& buffer);
+
+    //! Repair source packet buffer.
+    virtual core::Slice<uint8_t> repair(size_t index);
+
+    //! Reset current block.
+    virtual void reset();
+
+private:
+    size_t find_single_loss_repair_(size_t index) const;
+    void repair_single_loss_(size_t index, size_t repair_index, uint8_t* data);
+
+    bool prepare_();
+    void report_();
+
+    const size_t blk_source_packets_;
+    const size_t blk_repair_packets_;
+    const size_t payload_size_;
+
+    RS8mCode code_;
+
+    core::BufferPool<uint8_t>& buffer_pool_;
+
+    // received and repaired source and repair packets
+    core::Array<core::Slice<uint8_t> > buff_tab_;
+
+    // true if packet is received, false if it's is lost or repaired
+    core::Array<bool> recv_tab_;
+
+    // indices of n_source_packets received packets used for decoding
+    core::Array<size_t> decode_index_;
+
+    // inverted encoding matrix rows of packets from decode_index_
+    core::Array<uint8_t> decode_matrix_;
+
+    // temporary storage for matrix inversion and coefficients
+    core::Array<uint8_t> temp_matrix_;
+    core::Array<uint8_t> coeffs_;
+
+    // for debug logging
+    core::Array<char> status_;
+
+    size_t n_received_;
+    bool has_matrix_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RS8M_DECODER_H_
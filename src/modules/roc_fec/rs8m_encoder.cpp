@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/rs8m_encoder.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace fec {
+
+RS8mEncoder::RS8mEncoder(const Config& config,
+                         size_t payload_size,
+                         core::IAllocator& allocator)
+    : blk_source_packets_(config.n_source_packets)
+    , blk_repair_packets_(config.n_repair_packets)
+    , payload_size_(payload_size)
+    , code_(config.n_source_packets, config.n_repair_packets, allocator)
+    , buff_tab_(allocator, config.n_source_packets + config.n_repair_packets) {
+    if (config.codec != ReedSolomon8m || config.rs_m != 8) {
+        roc_panic("rs8m encoder: unsupported codec configuration");
+    }
+    buff_tab_.resize(buff_tab_.max_size());
+}
+
+size_t RS8mEncoder::alignment() const {
+    return Alignment;
+}
+
+void RS8mEncoder::set(size_t index, const core::Slice<uint8_t>& buffer) {
+    if (index >= blk_source_packets_ + blk_repair_packets_) {
+        roc_panic("rs8m encoder: index out of bounds: index=%lu, size=%lu",
+                  (unsigned long)index,
+                  (unsigned long)(blk_source_packets_ + blk_repair_packets_));
+    }
+
+    if (!buffer) {
+        roc_panic("rs8m encoder: null buffer");
+    }
+
+    if (buffer.size() != payload_size_) {
+        roc_panic("rs8m encoder: invalid payload size: size=%lu, expected=%lu",
+                  (unsigned long)buffer.size(), (unsigned long)payload_size_);
+    }
+
+    buff_tab_[index] = buffer;
+}
+
+void RS8mEncoder::commit() {
+    for (size_t i = 0; i < blk_source_packets_; i++) {
+        if (!buff_tab_[i]) {
+            roc_panic("rs8m encoder: source packet is not set: index=%lu",
+                      (unsigned long)i);
+        }
+    }
+
+    for (size_t i = blk_source_packets_; i < blk_source_packets_ + blk_repair_packets_;
+         i++) {
+        if (!buff_tab_[i]) {
+            continue;
+        }
+
+        uint8_t* repair = buff_tab_[i].data();
+        const uint8_t* coeffs = code_.row(i);
+
+        memset(repair, 0, payload_size_);
+
+        for (size_t j = 0; j < blk_source_packets_; j++) {
+            code_.muladd(repair, buff_tab_[j].data(), coeffs[j], payload_size_);
+        }
+    }
+}
+
+void RS8mEncoder::reset() {
+    for (size_t i = 0; i < buff_tab_.size(); ++i) {
+        buff_tab_[i] = core::Slice<uint8_t>();
+    }
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rs8m_encoder.h
+//! @brief Reed-Solomon GF(2^8) encoder.
+
+#ifndef ROC_FEC_RS8M_ENCODER_H_
+#define ROC_FEC_RS8M_ENCODER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_fec/config.h"
+#include "roc_fec/iencoder.h"
+#include "roc_fec/rs8m_code.h"
+
+namespace roc {
+namespace fec {
+
+//! Reed-Solomon GF(2^8) encoder.
+//! @remarks
+//!  Produces the same repair packets as OpenFEC Reed-Solomon encoder with m = 8,
+//!  but doesn't require OpenFEC.
+class RS8mEncoder : public IEncoder, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    explicit RS8mEncoder(const Config& config,
+                         size_t payload_size,
+                         core::IAllocator& allocator);
+
+    //! Get buffer alignment requirement.
+    virtual size_t alignment() const;
+
+    //! Store packet data for current block.
+    virtual void set(size_t index, const core::Slice<uint8_t>& buffer);
+
+    //! Fill repair packets.
+    virtual void commit();
+
+    //! Reset current block.
+    virtual void reset();
+
+private:
+    enum { Alignment = 8 };
+
+    const size_t blk_source_packets_;
+    const size_t blk_repair_packets_;
+    const size_t payload_size_;
+
+    RS8mCode code_;
+
+    core::Array<core::Slice<uint8_t> > buff_tab_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RS8M_ENCODER_H_
@@ -89,39 +89,33 @@ void OFDecoder::set(size_t index, const core::Slice<uint8_t>& buffer) {
                   (unsigned long)buffer.size(), (unsigned long)payload_size_);
     }
 
-    if (buff_tab_[index]) {
+    // every decoding pass restores all source packets it can, not only the
+    // requested one, so a restored packet may be replaced by its late original
+    if (recv_tab_[index]) {
         roc_panic("of decoder: can't overwrite buffer: index=%lu", (unsigned long)index);
     }
 
-    has_new_packets_ = true;
+    if (!buff_tab_[index]) {
+        has_new_packets_ = true;
+    }
 
     buff_tab_[index] = buffer;
     data_tab_[index] = buffer.data();
     recv_tab_[index] = true;
-
-    // register new packet and try to repair more packets
-    if (of_decode_with_new_symbol(of_sess_, data_tab_[index], (unsigned int)index)
-        != OF_STATUS_OK) {
-        roc_panic("of decoder: can't add packet to OF session");
-    }
 }
 
 core::Slice<uint8_t> OFDecoder::repair(size_t index) {
     if (!buff_tab_[index]) {
         update_();
-        fix_buffer_(index);
     }
     return buff_tab_[index];
 }
 
 void OFDecoder::reset() {
-    if (of_sess_ != NULL) {
+    if (has_n_packets_(1)) {
         report_();
-        destroy_session_();
     }
 
-    reset_session_();
-
     has_new_packets_ = false;
     decoding_finished_ = false;
 
@@ -133,41 +127,46 @@ void OFDecoder::reset() {
 }
 
 void OFDecoder::update_() {
-    roc_panic_if(of_sess_ == NULL);
-
     if (!has_new_packets_) {
         return;
     }
 
-    decode_();
-
-    of_get_source_symbols_tab(of_sess_, &data_tab_[0]);
-
-    has_new_packets_ = false;
-}
-
-void OFDecoder::decode_() {
     if (decoding_finished_ && is_optimal_()) {
         return;
     }
 
+    // don't bother OpenFEC until there is a chance to repair something
     if (!has_n_packets_(blk_source_packets_)) {
         return;
     }
 
-    if (decoding_finished_) {
-        // it's not allowed to decode twice, so we recrate the session
-        reset_session_();
+    has_new_packets_ = false;
 
-        if (of_set_available_symbols(of_sess_, &data_tab_[0]) != OF_STATUS_OK) {
-            roc_panic("of decoder: can't add packets to OF session");
-        }
+    decode_();
+}
+
+// OpenFEC doesn't allow to decode twice or to reuse a session for another
+// block, so the session lives only during one decoding pass; all received
+// packets are passed at once, and all repaired packets are moved to buffers
+// from our pool before the session is released
+void OFDecoder::decode_() {
+    create_session_();
+
+    if (of_set_available_symbols(of_sess_, &data_tab_[0]) != OF_STATUS_OK) {
+        roc_panic("of decoder: can't add packets to OF session");
     }
 
-    // try to repair more packets
     if (of_finish_decoding(of_sess_) == OF_STATUS_OK) {
         decoding_finished_ = true;
     }
+
+    of_get_source_symbols_tab(of_sess_, &data_tab_[0]);
+
+    for (size_t i = 0; i < blk_source_packets_; i++) {
+        fix_buffer_(i);
+    }
+
+    destroy_session_();
 }
 
 // note: we have to calculate this every time because OpenFEC
@@ -194,11 +193,8 @@ bool OFDecoder::is_optimal_() const {
     return codec_id_ == OF_CODEC_REED_SOLOMON_GF_2_M_STABLE;
 }
 
-void OFDecoder::reset_session_() {
-    if (of_sess_ != NULL) {
-        of_release_codec_instance(of_sess_);
-        of_sess_ = NULL;
-    }
+void OFDecoder::create_session_() {
+    roc_panic_if(of_sess_ != NULL);
 
     if (OF_STATUS_OK != of_create_codec_instance(&of_sess_, codec_id_, OF_DECODER, 0)) {
         roc_panic("of decoder: of_create_codec_instance() failed");
@@ -235,7 +231,7 @@ void OFDecoder::destroy_session_() {
             continue;
         }
         of_free(data_tab_[i]);
-        data_tab_[i] = NULL;
+        data_tab_[i] = buff_tab_[i] ? buff_tab_[i].data() : NULL;
     }
 }
 
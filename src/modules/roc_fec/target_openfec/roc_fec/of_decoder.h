@@ -64,7 +64,7 @@ private:
     bool has_n_packets_(size_t n_packets) const;
     bool is_optimal_() const;
 
-    void reset_session_();
+    void create_session_();
     void destroy_session_();
 
     void report_();
@@ -85,7 +85,7 @@ private:
         of_ldpc_parameters ldpc_params_;
     } codec_params_;
 
-    // session is recreated for every new block
+    // session exists only during decoding pass
     of_session_t* of_sess_;
     of_parameters_t* of_sess_params_;
 
@@ -95,7 +95,8 @@ private:
     core::Array<core::Slice<uint8_t> > buff_tab_;
 
     // data of received and repaired source and repair packets
-    // points to buff_tab_[x].data() or to memory allocated by OpenFEC
+    // points to buff_tab_[x].data(), or, during decoding pass, to memory
+    // allocated by OpenFEC
     core::Array<void*> data_tab_;
 
     // true if packet is received, false if it's is lost or repaired
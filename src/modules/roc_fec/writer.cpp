@@ -15,6 +15,95 @@
 namespace roc {
 namespace fec {
 
+Writer::Worker::Worker(Writer& writer, size_t max_blocks, core::IAllocator& allocator)
+    : writer_(writer)
+    , block_size_(writer.n_source_packets_)
+    , blocks_(allocator, max_blocks)
+    , buffers_(allocator, max_blocks * writer.n_source_packets_)
+    , head_(0)
+    , size_(0)
+    , sem_(0) {
+    blocks_.resize(blocks_.max_size());
+    buffers_.resize(buffers_.max_size());
+}
+
+size_t Writer::Worker::push(const core::Slice<uint8_t>* buffers,
+                            packet::seqnum_t source_sn,
+                            packet::seqnum_t repair_sn) {
+    size_t n_blocks;
+
+    {
+        core::Mutex::Lock lock(mutex_);
+
+        if (size_ == blocks_.size()) {
+            return 0;
+        }
+
+        // the slot is not accessed by the worker until size_ is incremented
+        const size_t tail = (head_ + size_) % blocks_.size();
+
+        blocks_[tail].source_sn = source_sn;
+        blocks_[tail].repair_sn = repair_sn;
+
+        for (size_t n = 0; n < block_size_; n++) {
+            buffers_[tail * block_size_ + n] = buffers[n];
+        }
+
+        n_blocks = ++size_;
+    }
+
+    sem_.post();
+
+    return n_blocks;
+}
+
+void Writer::Worker::stop() {
+    stop_ = true;
+    sem_.post();
+    join();
+}
+
+void Writer::Worker::run() {
+    roc_log(LogDebug, "fec writer: starting encoding thread");
+
+    for (;;) {
+        sem_.pend();
+
+        if (stop_) {
+            break;
+        }
+
+        size_t head;
+        Block block;
+
+        {
+            core::Mutex::Lock lock(mutex_);
+
+            roc_panic_if(size_ == 0);
+
+            head = head_;
+            block = blocks_[head];
+        }
+
+        // the slot stays occupied while it's being encoded
+        writer_.encode_block_(&buffers_[head * block_size_], block.source_sn,
+                              block.repair_sn, writer_.ready_queue_);
+
+        {
+            core::Mutex::Lock lock(mutex_);
+
+            for (size_t n = 0; n < block_size_; n++) {
+                buffers_[head * block_size_ + n] = core::Slice<uint8_t>();
+            }
+
+            head_ = (head_ + 1) % blocks_.size();
+            size_--;
+        }
+    }
+
+    roc_log(LogDebug, "fec writer: stopping encoding thread");
+}
+
 Writer::Writer(const Config& config,
                size_t payload_size,
                IEncoder& encoder,
@@ -33,15 +122,60 @@ Writer::Writer(const Config& config,
     , repair_composer_(repair_composer)
     , packet_pool_(packet_pool)
     , buffer_pool_(buffer_pool)
+    , allocator_(allocator)
+    , source_buffers_(allocator, config.n_source_packets)
     , repair_packets_(allocator, config.n_repair_packets)
+    , worker_(NULL)
+    , ready_queue_(0, false)
     , source_(0)
     , first_packet_(true)
     , cur_block_source_sn_(0)
     , cur_block_repair_sn_((packet::seqnum_t)core::random(packet::seqnum_t(-1)))
     , cur_packet_(0) {
+    source_buffers_.resize(n_source_packets_);
     repair_packets_.resize(n_repair_packets_);
 }
 
+Writer::~Writer() {
+    if (!worker_) {
+        return;
+    }
+
+    worker_->stop();
+    allocator_.destroy(*worker_);
+
+    roc_log(LogDebug,
+            "fec writer: encoding thread stats: encoded=%lu dropped=%lu max_queued=%lu",
+            (unsigned long)n_blocks_encoded(), (unsigned long)n_blocks_dropped(),
+            (unsigned long)max_queued_blocks());
+}
+
+bool Writer::start_encoding_thread(size_t max_blocks) {
+    roc_panic_if(worker_);
+    roc_panic_if(max_blocks == 0);
+
+    worker_ = new (allocator_) Worker(*this, max_blocks, allocator_);
+    if (!worker_) {
+        roc_log(LogError, "fec writer: can't allocate encoding thread");
+        return false;
+    }
+
+    worker_->start();
+    return true;
+}
+
+size_t Writer::n_blocks_encoded() const {
+    return (size_t)(long)n_blocks_encoded_;
+}
+
+size_t Writer::n_blocks_dropped() const {
+    return (size_t)(long)n_blocks_dropped_;
+}
+
+size_t Writer::max_queued_blocks() const {
+    return (size_t)(long)max_queued_blocks_;
+}
+
 void Writer::write(const packet::PacketPtr& pp) {
     roc_panic_if_not(pp);
 
@@ -73,38 +207,87 @@ void Writer::write(const packet::PacketPtr& pp) {
 
     writer_.write(pp);
 
-    encoder_.set(cur_packet_, pp->fec()->payload);
+    source_buffers_[cur_packet_] = pp->fec()->payload;
     cur_packet_++;
 
     if (cur_packet_ == n_source_packets_) {
-        for (packet::seqnum_t i = 0; i < n_repair_packets_; i++) {
-            packet::PacketPtr rp = make_repair_packet_(i);
-            if (!rp) {
-                roc_log(LogDebug, "fec writer: can't create repair packet");
-                continue;
-            }
-            repair_packets_[i] = rp;
-            encoder_.set(cur_packet_ + i, rp->fec()->payload);
+        end_block_();
+    }
+
+    if (worker_) {
+        write_ready_packets_();
+    }
+}
+
+void Writer::end_block_() {
+    if (worker_) {
+        const size_t n_blocks = worker_->push(&source_buffers_[0], cur_block_source_sn_,
+                                              cur_block_repair_sn_);
+
+        if (n_blocks == 0) {
+            roc_log(LogDebug, "fec writer: encoding queue is full, dropping block:"
+                              " blk_sn=%lu",
+                    (unsigned long)cur_block_source_sn_);
+            ++n_blocks_dropped_;
+        } else if (n_blocks > max_queued_blocks()) {
+            max_queued_blocks_.store((long)n_blocks);
         }
+    } else {
+        encode_block_(&source_buffers_[0], cur_block_source_sn_, cur_block_repair_sn_,
+                      writer_);
+    }
 
-        encoder_.commit();
+    for (size_t i = 0; i < n_source_packets_; i++) {
+        source_buffers_[i] = core::Slice<uint8_t>();
+    }
 
-        for (packet::seqnum_t i = 0; i < n_repair_packets_; i++) {
-            packet::PacketPtr rp = repair_packets_[i];
-            if (rp) {
-                writer_.write(repair_packets_[i]);
-                repair_packets_[i] = NULL;
-            }
+    cur_block_repair_sn_ += n_repair_packets_;
+    cur_packet_ = 0;
+}
+
+// invoked either from write() or from the encoding thread, but never from both
+void Writer::encode_block_(const core::Slice<uint8_t>* source_buffers,
+                           packet::seqnum_t source_sn,
+                           packet::seqnum_t repair_sn,
+                           packet::IWriter& writer) {
+    for (size_t i = 0; i < n_source_packets_; i++) {
+        encoder_.set(i, source_buffers[i]);
+    }
+
+    for (packet::seqnum_t i = 0; i < n_repair_packets_; i++) {
+        packet::PacketPtr rp = make_repair_packet_(source_sn, repair_sn, i);
+        if (!rp) {
+            roc_log(LogDebug, "fec writer: can't create repair packet");
+            continue;
         }
+        repair_packets_[i] = rp;
+        encoder_.set(n_source_packets_ + i, rp->fec()->payload);
+    }
 
-        encoder_.reset();
+    encoder_.commit();
+
+    for (packet::seqnum_t i = 0; i < n_repair_packets_; i++) {
+        packet::PacketPtr rp = repair_packets_[i];
+        if (rp) {
+            writer.write(repair_packets_[i]);
+            repair_packets_[i] = NULL;
+        }
+    }
+
+    encoder_.reset();
+
+    ++n_blocks_encoded_;
+}
 
-        cur_block_repair_sn_ += n_repair_packets_;
-        cur_packet_ = 0;
+void Writer::write_ready_packets_() {
+    while (packet::PacketPtr rp = ready_queue_.read()) {
+        writer_.write(rp);
     }
 }
 
-packet::PacketPtr Writer::make_repair_packet_(packet::seqnum_t n) {
+packet::PacketPtr Writer::make_repair_packet_(packet::seqnum_t source_sn,
+                                              packet::seqnum_t repair_sn,
+                                              packet::seqnum_t n) {
     packet::PacketPtr packet = new (packet_pool_) packet::Packet(packet_pool_);
     if (!packet) {
         roc_log(LogError, "fec writer: can't allocate packet");
@@ -140,14 +323,14 @@ packet::PacketPtr Writer::make_repair_packet_(packet::seqnum_t n) {
     packet::RTP& rtp = *packet->rtp();
 
     rtp.source = source_;
-    rtp.seqnum = cur_block_repair_sn_ + n;
+    rtp.seqnum = repair_sn + n;
     rtp.marker = (n == 0);
     rtp.payload_type = 123;
 
     packet::FEC& fec = *packet->fec();
 
-    fec.source_blknum = cur_block_source_sn_;
-    fec.repair_blknum = cur_block_repair_sn_;
+    fec.source_blknum = source_sn;
+    fec.repair_blknum = repair_sn;
 
     return packet;
 }
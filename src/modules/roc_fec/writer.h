@@ -14,12 +14,17 @@
 #define ROC_FEC_WRITER_H_
 
 #include "roc_core/array.h"
+#include "roc_core/atomic.h"
 #include "roc_core/buffer_pool.h"
 #include "roc_core/iallocator.h"
+#include "roc_core/mutex.h"
 #include "roc_core/noncopyable.h"
+#include "roc_core/semaphore.h"
 #include "roc_core/slice.h"
+#include "roc_core/thread.h"
 #include "roc_fec/config.h"
 #include "roc_fec/iencoder.h"
+#include "roc_packet/concurrent_queue.h"
 #include "roc_packet/icomposer.h"
 #include "roc_packet/iwriter.h"
 #include "roc_packet/packet.h"
@@ -29,6 +34,13 @@ namespace roc {
 namespace fec {
 
 //! FEC writer.
+//!
+//! @remarks
+//!  By default, when a block is completed, repair packets are built and written
+//!  by the thread that calls write(). If the encoding thread is started, completed
+//!  blocks are instead passed to a background thread through a bounded queue, and
+//!  write() forwards repair packets that are already built, so that source packets
+//!  are never delayed by encoding.
 class Writer : public packet::IWriter, public core::NonCopyable<> {
 public:
     //! Initialize.
@@ -52,18 +64,86 @@ public:
            core::BufferPool<uint8_t>& buffer_pool,
            core::IAllocator& allocator);
 
+    ~Writer();
+
+    //! Start encoding thread.
+    //! @remarks
+    //!  At most @p max_blocks completed blocks may wait for encoding. If the queue
+    //!  is full, no repair packets are generated for the next completed block.
+    //!  Should be called before the first write().
+    //! @returns
+    //!  false if allocation failed.
+    bool start_encoding_thread(size_t max_blocks);
+
     //! Write packet.
     //! @remarks
     //!  - writes the given source packet to the output writer
-    //!  - generates repair packets and also writes them to the output writer
+    //!  - generates repair packets and also writes them to the output writer;
+    //!    if the encoding thread is started, repair packets are written by one of
+    //!    the subsequent calls, when they are ready
     virtual void write(const packet::PacketPtr&);
 
+    //! Get number of blocks for which repair packets were generated.
+    size_t n_blocks_encoded() const;
+
+    //! Get number of blocks dropped because the encoding queue was full.
+    size_t n_blocks_dropped() const;
+
+    //! Get maximum number of blocks that were waiting in the encoding queue.
+    size_t max_queued_blocks() const;
+
 private:
+    class Worker : public core::Thread {
+    public:
+        Worker(Writer& writer, size_t max_blocks, core::IAllocator& allocator);
+
+        // returns number of queued blocks including the new one,
+        // or zero if the queue is full
+        size_t push(const core::Slice<uint8_t>* buffers,
+                    packet::seqnum_t source_sn,
+                    packet::seqnum_t repair_sn);
+
+        void stop();
+
+    private:
+        struct Block {
+            packet::seqnum_t source_sn;
+            packet::seqnum_t repair_sn;
+        };
+
+        virtual void run();
+
+        Writer& writer_;
+
+        const size_t block_size_;
+
+        core::Array<Block> blocks_;
+        core::Array<core::Slice<uint8_t> > buffers_;
+
+        size_t head_;
+        size_t size_;
+
+        core::Mutex mutex_;
+        core::Semaphore sem_;
+        core::Atomic stop_;
+    };
+
     const size_t n_source_packets_;
     const size_t n_repair_packets_;
     const size_t payload_size_;
 
-    packet::PacketPtr make_repair_packet_(packet::seqnum_t n);
+    void end_block_();
+
+    void encode_block_(const core::Slice<uint8_t>* source_buffers,
+                       packet::seqnum_t source_sn,
+                       packet::seqnum_t repair_sn,
+                       packet::IWriter& writer);
+
+    void write_ready_packets_();
+
+    packet::PacketPtr make_repair_packet_(packet::seqnum_t source_sn,
+                                          packet::seqnum_t repair_sn,
+                                          packet::seqnum_t n);
 
     IEncoder& encoder_;
     packet::IWriter& writer_;
@@ -73,9 +153,18 @@ private:
 
     packet::PacketPool& packet_pool_;
     core::BufferPool<uint8_t>& buffer_pool_;
+    core::IAllocator& allocator_;
 
+    core::Array<core::Slice<uint8_t> > source_buffers_;
     core::Array<packet::PacketPtr> repair_packets_;
 
+    Worker* worker_;
+    packet::ConcurrentQueue ready_queue_;
+
+    core::Atomic n_blocks_encoded_;
+    core::Atomic n_blocks_dropped_;
+    core::Atomic max_queued_blocks_;
+
     packet::source_t source_;
     bool first_packet_;
 
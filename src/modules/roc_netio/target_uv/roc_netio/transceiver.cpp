@@ -71,6 +71,12 @@ bool Transceiver::valid() const {
 
 bool Transceiver::add_udp_receiver(packet::Address& bind_address,
                                    packet::IWriter& writer) {
+    return add_udp_receiver(bind_address, UDPReceiverConfig(), writer) != NULL;
+}
+
+UDPReceiver* Transceiver::add_udp_receiver(packet::Address& bind_address,
+                                           const UDPReceiverConfig& config,
+                                           packet::IWriter& writer) {
     if (joinable()) {
         roc_panic("transceiver: can't call add_udp_receiver() when thread is running");
     }
@@ -80,23 +86,28 @@ bool Transceiver::add_udp_receiver(packet::Address& bind_address,
     }
 
     core::SharedPtr<UDPReceiver> rp = new (allocator_)
-        UDPReceiver(loop_, writer, packet_pool_, buffer_pool_, allocator_);
+        UDPReceiver(loop_, config, writer, packet_pool_, buffer_pool_, allocator_);
 
     if (!rp) {
         roc_log(LogError, "transceiver: can't allocate udp receiver");
-        return false;
+        return NULL;
     }
 
     if (!rp->start(bind_address)) {
         roc_log(LogError, "transceiver: can't start udp receiver");
-        return false;
+        return NULL;
     }
 
     receivers_.push_back(*rp);
-    return true;
+    return rp.get();
 }
 
 packet::IWriter* Transceiver::add_udp_sender(packet::Address& bind_address) {
+    return add_udp_sender(bind_address, UDPSenderConfig());
+}
+
+UDPSender* Transceiver::add_udp_sender(packet::Address& bind_address,
+                                       const UDPSenderConfig& config) {
     if (joinable()) {
         roc_panic("transceiver: can't call add_udp_sender() when thread is running");
     }
@@ -105,7 +116,7 @@ packet::IWriter* Transceiver::add_udp_sender(packet::Address& bind_address) {
         roc_panic("transceiver: can't use invalid transceiver");
     }
 
-    core::SharedPtr<UDPSender> sp = new (allocator_) UDPSender(loop_, allocator_);
+    core::SharedPtr<UDPSender> sp = new (allocator_) UDPSender(loop_, config, allocator_);
 
     if (!sp) {
         roc_log(LogError, "transceiver: can't allocate udp sender");
@@ -59,6 +59,21 @@ public:
     //!  Should be called before start().
     bool add_udp_receiver(packet::Address& bind_address, packet::IWriter& writer);
 
+    //! Add UDP datagram receiver with custom parameters.
+    //!
+    //! Same as above, but allows to configure the receiver, e.g. to enable
+    //! batched reads using @p config. The returned receiver may be also used
+    //! to retrieve batching statistics.
+    //!
+    //! @returns
+    //!  a new receiver on success or null if error occured
+    //!
+    //! @pre
+    //!  Should be called before start().
+    UDPReceiver* add_udp_receiver(packet::Address& bind_address,
+                                  const UDPReceiverConfig& config,
+                                  packet::IWriter& writer);
+
     //! Add UDP datagram sender.
     //!
     //! Creates a new UDP sender, bind to @p bind_address, and returns a writer
@@ -76,6 +91,20 @@ public:
     //!  Should be called before start().
     packet::IWriter* add_udp_sender(packet::Address& bind_address);
 
+    //! Add UDP datagram sender with custom parameters.
+    //!
+    //! Same as above, but allows to configure the sender, e.g. to enable
+    //! batched writes using @p config. The returned sender may be also used
+    //! to retrieve batching statistics.
+    //!
+    //! @returns
+    //!  a new sender on success or null if error occured
+    //!
+    //! @pre
+    //!  Should be called before start().
+    UDPSender* add_udp_sender(packet::Address& bind_address,
+                              const UDPSenderConfig& config);
+
     //! Asynchronous stop.
     //! @remarks
     //!  Asynchronously stops all receivers and senders. May be called from
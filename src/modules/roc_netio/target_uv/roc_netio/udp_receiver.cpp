@@ -7,16 +7,75 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+// needed for recvmmsg()
+#define _GNU_SOURCE
+#endif
+
 #include "roc_netio/udp_receiver.h"
 #include "roc_core/log.h"
+#include "roc_core/macros.h"
 #include "roc_core/panic.h"
 #include "roc_core/shared_ptr.h"
+#include "roc_core/tracer.h"
 #include "roc_packet/address_to_str.h"
 
+#if defined(__linux__)
+#define ROC_NETIO_HAS_RECVMMSG
+#define ROC_NETIO_HAS_TIMESTAMPNS
+#endif
+
+#if defined(ROC_NETIO_HAS_RECVMMSG) || defined(ROC_NETIO_HAS_TIMESTAMPNS)
+#include <errno.h>
+#include <sys/socket.h>
+
+#include "roc_core/errno_to_str.h"
+#endif
+
+#ifdef ROC_NETIO_HAS_TIMESTAMPNS
+#include <linux/sockios.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#endif
+
 namespace roc {
 namespace netio {
 
+namespace {
+
+#ifdef ROC_NETIO_HAS_TIMESTAMPNS
+// kernel timestamps use CLOCK_REALTIME, while core::timestamp() uses a monotonic
+// clock, so we translate them using the current offset between the two clocks
+core::nanoseconds_t to_local_timestamp(const timespec& ts) {
+    timespec now_ts;
+    if (clock_gettime(CLOCK_REALTIME, &now_ts) != 0) {
+        return 0;
+    }
+
+    const core::nanoseconds_t local_now = core::timestamp();
+
+    const core::nanoseconds_t real_now = core::nanoseconds_t(now_ts.tv_sec) * 1000000000
+        + core::nanoseconds_t(now_ts.tv_nsec);
+
+    const core::nanoseconds_t real_ts =
+        core::nanoseconds_t(ts.tv_sec) * 1000000000 + core::nanoseconds_t(ts.tv_nsec);
+
+    if (real_ts == 0 || real_ts >= real_now) {
+        return local_now;
+    }
+
+    if (real_now - real_ts >= local_now) {
+        return 0;
+    }
+
+    return local_now - (real_now - real_ts);
+}
+#endif // ROC_NETIO_HAS_TIMESTAMPNS
+
+} // namespace
+
 UDPReceiver::UDPReceiver(uv_loop_t& event_loop,
+                         const UDPReceiverConfig& config,
                          packet::IWriter& writer,
                          packet::PacketPool& packet_pool,
                          core::BufferPool<uint8_t>& buffer_pool,
@@ -24,10 +83,22 @@ UDPReceiver::UDPReceiver(uv_loop_t& event_loop,
     : allocator_(allocator)
     , loop_(event_loop)
     , handle_initialized_(false)
+    , poll_handle_initialized_(false)
+    , batch_size_(config.batch_size)
     , writer_(writer)
     , packet_pool_(packet_pool)
     , buffer_pool_(buffer_pool)
     , packet_counter_(0) {
+    if (batch_size_ > MaxBatchSize) {
+        roc_panic("udp receiver: batch size is too large: size=%lu max=%lu",
+                  (unsigned long)batch_size_, (unsigned long)MaxBatchSize);
+    }
+#ifndef ROC_NETIO_HAS_RECVMMSG
+    if (batch_size_ > 1) {
+        roc_log(LogDebug, "udp receiver: recvmmsg() is not supported, disabling batching");
+    }
+    batch_size_ = 0;
+#endif
 }
 
 UDPReceiver::~UDPReceiver() {
@@ -72,16 +143,29 @@ bool UDPReceiver::start(packet::Address& bind_address) {
         return false;
     }
 
+    address_ = bind_address;
+
+    enable_timestamps_();
+
+    if (batch_size_ > 1) {
+        return start_batch_();
+    }
+
     if (int err = uv_udp_recv_start(&handle_, alloc_cb_, recv_cb_)) {
         roc_log(LogError, "udp receiver: uv_udp_recv_start(): [%s] %s", uv_err_name(err),
                 uv_strerror(err));
         return false;
     }
 
-    address_ = bind_address;
     return true;
 }
 
+UDPReceiverStats UDPReceiver::stats() const {
+    core::Mutex::Lock lock(mutex_);
+
+    return stats_;
+}
+
 void UDPReceiver::stop() {
     if (!handle_initialized_) {
         return;
@@ -89,6 +173,22 @@ void UDPReceiver::stop() {
 
     handle_initialized_ = false;
 
+    if (poll_handle_initialized_) {
+        poll_handle_initialized_ = false;
+
+        if (!uv_is_closing((uv_handle_t*)&poll_handle_)) {
+            if (int err = uv_poll_stop(&poll_handle_)) {
+                roc_log(LogError, "udp receiver: uv_poll_stop(): [%s] %s",
+                        uv_err_name(err), uv_strerror(err));
+            }
+            uv_close((uv_handle_t*)&poll_handle_, NULL);
+        }
+    }
+
+    for (size_t n = 0; n < MaxBatchSize; n++) {
+        batch_buffers_[n] = NULL;
+    }
+
     if (uv_is_closing((uv_handle_t*)&handle_)) {
         return;
     }
@@ -200,12 +300,252 @@ void UDPReceiver::recv_cb_(uv_udp_t* handle,
         return;
     }
 
-    if ((size_t)nread > bp->size()) {
-        roc_panic("udp receiver: unexpected buffer size (got %ld, max %ld)", (long)nread,
-                  (long)bp->size());
+    self.deliver_(*bp, (size_t)nread, src_addr, self.last_timestamp_());
+}
+
+void UDPReceiver::enable_timestamps_() {
+#ifdef ROC_NETIO_HAS_TIMESTAMPNS
+    uv_os_fd_t fd;
+    if (int err = uv_fileno((uv_handle_t*)&handle_, &fd)) {
+        roc_log(LogError, "udp receiver: uv_fileno(): [%s] %s", uv_err_name(err),
+                uv_strerror(err));
+        return;
+    }
+
+    int enable = 1;
+    if (setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable)) != 0) {
+        roc_log(LogDebug, "udp receiver: setsockopt(SO_TIMESTAMPNS): %s",
+                core::errno_to_str(errno).c_str());
+    }
+#endif // ROC_NETIO_HAS_TIMESTAMPNS
+}
+
+// libuv doesn't provide ancillary data, so when reading datagrams via libuv,
+// the kernel timestamp of the last datagram is requested using ioctl(); this
+// costs an extra syscall per datagram, so it's done only when tracing
+core::nanoseconds_t UDPReceiver::last_timestamp_() {
+#ifdef ROC_NETIO_HAS_TIMESTAMPNS
+    if (!core::tracer().enabled()) {
+        return 0;
+    }
+
+    uv_os_fd_t fd;
+    if (uv_fileno((uv_handle_t*)&handle_, &fd) != 0) {
+        return 0;
+    }
+
+    timespec ts;
+    if (ioctl(fd, SIOCGSTAMPNS, &ts) != 0) {
+        return 0;
+    }
+
+    return to_local_timestamp(ts);
+#else  // !ROC_NETIO_HAS_TIMESTAMPNS
+    return 0;
+#endif // ROC_NETIO_HAS_TIMESTAMPNS
+}
+
+bool UDPReceiver::start_batch_() {
+    // We don't start receiving on the libuv UDP handle and instead poll its file
+    // descriptor ourselves, so that every wakeup is followed by a single recvmmsg()
+    // call that reads all pending datagrams into pre-reserved buffers.
+    uv_os_fd_t fd;
+    if (int err = uv_fileno((uv_handle_t*)&handle_, &fd)) {
+        roc_log(LogError, "udp receiver: uv_fileno(): [%s] %s", uv_err_name(err),
+                uv_strerror(err));
+        return false;
+    }
+
+    if (int err = uv_poll_init(&loop_, &poll_handle_, fd)) {
+        roc_log(LogError, "udp receiver: uv_poll_init(): [%s] %s", uv_err_name(err),
+                uv_strerror(err));
+        return false;
+    }
+
+    poll_handle_.data = this;
+    poll_handle_initialized_ = true;
+
+    if (int err = uv_poll_start(&poll_handle_, UV_READABLE, poll_cb_)) {
+        roc_log(LogError, "udp receiver: uv_poll_start(): [%s] %s", uv_err_name(err),
+                uv_strerror(err));
+        return false;
+    }
+
+    roc_log(LogDebug, "udp receiver: using batched reads: port=%s batch_size=%lu",
+            packet::address_to_str(address_).c_str(), (unsigned long)batch_size_);
+
+    return true;
+}
+
+void UDPReceiver::poll_cb_(uv_poll_t* handle, int status, int events) {
+    roc_panic_if_not(handle);
+
+    UDPReceiver& self = *(UDPReceiver*)handle->data;
+
+    if (status < 0) {
+        roc_log(LogError, "udp receiver: poll error: [%s] %s", uv_err_name(status),
+                uv_strerror(status));
+        return;
+    }
+
+    if (events & UV_READABLE) {
+        self.read_batch_();
+    }
+}
+
+size_t UDPReceiver::reserve_batch_() {
+    size_t n = 0;
+
+    for (; n < batch_size_; n++) {
+        if (batch_buffers_[n]) {
+            continue;
+        }
+
+        batch_buffers_[n] = new (buffer_pool_) core::Buffer<uint8_t>(buffer_pool_);
+
+        if (!batch_buffers_[n]) {
+            roc_log(LogError, "udp receiver: can't allocate buffer");
+            break;
+        }
+    }
+
+    return n;
+}
+
+void UDPReceiver::read_batch_() {
+#ifdef ROC_NETIO_HAS_RECVMMSG
+    mmsghdr msgs[MaxBatchSize];
+    iovec iovs[MaxBatchSize];
+    packet::Address addrs[MaxBatchSize];
+
+#ifdef ROC_NETIO_HAS_TIMESTAMPNS
+    union {
+        cmsghdr align;
+        char buf[CMSG_SPACE(sizeof(timespec))];
+    } ctls[MaxBatchSize];
+#endif
+
+    uv_os_fd_t fd;
+    if (int err = uv_fileno((uv_handle_t*)&handle_, &fd)) {
+        roc_log(LogError, "udp receiver: uv_fileno(): [%s] %s", uv_err_name(err),
+                uv_strerror(err));
+        return;
+    }
+
+    for (;;) {
+        const size_t n_msgs = reserve_batch_();
+        if (n_msgs == 0) {
+            return;
+        }
+
+#ifdef ROC_NETIO_HAS_TIMESTAMPNS
+        // kernel timestamps are only needed for tracing, so ancillary data is
+        // neither requested nor parsed when it's disabled
+        const bool want_timestamps = core::tracer().enabled();
+#endif
+
+        memset(msgs, 0, n_msgs * sizeof(msgs[0]));
+
+        for (size_t n = 0; n < n_msgs; n++) {
+            iovs[n].iov_base = batch_buffers_[n]->data();
+            iovs[n].iov_len = batch_buffers_[n]->size();
+
+            msgs[n].msg_hdr.msg_iov = &iovs[n];
+            msgs[n].msg_hdr.msg_iovlen = 1;
+            msgs[n].msg_hdr.msg_name = addrs[n].saddr();
+            msgs[n].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+
+#ifdef ROC_NETIO_HAS_TIMESTAMPNS
+            if (want_timestamps) {
+                msgs[n].msg_hdr.msg_control = ctls[n].buf;
+                msgs[n].msg_hdr.msg_controllen = sizeof(ctls[n].buf);
+            }
+#endif
+        }
+
+        const int ret = recvmmsg(fd, msgs, (unsigned)n_msgs, MSG_DONTWAIT, NULL);
+
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN) {
+                roc_log(LogError, "udp receiver: recvmmsg(): %s",
+                        core::errno_to_str(errno).c_str());
+            }
+            return;
+        }
+
+        roc_log(LogTrace, "udp receiver: got batch: dst=%s size=%d",
+                packet::address_to_str(address_).c_str(), ret);
+
+        if (ret > 0) {
+            core::Mutex::Lock lock(mutex_);
+
+            stats_.n_batches++;
+            stats_.n_packets += (size_t)ret;
+            stats_.max_batch_size = ROC_MAX(stats_.max_batch_size, (size_t)ret);
+        }
+
+        for (size_t n = 0; n < (size_t)ret; n++) {
+            // buffer is now referenced by the packet (if any) and will be
+            // re-reserved on the next iteration
+            core::SharedPtr<core::Buffer<uint8_t> > bp = batch_buffers_[n];
+            batch_buffers_[n] = NULL;
+
+            packet_counter_++;
+
+            if (msgs[n].msg_hdr.msg_flags & MSG_TRUNC) {
+                roc_log(LogDebug, "udp receiver:"
+                                  " ignoring partial read: num=%u src=%s dst=%s",
+                        packet_counter_, packet::address_to_str(addrs[n]).c_str(),
+                        packet::address_to_str(address_).c_str());
+                continue;
+            }
+
+            if (msgs[n].msg_len == 0) {
+                continue;
+            }
+
+            core::nanoseconds_t timestamp = 0;
+
+#ifdef ROC_NETIO_HAS_TIMESTAMPNS
+            if (want_timestamps) {
+                for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msgs[n].msg_hdr); cmsg;
+                     cmsg = CMSG_NXTHDR(&msgs[n].msg_hdr, cmsg)) {
+                    if (cmsg->cmsg_level == SOL_SOCKET
+                        && cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+                        timespec ts;
+                        memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+                        timestamp = to_local_timestamp(ts);
+                    }
+                }
+            }
+#endif
+
+            deliver_(*bp, msgs[n].msg_len, addrs[n], timestamp);
+        }
+
+        if ((size_t)ret < n_msgs) {
+            // socket is drained
+            return;
+        }
+    }
+#else
+    roc_panic("udp receiver: batched reads are not supported");
+#endif
+}
+
+void UDPReceiver::deliver_(core::Buffer<uint8_t>& buffer,
+                           size_t size,
+                           const packet::Address& src_addr,
+                           core::nanoseconds_t timestamp) {
+    if (size > buffer.size()) {
+        roc_panic("udp receiver: unexpected buffer size (got %ld, max %ld)", (long)size,
+                  (long)buffer.size());
     }
 
-    packet::PacketPtr pp = new (self.packet_pool_) packet::Packet(self.packet_pool_);
+    packet::PacketPtr pp = new (packet_pool_) packet::Packet(packet_pool_);
     if (!pp) {
         roc_log(LogError, "udp receiver: can't allocate packet");
         return;
@@ -214,11 +554,21 @@ void UDPReceiver::recv_cb_(uv_udp_t* handle,
     pp->add_flags(packet::Packet::FlagUDP);
 
     pp->udp()->src_addr = src_addr;
-    pp->udp()->dst_addr = self.address_;
+    pp->udp()->dst_addr = address_;
+    pp->udp()->receive_timestamp = timestamp;
+
+    pp->set_data(core::Slice<uint8_t>(buffer, 0, size));
 
-    pp->set_data(core::Slice<uint8_t>(*bp, 0, (size_t)nread));
+    if (core::tracer().enabled()) {
+        pp->set_trace_id(core::tracer().new_id());
+
+        if (timestamp != 0) {
+            roc_trace_at("kernel_rx", pp->trace_id(), timestamp);
+        }
+        roc_trace("udp_recv", pp->trace_id());
+    }
 
-    self.writer_.write(pp);
+    writer_.write(pp);
 }
 
 } // namespace netio
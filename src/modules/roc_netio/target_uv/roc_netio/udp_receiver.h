@@ -18,7 +18,10 @@
 #include "roc_core/buffer_pool.h"
 #include "roc_core/iallocator.h"
 #include "roc_core/list_node.h"
+#include "roc_core/mutex.h"
 #include "roc_core/refcnt.h"
+#include "roc_core/shared_ptr.h"
+#include "roc_core/time.h"
 #include "roc_packet/address.h"
 #include "roc_packet/iwriter.h"
 #include "roc_packet/packet_pool.h"
@@ -26,11 +29,48 @@
 namespace roc {
 namespace netio {
 
+//! UDP receiver parameters.
+struct UDPReceiverConfig {
+    //! Maximum number of datagrams to read per wakeup.
+    //! @remarks
+    //!  If zero or one, datagrams are read one by one using libuv. Otherwise,
+    //!  up to batch_size datagrams are read by a single recvmmsg() call into
+    //!  buffers reserved in advance. Ignored if recvmmsg() is not supported
+    //!  on the platform. Can't be larger than UDPReceiver::MaxBatchSize.
+    size_t batch_size;
+
+    UDPReceiverConfig()
+        : batch_size(0) {
+    }
+};
+
+//! UDP receiver statistics.
+struct UDPReceiverStats {
+    //! Number of recvmmsg() calls that returned datagrams.
+    size_t n_batches;
+
+    //! Number of datagrams received in batches.
+    size_t n_packets;
+
+    //! Maximum number of datagrams returned by a single recvmmsg() call.
+    size_t max_batch_size;
+
+    UDPReceiverStats()
+        : n_batches(0)
+        , n_packets(0)
+        , max_batch_size(0) {
+    }
+};
+
 //! UDP receiver.
 class UDPReceiver : public core::RefCnt<UDPReceiver>, public core::ListNode {
 public:
+    //! Maximum supported batch size.
+    enum { MaxBatchSize = 64 };
+
     //! Initialize.
     UDPReceiver(uv_loop_t& event_loop,
+                const UDPReceiverConfig& config,
                 packet::IWriter& writer,
                 packet::PacketPool& packet_pool,
                 core::BufferPool<uint8_t>& buffer_pool,
@@ -49,6 +89,11 @@ public:
     //!  Should be called from the event loop thread.
     void stop();
 
+    //! Get batching statistics.
+    //! @remarks
+    //!  May be called from any thread.
+    UDPReceiverStats stats() const;
+
 private:
     static void alloc_cb_(uv_handle_t* handle, size_t size, uv_buf_t* buf);
     static void recv_cb_(uv_udp_t* handle,
@@ -57,10 +102,24 @@ private:
                          const sockaddr* addr,
                          unsigned flags);
 
+    static void poll_cb_(uv_poll_t* handle, int status, int events);
+
     friend class core::RefCnt<UDPReceiver>;
 
     void destroy();
 
+    void enable_timestamps_();
+    core::nanoseconds_t last_timestamp_();
+
+    bool start_batch_();
+    void read_batch_();
+    size_t reserve_batch_();
+
+    void deliver_(core::Buffer<uint8_t>& buffer,
+                  size_t size,
+                  const packet::Address& src_addr,
+                  core::nanoseconds_t timestamp);
+
     core::IAllocator& allocator_;
 
     uv_loop_t& loop_;
@@ -68,6 +127,12 @@ private:
     uv_udp_t handle_;
     bool handle_initialized_;
 
+    uv_poll_t poll_handle_;
+    bool poll_handle_initialized_;
+
+    size_t batch_size_;
+    core::SharedPtr<core::Buffer<uint8_t> > batch_buffers_[MaxBatchSize];
+
     packet::Address address_;
 
     packet::IWriter& writer_;
@@ -75,6 +140,9 @@ private:
     packet::PacketPool& packet_pool_;
     core::BufferPool<uint8_t>& buffer_pool_;
 
+    UDPReceiverStats stats_;
+    core::Mutex mutex_;
+
     unsigned packet_counter_;
 };
 
@@ -7,23 +7,78 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+// needed for sendmmsg()
+#define _GNU_SOURCE
+#endif
+
 #include "roc_netio/udp_sender.h"
 #include "roc_core/log.h"
 #include "roc_core/macros.h"
 #include "roc_core/panic.h"
 #include "roc_packet/address_to_str.h"
 
+#if defined(__linux__)
+#define ROC_NETIO_HAS_SENDMMSG
+#endif
+
+#ifdef ROC_NETIO_HAS_SENDMMSG
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <string.h>
+#include <sys/socket.h>
+
+#include "roc_core/errno_to_str.h"
+#endif
+
 namespace roc {
 namespace netio {
 
-UDPSender::UDPSender(uv_loop_t& event_loop, core::IAllocator& allocator)
+#ifdef ROC_NETIO_HAS_SENDMMSG
+
+namespace {
+
+// Maximum number of datagrams merged into a single GSO message.
+enum { MaxGSOSegments = 64 };
+
+// Maximum total size of a single GSO message.
+enum { MaxGSOBytes = 65000 };
+
+} // namespace
+
+#endif // ROC_NETIO_HAS_SENDMMSG
+
+UDPSender::UDPSender(uv_loop_t& event_loop,
+                     const UDPSenderConfig& config,
+                     core::IAllocator& allocator)
     : allocator_(allocator)
     , loop_(event_loop)
     , write_sem_initialized_(false)
     , handle_initialized_(false)
     , pending_(0)
+    , async_pending_(0)
+    , wakeup_pending_(false)
     , stopped_(true)
+    , batch_size_(config.batch_size)
+    , gso_(config.enable_gso)
     , packet_counter_(0) {
+    if (batch_size_ > MaxBatchSize) {
+        roc_panic("udp sender: batch size is too large: size=%lu max=%lu",
+                  (unsigned long)batch_size_, (unsigned long)MaxBatchSize);
+    }
+#ifndef ROC_NETIO_HAS_SENDMMSG
+    if (batch_size_ > 1) {
+        roc_log(LogDebug, "udp sender: sendmmsg() is not supported, disabling batching");
+    }
+    batch_size_ = 0;
+#endif
+#if !defined(ROC_NETIO_HAS_SENDMMSG) || !defined(UDP_SEGMENT)
+    if (gso_) {
+        roc_log(LogDebug, "udp sender: gso is not supported, disabling it");
+    }
+    gso_ = false;
+#endif
 }
 
 UDPSender::~UDPSender() {
@@ -78,6 +133,13 @@ bool UDPSender::start(packet::Address& bind_address) {
 
     stopped_ = false;
     address_ = bind_address;
+
+    if (batch_size_ > 1) {
+        roc_log(LogDebug, "udp sender: using batched writes: port=%s batch_size=%lu gso=%d",
+                packet::address_to_str(address_).c_str(), (unsigned long)batch_size_,
+                (int)gso_);
+    }
+
     return true;
 }
 
@@ -129,6 +191,13 @@ void UDPSender::write(const packet::PacketPtr& pp) {
 
         list_.push_back(*pp);
         ++pending_;
+
+        // wake up the event loop only once per burst; the callback will
+        // drain all packets queued until it runs
+        if (wakeup_pending_) {
+            return;
+        }
+        wakeup_pending_ = true;
     }
 
     if (int err = uv_async_send(&write_sem_)) {
@@ -137,6 +206,12 @@ void UDPSender::write(const packet::PacketPtr& pp) {
     }
 }
 
+UDPSenderStats UDPSender::stats() const {
+    core::Mutex::Lock lock(mutex_);
+
+    return stats_;
+}
+
 packet::PacketPtr UDPSender::read_() {
     core::Mutex::Lock lock(mutex_);
 
@@ -153,30 +228,225 @@ void UDPSender::write_sem_cb_(uv_async_t* handle) {
 
     UDPSender& self = *(UDPSender*)handle->data;
 
+    {
+        core::Mutex::Lock lock(self.mutex_);
+        self.wakeup_pending_ = false;
+    }
+
+    if (self.batch_size_ > 1) {
+        self.send_batches_();
+        return;
+    }
+
     while (packet::PacketPtr pp = self.read_()) {
-        packet::UDP& udp = *pp->udp();
+        self.send_(pp);
+    }
+}
+
+void UDPSender::send_(const packet::PacketPtr& pp) {
+    packet::UDP& udp = *pp->udp();
+
+    packet_counter_++;
+
+    roc_log(LogTrace, "udp sender: sending datagram: num=%u src=%s dst=%s sz=%ld",
+            packet_counter_, packet::address_to_str(address_).c_str(),
+            packet::address_to_str(udp.dst_addr).c_str(), (long)pp->data().size());
+
+    uv_buf_t buf;
+    buf.base = (char*)pp->data().data();
+    buf.len = pp->data().size();
+
+    udp.request.data = this;
+
+    if (int err = uv_udp_send(&udp.request, &handle_, &buf, 1, udp.dst_addr.saddr(),
+                              send_cb_)) {
+        roc_log(LogError, "udp sender: uv_udp_send(): [%s] %s", uv_err_name(err),
+                uv_strerror(err));
+        complete_(1);
+        return;
+    }
+
+    // will be decremented in send_cb_()
+    pp->incref();
+
+    async_pending_++;
+}
+
+void UDPSender::send_batches_() {
+    packet::PacketPtr batch[MaxBatchSize];
+
+    for (;;) {
+        size_t n_packets = 0;
+
+        {
+            core::Mutex::Lock lock(mutex_);
 
-        self.packet_counter_++;
+            while (n_packets < batch_size_) {
+                packet::PacketPtr pp = list_.front();
+                if (!pp) {
+                    break;
+                }
+                list_.remove(*pp);
+                batch[n_packets++] = pp;
+            }
+        }
+
+        if (n_packets == 0) {
+            break;
+        }
+
+        // If some datagrams are still queued inside libuv, bypassing it would
+        // reorder packets, so we keep using libuv until its queue is flushed.
+        size_t n_sent = 0;
+        if (async_pending_ == 0) {
+            n_sent = send_mmsg_(batch, n_packets);
+        }
+
+        for (size_t n = n_sent; n < n_packets; n++) {
+            send_(batch[n]);
+        }
+
+        for (size_t n = 0; n < n_packets; n++) {
+            batch[n] = NULL;
+        }
+
+        if (n_sent != 0) {
+            complete_(n_sent);
+        }
+    }
+}
+
+size_t UDPSender::send_mmsg_(const packet::PacketPtr* packets, size_t n_packets) {
+#ifdef ROC_NETIO_HAS_SENDMMSG
+    mmsghdr msgs[MaxBatchSize];
+    iovec iovs[MaxBatchSize];
+    size_t msg_packets[MaxBatchSize + 1];
+
+#ifdef UDP_SEGMENT
+    union {
+        char buf[CMSG_SPACE(sizeof(uint16_t))];
+        cmsghdr align;
+    } ctrls[MaxBatchSize];
+#endif
+
+    uv_os_fd_t fd;
+    if (int err = uv_fileno((uv_handle_t*)&handle_, &fd)) {
+        roc_log(LogError, "udp sender: uv_fileno(): [%s] %s", uv_err_name(err),
+                uv_strerror(err));
+        return 0;
+    }
+
+    memset(msgs, 0, sizeof(msgs));
+
+    size_t n_msgs = 0;
+
+    for (size_t p = 0; p < n_packets;) {
+        packet::Packet& first = *packets[p];
+        const size_t seg_size = first.data().size();
+
+        // merge subsequent datagrams with the same destination into a single
+        // message; all segments except the last one should have equal sizes
+        size_t n_segs = 1;
+        if (gso_) {
+            while (p + n_segs < n_packets && n_segs < MaxGSOSegments
+                   && (n_segs + 1) * seg_size <= MaxGSOBytes) {
+                const packet::Packet& next = *packets[p + n_segs];
+                if (next.udp()->dst_addr != first.udp()->dst_addr) {
+                    break;
+                }
+                if (next.data().size() > seg_size) {
+                    break;
+                }
+                n_segs++;
+                if (next.data().size() < seg_size) {
+                    break;
+                }
+            }
+        }
+
+        for (size_t n = 0; n < n_segs; n++) {
+            iovs[p + n].iov_base = packets[p + n]->data().data();
+            iovs[p + n].iov_len = packets[p + n]->data().size();
+        }
+
+        msghdr& hdr = msgs[n_msgs].msg_hdr;
+
+        hdr.msg_iov = &iovs[p];
+        hdr.msg_iovlen = n_segs;
+        hdr.msg_name = first.udp()->dst_addr.saddr();
+        hdr.msg_namelen = first.udp()->dst_addr.slen();
 
-        roc_log(LogTrace, "udp sender: sending datagram: num=%u src=%s dst=%s sz=%ld",
-                self.packet_counter_, packet::address_to_str(self.address_).c_str(),
-                packet::address_to_str(udp.dst_addr).c_str(), (long)pp->data().size());
+#ifdef UDP_SEGMENT
+        if (n_segs > 1) {
+            memset(&ctrls[n_msgs], 0, sizeof(ctrls[n_msgs]));
 
-        uv_buf_t buf;
-        buf.base = (char*)pp->data().data();
-        buf.len = pp->data().size();
+            hdr.msg_control = ctrls[n_msgs].buf;
+            hdr.msg_controllen = sizeof(ctrls[n_msgs].buf);
 
-        udp.request.data = &self;
+            cmsghdr* cm = CMSG_FIRSTHDR(&hdr);
+            cm->cmsg_level = SOL_UDP;
+            cm->cmsg_type = UDP_SEGMENT;
+            cm->cmsg_len = CMSG_LEN(sizeof(uint16_t));
 
-        if (int err = uv_udp_send(&udp.request, &self.handle_, &buf, 1,
-                                  udp.dst_addr.saddr(), send_cb_)) {
-            roc_log(LogError, "udp sender: uv_udp_send(): [%s] %s", uv_err_name(err),
-                    uv_strerror(err));
-            continue;
+            const uint16_t gso_size = (uint16_t)seg_size;
+            memcpy(CMSG_DATA(cm), &gso_size, sizeof(gso_size));
         }
+#endif
 
-        // will be decremented in send_cb_()
-        pp->incref();
+        msg_packets[n_msgs++] = p;
+        p += n_segs;
+    }
+
+    msg_packets[n_msgs] = n_packets;
+
+    int ret;
+    do {
+        ret = sendmmsg(fd, msgs, (unsigned)n_msgs, MSG_DONTWAIT);
+    } while (ret < 0 && errno == EINTR);
+
+    if (ret < 0) {
+        if (gso_ && n_msgs < n_packets && (errno == EIO || errno == EINVAL)) {
+            roc_log(LogDebug, "udp sender: gso is not supported by kernel, disabling it");
+            gso_ = false;
+            return send_mmsg_(packets, n_packets);
+        }
+        if (errno != EAGAIN) {
+            roc_log(LogError, "udp sender: sendmmsg(): %s",
+                    core::errno_to_str(errno).c_str());
+        }
+        return 0;
+    }
+
+    const size_t n_sent = msg_packets[ret];
+
+    packet_counter_ += (unsigned)n_sent;
+
+    roc_log(LogTrace, "udp sender: sent batch: src=%s packets=%lu messages=%d",
+            packet::address_to_str(address_).c_str(), (unsigned long)n_sent, ret);
+
+    core::Mutex::Lock lock(mutex_);
+
+    stats_.n_batches++;
+    stats_.n_packets += n_sent;
+    stats_.n_messages += (size_t)ret;
+    stats_.max_batch_size = ROC_MAX(stats_.max_batch_size, n_sent);
+
+    return n_sent;
+#else
+    (void)packets;
+    (void)n_packets;
+    roc_panic("udp sender: batched writes are not supported");
+#endif
+}
+
+void UDPSender::complete_(size_t n_packets) {
+    core::Mutex::Lock lock(mutex_);
+
+    roc_panic_if(pending_ < n_packets);
+    pending_ -= n_packets;
+
+    if (stopped_ && pending_ == 0) {
+        close_();
     }
 }
 
@@ -188,11 +458,11 @@ void UDPSender::send_cb_(uv_udp_send_t* req, int status) {
     packet::PacketPtr pp =
         packet::Packet::container_of(ROC_CONTAINER_OF(req, packet::UDP, request));
 
-    // one reference for incref() called from write_sem_cb_()
+    // one reference for incref() called from send_()
     // one reference for the shared pointer above
     roc_panic_if(pp->getref() < 2);
 
-    // decrement reference counter incremented in async_cb_()
+    // decrement reference counter incremented in send_()
     pp->decref();
 
     if (status < 0) {
@@ -203,13 +473,8 @@ void UDPSender::send_cb_(uv_udp_send_t* req, int status) {
                 (long)pp->data().size(), uv_err_name(status), uv_strerror(status));
     }
 
-    core::Mutex::Lock lock(self.mutex_);
-
-    --self.pending_;
-
-    if (self.stopped_ && self.pending_ == 0) {
-        self.close_();
-    }
+    self.async_pending_--;
+    self.complete_(1);
 }
 
 } // namespace netio
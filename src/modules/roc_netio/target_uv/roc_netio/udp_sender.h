@@ -26,13 +26,66 @@
 namespace roc {
 namespace netio {
 
+//! UDP sender parameters.
+struct UDPSenderConfig {
+    //! Maximum number of datagrams to send per system call.
+    //! @remarks
+    //!  If zero or one, datagrams are sent one by one using libuv. Otherwise,
+    //!  all datagrams queued since the last wakeup are sent by sendmmsg() calls
+    //!  of up to batch_size datagrams. Ignored if sendmmsg() is not supported
+    //!  on the platform. Can't be larger than UDPSender::MaxBatchSize.
+    size_t batch_size;
+
+    //! Enable UDP generic segmentation offload.
+    //! @remarks
+    //!  If set, consecutive datagrams of the same size sent to the same
+    //!  address are merged into a single message and split by the kernel
+    //!  or the NIC. Used only when batching is enabled. Automatically
+    //!  disabled if not supported by the kernel.
+    bool enable_gso;
+
+    UDPSenderConfig()
+        : batch_size(0)
+        , enable_gso(false) {
+    }
+};
+
+//! UDP sender statistics.
+struct UDPSenderStats {
+    //! Number of batches sent.
+    size_t n_batches;
+
+    //! Number of datagrams sent in batches.
+    size_t n_packets;
+
+    //! Number of messages passed to the kernel in batches.
+    //! @remarks
+    //!  Less than n_packets if GSO merged some datagrams.
+    size_t n_messages;
+
+    //! Maximum number of datagrams in a batch.
+    size_t max_batch_size;
+
+    UDPSenderStats()
+        : n_batches(0)
+        , n_packets(0)
+        , n_messages(0)
+        , max_batch_size(0) {
+    }
+};
+
 //! UDP sender.
 class UDPSender : public core::RefCnt<UDPSender>,
                   public core::ListNode,
                   public packet::IWriter {
 public:
+    //! Maximum supported batch size.
+    enum { MaxBatchSize = 64 };
+
     //! Initialize.
-    UDPSender(uv_loop_t& event_loop, core::IAllocator& allocator);
+    UDPSender(uv_loop_t& event_loop,
+              const UDPSenderConfig& config,
+              core::IAllocator& allocator);
 
     //! Destroy.
     ~UDPSender();
@@ -52,6 +105,11 @@ public:
     //!  May be called from any thread.
     virtual void write(const packet::PacketPtr&);
 
+    //! Get batching statistics.
+    //! @remarks
+    //!  May be called from any thread.
+    UDPSenderStats stats() const;
+
 private:
     static void write_sem_cb_(uv_async_t* handle);
     static void send_cb_(uv_udp_send_t* req, int status);
@@ -63,6 +121,11 @@ private:
     packet::PacketPtr read_();
     void close_();
 
+    void send_(const packet::PacketPtr& pp);
+    void send_batches_();
+    size_t send_mmsg_(const packet::PacketPtr* packets, size_t n_packets);
+    void complete_(size_t n_packets);
+
     core::IAllocator& allocator_;
 
     uv_loop_t& loop_;
@@ -79,8 +142,15 @@ private:
     core::Mutex mutex_;
 
     size_t pending_;
+    size_t async_pending_;
+    bool wakeup_pending_;
     bool stopped_;
 
+    size_t batch_size_;
+    bool gso_;
+
+    UDPSenderStats stats_;
+
     unsigned packet_counter_;
 };
 
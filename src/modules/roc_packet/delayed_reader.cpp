@@ -15,9 +15,11 @@
 namespace roc {
 namespace packet {
 
-DelayedReader::DelayedReader(IReader& reader, timestamp_t delay)
+DelayedReader::DelayedReader(IReader& reader,
+                             timestamp_t delay,
+                             core::IAllocator& allocator)
     : reader_(reader)
-    , queue_(0)
+    , queue_(allocator, 0)
     , delay_(delay) {
 }
 
@@ -13,6 +13,7 @@
 #ifndef ROC_PACKET_DELAYED_READER_H_
 #define ROC_PACKET_DELAYED_READER_H_
 
+#include "roc_core/iallocator.h"
 #include "roc_core/noncopyable.h"
 #include "roc_packet/ireader.h"
 #include "roc_packet/sorted_queue.h"
@@ -30,7 +31,8 @@ public:
     //! @b Parameters
     //!  - @p reader is used to read packets
     //!  - @p delay is the delay to insert before first packet
-    DelayedReader(IReader& reader, timestamp_t delay);
+    //!  - @p allocator is used to allocate the packet queue
+    DelayedReader(IReader& reader, timestamp_t delay, core::IAllocator& allocator);
 
     //! Read packet.
     virtual PacketPtr read();
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+
+#include "roc_packet/mpsc_queue.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace packet {
+
+namespace {
+
+size_t round_up_pow2(size_t n) {
+    size_t ret = 1;
+    while (ret < n) {
+        ret <<= 1;
+    }
+    return ret;
+}
+
+// Sequence numbers may overflow, so we use unsigned arithmetic and
+// interpret the difference as signed.
+long seq_add(long a, size_t b) {
+    return (long)((unsigned long)a + (unsigned long)b);
+}
+
+long seq_diff(long a, long b) {
+    return (long)((unsigned long)a - (unsigned long)b);
+}
+
+} // namespace
+
+MPSCQueue::MPSCQueue(core::IAllocator& allocator, size_t max_size)
+    : cells_(allocator, round_up_pow2(max_size))
+    , mask_(cells_.max_size() - 1)
+    , sem_(0) {
+    if (max_size == 0) {
+        roc_panic("mpsc queue: max_size should be non-zero");
+    }
+
+    cells_.resize(cells_.max_size());
+
+    for (size_t n = 0; n < cells_.size(); n++) {
+        cells_[n].seq.store((long)n);
+    }
+}
+
+MPSCQueue::~MPSCQueue() {
+    while (Packet* packet = read_nb_()) {
+        packet->decref();
+    }
+}
+
+PacketPtr MPSCQueue::read() {
+    Packet* packet = read_nb_();
+    if (!packet) {
+        return NULL;
+    }
+
+    PacketPtr pp = packet;
+
+    // decrement reference counter incremented in write()
+    packet->decref();
+
+    return pp;
+}
+
+size_t MPSCQueue::read_batch(PacketPtr* packets, size_t max_packets) {
+    size_t n = 0;
+
+    for (; n < max_packets; n++) {
+        Packet* packet = read_nb_();
+        if (!packet) {
+            break;
+        }
+
+        packets[n] = packet;
+
+        // decrement reference counter incremented in write()
+        packet->decref();
+    }
+
+    return n;
+}
+
+void MPSCQueue::write(const PacketPtr& packet) {
+    if (!packet) {
+        roc_panic("mpsc queue: null packet in write");
+    }
+
+    long pos = tail_;
+    Cell* cell = NULL;
+
+    // reserve a cell; the cell is free when its sequence number is equal
+    // to the tail position
+    for (;;) {
+        cell = &cells_[(size_t)pos & mask_];
+
+        const long dif = seq_diff(cell->seq, pos);
+
+        if (dif == 0) {
+            if (tail_.compare_exchange(pos, seq_add(pos, 1))) {
+                break;
+            }
+        } else if (dif < 0) {
+            roc_log(LogDebug, "mpsc queue: queue is full, dropping packet: max_size=%lu",
+                    (unsigned long)max_size());
+            return;
+        }
+
+        pos = tail_;
+    }
+
+    // will be decremented in read() or read_batch()
+    packet->incref();
+
+    cell->packet = packet.get();
+
+    // publish the cell to the consumer
+    cell->seq.store(seq_add(pos, 1));
+
+    // wake up the consumer only if it's blocked in wait()
+    if (waiters_ != 0) {
+        sem_.post();
+    }
+}
+
+void MPSCQueue::wait() {
+    for (;;) {
+        if (readable_()) {
+            return;
+        }
+
+        ++waiters_;
+
+        // recheck after incrementing waiters_, since the producer
+        // could have written a packet before seeing it
+        if (readable_()) {
+            --waiters_;
+            return;
+        }
+
+        sem_.pend();
+
+        --waiters_;
+    }
+}
+
+size_t MPSCQueue::size() const {
+    const long dif = seq_diff(tail_, head_);
+    if (dif < 0) {
+        return 0;
+    }
+    return (size_t)dif;
+}
+
+size_t MPSCQueue::max_size() const {
+    return cells_.size();
+}
+
+bool MPSCQueue::readable_() const {
+    const long pos = head_;
+    const Cell& cell = cells_[(size_t)pos & mask_];
+
+    return seq_diff(cell.seq, seq_add(pos, 1)) >= 0;
+}
+
+Packet* MPSCQueue::read_nb_() {
+    const long pos = head_;
+    Cell& cell = cells_[(size_t)pos & mask_];
+
+    // the cell is published when its sequence number is equal to the
+    // head position plus one
+    if (seq_diff(cell.seq, seq_add(pos, 1)) < 0) {
+        return NULL;
+    }
+
+    Packet* packet = cell.packet;
+    cell.packet = NULL;
+
+    // release the cell for the next lap
+    cell.seq.store(seq_add(pos, cells_.size()));
+
+    head_.store(seq_add(pos, 1));
+
+    return packet;
+}
+
+} // namespace packet
+} // namespace roc
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+
+//! @file roc_packet/mpsc_queue.h
+//! @brief Lock-free multi-producer single-consumer packet queue.
+
+#ifndef ROC_PACKET_MPSC_QUEUE_H_
+#define ROC_PACKET_MPSC_QUEUE_H_
+
+#include "roc_core/array.h"
+#include "roc_core/atomic.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/semaphore.h"
+#include "roc_packet/ireader.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/packet.h"
+
+namespace roc {
+namespace packet {
+
+//! Lock-free multi-producer single-consumer packet queue.
+//!
+//! @remarks
+//!  A bounded fifo implemented as a ring buffer of sequenced cells. Any number
+//!  of threads may call write() concurrently, but only one thread at a time
+//!  may call read(), read_batch(), or wait(). Neither write() nor read() takes
+//!  a lock, and write() doesn't perform system calls unless the consumer is
+//!  blocked in wait().
+class MPSCQueue : public IReader, public IWriter, public core::NonCopyable<> {
+public:
+    //! Construct queue.
+    //!
+    //! @b Parameters
+    //!  - @p allocator is used to allocate the ring buffer
+    //!  - @p max_size specifies maximum number of packets in queue; it's
+    //!    rounded up to the nearest power of two
+    MPSCQueue(core::IAllocator& allocator, size_t max_size);
+
+    ~MPSCQueue();
+
+    //! Read next packet.
+    //! @returns
+    //!  the first packet in the queue or null if there are no packets.
+    //! @remarks
+    //!  Removes returned packet from the queue. Should be called only
+    //!  from the consumer thread.
+    virtual PacketPtr read();
+
+    //! Read multiple packets.
+    //! @returns
+    //!  number of packets written to @p packets, no more than @p max_packets.
+    //! @remarks
+    //!  Removes returned packets from the queue. Should be called only
+    //!  from the consumer thread.
+    size_t read_batch(PacketPtr* packets, size_t max_packets);
+
+    //! Add packet to the end of the queue.
+    //! @remarks
+    //!  Drops the packet if the queue is full. May be called from
+    //!  any thread.
+    virtual void write(const PacketPtr& packet);
+
+    //! Wait until the queue becomes non-empty.
+    //! @remarks
+    //!  Should be called only from the consumer thread.
+    void wait();
+
+    //! Get number of packets in queue.
+    size_t size() const;
+
+    //! Get maximum number of packets in queue.
+    size_t max_size() const;
+
+private:
+    struct Cell {
+        core::Atomic seq;
+        Packet* packet;
+
+        Cell()
+            : packet(NULL) {
+        }
+    };
+
+    bool readable_() const;
+    Packet* read_nb_();
+
+    core::Array<Cell> cells_;
+    const size_t mask_;
+
+    core::Atomic head_;
+    core::Atomic tail_;
+
+    core::Atomic waiters_;
+    core::Semaphore sem_;
+};
+
+} // namespace packet
+} // namespace roc
+
+#endif // ROC_PACKET_MPSC_QUEUE_H_
@@ -15,7 +15,9 @@ namespace packet {
 
 Packet::Packet(PacketPool& pool)
     : pool_(pool)
-    , flags_(0) {
+    , flags_(0)
+    , trace_id_(0) {
+    udp_.receive_timestamp = 0;
 }
 
 void Packet::add_flags(unsigned fl) {
@@ -85,6 +87,14 @@ void Packet::set_data(const core::Slice<uint8_t>& d) {
     data_ = d;
 }
 
+uint64_t Packet::trace_id() const {
+    return trace_id_;
+}
+
+void Packet::set_trace_id(uint64_t id) {
+    trace_id_ = id;
+}
+
 source_t Packet::source() const {
     if (const RTP* r = rtp()) {
         return r->source;
@@ -78,6 +78,15 @@ public:
     //! Set packet data.
     void set_data(const core::Slice<uint8_t>& data);
 
+    //! Get packet trace identifier.
+    //! @remarks
+    //!  Non-zero if the packet is traced by core::Tracer. Trace events
+    //!  related to the packet are recorded with this identifier.
+    uint64_t trace_id() const;
+
+    //! Set packet trace identifier.
+    void set_trace_id(uint64_t id);
+
     //! Return packet stream identifier.
     //! @remarks
     //!  The returning value depends on packet type. For some packet types, may
@@ -127,6 +136,8 @@ private:
     FEC fec_;
 
     core::Slice<uint8_t> data_;
+
+    uint64_t trace_id_;
 };
 
 } // namespace packet
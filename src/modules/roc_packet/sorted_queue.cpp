@@ -9,22 +9,62 @@
 
 #include "roc_packet/sorted_queue.h"
 #include "roc_core/log.h"
+#include "roc_core/macros.h"
 #include "roc_core/panic.h"
 
 namespace roc {
 namespace packet {
 
-SortedQueue::SortedQueue(size_t max_size)
-    : max_size_(max_size) {
+namespace {
+
+bool seqnum_lt(seqnum_t a, seqnum_t b) {
+    return ROC_UNSIGNED_LT(signed_seqnum_t, a, b);
+}
+
+// Number of seqnums in range [first; last].
+size_t seqnum_span(seqnum_t first, seqnum_t last) {
+    return (size_t)(seqnum_t)(last - first) + 1;
+}
+
+} // namespace
+
+SortedQueue::SortedQueue(core::IAllocator& allocator, size_t max_size)
+    : allocator_(allocator)
+    , ring_(NULL)
+    , ring_size_(0)
+    , head_sn_(0)
+    , tail_sn_(0)
+    , size_(0)
+    , max_size_(max_size)
+    , n_duplicates_(0) {
+}
+
+SortedQueue::~SortedQueue() {
+    release_();
 }
 
 PacketPtr SortedQueue::read() {
-    if (PacketPtr packet = list_.back()) {
-        list_.remove(*packet);
-        return packet;
+    if (size_ == 0) {
+        return NULL;
     }
 
-    return NULL;
+    PacketPtr& head = slot_(head_sn_);
+    roc_panic_if(!head);
+
+    PacketPtr packet = head;
+    head = NULL;
+
+    if (--size_ != 0) {
+        // skip slots of packets that were not received
+        do {
+            head_sn_++;
+        } while (!slot_(head_sn_));
+    } else if (ring_size_ > MaxIdleRingSize) {
+        // don't keep the ring grown by a large seqnum gap forever
+        release_();
+    }
+
+    return packet;
 }
 
 void SortedQueue::write(const PacketPtr& packet) {
@@ -32,47 +72,132 @@ void SortedQueue::write(const PacketPtr& packet) {
         roc_panic("sorted queue: attempting to add null packet");
     }
 
-    if (max_size_ > 0 && list_.size() == max_size_) {
+    if (!packet->rtp()) {
+        roc_panic("sorted queue: attempting to add non-rtp packet");
+    }
+
+    if (max_size_ > 0 && size_ == max_size_) {
         roc_log(LogDebug, "sorted queue: queue is full, dropping packet:"
                           " max_size=%u",
                 (unsigned)max_size_);
         return;
     }
 
-    PacketPtr pos = list_.front();
+    const seqnum_t sn = packet->rtp()->seqnum;
 
-    for (; pos; pos = list_.nextof(*pos)) {
-        const int cmp = packet->compare(*pos);
-
-        if (cmp < 0) {
-            continue;
+    if (size_ == 0) {
+        if (!reserve_(1)) {
+            return;
         }
-
-        if (cmp == 0) {
-            roc_log(LogDebug, "sorted queue: dropping duplicate packet");
+        head_sn_ = tail_sn_ = sn;
+    } else if (seqnum_lt(sn, head_sn_)) {
+        if (!reserve_(seqnum_span(sn, tail_sn_))) {
             return;
         }
-
-        break;
+        head_sn_ = sn;
+    } else if (seqnum_lt(tail_sn_, sn)) {
+        if (!reserve_(seqnum_span(head_sn_, sn))) {
+            return;
+        }
+        tail_sn_ = sn;
+    } else if (slot_(sn)) {
+        roc_log(LogDebug, "sorted queue: dropping duplicate packet");
+        n_duplicates_++;
+        return;
     }
 
-    if (pos) {
-        list_.insert_before(*packet, *pos);
-    } else {
-        list_.push_back(*packet);
-    }
+    slot_(sn) = packet;
+    size_++;
 }
 
 size_t SortedQueue::size() const {
-    return list_.size();
+    return size_;
+}
+
+size_t SortedQueue::n_duplicates() const {
+    return n_duplicates_;
 }
 
 PacketPtr SortedQueue::head() const {
-    return list_.back();
+    if (size_ == 0) {
+        return NULL;
+    }
+    return slot_(head_sn_);
 }
 
 PacketPtr SortedQueue::tail() const {
-    return list_.front();
+    if (size_ == 0) {
+        return NULL;
+    }
+    return slot_(tail_sn_);
+}
+
+PacketPtr& SortedQueue::slot_(seqnum_t sn) const {
+    // ring size is a power of two not larger than seqnum range, so
+    // seqnum wrapping doesn't break indexing
+    return ring_[sn & (ring_size_ - 1)];
+}
+
+bool SortedQueue::reserve_(size_t span) {
+    if (span <= ring_size_) {
+        return true;
+    }
+
+    if (span > MaxRingSize) {
+        roc_log(LogDebug, "sorted queue: seqnum range is too large, dropping packet:"
+                          " span=%lu max=%lu",
+                (unsigned long)span, (unsigned long)MaxRingSize);
+        return false;
+    }
+
+    size_t new_size = ROC_MAX(ring_size_, (size_t)MinRingSize);
+    while (new_size < span) {
+        new_size *= 2;
+    }
+
+    PacketPtr* new_ring = (PacketPtr*)allocator_.allocate(new_size * sizeof(PacketPtr));
+    if (!new_ring) {
+        roc_log(LogError, "sorted queue: can't allocate ring buffer, dropping packet:"
+                          " size=%lu",
+                (unsigned long)new_size);
+        return false;
+    }
+
+    for (size_t n = 0; n < new_size; n++) {
+        new (new_ring + n) PacketPtr();
+    }
+
+    if (ring_ && size_ != 0) {
+        const size_t old_span = seqnum_span(head_sn_, tail_sn_);
+        for (size_t n = 0; n < old_span; n++) {
+            const seqnum_t sn = seqnum_t(head_sn_ + n);
+            new_ring[sn & (new_size - 1)] = slot_(sn);
+        }
+    }
+
+    roc_log(LogTrace, "sorted queue: resized ring buffer: old_size=%lu new_size=%lu",
+            (unsigned long)ring_size_, (unsigned long)new_size);
+
+    release_();
+
+    ring_ = new_ring;
+    ring_size_ = new_size;
+
+    return true;
+}
+
+void SortedQueue::release_() {
+    if (!ring_) {
+        return;
+    }
+
+    for (size_t n = 0; n < ring_size_; n++) {
+        ring_[n].~PacketPtr();
+    }
+    allocator_.deallocate(ring_);
+
+    ring_ = NULL;
+    ring_size_ = 0;
 }
 
 } // namespace packet
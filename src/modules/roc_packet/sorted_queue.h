@@ -13,7 +13,7 @@
 #ifndef ROC_PACKET_SORTED_QUEUE_H_
 #define ROC_PACKET_SORTED_QUEUE_H_
 
-#include "roc_core/list.h"
+#include "roc_core/iallocator.h"
 #include "roc_core/noncopyable.h"
 #include "roc_packet/ireader.h"
 #include "roc_packet/iwriter.h"
@@ -24,18 +24,29 @@ namespace packet {
 
 //! Sorted packet queue.
 //! @remarks
-//!  Packets order is determined by Packet::compare() method.
+//!  Packets are ordered by RTP seqnum, taking wrapping into account.
+//!
+//!  Implemented as a power-of-two ring buffer indexed by seqnum. Insertion,
+//!  duplicate detection, and head() and tail() queries take constant time.
+//!  read() skips empty slots left by lost packets. The ring grows when the
+//!  distance between the first and the last seqnum exceeds its size. A ring
+//!  that has grown large is freed when the queue becomes empty, so that a
+//!  single seqnum jump doesn't hold the memory for the rest of the session.
 class SortedQueue : public IWriter, public IReader, public core::NonCopyable<> {
 public:
     //! Construct empty queue.
     //! @remarks
     //!  If @p max_size is non-zero, it specifies maximum number of packets in queue.
-    SortedQueue(size_t max_size);
+    //!  @p allocator is used to allocate the ring buffer.
+    SortedQueue(core::IAllocator& allocator, size_t max_size);
+
+    ~SortedQueue();
 
     //! Add packet to the queue.
     //! @remarks
     //!  - if the maximum queue size is reached, packet is dropped
     //!  - if packet is equal to another packet in the queue, it is dropped
+    //!  - if the ring buffer can't be grown to fit the packet, it is dropped
     //!  - otherwise, packet is inserted into the queue, keeping the queue sorted
     virtual void write(const PacketPtr& packet);
 
@@ -49,6 +60,9 @@ public:
     //! Get number of packets in queue.
     size_t size() const;
 
+    //! Get number of dropped duplicate packets.
+    size_t n_duplicates() const;
+
     //! Get first packet in the queue.
     //! @returns
     //!  the first packet in the queue or null if there are no packets
@@ -64,8 +78,24 @@ public:
     PacketPtr tail() const;
 
 private:
-    core::List<Packet> list_;
+    enum { MinRingSize = 16, MaxIdleRingSize = 1 << 10, MaxRingSize = 1 << 15 };
+
+    PacketPtr& slot_(seqnum_t sn) const;
+    bool reserve_(size_t span);
+    void release_();
+
+    core::IAllocator& allocator_;
+
+    PacketPtr* ring_;
+    size_t ring_size_;
+
+    seqnum_t head_sn_;
+    seqnum_t tail_sn_;
+
+    size_t size_;
     const size_t max_size_;
+
+    size_t n_duplicates_;
 };
 
 } // namespace packet
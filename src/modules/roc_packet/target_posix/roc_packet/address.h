@@ -70,6 +70,20 @@ public:
         return !(*this == other);
     }
 
+    //! Compute hash of the address.
+    //! @remarks
+    //!  Equal addresses have equal hashes.
+    size_t hash() const {
+        // FNV-1a
+        const uint8_t* data = (const uint8_t*)saddr();
+        size_t h = 2166136261u;
+        for (socklen_t n = 0; n < slen(); n++) {
+            h ^= data[n];
+            h *= 16777619u;
+        }
+        return h;
+    }
+
 private:
     static socklen_t sizeof_(sa_family_t family) {
         switch (family) {
@@ -17,6 +17,7 @@
 
 #include "roc_core/slice.h"
 #include "roc_core/stddefs.h"
+#include "roc_core/time.h"
 #include "roc_packet/address.h"
 
 namespace roc {
@@ -30,6 +31,11 @@ struct UDP {
     //! Destination address.
     Address dst_addr;
 
+    //! Time when the packet was received by kernel.
+    //! @remarks
+    //!  Uses the same clock as core::timestamp(). Zero if unknown.
+    core::nanoseconds_t receive_timestamp;
+
     //! Sender request state.
     uv_udp_send_t request;
 };
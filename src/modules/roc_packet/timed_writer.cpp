@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_packet/timed_writer.h"
+
+namespace roc {
+namespace packet {
+
+TimedWriter::TimedWriter(IWriter& writer, core::Histogram& histogram)
+    : writer_(writer)
+    , histogram_(histogram) {
+}
+
+void TimedWriter::write(const PacketPtr& packet) {
+    const core::nanoseconds_t start = core::timestamp();
+
+    writer_.write(packet);
+
+    histogram_.record(core::timestamp() - start);
+}
+
+} // namespace packet
+} // namespace roc
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_packet/timed_writer.h
+//! @brief Timed writer.
+
+#ifndef ROC_PACKET_TIMED_WRITER_H_
+#define ROC_PACKET_TIMED_WRITER_H_
+
+#include "roc_core/histogram.h"
+#include "roc_core/noncopyable.h"
+#include "roc_packet/iwriter.h"
+
+namespace roc {
+namespace packet {
+
+//! Timed writer.
+//! @remarks
+//!  Writes packets to the output writer and records time spent in every
+//!  write into a histogram.
+class TimedWriter : public IWriter, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    TimedWriter(IWriter& writer, core::Histogram& histogram);
+
+    //! Write packet.
+    virtual void write(const PacketPtr& packet);
+
+private:
+    IWriter& writer_;
+    core::Histogram& histogram_;
+};
+
+} // namespace packet
+} // namespace roc
+
+#endif // ROC_PACKET_TIMED_WRITER_H_
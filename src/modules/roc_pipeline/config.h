@@ -50,7 +50,19 @@ enum Protocol {
     Proto_RTP_LDPC_Source,
 
     //! FEC repair packet + FECFRAME LDPC header.
-    Proto_LDPC_Repair
+    Proto_LDPC_Repair,
+
+    //! RTP source packet + FECFRAME XOR parity footer.
+    Proto_RTP_Parity_Source,
+
+    //! FEC repair packet + FECFRAME XOR parity header.
+    Proto_Parity_Repair,
+
+    //! RTP source packet + FECFRAME random linear code footer.
+    Proto_RTP_RLC_Source,
+
+    //! FEC repair packet + FECFRAME random linear code header.
+    Proto_RLC_Repair
 };
 
 //! Port parameters.
@@ -126,18 +138,41 @@ struct ReceiverConfig {
     SessionConfig default_session;
 
     //! Sample rate, number of samples for all channels per second.
+    //! @remarks
+    //!  If it differs from the sample rate of the session payload type,
+    //!  session performs sample rate conversion.
     size_t sample_rate;
 
     //! Channel mask.
     packet::channel_mask_t channels;
 
+    //! Maximum number of packets queued between the network thread and
+    //! the pipeline thread.
+    //! @remarks
+    //!  If the queue is full, incoming packets are dropped.
+    size_t max_queued_packets;
+
+    //! Number of worker threads used to process sessions in parallel.
+    //! @remarks
+    //!  If zero, all sessions are processed on the thread calling read().
+    size_t num_threads;
+
     //! Constrain receiver speed using a CPU timer according to the sample rate.
     bool timing;
 
+    //! Interval between statistics updates, number of samples per channel.
+    //! @remarks
+    //!  Statistics are published and time of individual stages is measured
+    //!  once per interval. If zero, this is done for every frame.
+    packet::timestamp_t stats_interval;
+
     ReceiverConfig()
         : sample_rate(DefaultSampleRate)
         , channels(DefaultChannelMask)
-        , timing(false) {
+        , max_queued_packets(1024)
+        , num_threads(0)
+        , timing(false)
+        , stats_interval(DefaultSampleRate / 20) {
     }
 };
 
@@ -170,13 +205,19 @@ struct SenderConfig {
     //! FEC scheme parameters.
     fec::Config fec;
 
+    //! Maximum number of FEC blocks waiting for encoding in a separate thread.
+    //! @remarks
+    //!  If zero, repair packets are generated by the thread that writes frames.
+    size_t fec_encoding_queue;
+
     SenderConfig()
         : sample_rate(DefaultSampleRate)
         , channels(DefaultChannelMask)
         , samples_per_packet(DefaultPacketSize)
         , interleaving(false)
         , timing(false)
-        , payload_type(rtp::PayloadType_L16_Stereo) {
+        , payload_type(rtp::PayloadType_L16_Stereo)
+        , fec_encoding_queue(0) {
     }
 };
 
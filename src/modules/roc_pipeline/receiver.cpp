@@ -9,8 +9,10 @@
 
 #include "roc_pipeline/receiver.h"
 #include "roc_core/log.h"
+#include "roc_core/macros.h"
 #include "roc_core/panic.h"
 #include "roc_core/shared_ptr.h"
+#include "roc_core/tracer.h"
 
 namespace roc {
 namespace pipeline {
@@ -26,16 +28,21 @@ Receiver::Receiver(const ReceiverConfig& config,
     , byte_buffer_pool_(byte_buffer_pool)
     , sample_buffer_pool_(sample_buffer_pool)
     , allocator_(allocator)
-    , packet_queue_(0, false)
-    , mixer_(sample_buffer_pool)
+    , polyphase_cache_(allocator)
+    , port_index_(allocator)
+    , session_index_(allocator)
+    , packet_queue_(allocator, config.max_queued_packets)
+    , mixer_(sample_buffer_pool, allocator, config.num_threads)
     , ticker_(config.sample_rate)
     , config_(config)
     , timestamp_(0)
-    , num_channels_(packet::num_channels(config.channels)) {
+    , next_stats_ts_(0)
+    , num_channels_(packet::num_channels(config.channels))
+    , published_stats_(stats_) {
 }
 
 bool Receiver::valid() {
-    return true;
+    return mixer_.valid();
 }
 
 bool Receiver::add_port(const PortConfig& config) {
@@ -47,6 +54,16 @@ bool Receiver::add_port(const PortConfig& config) {
         return false;
     }
 
+    if (port_index_.find(port->address())) {
+        roc_log(LogError, "receiver: can't create port, address is already in use");
+        return false;
+    }
+
+    if (!port_index_.insert(port->address(), *port)) {
+        roc_log(LogError, "receiver: can't create port, can't update port index");
+        return false;
+    }
+
     ports_.push_back(*port);
     return true;
 }
@@ -55,7 +72,27 @@ size_t Receiver::num_sessions() const {
     return sessions_.size();
 }
 
+ReceiverStats Receiver::stats() const {
+    ReceiverStats stats = published_stats_.load();
+    stats.n_packets_received = (size_t)n_packets_received_;
+    return stats;
+}
+
+bool Receiver::latency(ReceiverStage stage, core::HistogramSnapshot& snapshot) const {
+    roc_panic_if(stage < 0 || stage >= ReceiverStage_Count);
+
+#ifndef ROC_DISABLE_HISTOGRAMS
+    latency_[stage].snapshot(snapshot);
+    return true;
+#else
+    (void)snapshot;
+    return false;
+#endif
+}
+
 void Receiver::write(const packet::PacketPtr& packet) {
+    ++n_packets_received_;
+    roc_trace("enqueue", packet->trace_id());
     packet_queue_.write(packet);
 }
 
@@ -64,15 +101,47 @@ IReceiver::Status Receiver::read(audio::Frame& frame) {
         ticker_.wait(timestamp_);
     }
 
+    // most frames are timed as a whole; stages are timed and statistics
+    // are published once per stats interval
+    const bool timed =
+        ROC_UNSIGNED_LE(packet::signed_timestamp_t, next_stats_ts_, timestamp_);
+    if (timed) {
+        next_stats_ts_ = timestamp_ + config_.stats_interval;
+    }
+
+    const core::nanoseconds_t fetch_start = core::timestamp();
+
     fetch_packets_();
 
     const Status status = status_();
 
+    const core::nanoseconds_t mix_start = timed ? core::timestamp() : 0;
+
     mixer_.read(frame);
     timestamp_ += frame.samples.size() / num_channels_;
 
+    const core::nanoseconds_t update_start = timed ? core::timestamp() : 0;
+
     update_sessions_();
 
+    const core::nanoseconds_t update_end = core::timestamp();
+
+    stats_.n_frames++;
+
+#ifndef ROC_DISABLE_HISTOGRAMS
+    latency_[ReceiverStage_Frame].record(update_end - fetch_start);
+#endif
+
+    if (timed) {
+#ifndef ROC_DISABLE_HISTOGRAMS
+        latency_[ReceiverStage_Fetch].record(mix_start - fetch_start);
+        latency_[ReceiverStage_Mix].record(update_start - mix_start);
+        latency_[ReceiverStage_Update].record(update_end - update_start);
+#endif
+        update_stats_(mix_start - fetch_start, update_start - mix_start,
+                      update_end - update_start);
+    }
+
     return status;
 }
 
@@ -97,43 +166,52 @@ IReceiver::Status Receiver::status_() const {
 }
 
 void Receiver::fetch_packets_() {
-    for (;;) {
-        packet::PacketPtr packet = packet_queue_.read();
-        if (!packet) {
-            break;
-        }
+    enum { MaxBatch = 32 };
 
-        if (!parse_packet_(packet)) {
-            roc_log(LogDebug, "receiver: can't parse packet, dropping");
-            continue;
-        }
+    packet::PacketPtr packets[MaxBatch];
 
-        if (!route_packet_(packet)) {
-            roc_log(LogDebug, "receiver: can't route packet, dropping");
-            continue;
+    while (size_t n_packets = packet_queue_.read_batch(packets, MaxBatch)) {
+        for (size_t n = 0; n < n_packets; n++) {
+            const packet::PacketPtr packet = packets[n];
+            packets[n] = NULL;
+
+            if (!parse_packet_(packet)) {
+                roc_log(LogDebug, "receiver: can't parse packet, dropping");
+                continue;
+            }
+
+            if (!route_packet_(packet)) {
+                roc_log(LogDebug, "receiver: can't route packet, dropping");
+                continue;
+            }
         }
     }
 }
 
 bool Receiver::parse_packet_(const packet::PacketPtr& packet) {
-    core::SharedPtr<ReceiverPort> port;
+    const packet::UDP* udp = packet->udp();
+    if (!udp) {
+        return false;
+    }
 
-    for (port = ports_.front(); port; port = ports_.nextof(*port)) {
-        if (port->handle(*packet)) {
-            return true;
-        }
+    ReceiverPort* port = port_index_.find(udp->dst_addr);
+    if (!port) {
+        return false;
     }
 
-    return false;
+    return port->handle(*packet);
 }
 
 bool Receiver::route_packet_(const packet::PacketPtr& packet) {
-    core::SharedPtr<ReceiverSession> sess;
+    const packet::UDP* udp = packet->udp();
+    if (!udp) {
+        return false;
+    }
 
-    for (sess = sessions_.front(); sess; sess = sessions_.nextof(*sess)) {
-        if (sess->handle(packet)) {
-            return true;
-        }
+    roc_trace("route", packet->trace_id());
+
+    if (ReceiverSession* sess = session_index_.find(udp->src_addr)) {
+        return sess->handle(packet);
     }
 
     return create_session_(packet);
@@ -148,9 +226,15 @@ bool Receiver::create_session_(const packet::PacketPtr& packet) {
     }
     const packet::Address src_address = packet->udp()->src_addr;
 
-    core::SharedPtr<ReceiverSession> sess = new (allocator_)
-        ReceiverSession(config_.default_session, src_address, format_map_, packet_pool_,
-                        byte_buffer_pool_, sample_buffer_pool_, allocator_);
+    core::SharedPtr<ReceiverSession> sess = new (allocator_) ReceiverSession(
+        config_.default_session, config_.sample_rate, src_address, format_map_,
+        packet_pool_, byte_buffer_pool_, sample_buffer_pool_, polyphase_cache_,
+#ifndef ROC_DISABLE_HISTOGRAMS
+        latency_,
+#else
+        NULL,
+#endif
+        allocator_);
 
     if (!sess || !sess->valid()) {
         roc_log(LogError, "receiver: can't create session, initialization failed");
@@ -162,7 +246,17 @@ bool Receiver::create_session_(const packet::PacketPtr& packet) {
         return false;
     }
 
-    mixer_.add(sess->reader());
+    if (!mixer_.add(sess->reader())) {
+        roc_log(LogError, "receiver: can't create session, can't add reader to mixer");
+        return false;
+    }
+
+    if (!session_index_.insert(sess->address(), *sess)) {
+        roc_log(LogError, "receiver: can't create session, can't update session index");
+        mixer_.remove(sess->reader());
+        return false;
+    }
+
     sessions_.push_back(*sess);
 
     return true;
@@ -171,7 +265,15 @@ bool Receiver::create_session_(const packet::PacketPtr& packet) {
 void Receiver::remove_session_(ReceiverSession& sess) {
     roc_log(LogInfo, "receiver: removing session");
 
+    const SessionStats stats = sess.stats();
+
+    removed_sessions_stats_.n_packets_late += stats.n_packets_late;
+    removed_sessions_stats_.n_packets_duplicate += stats.n_packets_duplicate;
+    removed_sessions_stats_.n_packets_repaired += stats.n_packets_repaired;
+    removed_sessions_stats_.n_samples_concealed += stats.n_samples_concealed;
+
     mixer_.remove(sess.reader());
+    session_index_.remove(sess.address());
     sessions_.remove(sess);
 }
 
@@ -187,5 +289,40 @@ void Receiver::update_sessions_() {
     }
 }
 
+void Receiver::update_stats_(core::nanoseconds_t fetch_time,
+                             core::nanoseconds_t mix_time,
+                             core::nanoseconds_t update_time) {
+    stats_.n_sessions = sessions_.size();
+    stats_.n_timed_frames++;
+    stats_.fetch_time += fetch_time;
+    stats_.mix_time += mix_time;
+    stats_.update_time += update_time;
+
+    SessionStats& sum = stats_.sessions;
+
+    sum = removed_sessions_stats_;
+    sum.resampler_scaling = 0;
+
+    for (core::SharedPtr<ReceiverSession> sess = sessions_.front(); sess;
+         sess = sessions_.nextof(*sess)) {
+        const SessionStats stats = sess->stats();
+
+        sum.n_packets_late += stats.n_packets_late;
+        sum.n_packets_duplicate += stats.n_packets_duplicate;
+        sum.n_packets_repaired += stats.n_packets_repaired;
+        sum.n_samples_concealed += stats.n_samples_concealed;
+        sum.queue_size += stats.queue_size;
+        sum.resampler_scaling += stats.resampler_scaling;
+    }
+
+    if (sessions_.size() != 0) {
+        sum.resampler_scaling /= (float)sessions_.size();
+    } else {
+        sum.resampler_scaling = 1.0f;
+    }
+
+    published_stats_.store(stats_);
+}
+
 } // namespace pipeline
 } // namespace roc
@@ -14,20 +14,26 @@
 #define ROC_PIPELINE_RECEIVER_H_
 
 #include "roc_audio/ireader.h"
-#include "roc_audio/mixer.h"
+#include "roc_audio/parallel_mixer.h"
+#include "roc_audio/polyphase_cache.h"
+#include "roc_core/atomic.h"
 #include "roc_core/buffer_pool.h"
+#include "roc_core/hash_map.h"
 #include "roc_core/iallocator.h"
 #include "roc_core/list.h"
 #include "roc_core/noncopyable.h"
+#include "roc_core/seqlock.h"
+#include "roc_core/time.h"
 #include "roc_core/unique_ptr.h"
-#include "roc_packet/concurrent_queue.h"
 #include "roc_packet/ireader.h"
 #include "roc_packet/iwriter.h"
+#include "roc_packet/mpsc_queue.h"
 #include "roc_packet/packet_pool.h"
 #include "roc_pipeline/config.h"
 #include "roc_pipeline/ireceiver.h"
 #include "roc_pipeline/receiver_port.h"
 #include "roc_pipeline/receiver_session.h"
+#include "roc_pipeline/stats.h"
 #include "roc_rtp/format_map.h"
 
 namespace roc {
@@ -53,6 +59,20 @@ public:
     //! Get number of alive sessions.
     size_t num_sessions() const;
 
+    //! Get receiver statistics.
+    //! @remarks
+    //!  Statistics are updated after every read(). This method doesn't take
+    //!  locks and may be called from any thread.
+    ReceiverStats stats() const;
+
+    //! Get latency histogram of pipeline stage.
+    //! @remarks
+    //!  Histograms are updated during every read(). This method doesn't take
+    //!  locks and may be called from any thread.
+    //! @returns
+    //!  false if histograms are disabled at compile time.
+    bool latency(ReceiverStage stage, core::HistogramSnapshot& snapshot) const;
+
     //! Write packet.
     virtual void write(const packet::PacketPtr&);
 
@@ -75,6 +95,15 @@ private:
 
     void update_sessions_();
 
+    void update_stats_(core::nanoseconds_t fetch_time,
+                       core::nanoseconds_t mix_time,
+                       core::nanoseconds_t update_time);
+
+#ifndef ROC_DISABLE_HISTOGRAMS
+    // declared first, so that it outlives pipeline elements recording to it
+    core::Histogram latency_[ReceiverStage_Count];
+#endif
+
     const rtp::FormatMap& format_map_;
 
     packet::PacketPool& packet_pool_;
@@ -82,18 +111,32 @@ private:
     core::BufferPool<audio::sample_t>& sample_buffer_pool_;
     core::IAllocator& allocator_;
 
+    audio::PolyphaseCache polyphase_cache_;
+
     core::List<ReceiverPort> ports_;
     core::List<ReceiverSession> sessions_;
 
-    packet::ConcurrentQueue packet_queue_;
+    core::HashMap<packet::Address, ReceiverPort> port_index_;
+    core::HashMap<packet::Address, ReceiverSession> session_index_;
 
-    audio::Mixer mixer_;
+    packet::MPSCQueue packet_queue_;
+
+    audio::ParallelMixer mixer_;
     core::Ticker ticker_;
 
     ReceiverConfig config_;
 
     packet::timestamp_t timestamp_;
+    packet::timestamp_t next_stats_ts_;
     size_t num_channels_;
+
+    core::Atomic n_packets_received_;
+
+    // counters of terminated sessions
+    SessionStats removed_sessions_stats_;
+
+    ReceiverStats stats_;
+    core::Seqlock<ReceiverStats> published_stats_;
 };
 
 } // namespace pipeline
@@ -29,6 +29,8 @@ ReceiverPort::ReceiverPort(const PortConfig& config,
     case Proto_RTP:
     case Proto_RTP_LDPC_Source:
     case Proto_RTP_RSm8_Source:
+    case Proto_RTP_Parity_Source:
+    case Proto_RTP_RLC_Source:
         rtp_parser_.reset(new (allocator) rtp::Parser(format_map, NULL), allocator);
         if (!rtp_parser_) {
             return;
@@ -78,12 +80,54 @@ ReceiverPort::ReceiverPort(const PortConfig& config,
         }
         parser = fec_parser_.get();
         break;
+    case Proto_RTP_Parity_Source:
+        fec_parser_.reset(
+            new (allocator)
+                fec::Parser<fec::Parity_PayloadID, fec::Source, fec::Footer>(parser),
+            allocator);
+        if (!fec_parser_) {
+            return;
+        }
+        parser = fec_parser_.get();
+        break;
+    case Proto_Parity_Repair:
+        fec_parser_.reset(
+            new (allocator)
+                fec::Parser<fec::Parity_PayloadID, fec::Repair, fec::Header>(parser),
+            allocator);
+        if (!fec_parser_) {
+            return;
+        }
+        parser = fec_parser_.get();
+        break;
+    case Proto_RTP_RLC_Source:
+        fec_parser_.reset(
+            new (allocator)
+                fec::Parser<fec::RLC_PayloadID, fec::Source, fec::Footer>(parser),
+            allocator);
+        if (!fec_parser_) {
+            return;
+        }
+        parser = fec_parser_.get();
+        break;
+    case Proto_RLC_Repair:
+        fec_parser_.reset(
+            new (allocator)
+                fec::Parser<fec::RLC_PayloadID, fec::Repair, fec::Header>(parser),
+            allocator);
+        if (!fec_parser_) {
+            return;
+        }
+        parser = fec_parser_.get();
+        break;
     }
 
     // FIXME
     switch ((unsigned)config.protocol) {
     case Proto_LDPC_Repair:
     case Proto_RSm8_Repair:
+    case Proto_Parity_Repair:
+    case Proto_RLC_Repair:
         rtp_parser_.reset(new (allocator) rtp::Parser(format_map, parser), allocator);
         if (!rtp_parser_) {
             return;
@@ -103,6 +147,10 @@ bool ReceiverPort::valid() const {
     return parser_;
 }
 
+const packet::Address& ReceiverPort::address() const {
+    return dst_address_;
+}
+
 bool ReceiverPort::handle(packet::Packet& packet) {
     roc_panic_if(!valid());
 
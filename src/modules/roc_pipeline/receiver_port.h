@@ -38,6 +38,9 @@ public:
     //! Check if the port pipeline was succefully constructed.
     bool valid() const;
 
+    //! Get listened address.
+    const packet::Address& address() const;
+
     //! Try to handle packet on this port.
     //! @returns
     //!  true if the packet is dedicated for this port
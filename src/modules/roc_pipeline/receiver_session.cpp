@@ -10,29 +10,37 @@
 #include "roc_pipeline/receiver_session.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
-
-#ifdef ROC_TARGET_OPENFEC
-#include "roc_fec/of_decoder.h"
-#endif
+#include "roc_core/tracer.h"
+#include "roc_fec/codec_factory.h"
 
 namespace roc {
 namespace pipeline {
 
 ReceiverSession::ReceiverSession(const SessionConfig& config,
+                                 size_t output_rate,
                                  const packet::Address& src_address,
                                  const rtp::FormatMap& format_map,
                                  packet::PacketPool& packet_pool,
                                  core::BufferPool<uint8_t>& byte_buffer_pool,
                                  core::BufferPool<audio::sample_t>& sample_buffer_pool,
+                                 audio::PolyphaseCache& polyphase_cache,
+                                 core::Histogram* latency,
                                  core::IAllocator& allocator)
     : src_address_(src_address)
     , allocator_(allocator)
-    , audio_reader_(NULL) {
+    , audio_reader_(NULL)
+    , input_rate_(output_rate)
+    , output_rate_(output_rate)
+    , has_output_time_(false)
+    , last_output_time_(0)
+    , output_elapsed_(0) {
     const rtp::Format* format = format_map.format(config.payload_type);
     if (!format) {
         return;
     }
 
+    input_rate_ = format->sample_rate;
+
     if (config.resampling) {
         resampler_updater_.reset(new (allocator_) audio::ResamplerUpdater(
                                      config.fe_update_interval, config.latency),
@@ -47,7 +55,7 @@ ReceiverSession::ReceiverSession(const SessionConfig& config,
         return;
     }
 
-    source_queue_.reset(new (allocator_) packet::SortedQueue(0), allocator_);
+    source_queue_.reset(new (allocator_) packet::SortedQueue(allocator_, 0), allocator_);
     if (!source_queue_) {
         return;
     }
@@ -65,8 +73,9 @@ ReceiverSession::ReceiverSession(const SessionConfig& config,
 
     packet::IReader* preader = source_queue_.get();
 
-    delayed_reader_.reset(
-        new (allocator_) packet::DelayedReader(*preader, config.latency), allocator_);
+    delayed_reader_.reset(new (allocator_) packet::DelayedReader(*preader, config.latency,
+                                                                 allocator_),
+                          allocator_);
     if (!delayed_reader_) {
         return;
     }
@@ -86,9 +95,9 @@ ReceiverSession::ReceiverSession(const SessionConfig& config,
     }
     preader = watchdog_.get();
 
-#ifdef ROC_TARGET_OPENFEC
     if (config.fec.codec != fec::NoCodec) {
-        repair_queue_.reset(new (allocator_) packet::SortedQueue(0), allocator_);
+        repair_queue_.reset(new (allocator_) packet::SortedQueue(allocator_, 0),
+                            allocator_);
         if (!repair_queue_) {
             return;
         }
@@ -96,9 +105,9 @@ ReceiverSession::ReceiverSession(const SessionConfig& config,
             return;
         }
 
-        fec_decoder_.reset(new (allocator_) fec::OFDecoder(
-                               config.fec, format->size(config.samples_per_packet),
-                               byte_buffer_pool, allocator_),
+        fec_decoder_.reset(fec::new_decoder(config.fec,
+                                            format->size(config.samples_per_packet),
+                                            byte_buffer_pool, allocator_),
                            allocator_);
         if (!fec_decoder_) {
             return;
@@ -133,7 +142,6 @@ ReceiverSession::ReceiverSession(const SessionConfig& config,
         }
         preader = fec_watchdog_.get();
     }
-#endif // ROC_TARGET_OPENFEC
 
     if (config.resampling) {
         resampler_updater_->set_reader(*preader);
@@ -154,7 +162,19 @@ ReceiverSession::ReceiverSession(const SessionConfig& config,
 
     audio::IReader* areader = depacketizer_.get();
 
-    if (config.resampling) {
+    if (latency) {
+        depacketizer_timer_.reset(new (allocator_) audio::TimedReader(
+                                      *areader, latency[ReceiverStage_Depacketize]),
+                                  allocator_);
+        if (!depacketizer_timer_) {
+            return;
+        }
+        areader = depacketizer_timer_.get();
+    }
+
+    const bool convert_rate = (format->sample_rate != output_rate);
+
+    if (config.resampling || convert_rate) {
         resampler_.reset(new (allocator_)
                              audio::Resampler(*areader, sample_buffer_pool, allocator,
                                               config.resampler, config.channels),
@@ -162,10 +182,32 @@ ReceiverSession::ReceiverSession(const SessionConfig& config,
         if (!resampler_) {
             return;
         }
-        resampler_updater_->set_resampler(*resampler_);
+        if (convert_rate) {
+            core::SharedPtr<audio::PolyphaseBank> bank = polyphase_cache.get(
+                format->sample_rate, output_rate, config.resampler.window_size);
+            if (!bank) {
+                return;
+            }
+            if (!resampler_->set_bank(*bank)) {
+                return;
+            }
+        }
+        if (resampler_updater_) {
+            resampler_updater_->set_resampler(*resampler_);
+        }
         areader = resampler_.get();
     }
 
+    if (latency) {
+        session_timer_.reset(new (allocator_) audio::TimedReader(
+                                 *areader, latency[ReceiverStage_Session]),
+                             allocator_);
+        if (!session_timer_) {
+            return;
+        }
+        areader = session_timer_.get();
+    }
+
     audio_reader_ = areader;
 }
 
@@ -177,6 +219,10 @@ bool ReceiverSession::valid() const {
     return audio_reader_;
 }
 
+const packet::Address& ReceiverSession::address() const {
+    return src_address_;
+}
+
 bool ReceiverSession::handle(const packet::PacketPtr& packet) {
     roc_panic_if(!valid());
 
@@ -190,12 +236,18 @@ bool ReceiverSession::handle(const packet::PacketPtr& packet) {
     }
 
     queue_router_->write(packet);
+    roc_trace("queue", packet->trace_id());
+
     return true;
 }
 
-bool ReceiverSession::update(packet::timestamp_t time) {
+bool ReceiverSession::update(packet::timestamp_t output_time) {
     roc_panic_if(!valid());
 
+    // watchdog timeout and resampler update interval are measured in
+    // samples of the session payload type
+    const packet::timestamp_t time = session_time_(output_time);
+
     if (watchdog_) {
         if (!watchdog_->update(time)) {
             return false;
@@ -217,11 +269,51 @@ bool ReceiverSession::update(packet::timestamp_t time) {
     return true;
 }
 
+packet::timestamp_t ReceiverSession::session_time_(packet::timestamp_t output_time) {
+    if (input_rate_ == output_rate_) {
+        return output_time;
+    }
+
+    if (!has_output_time_) {
+        last_output_time_ = output_time;
+        has_output_time_ = true;
+    }
+
+    output_elapsed_ += packet::timestamp_t(output_time - last_output_time_);
+    last_output_time_ = output_time;
+
+    return packet::timestamp_t(output_elapsed_ * input_rate_ / output_rate_);
+}
+
 audio::IReader& ReceiverSession::reader() {
     roc_panic_if(!valid());
 
     return *audio_reader_;
 }
 
+SessionStats ReceiverSession::stats() const {
+    SessionStats stats;
+
+    if (source_queue_) {
+        stats.n_packets_duplicate = source_queue_->n_duplicates();
+        stats.queue_size = source_queue_->size();
+    }
+
+    if (fec_reader_) {
+        stats.n_packets_repaired = fec_reader_->n_repairs_succeeded();
+    }
+
+    if (depacketizer_) {
+        stats.n_packets_late = depacketizer_->n_late_packets();
+        stats.n_samples_concealed = depacketizer_->n_missing_samples();
+    }
+
+    if (resampler_updater_) {
+        stats.resampler_scaling = resampler_updater_->scaling();
+    }
+
+    return stats;
+}
+
 } // namespace pipeline
 } // namespace roc
@@ -16,9 +16,12 @@
 #include "roc_audio/depacketizer.h"
 #include "roc_audio/idecoder.h"
 #include "roc_audio/ireader.h"
+#include "roc_audio/polyphase_cache.h"
 #include "roc_audio/resampler.h"
 #include "roc_audio/resampler_updater.h"
+#include "roc_audio/timed_reader.h"
 #include "roc_core/buffer_pool.h"
+#include "roc_core/histogram.h"
 #include "roc_core/iallocator.h"
 #include "roc_core/list_node.h"
 #include "roc_core/refcnt.h"
@@ -35,6 +38,7 @@
 #include "roc_packet/sorted_queue.h"
 #include "roc_packet/watchdog.h"
 #include "roc_pipeline/config.h"
+#include "roc_pipeline/stats.h"
 #include "roc_rtp/format_map.h"
 #include "roc_rtp/parser.h"
 #include "roc_rtp/validator.h"
@@ -48,23 +52,39 @@ namespace pipeline {
 class ReceiverSession : public core::RefCnt<ReceiverSession>, public core::ListNode {
 public:
     //! Initialize.
+    //!
+    //! @b Parameters
+    //!  - @p output_rate defines sample rate of the session output; if it differs
+    //!    from the sample rate of the session payload type, samples are resampled
+    //!    using a filter bank from @p polyphase_cache
+    //!  - @p latency is an array of ReceiverStage_Count histograms where
+    //!    session stages are recorded, or NULL to disable recording
     ReceiverSession(const SessionConfig& config,
+                    size_t output_rate,
                     const packet::Address& src_address,
                     const rtp::FormatMap& format_map,
                     packet::PacketPool& packet_pool,
                     core::BufferPool<uint8_t>& byte_buffer_pool,
                     core::BufferPool<audio::sample_t>& sample_buffer_pool,
+                    audio::PolyphaseCache& polyphase_cache,
+                    core::Histogram* latency,
                     core::IAllocator& allocator);
 
     //! Check if the session pipeline was succefully constructed.
     bool valid() const;
 
+    //! Get address of the sender.
+    const packet::Address& address() const;
+
     //! Try to route a packet to this session.
     //! @returns
     //!  true if the packet is dedicated for this session
     bool handle(const packet::PacketPtr& packet);
 
     //! Update session.
+    //! @remarks
+    //!  @p time is the receiver timestamp, in samples of the session output;
+    //!  it's converted to the session payload sample rate when they differ.
     //! @returns
     //!  false if the session is terminated
     bool update(packet::timestamp_t time);
@@ -72,11 +92,16 @@ public:
     //! Get audio reader.
     audio::IReader& reader();
 
+    //! Get session statistics.
+    SessionStats stats() const;
+
 private:
     friend class core::RefCnt<ReceiverSession>;
 
     void destroy();
 
+    packet::timestamp_t session_time_(packet::timestamp_t time);
+
     const packet::Address src_address_;
 
     core::IAllocator& allocator_;
@@ -100,9 +125,21 @@ private:
 
     core::UniquePtr<audio::IDecoder> decoder_;
     core::UniquePtr<audio::Depacketizer> depacketizer_;
+    core::UniquePtr<audio::TimedReader> depacketizer_timer_;
 
     core::UniquePtr<audio::Resampler> resampler_;
     core::UniquePtr<audio::ResamplerUpdater> resampler_updater_;
+
+    core::UniquePtr<audio::TimedReader> session_timer_;
+
+    // sample rates of the session payload type and the session output
+    size_t input_rate_;
+    size_t output_rate_;
+
+    // output samples elapsed since the first update
+    bool has_output_time_;
+    packet::timestamp_t last_output_time_;
+    uint64_t output_elapsed_;
 };
 
 } // namespace pipeline
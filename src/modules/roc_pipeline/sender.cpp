@@ -10,10 +10,7 @@
 #include "roc_pipeline/sender.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
-
-#ifdef ROC_TARGET_OPENFEC
-#include "roc_fec/of_encoder.h"
-#endif
+#include "roc_fec/codec_factory.h"
 
 namespace roc {
 namespace pipeline {
@@ -28,21 +25,43 @@ Sender::Sender(const SenderConfig& config,
     : ticker_(config.sample_rate)
     , timing_(config.timing)
     , timestamp_(0)
-    , num_channels_(packet::num_channels(config.channels)) {
+    , num_channels_(packet::num_channels(config.channels))
+    , published_stats_(stats_) {
     const rtp::Format* format = format_map.format(config.payload_type);
     if (!format) {
         return;
     }
 
+    packet::IWriter* source_pwriter = &source_writer;
+    packet::IWriter* repair_pwriter = &repair_writer;
+
+#ifndef ROC_DISABLE_HISTOGRAMS
+    source_timer_.reset(new (allocator) packet::TimedWriter(
+                            *source_pwriter, latency_[SenderStage_Send]),
+                        allocator);
+    if (!source_timer_) {
+        return;
+    }
+    source_pwriter = source_timer_.get();
+
+    repair_timer_.reset(new (allocator) packet::TimedWriter(
+                            *repair_pwriter, latency_[SenderStage_Send]),
+                        allocator);
+    if (!repair_timer_) {
+        return;
+    }
+    repair_pwriter = repair_timer_.get();
+#endif
+
     source_port_.reset(new (allocator)
-                           SenderPort(config.source_port, source_writer, allocator),
+                           SenderPort(config.source_port, *source_pwriter, allocator),
                        allocator);
     if (!source_port_ || !source_port_->valid()) {
         return;
     }
 
     repair_port_.reset(new (allocator)
-                           SenderPort(config.repair_port, repair_writer, allocator),
+                           SenderPort(config.repair_port, *repair_pwriter, allocator),
                        allocator);
     if (!repair_port_ || !repair_port_->valid()) {
         return;
@@ -61,7 +80,6 @@ Sender::Sender(const SenderConfig& config,
         return;
     }
 
-#ifdef ROC_TARGET_OPENFEC
     if (config.fec.codec != fec::NoCodec) {
         if (config.interleaving) {
             interleaver_.reset(new (allocator)
@@ -77,8 +95,7 @@ Sender::Sender(const SenderConfig& config,
 
         const size_t source_packet_size = format->size(config.samples_per_packet);
 
-        fec_encoder_.reset(new (allocator)
-                               fec::OFEncoder(config.fec, source_packet_size, allocator),
+        fec_encoder_.reset(fec::new_encoder(config.fec, source_packet_size, allocator),
                            allocator);
         if (!fec_encoder_) {
             return;
@@ -92,9 +109,23 @@ Sender::Sender(const SenderConfig& config,
         if (!fec_writer_) {
             return;
         }
+
+        if (config.fec_encoding_queue != 0
+            && !fec_writer_->start_encoding_thread(config.fec_encoding_queue)) {
+            return;
+        }
         pwriter = fec_writer_.get();
+
+#ifndef ROC_DISABLE_HISTOGRAMS
+        fec_timer_.reset(new (allocator)
+                             packet::TimedWriter(*pwriter, latency_[SenderStage_FEC]),
+                         allocator);
+        if (!fec_timer_) {
+            return;
+        }
+        pwriter = fec_timer_.get();
+#endif
     }
-#endif // ROC_TARGET_OPENFEC
 
     encoder_.reset(format->new_encoder(allocator), allocator);
     if (!encoder_) {
@@ -119,8 +150,46 @@ void Sender::write(audio::Frame& frame) {
         ticker_.wait(timestamp_);
     }
 
+    const core::nanoseconds_t write_start = core::timestamp();
+
     packetizer_->write(frame);
     timestamp_ += frame.samples.size() / num_channels_;
+
+    const core::nanoseconds_t write_time = core::timestamp() - write_start;
+
+    stats_.n_frames++;
+    stats_.write_time += write_time;
+
+#ifndef ROC_DISABLE_HISTOGRAMS
+    latency_[SenderStage_Frame].record(write_time);
+#endif
+
+    published_stats_.store(stats_);
+}
+
+SenderStats Sender::stats() const {
+    SenderStats stats = published_stats_.load();
+
+    if (source_port_) {
+        stats.n_source_packets = source_port_->n_packets();
+    }
+    if (repair_port_) {
+        stats.n_repair_packets = repair_port_->n_packets();
+    }
+
+    return stats;
+}
+
+bool Sender::latency(SenderStage stage, core::HistogramSnapshot& snapshot) const {
+    roc_panic_if(stage < 0 || stage >= SenderStage_Count);
+
+#ifndef ROC_DISABLE_HISTOGRAMS
+    latency_[stage].snapshot(snapshot);
+    return true;
+#else
+    (void)snapshot;
+    return false;
+#endif
 }
 
 } // namespace pipeline
@@ -17,8 +17,10 @@
 #include "roc_audio/iwriter.h"
 #include "roc_audio/packetizer.h"
 #include "roc_core/buffer_pool.h"
+#include "roc_core/histogram.h"
 #include "roc_core/iallocator.h"
 #include "roc_core/noncopyable.h"
+#include "roc_core/seqlock.h"
 #include "roc_core/ticker.h"
 #include "roc_core/unique_ptr.h"
 #include "roc_fec/iencoder.h"
@@ -26,8 +28,10 @@
 #include "roc_packet/interleaver.h"
 #include "roc_packet/packet_pool.h"
 #include "roc_packet/router.h"
+#include "roc_packet/timed_writer.h"
 #include "roc_pipeline/config.h"
 #include "roc_pipeline/sender_port.h"
+#include "roc_pipeline/stats.h"
 #include "roc_rtp/format_map.h"
 
 namespace roc {
@@ -51,7 +55,29 @@ public:
     //! Write audio frame.
     virtual void write(audio::Frame& frame);
 
+    //! Get sender statistics.
+    //! @remarks
+    //!  Frame counter and processing time are updated after every write().
+    //!  This method doesn't take locks and may be called from any thread.
+    SenderStats stats() const;
+
+    //! Get latency histogram of pipeline stage.
+    //! @remarks
+    //!  Histograms are updated during every write(). This method doesn't take
+    //!  locks and may be called from any thread.
+    //! @returns
+    //!  false if histograms are disabled at compile time.
+    bool latency(SenderStage stage, core::HistogramSnapshot& snapshot) const;
+
 private:
+#ifndef ROC_DISABLE_HISTOGRAMS
+    // declared first, so that it outlives pipeline elements recording to it
+    core::Histogram latency_[SenderStage_Count];
+#endif
+
+    core::UniquePtr<packet::TimedWriter> source_timer_;
+    core::UniquePtr<packet::TimedWriter> repair_timer_;
+
     core::UniquePtr<SenderPort> source_port_;
     core::UniquePtr<SenderPort> repair_port_;
 
@@ -61,6 +87,7 @@ private:
 
     core::UniquePtr<fec::IEncoder> fec_encoder_;
     core::UniquePtr<fec::Writer> fec_writer_;
+    core::UniquePtr<packet::TimedWriter> fec_timer_;
 
     core::UniquePtr<audio::IEncoder> encoder_;
     core::UniquePtr<audio::Packetizer> packetizer_;
@@ -70,6 +97,9 @@ private:
 
     packet::timestamp_t timestamp_;
     size_t num_channels_;
+
+    SenderStats stats_;
+    core::Seqlock<SenderStats> published_stats_;
 };
 
 } // namespace pipeline
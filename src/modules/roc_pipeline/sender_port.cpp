@@ -28,6 +28,8 @@ SenderPort::SenderPort(const PortConfig& config,
     case Proto_RTP:
     case Proto_RTP_LDPC_Source:
     case Proto_RTP_RSm8_Source:
+    case Proto_RTP_Parity_Source:
+    case Proto_RTP_RLC_Source:
         rtp_composer_.reset(new (allocator) rtp::Composer(NULL), allocator);
         if (!rtp_composer_) {
             return;
@@ -79,12 +81,54 @@ SenderPort::SenderPort(const PortConfig& config,
         }
         composer = fec_composer_.get();
         break;
+    case Proto_RTP_Parity_Source:
+        fec_composer_.reset(
+            new (allocator)
+                fec::Composer<fec::Parity_PayloadID, fec::Source, fec::Footer>(composer),
+            allocator);
+        if (!fec_composer_) {
+            return;
+        }
+        composer = fec_composer_.get();
+        break;
+    case Proto_Parity_Repair:
+        fec_composer_.reset(
+            new (allocator)
+                fec::Composer<fec::Parity_PayloadID, fec::Repair, fec::Header>(composer),
+            allocator);
+        if (!fec_composer_) {
+            return;
+        }
+        composer = fec_composer_.get();
+        break;
+    case Proto_RTP_RLC_Source:
+        fec_composer_.reset(
+            new (allocator)
+                fec::Composer<fec::RLC_PayloadID, fec::Source, fec::Footer>(composer),
+            allocator);
+        if (!fec_composer_) {
+            return;
+        }
+        composer = fec_composer_.get();
+        break;
+    case Proto_RLC_Repair:
+        fec_composer_.reset(
+            new (allocator)
+                fec::Composer<fec::RLC_PayloadID, fec::Repair, fec::Header>(composer),
+            allocator);
+        if (!fec_composer_) {
+            return;
+        }
+        composer = fec_composer_.get();
+        break;
     }
 
     // FIXME
     switch ((unsigned)config.protocol) {
     case Proto_LDPC_Repair:
     case Proto_RSm8_Repair:
+    case Proto_Parity_Repair:
+    case Proto_RLC_Repair:
         rtp_composer_.reset(new (allocator) rtp::Composer(composer), allocator);
         if (!rtp_composer_) {
             return;
@@ -123,6 +167,12 @@ void SenderPort::write(const packet::PacketPtr& packet) {
     }
 
     writer_.write(packet);
+
+    ++n_packets_;
+}
+
+size_t SenderPort::n_packets() const {
+    return (size_t)n_packets_;
 }
 
 } // namespace pipeline
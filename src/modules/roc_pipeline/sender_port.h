@@ -13,6 +13,7 @@
 #ifndef ROC_PIPELINE_SENDER_PORT_H_
 #define ROC_PIPELINE_SENDER_PORT_H_
 
+#include "roc_core/atomic.h"
 #include "roc_core/iallocator.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/unique_ptr.h"
@@ -43,6 +44,11 @@ public:
     //! Write packet.
     void write(const packet::PacketPtr& packet);
 
+    //! Get number of written packets.
+    //! @remarks
+    //!  May be called from any thread.
+    size_t n_packets() const;
+
 private:
     const packet::Address dst_address_;
 
@@ -51,6 +57,8 @@ private:
 
     core::UniquePtr<rtp::Composer> rtp_composer_;
     core::UniquePtr<packet::IComposer> fec_composer_;
+
+    core::Atomic n_packets_;
 };
 
 } // namespace pipeline
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/stats.h
+//! @brief Pipeline statistics.
+
+#ifndef ROC_PIPELINE_STATS_H_
+#define ROC_PIPELINE_STATS_H_
+
+#include "roc_core/histogram.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Receiver pipeline stages.
+//! @remarks
+//!  Stages are nested, and time of every stage includes time of the stages
+//!  it calls. Fetch, Mix, and Update stages are measured only for timed
+//!  frames, see ReceiverConfig::stats_interval.
+enum ReceiverStage {
+    //! Fetching, parsing, and routing incoming packets.
+    ReceiverStage_Fetch,
+
+    //! Reading frame from session depacketizer, including FEC decoding.
+    ReceiverStage_Depacketize,
+
+    //! Reading frame from session, including depacketizing and resampling.
+    ReceiverStage_Session,
+
+    //! Producing frame mixed from all sessions.
+    ReceiverStage_Mix,
+
+    //! Updating sessions.
+    ReceiverStage_Update,
+
+    //! Whole frame, excluding waiting for the ticker.
+    ReceiverStage_Frame,
+
+    //! Number of stages.
+    ReceiverStage_Count
+};
+
+//! Sender pipeline stages.
+//! @remarks
+//!  Stages are nested, and time of every stage includes time of the stages
+//!  it calls.
+enum SenderStage {
+    //! Writing packet to FEC writer, including FEC encoding and sending.
+    SenderStage_FEC,
+
+    //! Writing packet to network writer.
+    SenderStage_Send,
+
+    //! Whole frame, excluding waiting for the ticker.
+    SenderStage_Frame,
+
+    //! Number of stages.
+    SenderStage_Count
+};
+
+//! Receiver session statistics.
+struct SessionStats {
+    //! Number of packets dropped because they were late.
+    size_t n_packets_late;
+
+    //! Number of dropped duplicate packets.
+    size_t n_packets_duplicate;
+
+    //! Number of packets repaired using FEC.
+    size_t n_packets_repaired;
+
+    //! Number of samples per channel filled in place of lost packets.
+    size_t n_samples_concealed;
+
+    //! Number of packets waiting in the jitter buffer.
+    size_t queue_size;
+
+    //! Resampler scaling factor, or 1 if the resampler is disabled.
+    float resampler_scaling;
+
+    SessionStats()
+        : n_packets_late(0)
+        , n_packets_duplicate(0)
+        , n_packets_repaired(0)
+        , n_samples_concealed(0)
+        , queue_size(0)
+        , resampler_scaling(1.0f) {
+    }
+};
+
+//! Receiver statistics.
+//! @remarks
+//!  Packet and sample counters and queue size are summed over all sessions,
+//!  including terminated ones for the counters. Resampler scaling is averaged
+//!  over active sessions.
+struct ReceiverStats {
+    //! Number of active sessions.
+    size_t n_sessions;
+
+    //! Number of packets received from network.
+    size_t n_packets_received;
+
+    //! Session statistics summed over sessions.
+    SessionStats sessions;
+
+    //! Number of frames read from receiver.
+    size_t n_frames;
+
+    //! Number of frames for which time of individual stages was measured.
+    size_t n_timed_frames;
+
+    //! Total time spent fetching and routing incoming packets in timed frames.
+    core::nanoseconds_t fetch_time;
+
+    //! Total time spent producing timed frames, including depacketizing, FEC
+    //! decoding, resampling, and mixing.
+    core::nanoseconds_t mix_time;
+
+    //! Total time spent updating sessions in timed frames.
+    core::nanoseconds_t update_time;
+
+    ReceiverStats()
+        : n_sessions(0)
+        , n_packets_received(0)
+        , n_frames(0)
+        , n_timed_frames(0)
+        , fetch_time(0)
+        , mix_time(0)
+        , update_time(0) {
+    }
+};
+
+//! Sender statistics.
+struct SenderStats {
+    //! Number of frames written to sender.
+    size_t n_frames;
+
+    //! Number of source packets sent.
+    size_t n_source_packets;
+
+    //! Number of repair packets sent.
+    size_t n_repair_packets;
+
+    //! Total time spent processing frames, including packetizing and FEC
+    //! encoding when it's not performed in a separate thread.
+    core::nanoseconds_t write_time;
+
+    SenderStats()
+        : n_frames(0)
+        , n_source_packets(0)
+        , n_repair_packets(0)
+        , write_time(0) {
+    }
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_STATS_H_
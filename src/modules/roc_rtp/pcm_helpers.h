@@ -16,8 +16,10 @@
 #include "roc_audio/units.h"
 #include "roc_core/endian.h"
 #include "roc_core/stddefs.h"
+#include "roc_packet/rtp.h"
 #include "roc_packet/units.h"
 #include "roc_rtp/headers.h"
+#include "roc_rtp/pcm_kernel.h"
 
 namespace roc {
 namespace rtp {
@@ -53,7 +55,35 @@ inline audio::sample_t pcm_unpack(int16_t ns) {
     return audio::sample_t(hs) / (1 << 15);
 }
 
-//! Decode multiple samples.
+//! Encode multiple interleaved samples without remapping channels.
+template <class Sample>
+void pcm_pack_n(Sample* out, const audio::sample_t* in, size_t n_samples) {
+    for (size_t n = 0; n < n_samples; n++) {
+        out[n] = pcm_pack<Sample>(in[n]);
+    }
+}
+
+//! Encode multiple interleaved samples without remapping channels (int16_t).
+template <>
+inline void pcm_pack_n(int16_t* out, const audio::sample_t* in, size_t n_samples) {
+    pcm_pack_s16(out, in, n_samples);
+}
+
+//! Decode multiple interleaved samples without remapping channels.
+template <class Sample>
+void pcm_unpack_n(audio::sample_t* out, const Sample* in, size_t n_samples) {
+    for (size_t n = 0; n < n_samples; n++) {
+        out[n] = pcm_unpack(in[n]);
+    }
+}
+
+//! Decode multiple interleaved samples without remapping channels (int16_t).
+template <>
+inline void pcm_unpack_n(audio::sample_t* out, const int16_t* in, size_t n_samples) {
+    pcm_unpack_s16(out, in, n_samples);
+}
+
+//! Encode multiple samples.
 template <class Sample, size_t NumCh>
 size_t pcm_write(void* out_data,
                  size_t out_size,
@@ -76,6 +106,11 @@ size_t pcm_write(void* out_data,
 
     Sample* out_samples = (Sample*)out_data + (off * NumCh);
 
+    if (in_chan_mask == out_chan_mask) {
+        pcm_pack_n<Sample>(out_samples, in_samples, in_n_samples * NumCh);
+        return in_n_samples;
+    }
+
     for (size_t ns = 0; ns < in_n_samples; ns++) {
         for (packet::channel_mask_t ch = 1; ch <= inout_chan_mask && ch != 0; ch <<= 1) {
             if (in_chan_mask & ch) {
@@ -116,6 +151,11 @@ size_t pcm_read(const void* in_data,
 
     const Sample* in_samples = (const Sample*)in_data + (off * NumCh);
 
+    if (in_chan_mask == out_chan_mask) {
+        pcm_unpack_n<Sample>(out_samples, in_samples, out_n_samples * NumCh);
+        return out_n_samples;
+    }
+
     for (size_t ns = 0; ns < out_n_samples; ns++) {
         for (packet::channel_mask_t ch = 1; ch <= inout_chan_mask && ch != 0; ch <<= 1) {
             audio::sample_t s = 0;
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_rtp/pcm_kernel.h"
+#include "roc_core/endian.h"
+#include "roc_core/panic.h"
+
+// Vector kernels swap bytes unconditionally, so they're enabled only on
+// little-endian targets.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) \
+    && defined(__SSE2__)
+#define ROC_RTP_PCM_SSE2
+#include <emmintrin.h>
+#endif
+
+#if (defined(__ARM_NEON) || defined(__ARM_NEON__)) && !defined(__ARM_BIG_ENDIAN)
+#define ROC_RTP_PCM_NEON
+#include <arm_neon.h>
+#endif
+
+namespace roc {
+namespace rtp {
+
+namespace {
+
+const float PackScale = float(1 << 15);
+const float UnpackScale = 1.0f / float(1 << 15);
+
+void pack_s16_generic(int16_t* out, const audio::sample_t* in, size_t n_samples) {
+    for (size_t n = 0; n < n_samples; n++) {
+        const int16_t hs = int16_t(in[n] * PackScale);
+        out[n] = (int16_t)ROC_HTON_16(uint16_t(hs));
+    }
+}
+
+void unpack_s16_generic(audio::sample_t* out, const int16_t* in, size_t n_samples) {
+    for (size_t n = 0; n < n_samples; n++) {
+        const int16_t hs = (int16_t)ROC_NTOH_16(uint16_t(in[n]));
+        out[n] = audio::sample_t(hs) * UnpackScale;
+    }
+}
+
+#ifdef ROC_RTP_PCM_SSE2
+
+inline __m128i bswap16_sse2(__m128i v) {
+    return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+
+void pack_s16_sse2(int16_t* out, const audio::sample_t* in, size_t n_samples) {
+    const __m128 scale = _mm_set1_ps(PackScale);
+
+    size_t n = 0;
+
+    for (; n + 8 <= n_samples; n += 8) {
+        const __m128i lo = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(in + n), scale));
+        const __m128i hi =
+            _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(in + n + 4), scale));
+
+        _mm_storeu_si128((__m128i*)(void*)(out + n),
+                         bswap16_sse2(_mm_packs_epi32(lo, hi)));
+    }
+
+    pack_s16_generic(out + n, in + n, n_samples - n);
+}
+
+void unpack_s16_sse2(audio::sample_t* out, const int16_t* in, size_t n_samples) {
+    const __m128 scale = _mm_set1_ps(UnpackScale);
+
+    size_t n = 0;
+
+    for (; n + 8 <= n_samples; n += 8) {
+        const __m128i v =
+            bswap16_sse2(_mm_loadu_si128((const __m128i*)(const void*)(in + n)));
+
+        // sign-extend int16 to int32 by placing it into the upper half
+        const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+
+        _mm_storeu_ps(out + n, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(out + n + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+
+    unpack_s16_generic(out + n, in + n, n_samples - n);
+}
+
+#endif // ROC_RTP_PCM_SSE2
+
+#ifdef ROC_RTP_PCM_NEON
+
+void pack_s16_neon(int16_t* out, const audio::sample_t* in, size_t n_samples) {
+    size_t n = 0;
+
+    for (; n + 8 <= n_samples; n += 8) {
+        const int32x4_t lo = vcvtq_s32_f32(vmulq_n_f32(vld1q_f32(in + n), PackScale));
+        const int32x4_t hi =
+            vcvtq_s32_f32(vmulq_n_f32(vld1q_f32(in + n + 4), PackScale));
+
+        const int16x8_t v = vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi));
+
+        vst1q_s16(out + n, vreinterpretq_s16_u8(vrev16q_u8(vreinterpretq_u8_s16(v))));
+    }
+
+    pack_s16_generic(out + n, in + n, n_samples - n);
+}
+
+void unpack_s16_neon(audio::sample_t* out, const int16_t* in, size_t n_samples) {
+    size_t n = 0;
+
+    for (; n + 8 <= n_samples; n += 8) {
+        const int16x8_t v = vreinterpretq_s16_u8(
+            vrev16q_u8(vreinterpretq_u8_s16(vld1q_s16(in + n))));
+
+        const float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(v)));
+        const float32x4_t hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(v)));
+
+        vst1q_f32(out + n, vmulq_n_f32(lo, UnpackScale));
+        vst1q_f32(out + n + 4, vmulq_n_f32(hi, UnpackScale));
+    }
+
+    unpack_s16_generic(out + n, in + n, n_samples - n);
+}
+
+#endif // ROC_RTP_PCM_NEON
+
+} // namespace
+
+bool pcm_kernel_supported(PCMKernel kernel) {
+    switch (kernel) {
+    case PCMKernel_Generic:
+        return true;
+
+    case PCMKernel_SSE2:
+#ifdef ROC_RTP_PCM_SSE2
+        return true;
+#else
+        return false;
+#endif
+
+    case PCMKernel_NEON:
+#ifdef ROC_RTP_PCM_NEON
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    return false;
+}
+
+pcm_pack_s16_func_t pcm_kernel_pack_s16(PCMKernel kernel) {
+    switch (kernel) {
+    case PCMKernel_Generic:
+        return pack_s16_generic;
+
+#ifdef ROC_RTP_PCM_SSE2
+    case PCMKernel_SSE2:
+        return pack_s16_sse2;
+#endif
+
+#ifdef ROC_RTP_PCM_NEON
+    case PCMKernel_NEON:
+        return pack_s16_neon;
+#endif
+
+    default:
+        break;
+    }
+
+    roc_panic("pcm kernel: kernel is not supported: %s", pcm_kernel_name(kernel));
+
+    return NULL;
+}
+
+pcm_unpack_s16_func_t pcm_kernel_unpack_s16(PCMKernel kernel) {
+    switch (kernel) {
+    case PCMKernel_Generic:
+        return unpack_s16_generic;
+
+#ifdef ROC_RTP_PCM_SSE2
+    case PCMKernel_SSE2:
+        return unpack_s16_sse2;
+#endif
+
+#ifdef ROC_RTP_PCM_NEON
+    case PCMKernel_NEON:
+        return unpack_s16_neon;
+#endif
+
+    default:
+        break;
+    }
+
+    roc_panic("pcm kernel: kernel is not supported: %s", pcm_kernel_name(kernel));
+
+    return NULL;
+}
+
+const char* pcm_kernel_name(PCMKernel kernel) {
+    switch (kernel) {
+    case PCMKernel_Generic:
+        return "generic";
+    case PCMKernel_SSE2:
+        return "sse2";
+    case PCMKernel_NEON:
+        return "neon";
+    }
+
+    return "<invalid>";
+}
+
+void pcm_pack_s16(int16_t* out, const audio::sample_t* in, size_t n_samples) {
+#if defined(ROC_RTP_PCM_SSE2)
+    pack_s16_sse2(out, in, n_samples);
+#elif defined(ROC_RTP_PCM_NEON)
+    pack_s16_neon(out, in, n_samples);
+#else
+    pack_s16_generic(out, in, n_samples);
+#endif
+}
+
+void pcm_unpack_s16(audio::sample_t* out, const int16_t* in, size_t n_samples) {
+#if defined(ROC_RTP_PCM_SSE2)
+    unpack_s16_sse2(out, in, n_samples);
+#elif defined(ROC_RTP_PCM_NEON)
+    unpack_s16_neon(out, in, n_samples);
+#else
+    unpack_s16_generic(out, in, n_samples);
+#endif
+}
+
+} // namespace rtp
+} // namespace roc
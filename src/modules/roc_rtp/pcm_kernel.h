@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_rtp/pcm_kernel.h
+//! @brief PCM conversion kernels.
+
+#ifndef ROC_RTP_PCM_KERNEL_H_
+#define ROC_RTP_PCM_KERNEL_H_
+
+#include "roc_audio/units.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace rtp {
+
+//! PCM conversion kernel implementation.
+enum PCMKernel {
+    //! Portable scalar implementation.
+    PCMKernel_Generic,
+
+    //! SSE2 implementation.
+    PCMKernel_SSE2,
+
+    //! NEON implementation.
+    PCMKernel_NEON
+};
+
+//! Encode function for 16-bit network order samples.
+//! @remarks
+//!  Converts @p n_samples floats from @p in to big-endian int16 values in @p out.
+//!  Samples are not remapped, so the input and output channel masks should be
+//!  the same.
+typedef void (*pcm_pack_s16_func_t)(int16_t* out,
+                                    const audio::sample_t* in,
+                                    size_t n_samples);
+
+//! Decode function for 16-bit network order samples.
+//! @remarks
+//!  Converts @p n_samples big-endian int16 values from @p in to floats in @p out.
+//!  Samples are not remapped, so the input and output channel masks should be
+//!  the same.
+typedef void (*pcm_unpack_s16_func_t)(audio::sample_t* out,
+                                      const int16_t* in,
+                                      size_t n_samples);
+
+//! Check if the kernel is available in this build.
+//! @remarks
+//!  The kernels rely only on the baseline instruction set of the target
+//!  architecture, so the check is performed at compile time.
+bool pcm_kernel_supported(PCMKernel kernel);
+
+//! Get encode function.
+//! @pre
+//!  The kernel should be supported.
+pcm_pack_s16_func_t pcm_kernel_pack_s16(PCMKernel kernel);
+
+//! Get decode function.
+//! @pre
+//!  The kernel should be supported.
+pcm_unpack_s16_func_t pcm_kernel_unpack_s16(PCMKernel kernel);
+
+//! Get kernel name.
+const char* pcm_kernel_name(PCMKernel kernel);
+
+//! Encode 16-bit samples using the fastest available kernel.
+void pcm_pack_s16(int16_t* out, const audio::sample_t* in, size_t n_samples);
+
+//! Decode 16-bit samples using the fastest available kernel.
+void pcm_unpack_s16(audio::sample_t* out, const int16_t* in, size_t n_samples);
+
+} // namespace rtp
+} // namespace roc
+
+#endif // ROC_RTP_PCM_KERNEL_H_
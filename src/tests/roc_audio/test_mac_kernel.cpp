@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/mac_kernel.h"
+#include "roc_core/macros.h"
+#include "roc_core/random.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum { MaxChannels = 8, MaxSamples = 1024 };
+
+const double Epsilon = 1e-5;
+
+const MacKernel kernels[] = {
+    MacKernel_Generic, MacKernel_SSE2, MacKernel_AVX, MacKernel_NEON
+};
+
+sample_t random_sample() {
+    return sample_t(core::random(0, 2000)) / 1000 - 1;
+}
+
+} // namespace
+
+TEST_GROUP(mac_kernel) {
+    sample_t samples[MaxSamples];
+    sample_t coeffs[MaxSamples];
+
+    void setup() {
+        for (size_t n = 0; n < MaxSamples; n++) {
+            samples[n] = random_sample();
+            coeffs[n] = random_sample();
+        }
+    }
+
+    void expected(size_t n_samples, size_t n_channels, double* accum) {
+        for (size_t ch = 0; ch < n_channels; ch++) {
+            accum[ch] = 0.5;
+        }
+        for (size_t n = 0; n < n_samples; n++) {
+            accum[n % n_channels] += (double)samples[n] * (double)coeffs[n];
+        }
+    }
+
+    void check(MacKernel kernel, size_t n_samples, size_t n_channels) {
+        double exp_accum[MaxChannels];
+        expected(n_samples, n_channels, exp_accum);
+
+        sample_t accum[MaxChannels];
+        for (size_t ch = 0; ch < n_channels; ch++) {
+            accum[ch] = 0.5f;
+        }
+
+        mac_kernel_func(kernel)(samples, coeffs, n_samples, n_channels, accum);
+
+        for (size_t ch = 0; ch < n_channels; ch++) {
+            DOUBLES_EQUAL(exp_accum[ch], (double)accum[ch], Epsilon * n_samples);
+        }
+    }
+};
+
+TEST(mac_kernel, generic_always_supported) {
+    for (size_t n_ch = 1; n_ch <= MaxChannels; n_ch++) {
+        CHECK(mac_kernel_supported(MacKernel_Generic, n_ch));
+    }
+}
+
+TEST(mac_kernel, select_supported) {
+    for (size_t n_ch = 1; n_ch <= MaxChannels; n_ch++) {
+        CHECK(mac_kernel_supported(mac_kernel_select(n_ch), n_ch));
+    }
+}
+
+TEST(mac_kernel, all_sizes) {
+    for (size_t k = 0; k < ROC_ARRAY_SIZE(kernels); k++) {
+        for (size_t n_ch = 1; n_ch <= MaxChannels; n_ch++) {
+            if (!mac_kernel_supported(kernels[k], n_ch)) {
+                continue;
+            }
+            for (size_t n_samples = 0; n_samples + n_ch <= MaxSamples / 8;
+                 n_samples += n_ch) {
+                check(kernels[k], n_samples, n_ch);
+            }
+        }
+    }
+}
+
+TEST(mac_kernel, large_size) {
+    for (size_t k = 0; k < ROC_ARRAY_SIZE(kernels); k++) {
+        for (size_t n_ch = 1; n_ch <= MaxChannels; n_ch++) {
+            if (!mac_kernel_supported(kernels[k], n_ch)) {
+                continue;
+            }
+            check(kernels[k], MaxSamples / n_ch * n_ch, n_ch);
+        }
+    }
+}
+
+} // namespace audio
+} // namespace roc
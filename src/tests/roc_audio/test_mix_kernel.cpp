@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/mix_kernel.h"
+#include "roc_core/macros.h"
+#include "roc_core/random.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum { MaxSamples = 1024 };
+
+const double Epsilon = 1e-6;
+
+const MixKernel kernels[] = {
+    MixKernel_Generic, MixKernel_SSE2, MixKernel_AVX, MixKernel_NEON
+};
+
+sample_t random_sample() {
+    return sample_t(core::random(0, 4000)) / 1000 - 2;
+}
+
+} // namespace
+
+TEST_GROUP(mix_kernel) {
+    sample_t samples[MaxSamples];
+    sample_t accum[MaxSamples];
+
+    void setup() {
+        for (size_t n = 0; n < MaxSamples; n++) {
+            samples[n] = random_sample();
+            accum[n] = random_sample();
+        }
+    }
+
+    void check_add(MixKernel kernel, size_t n_samples) {
+        sample_t result[MaxSamples];
+        memcpy(result, accum, sizeof(result));
+
+        mix_kernel_add_func(kernel)(result, samples, n_samples);
+
+        for (size_t n = 0; n < MaxSamples; n++) {
+            if (n < n_samples) {
+                DOUBLES_EQUAL((double)accum[n] + (double)samples[n], (double)result[n],
+                              Epsilon);
+            } else {
+                DOUBLES_EQUAL((double)accum[n], (double)result[n], 0);
+            }
+        }
+    }
+
+    void check_clamp(MixKernel kernel, size_t n_samples) {
+        sample_t result[MaxSamples];
+        memcpy(result, samples, sizeof(result));
+
+        mix_kernel_clamp_func(kernel)(result, n_samples);
+
+        for (size_t n = 0; n < MaxSamples; n++) {
+            double expected = (double)samples[n];
+            if (n < n_samples) {
+                if (expected > (double)SampleMax) {
+                    expected = (double)SampleMax;
+                }
+                if (expected < (double)SampleMin) {
+                    expected = (double)SampleMin;
+                }
+            }
+            DOUBLES_EQUAL(expected, (double)result[n], 0);
+        }
+    }
+};
+
+TEST(mix_kernel, generic_always_supported) {
+    CHECK(mix_kernel_supported(MixKernel_Generic));
+}
+
+TEST(mix_kernel, select_supported) {
+    CHECK(mix_kernel_supported(mix_kernel_select()));
+}
+
+TEST(mix_kernel, add) {
+    for (size_t k = 0; k < ROC_ARRAY_SIZE(kernels); k++) {
+        if (!mix_kernel_supported(kernels[k])) {
+            continue;
+        }
+        for (size_t n_samples = 0; n_samples <= MaxSamples / 8; n_samples++) {
+            check_add(kernels[k], n_samples);
+        }
+        check_add(kernels[k], MaxSamples);
+    }
+}
+
+TEST(mix_kernel, clamp) {
+    for (size_t k = 0; k < ROC_ARRAY_SIZE(kernels); k++) {
+        if (!mix_kernel_supported(kernels[k])) {
+            continue;
+        }
+        for (size_t n_samples = 0; n_samples <= MaxSamples / 8; n_samples++) {
+            check_clamp(kernels[k], n_samples);
+        }
+        check_clamp(kernels[k], MaxSamples);
+    }
+}
+
+} // namespace audio
+} // namespace roc
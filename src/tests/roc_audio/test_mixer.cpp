@@ -143,5 +143,49 @@ TEST(mixer, clamp) {
     CHECK(reader2.num_unread() == 0);
 }
 
+TEST(mixer, clamp_one_reader) {
+    MockReader reader1;
+
+    Mixer mixer(buffer_pool);
+
+    mixer.add(reader1);
+
+    reader1.add(BufSz, 1.5f);
+    expect_output(mixer, BufSz, 1.0f);
+
+    reader1.add(BufSz, -1.5f);
+    expect_output(mixer, BufSz, -1.0f);
+
+    CHECK(reader1.num_unread() == 0);
+}
+
+TEST(mixer, clamp_after_sum) {
+    MockReader reader1;
+    MockReader reader2;
+    MockReader reader3;
+
+    Mixer mixer(buffer_pool);
+
+    mixer.add(reader1);
+    mixer.add(reader2);
+    mixer.add(reader3);
+
+    reader1.add(BufSz, 0.9f);
+    reader2.add(BufSz, 0.8f);
+    reader3.add(BufSz, -0.7f);
+
+    expect_output(mixer, BufSz, 1.0f);
+
+    reader1.add(BufSz, 0.7f);
+    reader2.add(BufSz, 0.6f);
+    reader3.add(BufSz, -0.9f);
+
+    expect_output(mixer, BufSz, 0.4f);
+
+    CHECK(reader1.num_unread() == 0);
+    CHECK(reader2.num_unread() == 0);
+    CHECK(reader3.num_unread() == 0);
+}
+
 } // namespace audio
 } // namespace roc
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/parallel_mixer.h"
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/stddefs.h"
+
+#include "test_mock_reader.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum { BufSz = 100, MaxSz = 1000, NumThreads = 3, NumReaders = 10, NumFrames = 5 };
+
+core::HeapAllocator allocator;
+core::BufferPool<sample_t> buffer_pool(allocator, MaxSz, 1);
+
+} // namespace
+
+TEST_GROUP(parallel_mixer) {
+    core::Slice<sample_t> new_buffer(size_t sz) {
+        core::Slice<sample_t> buf = new (buffer_pool) core::Buffer<sample_t>(buffer_pool);
+        buf.resize(sz);
+        return buf;
+    }
+
+    void expect_output(ParallelMixer& mixer, size_t sz, sample_t value) {
+        Frame frame;
+        frame.samples = new_buffer(sz);
+
+        mixer.read(frame);
+
+        UNSIGNED_LONGS_EQUAL(sz, frame.samples.size());
+
+        for (size_t n = 0; n < sz; n++) {
+            DOUBLES_EQUAL(value, frame.samples.data()[n], 0.0001);
+        }
+    }
+};
+
+TEST(parallel_mixer, no_readers) {
+    ParallelMixer mixer(buffer_pool, allocator, NumThreads);
+    CHECK(mixer.valid());
+
+    expect_output(mixer, BufSz, 0);
+}
+
+TEST(parallel_mixer, one_reader) {
+    MockReader reader1;
+
+    ParallelMixer mixer(buffer_pool, allocator, NumThreads);
+    CHECK(mixer.valid());
+
+    CHECK(mixer.add(reader1));
+
+    reader1.add(BufSz, 0.11f);
+    expect_output(mixer, BufSz, 0.11f);
+
+    CHECK(reader1.num_unread() == 0);
+}
+
+TEST(parallel_mixer, many_readers) {
+    MockReader readers[NumReaders];
+
+    ParallelMixer mixer(buffer_pool, allocator, NumThreads);
+    CHECK(mixer.valid());
+
+    for (size_t n = 0; n < NumReaders; n++) {
+        CHECK(mixer.add(readers[n]));
+    }
+
+    for (size_t f = 0; f < NumFrames; f++) {
+        for (size_t n = 0; n < NumReaders; n++) {
+            readers[n].add(BufSz, 0.01f * (f + 1));
+        }
+
+        expect_output(mixer, BufSz, 0.01f * (f + 1) * NumReaders);
+    }
+
+    for (size_t n = 0; n < NumReaders; n++) {
+        CHECK(readers[n].num_unread() == 0);
+    }
+}
+
+TEST(parallel_mixer, remove_reader) {
+    MockReader reader1;
+    MockReader reader2;
+
+    ParallelMixer mixer(buffer_pool, allocator, NumThreads);
+    CHECK(mixer.valid());
+
+    CHECK(mixer.add(reader1));
+    CHECK(mixer.add(reader2));
+
+    reader1.add(BufSz, 0.11f);
+    reader2.add(BufSz, 0.22f);
+    expect_output(mixer, BufSz, 0.33f);
+
+    mixer.remove(reader2);
+
+    reader1.add(BufSz, 0.44f);
+    reader2.add(BufSz, 0.55f);
+    expect_output(mixer, BufSz, 0.44f);
+
+    mixer.remove(reader1);
+
+    reader1.add(BufSz, 0.77f);
+    reader2.add(BufSz, 0.88f);
+    expect_output(mixer, BufSz, 0.0f);
+
+    CHECK(reader1.num_unread() == BufSz);
+    CHECK(reader2.num_unread() == BufSz * 2);
+}
+
+TEST(parallel_mixer, clamp_after_sum) {
+    MockReader reader1;
+    MockReader reader2;
+    MockReader reader3;
+
+    ParallelMixer mixer(buffer_pool, allocator, NumThreads);
+    CHECK(mixer.valid());
+
+    CHECK(mixer.add(reader1));
+    CHECK(mixer.add(reader2));
+    CHECK(mixer.add(reader3));
+
+    // clamped once, after all readers are summed
+    reader1.add(BufSz, 0.9f);
+    reader2.add(BufSz, 0.5f);
+    reader3.add(BufSz, -0.5f);
+
+    expect_output(mixer, BufSz, 0.9f);
+
+    CHECK(reader1.num_unread() == 0);
+    CHECK(reader2.num_unread() == 0);
+    CHECK(reader3.num_unread() == 0);
+}
+
+TEST(parallel_mixer, no_threads) {
+    MockReader reader1;
+    MockReader reader2;
+
+    ParallelMixer mixer(buffer_pool, allocator, 0);
+    CHECK(mixer.valid());
+
+    CHECK(mixer.add(reader1));
+    CHECK(mixer.add(reader2));
+
+    reader1.add(BufSz, 0.11f);
+    reader2.add(BufSz, 0.22f);
+    expect_output(mixer, BufSz, 0.33f);
+
+    mixer.remove(reader1);
+
+    reader1.add(BufSz, 0.44f);
+    reader2.add(BufSz, 0.55f);
+    expect_output(mixer, BufSz, 0.55f);
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/polyphase_bank.h"
+#include "roc_audio/polyphase_cache.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/shared_ptr.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum { WindowSize = 32 };
+
+const double Epsilon = 1e-5;
+
+core::HeapAllocator allocator;
+
+} // namespace
+
+TEST_GROUP(polyphase_bank) {};
+
+TEST(polyphase_bank, num_phases) {
+    {
+        // 44100 / 48000 = 147 / 160
+        PolyphaseBank bank(44100, 48000, WindowSize, allocator);
+        CHECK(bank.num_phases() >= 256);
+        LONGS_EQUAL(0, bank.num_phases() % 160);
+    }
+    {
+        // 48000 / 44100 = 160 / 147
+        PolyphaseBank bank(48000, 44100, WindowSize, allocator);
+        CHECK(bank.num_phases() >= 256);
+        LONGS_EQUAL(0, bank.num_phases() % 147);
+    }
+    {
+        PolyphaseBank bank(44100, 44100, WindowSize, allocator);
+        CHECK(bank.num_phases() >= 256);
+    }
+}
+
+TEST(polyphase_bank, num_taps) {
+    PolyphaseBank upsampler(44100, 48000, WindowSize, allocator);
+    PolyphaseBank downsampler(48000, 44100, WindowSize, allocator);
+
+    LONGS_EQUAL(0, upsampler.num_taps() % 2);
+    LONGS_EQUAL(0, downsampler.num_taps() % 2);
+
+    CHECK(upsampler.num_taps() > WindowSize * 2);
+
+    // lower cutoff requires longer filter
+    CHECK(downsampler.num_taps() > upsampler.num_taps());
+}
+
+TEST(polyphase_bank, unity_gain) {
+    PolyphaseBank bank(44100, 48000, WindowSize, allocator);
+
+    for (size_t p = 0; p <= bank.num_phases(); p++) {
+        const sample_t* filter = bank.filter(p);
+
+        double sum = 0;
+        for (size_t n = 0; n < bank.num_taps(); n++) {
+            sum += (double)filter[n];
+        }
+
+        DOUBLES_EQUAL(1.0, sum, Epsilon);
+    }
+}
+
+TEST(polyphase_bank, zero_phase) {
+    PolyphaseBank bank(44100, 48000, WindowSize, allocator);
+
+    const sample_t* filter = bank.filter(0);
+
+    // with zero delay, the filter is symmetric around tap num_taps/2-1
+    // and has its peak there
+    const size_t center = bank.num_taps() / 2 - 1;
+
+    for (size_t n = 1; n < center; n++) {
+        DOUBLES_EQUAL((double)filter[center - n], (double)filter[center + n], Epsilon);
+        CHECK(filter[center] > filter[center + n]);
+    }
+}
+
+TEST(polyphase_bank, last_phase) {
+    PolyphaseBank bank(44100, 48000, WindowSize, allocator);
+
+    const sample_t* first = bank.filter(0);
+    const sample_t* last = bank.filter(bank.num_phases());
+
+    // the last phase is the first phase delayed by one tap
+    for (size_t n = 0; n < bank.num_taps() - 2; n++) {
+        DOUBLES_EQUAL((double)first[n], (double)last[n + 1], 1e-3);
+    }
+}
+
+TEST(polyphase_bank, cache) {
+    PolyphaseCache cache(allocator);
+
+    core::SharedPtr<PolyphaseBank> bank1 = cache.get(44100, 48000, WindowSize);
+    core::SharedPtr<PolyphaseBank> bank2 = cache.get(44100, 48000, WindowSize);
+    core::SharedPtr<PolyphaseBank> bank3 = cache.get(48000, 44100, WindowSize);
+    core::SharedPtr<PolyphaseBank> bank4 = cache.get(44100, 48000, WindowSize * 2);
+
+    CHECK(bank1);
+    CHECK(bank3);
+    CHECK(bank4);
+
+    CHECK(bank1.get() == bank2.get());
+    CHECK(bank1.get() != bank3.get());
+    CHECK(bank1.get() != bank4.get());
+
+    LONGS_EQUAL(3, cache.size());
+}
+
+} // namespace audio
+} // namespace roc
@@ -9,10 +9,12 @@
 
 #include <CppUTest/TestHarness.h>
 
+#include "roc_audio/polyphase_bank.h"
 #include "roc_audio/resampler.h"
 #include "roc_core/buffer_pool.h"
 #include "roc_core/heap_allocator.h"
 #include "roc_core/random.h"
+#include "roc_core/shared_ptr.h"
 #include "roc_core/stddefs.h"
 
 #include "test_fft.h"
@@ -109,6 +111,47 @@ TEST_GROUP(resampler) {
 
         return result; // return the generated random sample to the caller
     }
+
+    // Converts sine-wave from 44100 to 48000 Hz and compares it with the ideal one.
+    void check_rate_conversion(packet::channel_mask_t ch_mask, float scaling) {
+        enum { InRate = 44100, OutRate = 48000, NumOut = FrameSize * 4 };
+
+        const size_t n_ch = packet::num_channels(ch_mask);
+
+        core::SharedPtr<PolyphaseBank> bank =
+            new (allocator) PolyphaseBank(InRate, OutRate, ResamplerFIRLen, allocator);
+
+        MockReader reader;
+        Resampler resampler(reader, buffer_pool, allocator, config, ch_mask);
+
+        CHECK(resampler.set_bank(*bank));
+        CHECK(resampler.set_scaling(scaling));
+
+        const double freq = 2 * M_PI * 1000 / InRate;
+
+        for (size_t n = 0; n < InSamples / n_ch; n++) {
+            for (size_t ch = 0; ch < n_ch; ch++) {
+                reader.add(1, (sample_t)(0.5 * sin(freq * (double)n * (ch + 1))));
+            }
+        }
+
+        Frame frame;
+        frame.samples = new_buffer(NumOut);
+        resampler.read(frame);
+
+        // first output sample corresponds to the beginning of the second frame
+        const double offset = (double)FrameSize / n_ch;
+        const double step = (double)InRate / OutRate * (double)scaling;
+
+        for (size_t n = 0; n < NumOut / n_ch; n++) {
+            for (size_t ch = 0; ch < n_ch; ch++) {
+                const double expected =
+                    0.5 * sin(freq * (offset + step * (double)n) * (ch + 1));
+                DOUBLES_EQUAL(expected, (double)frame.samples.data()[n * n_ch + ch],
+                              1e-3);
+            }
+        }
+    }
 };
 
 TEST(resampler, invalid_scaling) {
@@ -208,6 +251,52 @@ TEST(resampler, downsample) {
     }
 }
 
+TEST(resampler, rate_conversion_mono) {
+    check_rate_conversion(0x1, 1.0f);
+}
+
+TEST(resampler, rate_conversion_stereo) {
+    check_rate_conversion(0x3, 1.0f);
+}
+
+TEST(resampler, rate_conversion_with_scaling) {
+    check_rate_conversion(0x3, 1.002f);
+}
+
+TEST(resampler, rate_conversion_bank_too_large) {
+    enum { ChMask = 0x1 };
+
+    config.window_size = ResamplerFIRLen / 4;
+    config.frame_size = ResamplerFIRLen;
+
+    core::SharedPtr<PolyphaseBank> bank =
+        new (allocator) PolyphaseBank(44100, 48000, ResamplerFIRLen, allocator);
+
+    MockReader reader;
+    Resampler resampler(reader, buffer_pool, allocator, config, ChMask);
+
+    CHECK(!resampler.set_bank(*bank));
+}
+
+TEST(resampler, rate_conversion_scaling_limit) {
+    enum { ChMask = 0x1 };
+
+    // sinc window is not used with bank, so it doesn't limit scaling
+    config.window_size = FrameSize / 2;
+
+    core::SharedPtr<PolyphaseBank> bank =
+        new (allocator) PolyphaseBank(44100, 48000, ResamplerFIRLen / 4, allocator);
+
+    MockReader reader;
+    Resampler resampler(reader, buffer_pool, allocator, config, ChMask);
+
+    CHECK(!resampler.set_scaling(2.5f));
+
+    CHECK(resampler.set_bank(*bank));
+    CHECK(resampler.set_scaling(2.5f));
+    CHECK(!resampler.set_scaling((float)FrameSize * 2));
+}
+
 TEST(resampler, two_tones_sep_channels) {
     enum { ChMask = 0x3, nChannels = 2 };
 
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/cpu_features.h"
+
+namespace roc {
+namespace core {
+
+TEST_GROUP(cpu_features){};
+
+TEST(cpu_features, implied) {
+    // every CPU that has AVX2 also has AVX, SSSE3, and SSE2
+    if (cpu_supports(CpuFeature_AVX2)) {
+        CHECK(cpu_supports(CpuFeature_AVX));
+    }
+    if (cpu_supports(CpuFeature_AVX)) {
+        CHECK(cpu_supports(CpuFeature_SSSE3));
+    }
+    if (cpu_supports(CpuFeature_SSSE3)) {
+        CHECK(cpu_supports(CpuFeature_SSE2));
+    }
+}
+
+TEST(cpu_features, exclusive) {
+    CHECK(!(cpu_supports(CpuFeature_SSE2) && cpu_supports(CpuFeature_NEON)));
+}
+
+#if defined(__x86_64__)
+TEST(cpu_features, x86_64_baseline) {
+    CHECK(cpu_supports(CpuFeature_SSE2));
+}
+#endif
+
+TEST(cpu_features, name) {
+    STRCMP_EQUAL("sse2", cpu_feature_name(CpuFeature_SSE2));
+    STRCMP_EQUAL("ssse3", cpu_feature_name(CpuFeature_SSSE3));
+    STRCMP_EQUAL("avx", cpu_feature_name(CpuFeature_AVX));
+    STRCMP_EQUAL("avx2", cpu_feature_name(CpuFeature_AVX2));
+    STRCMP_EQUAL("neon", cpu_feature_name(CpuFeature_NEON));
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/hash_map.h"
+#include "roc_core/heap_allocator.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+enum { NumObjects = 1000, NumBuckets = 4 };
+
+struct Key {
+    size_t value;
+
+    Key(size_t v = 0)
+        : value(v) {
+    }
+
+    size_t hash() const {
+        // force collisions
+        return value % NumBuckets;
+    }
+
+    bool operator==(const Key& other) const {
+        return value == other.value;
+    }
+};
+
+struct Object {
+    size_t value;
+};
+
+} // namespace
+
+TEST_GROUP(hash_map) {
+    HeapAllocator allocator;
+    Object objects[NumObjects];
+
+    void setup() {
+        for (size_t n = 0; n < NumObjects; n++) {
+            objects[n].value = n;
+        }
+    }
+};
+
+TEST(hash_map, empty) {
+    HashMap<Key, Object> map(allocator);
+
+    LONGS_EQUAL(0, map.size());
+
+    CHECK(map.find(Key(0)) == NULL);
+    CHECK(!map.remove(Key(0)));
+}
+
+TEST(hash_map, insert_find) {
+    HashMap<Key, Object> map(allocator);
+
+    CHECK(map.insert(Key(1), objects[1]));
+    CHECK(map.insert(Key(2), objects[2]));
+
+    LONGS_EQUAL(2, map.size());
+
+    CHECK(map.find(Key(1)) == &objects[1]);
+    CHECK(map.find(Key(2)) == &objects[2]);
+    CHECK(map.find(Key(3)) == NULL);
+}
+
+TEST(hash_map, insert_duplicate) {
+    HashMap<Key, Object> map(allocator);
+
+    CHECK(map.insert(Key(1), objects[1]));
+    CHECK(!map.insert(Key(1), objects[2]));
+
+    LONGS_EQUAL(1, map.size());
+
+    CHECK(map.find(Key(1)) == &objects[1]);
+}
+
+TEST(hash_map, remove) {
+    HashMap<Key, Object> map(allocator);
+
+    CHECK(map.insert(Key(1), objects[1]));
+    CHECK(map.insert(Key(2), objects[2]));
+
+    CHECK(map.remove(Key(1)));
+    CHECK(!map.remove(Key(1)));
+
+    LONGS_EQUAL(1, map.size());
+
+    CHECK(map.find(Key(1)) == NULL);
+    CHECK(map.find(Key(2)) == &objects[2]);
+}
+
+TEST(hash_map, grow) {
+    HashMap<Key, Object> map(allocator);
+
+    for (size_t n = 0; n < NumObjects; n++) {
+        CHECK(map.insert(Key(n), objects[n]));
+        LONGS_EQUAL(n + 1, map.size());
+    }
+
+    for (size_t n = 0; n < NumObjects; n++) {
+        CHECK(map.find(Key(n)) == &objects[n]);
+    }
+}
+
+TEST(hash_map, remove_collisions) {
+    HashMap<Key, Object> map(allocator);
+
+    for (size_t n = 0; n < NumObjects; n++) {
+        CHECK(map.insert(Key(n), objects[n]));
+    }
+
+    for (size_t n = 0; n < NumObjects; n += 2) {
+        CHECK(map.remove(Key(n)));
+    }
+
+    LONGS_EQUAL(NumObjects / 2, map.size());
+
+    for (size_t n = 0; n < NumObjects; n++) {
+        if (n % 2 == 0) {
+            CHECK(map.find(Key(n)) == NULL);
+        } else {
+            CHECK(map.find(Key(n)) == &objects[n]);
+        }
+    }
+
+    for (size_t n = 0; n < NumObjects; n += 2) {
+        CHECK(map.insert(Key(n), objects[n]));
+    }
+
+    for (size_t n = 0; n < NumObjects; n++) {
+        CHECK(map.find(Key(n)) == &objects[n]);
+    }
+}
+
+} // namespace core
+} // namespace roc
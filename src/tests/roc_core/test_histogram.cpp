@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/histogram.h"
+#include "roc_core/thread.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+class RecorderThread : public Thread {
+public:
+    enum { NumIterations = 10000 };
+
+    RecorderThread(Histogram& histogram)
+        : histogram_(histogram) {
+    }
+
+private:
+    virtual void run() {
+        for (size_t n = 0; n < NumIterations; n++) {
+            histogram_.record(n);
+        }
+    }
+
+    Histogram& histogram_;
+};
+
+} // namespace
+
+TEST_GROUP(histogram) {};
+
+TEST(histogram, empty) {
+    Histogram histogram;
+
+    HistogramSnapshot snapshot;
+    histogram.snapshot(snapshot);
+
+    UNSIGNED_LONGS_EQUAL(0, snapshot.count());
+    UNSIGNED_LONGS_EQUAL(0, snapshot.quantile(0.5));
+    UNSIGNED_LONGS_EQUAL(0, snapshot.quantile(1));
+}
+
+TEST(histogram, buckets) {
+    for (nanoseconds_t v = 0; v < HistogramSubBuckets * 2; v++) {
+        UNSIGNED_LONGS_EQUAL(v, Histogram::bucket_index(v));
+        UNSIGNED_LONGS_EQUAL(v, Histogram::bucket_max(Histogram::bucket_index(v)));
+    }
+
+    for (size_t i = 1; i < HistogramBuckets; i++) {
+        CHECK(Histogram::bucket_max(i) > Histogram::bucket_max(i - 1));
+
+        const nanoseconds_t v = Histogram::bucket_max(i);
+        UNSIGNED_LONGS_EQUAL(i, Histogram::bucket_index(v));
+        UNSIGNED_LONGS_EQUAL(i,
+                             Histogram::bucket_index(Histogram::bucket_max(i - 1) + 1));
+    }
+
+    const nanoseconds_t max_value = ((nanoseconds_t)1 << HistogramValueBits) - 1;
+
+    UNSIGNED_LONGS_EQUAL(max_value, Histogram::bucket_max(HistogramBuckets - 1));
+
+    UNSIGNED_LONGS_EQUAL(HistogramBuckets - 1, Histogram::bucket_index(max_value));
+    UNSIGNED_LONGS_EQUAL(HistogramBuckets - 1, Histogram::bucket_index(max_value * 10));
+}
+
+TEST(histogram, quantiles) {
+    enum { NumValues = 100000 };
+
+    Histogram histogram;
+
+    for (nanoseconds_t v = 1; v <= NumValues; v++) {
+        histogram.record(v * 1000);
+    }
+
+    HistogramSnapshot snapshot;
+    histogram.snapshot(snapshot);
+
+    UNSIGNED_LONGS_EQUAL(NumValues, snapshot.count());
+
+    const double quantiles[] = { 0, 0.5, 0.9, 0.99, 0.999, 1 };
+
+    for (size_t n = 0; n < sizeof(quantiles) / sizeof(quantiles[0]); n++) {
+        nanoseconds_t expected = (nanoseconds_t)(quantiles[n] * NumValues) * 1000;
+        if (expected == 0) {
+            expected = 1000;
+        }
+
+        const nanoseconds_t actual = snapshot.quantile(quantiles[n]);
+
+        CHECK(actual >= expected);
+        CHECK(actual - expected <= expected / HistogramSubBuckets);
+    }
+}
+
+TEST(histogram, tail) {
+    Histogram histogram;
+
+    for (size_t n = 0; n < 999; n++) {
+        histogram.record(100);
+    }
+    histogram.record(5000000);
+
+    HistogramSnapshot snapshot;
+    histogram.snapshot(snapshot);
+
+    UNSIGNED_LONGS_EQUAL(Histogram::bucket_max(Histogram::bucket_index(100)),
+                         snapshot.quantile(0.5));
+    UNSIGNED_LONGS_EQUAL(Histogram::bucket_max(Histogram::bucket_index(100)),
+                         snapshot.quantile(0.999));
+    UNSIGNED_LONGS_EQUAL(Histogram::bucket_max(Histogram::bucket_index(5000000)),
+                         snapshot.quantile(0.9999));
+}
+
+TEST(histogram, concurrent) {
+    enum { NumThreads = 4 };
+
+    Histogram histogram;
+
+    RecorderThread t0(histogram), t1(histogram), t2(histogram), t3(histogram);
+    RecorderThread* threads[NumThreads] = { &t0, &t1, &t2, &t3 };
+
+    for (size_t n = 0; n < NumThreads; n++) {
+        threads[n]->start();
+    }
+
+    for (size_t n = 0; n < NumThreads; n++) {
+        threads[n]->join();
+    }
+
+    HistogramSnapshot snapshot;
+    histogram.snapshot(snapshot);
+
+    UNSIGNED_LONGS_EQUAL(NumThreads * RecorderThread::NumIterations, snapshot.count());
+    UNSIGNED_LONGS_EQUAL(Histogram::bucket_max(Histogram::bucket_index(
+                             RecorderThread::NumIterations - 1)),
+                         snapshot.quantile(1));
+}
+
+} // namespace core
+} // namespace roc
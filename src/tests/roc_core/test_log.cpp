@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <stdio.h>
+
+#include "roc_core/log.h"
+#include "roc_core/thread.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+enum { MaxMessages = 100 };
+
+int n_messages;
+int last_value;
+bool ordered;
+uint64_t handler_tid;
+
+void handler(LogLevel, const char*, const char* message) {
+    int value = -1;
+    sscanf(message, "message %d", &value);
+
+    if (value != last_value + 1) {
+        ordered = false;
+    }
+
+    last_value = value;
+    n_messages++;
+
+    handler_tid = Thread::get_tid();
+}
+
+int n_evaluated;
+
+int evaluate() {
+    return n_evaluated++;
+}
+
+} // namespace
+
+TEST_GROUP(log) {
+    LogLevel level;
+    LogHandler prev_handler;
+
+    void setup() {
+        level = set_log_level(LogDebug);
+        prev_handler = set_log_handler(handler);
+
+        n_messages = 0;
+        last_value = -1;
+        ordered = true;
+        handler_tid = 0;
+
+        n_evaluated = 0;
+    }
+
+    void teardown() {
+        set_log_async(false);
+        set_log_handler(prev_handler);
+        set_log_level(level);
+    }
+};
+
+TEST(log, sync) {
+    for (int n = 0; n < MaxMessages; n++) {
+        roc_log(LogDebug, "message %d", n);
+    }
+
+    LONGS_EQUAL(MaxMessages, n_messages);
+    CHECK(ordered);
+    CHECK(handler_tid == Thread::get_tid());
+}
+
+TEST(log, async) {
+    CHECK(!set_log_async(true));
+
+    for (int n = 0; n < MaxMessages; n++) {
+        roc_log(LogDebug, "message %d", n);
+    }
+
+    CHECK(set_log_async(false));
+
+    LONGS_EQUAL(MaxMessages, n_messages);
+    CHECK(ordered);
+    CHECK(handler_tid != Thread::get_tid());
+}
+
+TEST(log, filtered_args_not_evaluated) {
+    roc_log(LogTrace, "message %d", evaluate());
+    LONGS_EQUAL(0, n_evaluated);
+    LONGS_EQUAL(0, n_messages);
+
+    roc_log(LogDebug, "message %d", evaluate());
+    LONGS_EQUAL(1, n_evaluated);
+    LONGS_EQUAL(1, n_messages);
+}
+
+} // namespace core
+} // namespace roc
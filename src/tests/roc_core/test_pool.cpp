@@ -12,6 +12,7 @@
 #include "roc_core/heap_allocator.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/pool.h"
+#include "roc_core/thread.h"
 
 namespace roc {
 namespace core {
@@ -32,6 +33,74 @@ struct Object : NonCopyable<> {
 
 long Object::n_objects = 0;
 
+struct Item {
+    explicit Item(const void* o)
+        : owner(o) {
+    }
+
+    const void* owner;
+};
+
+// Allocates and destroys items in a loop, checking that no one else
+// uses the same items.
+class AllocThread : public Thread {
+public:
+    enum { NumIterations = 1000, NumItems = 20 };
+
+    AllocThread(Pool<Item>& pool)
+        : n_failed(0)
+        , pool_(pool) {
+    }
+
+    size_t n_failed;
+
+private:
+    virtual void run() {
+        Item* items[NumItems];
+
+        for (size_t i = 0; i < NumIterations; i++) {
+            for (size_t n = 0; n < NumItems; n++) {
+                items[n] = new (pool_) Item(this);
+                if (!items[n]) {
+                    n_failed++;
+                }
+            }
+            for (size_t n = 0; n < NumItems; n++) {
+                if (!items[n]) {
+                    continue;
+                }
+                if (items[n]->owner != this) {
+                    n_failed++;
+                }
+                pool_.destroy(*items[n]);
+            }
+        }
+    }
+
+    Pool<Item>& pool_;
+};
+
+// Destroys objects allocated by another thread.
+class DestroyThread : public Thread {
+public:
+    DestroyThread(Pool<Object>& pool, Object** objects, size_t n_objects)
+        : pool_(pool)
+        , objects_(objects)
+        , n_objects_(n_objects) {
+    }
+
+private:
+    virtual void run() {
+        for (size_t n = 0; n < n_objects_; n++) {
+            pool_.destroy(*objects_[n]);
+        }
+    }
+
+    Pool<Object>& pool_;
+    Object** objects_;
+    size_t n_objects_;
+};
+
 } // namespace
 
 TEST_GROUP(pool) {
@@ -99,5 +168,236 @@ TEST(pool, new_destroy_many) {
     LONGS_EQUAL(0, allocator.num_allocations());
 }
 
+TEST(pool, reuse) {
+    enum { NumObjects = 5, NumIterations = 100 };
+
+    {
+        Pool<Object> pool(allocator, sizeof(Object), NumObjects);
+
+        for (size_t i = 0; i < NumIterations; i++) {
+            Object* object = new (pool) Object;
+            CHECK(object);
+
+            pool.destroy(*object);
+
+            LONGS_EQUAL(1, allocator.num_allocations());
+        }
+    }
+
+    LONGS_EQUAL(0, allocator.num_allocations());
+}
+
+TEST(pool, concurrent) {
+    enum { NumObjects = 5, NumThreads = 4 };
+
+    {
+        Pool<Item> pool(allocator, sizeof(Item), NumObjects);
+
+        AllocThread t1(pool), t2(pool), t3(pool), t4(pool);
+        AllocThread* threads[NumThreads] = { &t1, &t2, &t3, &t4 };
+
+        for (size_t n = 0; n < NumThreads; n++) {
+            threads[n]->start();
+        }
+        for (size_t n = 0; n < NumThreads; n++) {
+            threads[n]->join();
+            LONGS_EQUAL(0, threads[n]->n_failed);
+        }
+    }
+
+    LONGS_EQUAL(0, allocator.num_allocations());
+}
+
+TEST(pool, cross_thread) {
+    enum { NumObjects = 5, NumAllocated = 200, NumIterations = 10 };
+
+    {
+        Pool<Object> pool(allocator, sizeof(Object), NumObjects);
+
+        Object* objects[NumAllocated];
+
+        for (size_t i = 0; i < NumIterations; i++) {
+            for (size_t n = 0; n < NumAllocated; n++) {
+                objects[n] = new (pool) Object;
+                CHECK(objects[n]);
+            }
+
+            DestroyThread thread(pool, objects, NumAllocated);
+            thread.start();
+            thread.join();
+
+            LONGS_EQUAL(0, Object::n_objects);
+        }
+
+        // objects freed by another thread are returned to shared list and
+        // reused, except the few ones cached in its magazine
+        CHECK(allocator.num_allocations() < NumAllocated / NumObjects * 2);
+    }
+
+    LONGS_EQUAL(0, allocator.num_allocations());
+}
+
+TEST(pool, reserve) {
+    enum { NumObjects = 5, NumReserved = 12 };
+
+    {
+        Pool<Object> pool(allocator, sizeof(Object), NumObjects);
+
+        CHECK(pool.reserve(NumReserved, false));
+
+        LONGS_EQUAL(3, allocator.num_allocations());
+        LONGS_EQUAL(NumObjects * 3, pool.capacity());
+
+        Object* objects[NumObjects * 3];
+
+        for (size_t n = 0; n < NumObjects * 3; n++) {
+            objects[n] = new (pool) Object;
+            CHECK(objects[n]);
+        }
+
+        LONGS_EQUAL(3, allocator.num_allocations());
+
+        for (size_t n = 0; n < NumObjects * 3; n++) {
+            pool.destroy(*objects[n]);
+        }
+
+        // reserved chunks are kept
+        LONGS_EQUAL(0, pool.trim());
+        LONGS_EQUAL(3, allocator.num_allocations());
+    }
+
+    LONGS_EQUAL(0, allocator.num_allocations());
+}
+
+TEST(pool, reserve_locked) {
+    enum { NumObjects = 4 };
+
+    {
+        Pool<Object> pool(allocator, sizeof(Object), NumObjects);
+
+        CHECK(pool.reserve(NumObjects, true));
+        LONGS_EQUAL(1, allocator.num_allocations());
+
+        Object* object = new (pool) Object;
+        CHECK(object);
+        pool.destroy(*object);
+    }
+
+    LONGS_EQUAL(0, allocator.num_allocations());
+}
+
+TEST(pool, limit) {
+    enum { NumObjects = 5, MaxObjects = 10 };
+
+    {
+        Pool<Object> pool(allocator, sizeof(Object), NumObjects);
+        pool.set_limit(MaxObjects);
+
+        CHECK(!pool.reserve(MaxObjects + 1, false));
+
+        Object* objects[MaxObjects];
+
+        for (size_t n = 0; n < MaxObjects; n++) {
+            objects[n] = new (pool) Object;
+            CHECK(objects[n]);
+        }
+
+        LONGS_EQUAL(0, pool.num_failures());
+
+        CHECK(!new (pool) Object);
+        CHECK(!new (pool) Object);
+
+        LONGS_EQUAL(2, pool.num_failures());
+        LONGS_EQUAL(MaxObjects, pool.capacity());
+
+        pool.destroy(*objects[0]);
+
+        objects[0] = new (pool) Object;
+        CHECK(objects[0]);
+
+        LONGS_EQUAL(2, pool.num_failures());
+
+        for (size_t n = 0; n < MaxObjects; n++) {
+            pool.destroy(*objects[n]);
+        }
+    }
+
+    LONGS_EQUAL(0, allocator.num_allocations());
+}
+
+TEST(pool, limit_cross_thread) {
+    enum { NumObjects = 1, MaxObjects = 10 };
+
+    {
+        Pool<Object> pool(allocator, sizeof(Object), NumObjects);
+        pool.set_limit(MaxObjects);
+
+        Object* objects[MaxObjects];
+
+        for (size_t i = 0; i < 3; i++) {
+            for (size_t n = 0; n < MaxObjects; n++) {
+                objects[n] = new (pool) Object;
+                CHECK(objects[n]);
+            }
+
+            // objects are cached in magazine of another thread, but still
+            // available to this thread
+            DestroyThread thread(pool, objects, MaxObjects);
+            thread.start();
+            thread.join();
+        }
+
+        LONGS_EQUAL(0, pool.num_failures());
+    }
+
+    LONGS_EQUAL(0, allocator.num_allocations());
+}
+
+TEST(pool, trim) {
+    enum { NumObjects = 5, NumChunks = 4 };
+
+    {
+        Pool<Object> pool(allocator, sizeof(Object), NumObjects);
+
+        Object* objects[NumObjects * NumChunks];
+
+        for (size_t n = 0; n < NumObjects * NumChunks; n++) {
+            objects[n] = new (pool) Object;
+            CHECK(objects[n]);
+        }
+
+        LONGS_EQUAL(NumChunks, allocator.num_allocations());
+        LONGS_EQUAL(0, pool.trim());
+
+        // free whole first and third chunks and a part of second one
+        for (size_t n = 0; n < NumObjects * 3; n++) {
+            if (n / NumObjects == 1 && n % 2 == 0) {
+                continue;
+            }
+            pool.destroy(*objects[n]);
+            objects[n] = NULL;
+        }
+
+        LONGS_EQUAL(NumObjects * 2, pool.trim());
+        LONGS_EQUAL(NumChunks - 2, allocator.num_allocations());
+        LONGS_EQUAL(NumObjects * (NumChunks - 2), pool.capacity());
+
+        for (size_t n = 0; n < NumObjects * NumChunks; n++) {
+            if (objects[n]) {
+                pool.destroy(*objects[n]);
+            }
+        }
+
+        LONGS_EQUAL(NumObjects * (NumChunks - 2), pool.trim());
+        LONGS_EQUAL(0, allocator.num_allocations());
+
+        Object* object = new (pool) Object;
+        CHECK(object);
+        pool.destroy(*object);
+    }
+
+    LONGS_EQUAL(0, allocator.num_allocations());
+}
+
 } // namespace core
 } // namespace roc
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/seqlock.h"
+#include "roc_core/thread.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+struct Value {
+    size_t a;
+    double b;
+    char c[5];
+};
+
+Value make_value(size_t n) {
+    Value v;
+    memset(&v, 0, sizeof(v));
+    v.a = n;
+    v.b = (double)n / 2;
+    for (size_t i = 0; i < sizeof(v.c); i++) {
+        v.c[i] = (char)(n + i);
+    }
+    return v;
+}
+
+bool check_value(const Value& v) {
+    const Value expected = make_value(v.a);
+    return memcmp(&v, &expected, sizeof(Value)) == 0;
+}
+
+class WriterThread : public Thread {
+public:
+    enum { NumIterations = 100000 };
+
+    WriterThread(Seqlock<Value>& seqlock)
+        : seqlock_(seqlock) {
+    }
+
+private:
+    virtual void run() {
+        for (size_t n = 1; n <= NumIterations; n++) {
+            seqlock_.store(make_value(n));
+        }
+    }
+
+    Seqlock<Value>& seqlock_;
+};
+
+} // namespace
+
+TEST_GROUP(seqlock) {};
+
+TEST(seqlock, load_store) {
+    Seqlock<Value> seqlock(make_value(0));
+
+    CHECK(check_value(seqlock.load()));
+    UNSIGNED_LONGS_EQUAL(0, seqlock.load().a);
+
+    seqlock.store(make_value(123));
+
+    Value v;
+    CHECK(seqlock.try_load(v));
+    CHECK(check_value(v));
+    UNSIGNED_LONGS_EQUAL(123, v.a);
+}
+
+TEST(seqlock, concurrent) {
+    Seqlock<Value> seqlock(make_value(0));
+
+    WriterThread writer(seqlock);
+    writer.start();
+
+    size_t last = 0;
+
+    while (last != WriterThread::NumIterations) {
+        const Value v = seqlock.load();
+
+        CHECK(check_value(v));
+        CHECK(v.a >= last);
+
+        last = v.a;
+    }
+
+    writer.join();
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <stdio.h>
+
+#include "roc_core/heap_allocator.h"
+#include "roc_core/temp_file.h"
+#include "roc_core/thread.h"
+#include "roc_core/tracer.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+HeapAllocator allocator;
+
+class RecorderThread : public Thread {
+public:
+    enum { NumEvents = 1000 };
+
+    RecorderThread(Tracer& tracer, const char* name)
+        : tracer_(tracer)
+        , name_(name) {
+    }
+
+private:
+    virtual void run() {
+        for (size_t n = 0; n < NumEvents; n++) {
+            tracer_.record(name_, n, n);
+        }
+    }
+
+    Tracer& tracer_;
+    const char* name_;
+};
+
+} // namespace
+
+TEST_GROUP(tracer) {};
+
+TEST(tracer, disabled) {
+    Tracer tracer(allocator);
+
+    CHECK(!tracer.enabled());
+
+    tracer.record("event", 1, 100);
+
+    UNSIGNED_LONGS_EQUAL(0, tracer.num_events());
+}
+
+TEST(tracer, record) {
+    Tracer tracer(allocator);
+
+    CHECK(tracer.start(10));
+    CHECK(tracer.enabled());
+    CHECK(!tracer.start(10));
+
+    tracer.record("event1", 1, 100);
+    tracer.record("event2", 2, 200);
+
+    tracer.stop();
+    CHECK(!tracer.enabled());
+
+    tracer.record("event3", 3, 300);
+
+    UNSIGNED_LONGS_EQUAL(2, tracer.num_events());
+
+    STRCMP_EQUAL("event1", tracer.event(0).name);
+    UNSIGNED_LONGS_EQUAL(1, tracer.event(0).id);
+    UNSIGNED_LONGS_EQUAL(100, tracer.event(0).timestamp);
+
+    STRCMP_EQUAL("event2", tracer.event(1).name);
+    UNSIGNED_LONGS_EQUAL(2, tracer.event(1).id);
+    UNSIGNED_LONGS_EQUAL(200, tracer.event(1).timestamp);
+
+    CHECK(tracer.start(10));
+    tracer.stop();
+
+    UNSIGNED_LONGS_EQUAL(0, tracer.num_events());
+}
+
+TEST(tracer, overwrite) {
+    enum { NumEvents = 10 };
+
+    Tracer tracer(allocator);
+
+    CHECK(tracer.start(NumEvents));
+
+    for (size_t n = 0; n < NumEvents * 3 + 5; n++) {
+        tracer.record("event", n, n);
+    }
+
+    tracer.stop();
+
+    UNSIGNED_LONGS_EQUAL(NumEvents, tracer.num_events());
+
+    for (size_t n = 0; n < NumEvents; n++) {
+        UNSIGNED_LONGS_EQUAL(NumEvents * 2 + 5 + n, tracer.event(n).id);
+    }
+}
+
+TEST(tracer, threads) {
+    Tracer tracer(allocator);
+
+    CHECK(tracer.start(RecorderThread::NumEvents));
+
+    RecorderThread t1(tracer, "thread1");
+    RecorderThread t2(tracer, "thread2");
+
+    t1.start();
+    t2.start();
+
+    t1.join();
+    t2.join();
+
+    tracer.stop();
+
+    UNSIGNED_LONGS_EQUAL(RecorderThread::NumEvents * 2, tracer.num_events());
+
+    size_t prev_thread = 0;
+
+    for (size_t n = 0; n < tracer.num_events(); n++) {
+        size_t thread = 0;
+        const TraceEvent& event = tracer.event(n, &thread);
+
+        // events of every thread are ordered
+        UNSIGNED_LONGS_EQUAL(n % RecorderThread::NumEvents, event.id);
+
+        if (n % RecorderThread::NumEvents == 0) {
+            CHECK(n == 0 || thread != prev_thread);
+        } else {
+            UNSIGNED_LONGS_EQUAL(prev_thread, thread);
+        }
+
+        prev_thread = thread;
+    }
+}
+
+TEST(tracer, new_id) {
+    Tracer tracer(allocator);
+
+    const uint64_t id1 = tracer.new_id();
+    const uint64_t id2 = tracer.new_id();
+
+    CHECK(id1 != 0);
+    CHECK(id2 != 0);
+    CHECK(id1 != id2);
+}
+
+TEST(tracer, dump) {
+    Tracer tracer(allocator);
+
+    CHECK(tracer.start(10));
+
+    tracer.record("event1", 11, 1000);
+    tracer.record("event2", 22, 2500);
+
+    tracer.stop();
+
+    TempFile file("trace.json");
+    CHECK(tracer.dump(file.path()));
+
+    FILE* fp = fopen(file.path(), "r");
+    CHECK(fp);
+
+    char buf[1024] = {};
+    CHECK(fread(buf, 1, sizeof(buf) - 1, fp) > 0);
+    fclose(fp);
+
+    CHECK(strstr(buf, "\"traceEvents\""));
+    CHECK(strstr(buf, "\"name\":\"event1\""));
+    CHECK(strstr(buf, "\"ts\":1.000"));
+    CHECK(strstr(buf, "\"id\":11"));
+    CHECK(strstr(buf, "\"name\":\"event2\""));
+    CHECK(strstr(buf, "\"ts\":2.500"));
+    CHECK(strstr(buf, "\"id\":22"));
+}
+
+TEST(tracer, macro) {
+    CHECK(!tracer().enabled());
+
+    size_t n_evaluated = 0;
+
+    roc_trace("event", ++n_evaluated);
+    UNSIGNED_LONGS_EQUAL(0, n_evaluated);
+
+    CHECK(tracer().start(10));
+
+    roc_trace("event", ++n_evaluated);
+    UNSIGNED_LONGS_EQUAL(1, n_evaluated);
+
+    tracer().stop();
+
+    UNSIGNED_LONGS_EQUAL(1, tracer().num_events());
+    UNSIGNED_LONGS_EQUAL(1, tracer().event(0).id);
+}
+
+} // namespace core
+} // namespace roc
@@ -103,7 +103,7 @@ TEST_GROUP(encoder_decoder) {
 };
 
 TEST(encoder_decoder, without_loss) {
-    for (int type = ReedSolomon8m; type != CodecTypeMax; ++type) {
+    for (int type = ReedSolomon8m; type <= LDPCStaircase; ++type) {
         config.codec = (CodecType)type;
         Codec code(config);
         code.encode();
@@ -116,7 +116,7 @@ TEST(encoder_decoder, without_loss) {
 }
 
 TEST(encoder_decoder, loss_1) {
-    for (int type = ReedSolomon8m; type != CodecTypeMax; ++type) {
+    for (int type = ReedSolomon8m; type <= LDPCStaircase; ++type) {
         config.codec = (CodecType)type;
         Codec code(config);
         code.encode();
@@ -131,9 +131,29 @@ TEST(encoder_decoder, loss_1) {
     }
 }
 
+TEST(encoder_decoder, late_packet_after_repair) {
+    for (int type = ReedSolomon8m; type <= LDPCStaircase; ++type) {
+        config.codec = (CodecType)type;
+        Codec code(config);
+        code.encode();
+        for (size_t i = 0; i < NumSourcePackets + NumRepairPackets; ++i) {
+            if (i == 3 || i == 7) {
+                continue;
+            }
+            code.decoder().set(i, code.get_buffer(i));
+        }
+        // Decoding pass restores both lost packets.
+        CHECK(code.decoder().repair(3));
+        // Original of the other packet arrives late and replaces restored one.
+        code.decoder().set(7, code.get_buffer(7));
+        CHECK(code.decoder().repair(7).data() == code.get_buffer(7).data());
+        CHECK(code.decode());
+    }
+}
+
 TEST(encoder_decoder, load_test) {
     enum { NumIterations = 20, LossPercent = 10, MaxLoss = 3 };
-    for (int type = ReedSolomon8m; type != CodecTypeMax; ++type) {
+    for (int type = ReedSolomon8m; type <= LDPCStaircase; ++type) {
         config.codec = (CodecType)type;
         Codec code(config);
 
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/random.h"
+#include "roc_fec/of_decoder.h"
+#include "roc_fec/of_encoder.h"
+#include "roc_fec/rs8m_decoder.h"
+#include "roc_fec/rs8m_encoder.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+const size_t NumSourcePackets = 20;
+const size_t NumRepairPackets = 10;
+const size_t NumPackets = NumSourcePackets + NumRepairPackets;
+
+const size_t PayloadSize = 251;
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, PayloadSize, 1);
+
+core::Slice<uint8_t> make_buffer() {
+    core::Slice<uint8_t> buf = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+    buf.resize(PayloadSize);
+    for (size_t j = 0; j < buf.size(); ++j) {
+        buf.data()[j] = (uint8_t)core::random(0, 0xff);
+    }
+    return buf;
+}
+
+core::Slice<uint8_t> copy_buffer(const core::Slice<uint8_t>& src) {
+    core::Slice<uint8_t> buf = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+    buf.resize(PayloadSize);
+    memcpy(buf.data(), src.data(), PayloadSize);
+    return buf;
+}
+
+} // namespace
+
+// In-tree Reed-Solomon codec should produce and accept the same repair
+// packets as OpenFEC Reed-Solomon codec, so that new and old senders and
+// receivers can talk to each other.
+TEST_GROUP(rs8m_interop) {
+    Config config;
+
+    core::Slice<uint8_t> buffers[NumPackets];
+
+    void setup() {
+        config.codec = ReedSolomon8m;
+        config.n_source_packets = NumSourcePackets;
+        config.n_repair_packets = NumRepairPackets;
+    }
+
+    void encode(IEncoder & encoder) {
+        for (size_t i = 0; i < NumPackets; ++i) {
+            buffers[i] = make_buffer();
+            encoder.set(i, buffers[i]);
+        }
+        encoder.commit();
+        encoder.reset();
+    }
+
+    // loses first n_repair_packets source packets, which is the maximum
+    // that Reed-Solomon can repair, so that every repair packet is used
+    bool decode(IDecoder & decoder) {
+        for (size_t i = NumRepairPackets; i < NumPackets; ++i) {
+            decoder.set(i, buffers[i]);
+        }
+        for (size_t i = 0; i < NumSourcePackets; ++i) {
+            core::Slice<uint8_t> decoded = decoder.repair(i);
+            if (!decoded) {
+                return false;
+            }
+            if (memcmp(buffers[i].data(), decoded.data(), PayloadSize) != 0) {
+                return false;
+            }
+        }
+        decoder.reset();
+        return true;
+    }
+};
+
+TEST(rs8m_interop, same_repair_packets) {
+    OFEncoder of_encoder(config, PayloadSize, allocator);
+    RS8mEncoder rs_encoder(config, PayloadSize, allocator);
+
+    encode(of_encoder);
+
+    core::Slice<uint8_t> rs_buffers[NumPackets];
+    for (size_t i = 0; i < NumPackets; ++i) {
+        rs_buffers[i] = i < NumSourcePackets ? copy_buffer(buffers[i]) : make_buffer();
+        rs_encoder.set(i, rs_buffers[i]);
+    }
+    rs_encoder.commit();
+    rs_encoder.reset();
+
+    for (size_t i = NumSourcePackets; i < NumPackets; ++i) {
+        CHECK(memcmp(buffers[i].data(), rs_buffers[i].data(), PayloadSize) == 0);
+    }
+}
+
+TEST(rs8m_interop, openfec_encoder_rs8m_decoder) {
+    OFEncoder encoder(config, PayloadSize, allocator);
+    RS8mDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    encode(encoder);
+    CHECK(decode(decoder));
+}
+
+TEST(rs8m_interop, rs8m_encoder_openfec_decoder) {
+    RS8mEncoder encoder(config, PayloadSize, allocator);
+    OFDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    encode(encoder);
+    CHECK(decode(decoder));
+}
+
+} // namespace fec
+} // namespace roc
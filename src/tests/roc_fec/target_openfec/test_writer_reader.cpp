@@ -60,10 +60,10 @@ class PacketDispatcher : public packet::IWriter {
 public:
     PacketDispatcher()
         : packet_num_(0)
-        , source_queue_(0)
-        , source_stock_(0)
-        , repair_queue_(0)
-        , repair_stock_(0) {
+        , source_queue_(allocator, 0)
+        , source_stock_(allocator, 0)
+        , repair_queue_(allocator, 0)
+        , repair_stock_(allocator, 0) {
         reset();
     }
 
@@ -140,6 +140,10 @@ public:
         }
     }
 
+    void push_source(const packet::PacketPtr& p) {
+        source_queue_.write(p);
+    }
+
     bool pop_source() {
         packet::PacketPtr p;
         if (!(p = source_stock_.read())) {
@@ -462,6 +466,53 @@ TEST(writer_reader, decoding_late_packet) {
     LONGS_EQUAL(0, dispatcher.source_size());
 }
 
+TEST(writer_reader, late_packet_after_side_repair) {
+    // 1. Lose packets #1 and #10.
+    // 2. Read till packet #1; decoding pass repairs both lost packets.
+    // 3. Receive original of packet #10, which replaces the repaired one.
+    // 4. Read and check the rest of block.
+
+    for (int type = ReedSolomon8m; type <= LDPCStaircase; ++type) {
+        config.codec = (CodecType)type;
+
+        OFEncoder encoder(config, FECPayloadSize, allocator);
+        OFDecoder decoder(config, FECPayloadSize, buffer_pool, allocator);
+
+        PacketDispatcher dispatcher;
+
+        Writer writer(config, FECPayloadSize, encoder, dispatcher, source_composer,
+                      repair_composer, packet_pool, buffer_pool, allocator);
+
+        Reader reader(config, decoder, dispatcher.source_reader(),
+                      dispatcher.repair_reader(), rtp_parser, packet_pool, allocator);
+
+        fill_all_packets(0);
+
+        dispatcher.lose(1);
+        dispatcher.lose(10);
+
+        for (size_t i = 0; i < NumSourcePackets; ++i) {
+            writer.write(source_packets[i]);
+        }
+        dispatcher.release_all();
+
+        for (size_t i = 0; i <= 1; ++i) {
+            packet::PacketPtr p = reader.read();
+            CHECK(p);
+            check_audio_packet(p, i);
+        }
+
+        dispatcher.push_source(source_packets[10]);
+
+        for (size_t i = 2; i < NumSourcePackets; ++i) {
+            packet::PacketPtr p = reader.read();
+            CHECK(p);
+            check_audio_packet(p, i);
+        }
+        LONGS_EQUAL(0, dispatcher.source_size());
+    }
+}
+
 TEST(writer_reader, get_packets_before_marker_bit) {
     // 1. Fill second half of block and whole block with one loss after, so that there
     //    is 10-19 and 20-39 seqnums in packet queue.
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/macros.h"
+#include "roc_core/random.h"
+#include "roc_core/stddefs.h"
+#include "roc_fec/gf256.h"
+#include "roc_fec/gf_kernel.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+enum { MaxSize = 300 };
+
+const GFKernel kernels[] = { GFKernel_Generic, GFKernel_SSSE3, GFKernel_AVX2,
+                             GFKernel_NEON };
+
+// multiplication by shift-and-add, independent from tables
+uint8_t slow_mul(uint8_t a, uint8_t b) {
+    unsigned r = 0, x = a;
+    for (; b; b >>= 1) {
+        if (b & 1) {
+            r ^= x;
+        }
+        x <<= 1;
+        if (x & 0x100) {
+            x ^= 0x11d;
+        }
+    }
+    return (uint8_t)r;
+}
+
+} // namespace
+
+TEST_GROUP(gf_kernel) {
+    uint8_t src[MaxSize];
+    uint8_t dst[MaxSize];
+
+    void setup() {
+        for (size_t n = 0; n < MaxSize; n++) {
+            src[n] = (uint8_t)core::random(0, 0xff);
+            dst[n] = (uint8_t)core::random(0, 0xff);
+        }
+    }
+
+    void check(GFKernel kernel, uint8_t coeff, size_t size) {
+        uint8_t result[MaxSize];
+        memcpy(result, dst, sizeof(result));
+
+        gf_kernel_muladd(kernel)(result, src, coeff, size);
+
+        for (size_t n = 0; n < MaxSize; n++) {
+            const uint8_t expected =
+                n < size ? uint8_t(dst[n] ^ slow_mul(coeff, src[n])) : dst[n];
+            LONGS_EQUAL(expected, result[n]);
+        }
+    }
+};
+
+TEST(gf_kernel, mul) {
+    for (unsigned a = 0; a < 256; a++) {
+        for (unsigned b = 0; b < 256; b++) {
+            LONGS_EQUAL(slow_mul((uint8_t)a, (uint8_t)b),
+                        gf256_mul((uint8_t)a, (uint8_t)b));
+        }
+    }
+}
+
+TEST(gf_kernel, inv) {
+    for (unsigned a = 1; a < 256; a++) {
+        LONGS_EQUAL(1, gf256_mul((uint8_t)a, gf256_inv((uint8_t)a)));
+    }
+}
+
+TEST(gf_kernel, generic_always_supported) {
+    CHECK(gf_kernel_supported(GFKernel_Generic));
+}
+
+TEST(gf_kernel, select_supported) {
+    CHECK(gf_kernel_supported(gf_kernel_select()));
+}
+
+TEST(gf_kernel, muladd) {
+    const uint8_t coeffs[] = { 0, 1, 2, 3, 0x1d, 0x80, 0xa5, 0xff };
+
+    for (size_t k = 0; k < ROC_ARRAY_SIZE(kernels); k++) {
+        if (!gf_kernel_supported(kernels[k])) {
+            continue;
+        }
+        for (size_t c = 0; c < ROC_ARRAY_SIZE(coeffs); c++) {
+            for (size_t size = 0; size <= 70; size++) {
+                check(kernels[k], coeffs[c], size);
+            }
+            check(kernels[k], coeffs[c], MaxSize);
+        }
+    }
+}
+
+TEST(gf_kernel, add) {
+    for (size_t k = 0; k < ROC_ARRAY_SIZE(kernels); k++) {
+        if (!gf_kernel_supported(kernels[k])) {
+            continue;
+        }
+        for (size_t size = 0; size <= MaxSize; size++) {
+            uint8_t result[MaxSize];
+            memcpy(result, dst, sizeof(result));
+
+            gf_kernel_add(kernels[k])(result, src, size);
+
+            for (size_t n = 0; n < MaxSize; n++) {
+                LONGS_EQUAL(n < size ? uint8_t(dst[n] ^ src[n]) : dst[n], result[n]);
+            }
+        }
+    }
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/random.h"
+#include "roc_fec/codec_factory.h"
+#include "roc_fec/parity_code.h"
+#include "roc_fec/parity_decoder.h"
+#include "roc_fec/parity_encoder.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+// 1-D code: 4 columns, 5 rows
+const size_t NumSourcePackets = 20;
+const size_t NumRepairPackets = 4;
+
+// 2-D code: 5 columns, 4 rows
+const size_t NumRepairPackets2D = 9;
+
+const size_t MaxPackets = NumSourcePackets + NumRepairPackets2D;
+
+const size_t PayloadSize = 251;
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, PayloadSize, 1);
+
+core::Slice<uint8_t> make_buffer() {
+    core::Slice<uint8_t> buf = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+    buf.resize(PayloadSize);
+    for (size_t j = 0; j < buf.size(); ++j) {
+        buf.data()[j] = (uint8_t)core::random(0, 0xff);
+    }
+    return buf;
+}
+
+} // namespace
+
+TEST_GROUP(parity_encoder_decoder) {
+    Config config;
+
+    core::Slice<uint8_t> buffers[MaxPackets];
+
+    void setup() {
+        config.codec = XORParity;
+        config.n_source_packets = NumSourcePackets;
+        config.n_repair_packets = NumRepairPackets;
+    }
+
+    void encode(IEncoder & encoder) {
+        for (size_t i = 0; i < config.n_source_packets + config.n_repair_packets; ++i) {
+            buffers[i] = make_buffer();
+            encoder.set(i, buffers[i]);
+        }
+        encoder.commit();
+        encoder.reset();
+    }
+
+    bool decode(IDecoder & decoder) {
+        for (size_t i = 0; i < config.n_source_packets; ++i) {
+            core::Slice<uint8_t> decoded = decoder.repair(i);
+            if (!decoded) {
+                return false;
+            }
+
+            LONGS_EQUAL(PayloadSize, decoded.size());
+
+            if (memcmp(buffers[i].data(), decoded.data(), PayloadSize) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+TEST(parity_encoder_decoder, supported) {
+    // k multiple of r: one-dimensional
+    CHECK(ParityCode::supported(20, 1));
+    CHECK(ParityCode::supported(20, 4));
+    CHECK(ParityCode::supported(20, 10));
+
+    // L + D = r, L * D = k: two-dimensional
+    CHECK(ParityCode::supported(20, 9));
+    CHECK(ParityCode::supported(16, 8));
+
+    CHECK(!ParityCode::supported(20, 0));
+    CHECK(!ParityCode::supported(20, 3));
+    CHECK(!ParityCode::supported(20, 7));
+    CHECK(!ParityCode::supported(0, 4));
+
+    ParityCode code1(20, 4);
+    UNSIGNED_LONGS_EQUAL(4, code1.n_columns());
+    UNSIGNED_LONGS_EQUAL(5, code1.n_rows());
+
+    ParityCode code2(20, 9);
+    UNSIGNED_LONGS_EQUAL(5, code2.n_columns());
+    UNSIGNED_LONGS_EQUAL(4, code2.n_rows());
+
+    UNSIGNED_LONGS_EQUAL(4, code2.group_size(0));
+    UNSIGNED_LONGS_EQUAL(5, code2.group_size(5));
+
+    UNSIGNED_LONGS_EQUAL(12, code2.group_member(2, 2));
+    UNSIGNED_LONGS_EQUAL(11, code2.group_member(7, 1));
+}
+
+TEST(parity_encoder_decoder, codec_factory) {
+    CHECK(codec_supported(XORParity));
+
+    IEncoder* encoder = new_encoder(config, PayloadSize, allocator);
+    CHECK(encoder);
+    allocator.destroy(*encoder);
+
+    IDecoder* decoder = new_decoder(config, PayloadSize, buffer_pool, allocator);
+    CHECK(decoder);
+    allocator.destroy(*decoder);
+
+    config.n_repair_packets = 7;
+
+    CHECK(!new_encoder(config, PayloadSize, allocator));
+    CHECK(!new_decoder(config, PayloadSize, buffer_pool, allocator));
+}
+
+TEST(parity_encoder_decoder, known_repair) {
+    ParityEncoder encoder(config, PayloadSize, allocator);
+
+    encode(encoder);
+
+    for (size_t r = 0; r < NumRepairPackets; r++) {
+        for (size_t n = 0; n < PayloadSize; n++) {
+            uint8_t expected = 0;
+            for (size_t i = r; i < NumSourcePackets; i += NumRepairPackets) {
+                expected ^= buffers[i].data()[n];
+            }
+            LONGS_EQUAL(expected, buffers[NumSourcePackets + r].data()[n]);
+        }
+    }
+}
+
+TEST(parity_encoder_decoder, without_loss) {
+    ParityEncoder encoder(config, PayloadSize, allocator);
+    ParityDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    encode(encoder);
+
+    for (size_t i = 0; i < NumSourcePackets + NumRepairPackets; ++i) {
+        decoder.set(i, buffers[i]);
+    }
+    CHECK(decode(decoder));
+}
+
+TEST(parity_encoder_decoder, loss_burst) {
+    ParityEncoder encoder(config, PayloadSize, allocator);
+    ParityDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    for (size_t first = 0; first + NumRepairPackets <= NumSourcePackets; first++) {
+        encode(encoder);
+
+        // a burst of up to L packets hits every column only once
+        for (size_t i = 0; i < NumSourcePackets + NumRepairPackets; ++i) {
+            if (i >= first && i < first + NumRepairPackets) {
+                continue;
+            }
+            decoder.set(i, buffers[i]);
+        }
+        CHECK(decode(decoder));
+
+        decoder.reset();
+    }
+}
+
+TEST(parity_encoder_decoder, loss_repair) {
+    ParityEncoder encoder(config, PayloadSize, allocator);
+    ParityDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    encode(encoder);
+
+    for (size_t i = 0; i < NumSourcePackets; ++i) {
+        decoder.set(i, buffers[i]);
+    }
+
+    // lost repair packets are recomputed from source packets
+    for (size_t r = 0; r < NumRepairPackets; r++) {
+        core::Slice<uint8_t> repair = decoder.repair(NumSourcePackets + r);
+        CHECK(repair);
+        CHECK(memcmp(buffers[NumSourcePackets + r].data(), repair.data(), PayloadSize)
+              == 0);
+    }
+}
+
+TEST(parity_encoder_decoder, too_much_loss_1d) {
+    ParityEncoder encoder(config, PayloadSize, allocator);
+    ParityDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    encode(encoder);
+
+    // packets 1 and 5 are in the same column
+    for (size_t i = 0; i < NumSourcePackets + NumRepairPackets; ++i) {
+        if (i == 1 || i == 5) {
+            continue;
+        }
+        decoder.set(i, buffers[i]);
+    }
+
+    CHECK(!decoder.repair(1));
+    CHECK(!decoder.repair(5));
+    CHECK(decoder.repair(2));
+}
+
+TEST(parity_encoder_decoder, late_packet_after_repair) {
+    ParityEncoder encoder(config, PayloadSize, allocator);
+    ParityDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    encode(encoder);
+
+    // packets 0 and 1 are in different columns
+    for (size_t i = 0; i < NumSourcePackets + NumRepairPackets; ++i) {
+        if (i == 0 || i == 1) {
+            continue;
+        }
+        decoder.set(i, buffers[i]);
+    }
+
+    // column 0 is checked first, so packet 0 is restored on the way
+    CHECK(decoder.repair(1));
+
+    // original of restored packet arrives late and replaces it
+    decoder.set(0, buffers[0]);
+
+    CHECK(decoder.repair(0).data() == buffers[0].data());
+    CHECK(decode(decoder));
+}
+
+TEST(parity_encoder_decoder, loss_2d) {
+    config.n_repair_packets = NumRepairPackets2D;
+
+    ParityEncoder encoder(config, PayloadSize, allocator);
+    ParityDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    encode(encoder);
+
+    // with 5 columns, packets 0, 5, 10 are in the same column and can't be
+    // repaired by column parity; packet 6 is repaired by its column, and then
+    // every row has only one loss
+    const size_t lost[] = { 0, 5, 6, 10 };
+
+    for (size_t i = 0; i < NumSourcePackets + NumRepairPackets2D; ++i) {
+        bool skip = false;
+        for (size_t n = 0; n < sizeof(lost) / sizeof(lost[0]); n++) {
+            if (lost[n] == i) {
+                skip = true;
+            }
+        }
+        if (!skip) {
+            decoder.set(i, buffers[i]);
+        }
+    }
+
+    CHECK(decode(decoder));
+}
+
+TEST(parity_encoder_decoder, too_much_loss_2d) {
+    config.n_repair_packets = NumRepairPackets2D;
+
+    ParityEncoder encoder(config, PayloadSize, allocator);
+    ParityDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    encode(encoder);
+
+    // packets 0, 1, 5, 6 form a square: every column and row covering them
+    // has two losses
+    for (size_t i = 0; i < NumSourcePackets + NumRepairPackets2D; ++i) {
+        if (i == 0 || i == 1 || i == 5 || i == 6) {
+            continue;
+        }
+        decoder.set(i, buffers[i]);
+    }
+
+    CHECK(!decoder.repair(0));
+    CHECK(!decoder.repair(6));
+    CHECK(decoder.repair(2));
+}
+
+TEST(parity_encoder_decoder, random_loss_2d) {
+    enum { NumIterations = 50 };
+
+    config.n_repair_packets = NumRepairPackets2D;
+
+    ParityEncoder encoder(config, PayloadSize, allocator);
+    ParityDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    for (size_t test_num = 0; test_num < NumIterations; ++test_num) {
+        encode(encoder);
+
+        // any two lost source packets are repaired by 2-D code
+        const size_t a = core::random(NumSourcePackets);
+        const size_t b = (a + 1 + core::random(NumSourcePackets - 1)) % NumSourcePackets;
+
+        for (size_t i = 0; i < NumSourcePackets + NumRepairPackets2D; ++i) {
+            if (i == a || i == b) {
+                continue;
+            }
+            decoder.set(i, buffers[i]);
+        }
+
+        CHECK(decode(decoder));
+        decoder.reset();
+    }
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_fec/composer.h"
+#include "roc_fec/headers.h"
+#include "roc_fec/parity_decoder.h"
+#include "roc_fec/parity_encoder.h"
+#include "roc_fec/reader.h"
+#include "roc_fec/rs8m_decoder.h"
+#include "roc_fec/rs8m_encoder.h"
+#include "roc_fec/writer.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/packet_pool.h"
+#include "roc_packet/sorted_queue.h"
+#include "roc_rtp/composer.h"
+#include "roc_rtp/format_map.h"
+#include "roc_rtp/headers.h"
+#include "roc_rtp/parser.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+const size_t NumSourcePackets = 20;
+const size_t NumRepairPackets = 10;
+
+const unsigned SourceID = 555;
+const unsigned PayloadType = rtp::PayloadType_L16_Stereo;
+
+const size_t RTPPayloadSize = 177;
+const size_t FECPayloadSize = RTPPayloadSize + sizeof(rtp::Header);
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, FECPayloadSize * 2, 1);
+packet::PacketPool packet_pool(allocator, 1);
+
+rtp::FormatMap format_map;
+rtp::Parser rtp_parser(format_map, NULL);
+rtp::Composer rtp_composer(NULL);
+fec::Composer<RSm8_PayloadID, Source, Footer> source_composer(&rtp_composer);
+fec::Composer<RSm8_PayloadID, Repair, Header> repair_composer_inner(NULL);
+rtp::Composer repair_composer(&repair_composer_inner);
+
+// Remembers packets produced by Writer, so that the test can deliver them
+// to Reader in arbitrary order.
+class PacketStock : public packet::IWriter {
+public:
+    PacketStock()
+        : source_queue(allocator, 0)
+        , repair_queue(allocator, 0)
+        , n_source_(0)
+        , n_repair_(0) {
+    }
+
+    virtual void write(const packet::PacketPtr& pp) {
+        if (pp->flags() & packet::Packet::FlagAudio) {
+            CHECK(n_source_ < NumSourcePackets);
+            source_[n_source_++] = pp;
+        } else if (pp->flags() & packet::Packet::FlagRepair) {
+            CHECK(n_repair_ < NumRepairPackets);
+            repair_[n_repair_++] = pp;
+        } else {
+            FAIL("unexpected packet type");
+        }
+    }
+
+    void deliver_source(size_t n) {
+        CHECK(n < n_source_);
+        source_queue.write(source_[n]);
+    }
+
+    void deliver_repair(size_t n) {
+        CHECK(n < n_repair_);
+        repair_queue.write(repair_[n]);
+    }
+
+    packet::SortedQueue source_queue;
+    packet::SortedQueue repair_queue;
+
+private:
+    packet::PacketPtr source_[NumSourcePackets];
+    packet::PacketPtr repair_[NumRepairPackets];
+
+    size_t n_source_;
+    size_t n_repair_;
+};
+
+} // namespace
+
+TEST_GROUP(reader) {
+    packet::PacketPtr source_packets[NumSourcePackets];
+
+    Config config;
+
+    void setup() {
+        config.codec = ReedSolomon8m;
+        config.n_source_packets = NumSourcePackets;
+        config.n_repair_packets = NumRepairPackets;
+
+        for (size_t i = 0; i < NumSourcePackets; ++i) {
+            source_packets[i] = make_packet(i);
+        }
+    }
+
+    packet::PacketPtr make_packet(size_t sn) {
+        packet::PacketPtr pp = new (packet_pool) packet::Packet(packet_pool);
+        CHECK(pp);
+
+        core::Slice<uint8_t> bp = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+        CHECK(bp);
+
+        CHECK(source_composer.prepare(*pp, bp, RTPPayloadSize));
+
+        pp->set_data(bp);
+        pp->add_flags(packet::Packet::FlagAudio);
+
+        pp->rtp()->source = SourceID;
+        pp->rtp()->payload_type = PayloadType;
+        pp->rtp()->seqnum = packet::seqnum_t(sn);
+        pp->rtp()->timestamp = packet::timestamp_t(sn * 10);
+
+        for (size_t i = 0; i < RTPPayloadSize; i++) {
+            pp->rtp()->payload.data()[i] = uint8_t(sn + i);
+        }
+
+        return pp;
+    }
+
+    void encode(PacketStock & stock) {
+        RS8mEncoder encoder(config, FECPayloadSize, allocator);
+        encode(stock, encoder);
+    }
+
+    void encode(PacketStock & stock, IEncoder & encoder) {
+        Writer writer(config, FECPayloadSize, encoder, stock, source_composer,
+                      repair_composer, packet_pool, buffer_pool, allocator);
+
+        for (size_t i = 0; i < NumSourcePackets; ++i) {
+            writer.write(source_packets[i]);
+        }
+    }
+
+    void check_packet(const packet::PacketPtr& pp, size_t sn) {
+        CHECK(pp);
+        CHECK(pp->rtp());
+
+        UNSIGNED_LONGS_EQUAL(SourceID, pp->rtp()->source);
+        UNSIGNED_LONGS_EQUAL(sn, pp->rtp()->seqnum);
+        UNSIGNED_LONGS_EQUAL(RTPPayloadSize, pp->rtp()->payload.size());
+
+        for (size_t i = 0; i < RTPPayloadSize; i++) {
+            UNSIGNED_LONGS_EQUAL(uint8_t(sn + i), pp->rtp()->payload.data()[i]);
+        }
+    }
+};
+
+TEST(reader, no_losses) {
+    PacketStock stock;
+    encode(stock);
+
+    RS8mDecoder decoder(config, FECPayloadSize, buffer_pool, allocator);
+    Reader reader(config, decoder, stock.source_queue, stock.repair_queue, rtp_parser,
+                  packet_pool, allocator);
+
+    for (size_t i = 0; i < NumSourcePackets; ++i) {
+        stock.deliver_source(i);
+    }
+    for (size_t i = 0; i < NumRepairPackets; ++i) {
+        stock.deliver_repair(i);
+    }
+
+    for (size_t i = 0; i < NumSourcePackets; ++i) {
+        packet::PacketPtr pp = reader.read();
+        check_packet(pp, i);
+        CHECK(pp == source_packets[i]);
+    }
+
+    UNSIGNED_LONGS_EQUAL(0, reader.n_repairs_attempted());
+    UNSIGNED_LONGS_EQUAL(0, reader.n_repairs_succeeded());
+    UNSIGNED_LONGS_EQUAL(0, reader.n_repairs_wasted());
+}
+
+TEST(reader, repair_on_demand) {
+    // Packet #5 is lost and packet #10 is late. Only packet #5 should be
+    // repaired, since packet #10 arrives before the reader needs it.
+
+    PacketStock stock;
+    encode(stock);
+
+    RS8mDecoder decoder(config, FECPayloadSize, buffer_pool, allocator);
+    Reader reader(config, decoder, stock.source_queue, stock.repair_queue, rtp_parser,
+                  packet_pool, allocator);
+
+    for (size_t i = 0; i < NumSourcePackets; ++i) {
+        if (i != 5 && i != 10) {
+            stock.deliver_source(i);
+        }
+    }
+    for (size_t i = 0; i < NumRepairPackets; ++i) {
+        stock.deliver_repair(i);
+    }
+
+    for (size_t i = 0; i <= 5; ++i) {
+        check_packet(reader.read(), i);
+    }
+
+    UNSIGNED_LONGS_EQUAL(1, reader.n_repairs_attempted());
+    UNSIGNED_LONGS_EQUAL(1, reader.n_repairs_succeeded());
+
+    stock.deliver_source(10);
+
+    for (size_t i = 6; i < NumSourcePackets; ++i) {
+        packet::PacketPtr pp = reader.read();
+        check_packet(pp, i);
+        CHECK(pp == source_packets[i]);
+    }
+
+    UNSIGNED_LONGS_EQUAL(1, reader.n_repairs_attempted());
+    UNSIGNED_LONGS_EQUAL(1, reader.n_repairs_succeeded());
+    UNSIGNED_LONGS_EQUAL(0, reader.n_repairs_wasted());
+}
+
+TEST(reader, repair_wasted) {
+    // Packet #3 is repaired when the reader needs it, but the original
+    // packet arrives later anyway.
+
+    PacketStock stock;
+    encode(stock);
+
+    RS8mDecoder decoder(config, FECPayloadSize, buffer_pool, allocator);
+    Reader reader(config, decoder, stock.source_queue, stock.repair_queue, rtp_parser,
+                  packet_pool, allocator);
+
+    for (size_t i = 0; i < NumSourcePackets; ++i) {
+        if (i != 3) {
+            stock.deliver_source(i);
+        }
+    }
+    stock.deliver_repair(7);
+
+    for (size_t i = 0; i <= 3; ++i) {
+        check_packet(reader.read(), i);
+    }
+
+    stock.deliver_source(3);
+
+    for (size_t i = 4; i < NumSourcePackets; ++i) {
+        check_packet(reader.read(), i);
+    }
+
+    UNSIGNED_LONGS_EQUAL(1, reader.n_repairs_attempted());
+    UNSIGNED_LONGS_EQUAL(1, reader.n_repairs_succeeded());
+    UNSIGNED_LONGS_EQUAL(1, reader.n_repairs_wasted());
+}
+
+TEST(reader, late_packet_after_side_repair) {
+    // Packets #1 and #10 are lost. With 20+10 parity code they're in different
+    // columns, and repairing #1 restores #10 too. Then the original of #10
+    // arrives and should replace the restored packet.
+
+    config.codec = XORParity;
+
+    PacketStock stock;
+
+    ParityEncoder encoder(config, FECPayloadSize, allocator);
+    encode(stock, encoder);
+
+    ParityDecoder decoder(config, FECPayloadSize, buffer_pool, allocator);
+    Reader reader(config, decoder, stock.source_queue, stock.repair_queue, rtp_parser,
+                  packet_pool, allocator);
+
+    for (size_t i = 0; i < NumSourcePackets; ++i) {
+        if (i != 1 && i != 10) {
+            stock.deliver_source(i);
+        }
+    }
+    for (size_t i = 0; i < NumRepairPackets; ++i) {
+        stock.deliver_repair(i);
+    }
+
+    for (size_t i = 0; i <= 1; ++i) {
+        check_packet(reader.read(), i);
+    }
+
+    UNSIGNED_LONGS_EQUAL(1, reader.n_repairs_attempted());
+    UNSIGNED_LONGS_EQUAL(1, reader.n_repairs_succeeded());
+
+    stock.deliver_source(10);
+
+    for (size_t i = 2; i < NumSourcePackets; ++i) {
+        packet::PacketPtr pp = reader.read();
+        check_packet(pp, i);
+        CHECK(pp == source_packets[i]);
+    }
+
+    UNSIGNED_LONGS_EQUAL(1, reader.n_repairs_attempted());
+    UNSIGNED_LONGS_EQUAL(1, reader.n_repairs_succeeded());
+    UNSIGNED_LONGS_EQUAL(0, reader.n_repairs_wasted());
+}
+
+TEST(reader, repair_not_possible) {
+    // Too many packets are lost. The reader should try to repair only once
+    // and then skip missing packets until new packets arrive.
+
+    PacketStock stock;
+    encode(stock);
+
+    RS8mDecoder decoder(config, FECPayloadSize, buffer_pool, allocator);
+    Reader reader(config, decoder, stock.source_queue, stock.repair_queue, rtp_parser,
+                  packet_pool, allocator);
+
+    for (size_t i = 0; i < NumSourcePackets; ++i) {
+        if (i % 2 == 0 || i == NumSourcePackets - 1) {
+            stock.deliver_source(i);
+        }
+    }
+    stock.deliver_repair(0);
+
+    for (size_t i = 0; i < NumSourcePackets; ++i) {
+        if (i % 2 == 0 || i == NumSourcePackets - 1) {
+            check_packet(reader.read(), i);
+        }
+    }
+
+    UNSIGNED_LONGS_EQUAL(1, reader.n_repairs_attempted());
+    UNSIGNED_LONGS_EQUAL(0, reader.n_repairs_succeeded());
+    UNSIGNED_LONGS_EQUAL(0, reader.n_repairs_wasted());
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/random.h"
+#include "roc_fec/gf256.h"
+#include "roc_fec/rlc_code.h"
+#include "roc_fec/rlc_decoder.h"
+#include "roc_fec/rlc_encoder.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+const size_t NumSourcePackets = 300;
+const size_t NumRepairPackets = 30;
+
+const size_t PayloadSize = 251;
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, PayloadSize, 1);
+
+core::Slice<uint8_t> make_buffer() {
+    core::Slice<uint8_t> buf = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+    buf.resize(PayloadSize);
+    for (size_t j = 0; j < buf.size(); ++j) {
+        buf.data()[j] = (uint8_t)core::random(0, 0xff);
+    }
+    return buf;
+}
+
+} // namespace
+
+TEST_GROUP(rlc_encoder_decoder) {
+    Config config;
+
+    core::Slice<uint8_t> buffers[NumSourcePackets + NumRepairPackets];
+
+    void setup() {
+        config.codec = RandomLinear;
+        config.n_source_packets = NumSourcePackets;
+        config.n_repair_packets = NumRepairPackets;
+    }
+
+    void encode(IEncoder & encoder) {
+        for (size_t i = 0; i < NumSourcePackets + NumRepairPackets; ++i) {
+            buffers[i] = make_buffer();
+            encoder.set(i, buffers[i]);
+        }
+        encoder.commit();
+        encoder.reset();
+    }
+
+    bool decode(IDecoder & decoder) {
+        for (size_t i = 0; i < NumSourcePackets; ++i) {
+            core::Slice<uint8_t> decoded = decoder.repair(i);
+            if (!decoded) {
+                return false;
+            }
+
+            LONGS_EQUAL(PayloadSize, decoded.size());
+
+            if (memcmp(buffers[i].data(), decoded.data(), PayloadSize) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+TEST(rlc_encoder_decoder, known_repair) {
+    RLCCode code(NumSourcePackets, NumRepairPackets, allocator);
+    RLCEncoder encoder(config, PayloadSize, allocator);
+
+    encode(encoder);
+
+    for (size_t r = 0; r < NumRepairPackets; r++) {
+        const uint8_t* row = code.row(r);
+
+        for (size_t n = 0; n < PayloadSize; n++) {
+            uint8_t expected = 0;
+            for (size_t j = 0; j < NumSourcePackets; j++) {
+                CHECK(row[j] != 0);
+                expected ^= gf256_mul(row[j], buffers[j].data()[n]);
+            }
+            LONGS_EQUAL(expected, buffers[NumSourcePackets + r].data()[n]);
+        }
+    }
+}
+
+TEST(rlc_encoder_decoder, fixed_coefficients) {
+    // coefficients are part of wire format: if this test fails, encoders and
+    // decoders of different versions can't repair each other's packets
+    const uint8_t small[2][4] = {
+        { 0x5d, 0x18, 0x8d, 0x18 },
+        { 0x82, 0x5d, 0xa3, 0x97 },
+    };
+
+    RLCCode small_code(4, 2, allocator);
+
+    for (size_t r = 0; r < 2; r++) {
+        for (size_t j = 0; j < 4; j++) {
+            UNSIGNED_LONGS_EQUAL(small[r][j], small_code.row(r)[j]);
+        }
+    }
+
+    const uint8_t large_first[20] = {
+        0x69, 0x08, 0xcb, 0xc2, 0xab, 0x47, 0x28, 0x60, 0x51, 0x5b,
+        0x1d, 0x96, 0x7d, 0x80, 0x80, 0x1a, 0xa7, 0x07, 0x1b, 0x6c,
+    };
+    const uint8_t large_last[20] = {
+        0xa1, 0x1e, 0x02, 0x77, 0xef, 0x17, 0x91, 0x4d, 0xa2, 0x2a,
+        0x77, 0x16, 0xc7, 0xc9, 0x6d, 0x01, 0x46, 0x33, 0xcd, 0x62,
+    };
+
+    RLCCode large_code(20, 10, allocator);
+
+    for (size_t j = 0; j < 20; j++) {
+        UNSIGNED_LONGS_EQUAL(large_first[j], large_code.row(0)[j]);
+        UNSIGNED_LONGS_EQUAL(large_last[j], large_code.row(9)[j]);
+    }
+}
+
+TEST(rlc_encoder_decoder, without_loss) {
+    RLCEncoder encoder(config, PayloadSize, allocator);
+    RLCDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    encode(encoder);
+
+    for (size_t i = 0; i < NumSourcePackets + NumRepairPackets; ++i) {
+        decoder.set(i, buffers[i]);
+    }
+    CHECK(decode(decoder));
+}
+
+TEST(rlc_encoder_decoder, loss_1_any_repair) {
+    RLCEncoder encoder(config, PayloadSize, allocator);
+    RLCDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    for (size_t lost = 0; lost < NumSourcePackets; lost += 7) {
+        for (size_t repair = 0; repair < NumRepairPackets; repair++) {
+            encode(encoder);
+
+            // coefficients are non-zero, so any repair packet can be used
+            for (size_t i = 0; i < NumSourcePackets; ++i) {
+                if (i == lost) {
+                    continue;
+                }
+                decoder.set(i, buffers[i]);
+            }
+            decoder.set(NumSourcePackets + repair, buffers[NumSourcePackets + repair]);
+
+            CHECK(decode(decoder));
+            decoder.reset();
+        }
+    }
+}
+
+TEST(rlc_encoder_decoder, loss_burst) {
+    RLCEncoder encoder(config, PayloadSize, allocator);
+    RLCDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    for (size_t first = 0; first + NumRepairPackets - 2 <= NumSourcePackets;
+         first += 11) {
+        encode(encoder);
+
+        // two extra repair packets make decoding failure very unlikely
+        for (size_t i = 0; i < NumSourcePackets + NumRepairPackets; ++i) {
+            if (i >= first && i < first + NumRepairPackets - 2) {
+                continue;
+            }
+            decoder.set(i, buffers[i]);
+        }
+        CHECK(decode(decoder));
+
+        decoder.reset();
+    }
+}
+
+TEST(rlc_encoder_decoder, incremental) {
+    RLCEncoder encoder(config, PayloadSize, allocator);
+    RLCDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    encode(encoder);
+
+    // repair packets arrive before the source packets, and some source
+    // packets arrive after first repair attempts
+    for (size_t i = 0; i < NumRepairPackets; ++i) {
+        decoder.set(NumSourcePackets + i, buffers[NumSourcePackets + i]);
+    }
+
+    for (size_t i = 0; i < NumSourcePackets; ++i) {
+        if (i % 20 == 0) {
+            continue;
+        }
+        if (i % 20 == 1) {
+            CHECK(!decoder.repair(i));
+        }
+        decoder.set(i, buffers[i]);
+    }
+
+    CHECK(decode(decoder));
+}
+
+TEST(rlc_encoder_decoder, too_much_loss) {
+    RLCEncoder encoder(config, PayloadSize, allocator);
+    RLCDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    encode(encoder);
+
+    for (size_t i = 0; i < NumSourcePackets + NumRepairPackets; ++i) {
+        if (i < NumRepairPackets + 1) {
+            continue;
+        }
+        decoder.set(i, buffers[i]);
+    }
+
+    CHECK(!decoder.repair(0));
+    CHECK(decoder.repair(NumRepairPackets + 1));
+}
+
+TEST(rlc_encoder_decoder, lost_repair) {
+    RLCEncoder encoder(config, PayloadSize, allocator);
+    RLCDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    encode(encoder);
+
+    for (size_t i = 1; i < NumSourcePackets + 1; ++i) {
+        decoder.set(i, buffers[i]);
+    }
+
+    // repair packets are recomputed when all source packets are repaired
+    core::Slice<uint8_t> repair = decoder.repair(NumSourcePackets + 5);
+    CHECK(repair);
+    CHECK(memcmp(buffers[NumSourcePackets + 5].data(), repair.data(), PayloadSize) == 0);
+}
+
+TEST(rlc_encoder_decoder, random_loss) {
+    enum { NumIterations = 20 };
+
+    RLCEncoder encoder(config, PayloadSize, allocator);
+    RLCDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    for (size_t test_num = 0; test_num < NumIterations; ++test_num) {
+        encode(encoder);
+
+        size_t n_lost = 0;
+        for (size_t i = 0; i < NumSourcePackets + NumRepairPackets; ++i) {
+            if (n_lost < NumRepairPackets - 2 && core::random(100) < 10) {
+                n_lost++;
+                continue;
+            }
+            decoder.set(i, buffers[i]);
+        }
+
+        CHECK(decode(decoder));
+        decoder.reset();
+    }
+}
+
+} // namespace fec
+} // namespace roc
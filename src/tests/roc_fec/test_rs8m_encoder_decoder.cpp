@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/random.h"
+#include "roc_fec/gf256.h"
+#include "roc_fec/rs8m_decoder.h"
+#include "roc_fec/rs8m_encoder.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+const size_t NumSourcePackets = 20;
+const size_t NumRepairPackets = 10;
+
+const size_t PayloadSize = 251;
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, PayloadSize, 1);
+
+core::Slice<uint8_t> make_buffer() {
+    core::Slice<uint8_t> buf = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+    buf.resize(PayloadSize);
+    for (size_t j = 0; j < buf.size(); ++j) {
+        buf.data()[j] = (uint8_t)core::random(0, 0xff);
+    }
+    return buf;
+}
+
+} // namespace
+
+TEST_GROUP(rs8m_encoder_decoder) {
+    Config config;
+
+    core::Slice<uint8_t> buffers[NumSourcePackets + NumRepairPackets];
+
+    void setup() {
+        config.codec = ReedSolomon8m;
+        config.n_source_packets = NumSourcePackets;
+        config.n_repair_packets = NumRepairPackets;
+    }
+
+    void encode(IEncoder & encoder) {
+        for (size_t i = 0; i < NumSourcePackets + NumRepairPackets; ++i) {
+            buffers[i] = make_buffer();
+            encoder.set(i, buffers[i]);
+        }
+        encoder.commit();
+        encoder.reset();
+    }
+
+    bool decode(IDecoder & decoder) {
+        for (size_t i = 0; i < NumSourcePackets; ++i) {
+            core::Slice<uint8_t> decoded = decoder.repair(i);
+            if (!decoded) {
+                return false;
+            }
+
+            LONGS_EQUAL(PayloadSize, decoded.size());
+
+            if (memcmp(buffers[i].data(), decoded.data(), PayloadSize) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+TEST(rs8m_encoder_decoder, known_repair) {
+    // k = 2, r = 1: points are 0, 1, alpha, and the repair row is
+    // [1 alpha] * inv([1 0; 1 1]) = [1 + alpha, alpha] = [3, 2]
+    Config cfg;
+    cfg.codec = ReedSolomon8m;
+    cfg.n_source_packets = 2;
+    cfg.n_repair_packets = 1;
+
+    RS8mEncoder encoder(cfg, PayloadSize, allocator);
+
+    core::Slice<uint8_t> s0 = make_buffer();
+    core::Slice<uint8_t> s1 = make_buffer();
+    core::Slice<uint8_t> r0 = make_buffer();
+
+    encoder.set(0, s0);
+    encoder.set(1, s1);
+    encoder.set(2, r0);
+    encoder.commit();
+
+    for (size_t n = 0; n < PayloadSize; n++) {
+        LONGS_EQUAL(gf256_mul(3, s0.data()[n]) ^ gf256_mul(2, s1.data()[n]),
+                    r0.data()[n]);
+    }
+}
+
+TEST(rs8m_encoder_decoder, without_loss) {
+    RS8mEncoder encoder(config, PayloadSize, allocator);
+    RS8mDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    encode(encoder);
+
+    for (size_t i = 0; i < NumSourcePackets + NumRepairPackets; ++i) {
+        decoder.set(i, buffers[i]);
+    }
+    CHECK(decode(decoder));
+}
+
+TEST(rs8m_encoder_decoder, loss_1) {
+    RS8mEncoder encoder(config, PayloadSize, allocator);
+    RS8mDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    encode(encoder);
+
+    for (size_t i = 0; i < NumSourcePackets + NumRepairPackets; ++i) {
+        if (i == 5) {
+            continue;
+        }
+        decoder.set(i, buffers[i]);
+    }
+    CHECK(decode(decoder));
+}
+
+TEST(rs8m_encoder_decoder, loss_1_any_repair) {
+    RS8mEncoder encoder(config, PayloadSize, allocator);
+    RS8mDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    for (size_t lost = 0; lost < NumSourcePackets; lost++) {
+        for (size_t repair = 0; repair < NumRepairPackets; repair++) {
+            encode(encoder);
+
+            // one lost source packet is recovered from any single repair packet
+            for (size_t i = 0; i < NumSourcePackets; ++i) {
+                if (i == lost) {
+                    continue;
+                }
+                decoder.set(i, buffers[i]);
+            }
+            decoder.set(NumSourcePackets + repair, buffers[NumSourcePackets + repair]);
+
+            CHECK(decode(decoder));
+            decoder.reset();
+        }
+    }
+}
+
+TEST(rs8m_encoder_decoder, max_loss) {
+    RS8mEncoder encoder(config, PayloadSize, allocator);
+    RS8mDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    for (size_t first = 0; first <= NumSourcePackets; first++) {
+        encode(encoder);
+
+        // any NumSourcePackets packets are enough
+        for (size_t i = 0; i < NumSourcePackets + NumRepairPackets; ++i) {
+            if (i >= first && i < first + NumRepairPackets) {
+                continue;
+            }
+            decoder.set(i, buffers[i]);
+        }
+        CHECK(decode(decoder));
+
+        decoder.reset();
+    }
+}
+
+TEST(rs8m_encoder_decoder, too_much_loss) {
+    RS8mEncoder encoder(config, PayloadSize, allocator);
+    RS8mDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    encode(encoder);
+
+    for (size_t i = 0; i < NumSourcePackets + NumRepairPackets; ++i) {
+        if (i < NumRepairPackets + 1) {
+            continue;
+        }
+        decoder.set(i, buffers[i]);
+    }
+
+    CHECK(!decoder.repair(0));
+    CHECK(decoder.repair(NumRepairPackets + 1));
+}
+
+TEST(rs8m_encoder_decoder, random_loss) {
+    enum { NumIterations = 50 };
+
+    RS8mEncoder encoder(config, PayloadSize, allocator);
+    RS8mDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    for (size_t test_num = 0; test_num < NumIterations; ++test_num) {
+        encode(encoder);
+
+        size_t n_lost = 0;
+        for (size_t i = 0; i < NumSourcePackets + NumRepairPackets; ++i) {
+            if (n_lost < NumRepairPackets && core::random(100) < 30) {
+                n_lost++;
+                continue;
+            }
+            decoder.set(i, buffers[i]);
+        }
+
+        CHECK(decode(decoder));
+        decoder.reset();
+    }
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/atomic.h"
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/semaphore.h"
+#include "roc_core/time.h"
+#include "roc_fec/composer.h"
+#include "roc_fec/headers.h"
+#include "roc_fec/iencoder.h"
+#include "roc_fec/writer.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/packet_pool.h"
+#include "roc_rtp/composer.h"
+#include "roc_rtp/headers.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+const size_t NumSourcePackets = 20;
+const size_t NumRepairPackets = 10;
+
+const size_t RTPPayloadSize = 177;
+const size_t FECPayloadSize = RTPPayloadSize + sizeof(rtp::Header);
+
+const core::nanoseconds_t WaitStep = 1000000;
+const size_t MaxWaitSteps = 5000;
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, FECPayloadSize * 2, 1);
+packet::PacketPool packet_pool(allocator, 1);
+
+rtp::Composer rtp_composer(NULL);
+fec::Composer<RSm8_PayloadID, Source, Footer> source_composer(&rtp_composer);
+fec::Composer<RSm8_PayloadID, Repair, Header> repair_composer_inner(NULL);
+rtp::Composer repair_composer(&repair_composer_inner);
+
+// Encoder that doesn't touch buffers and can be paused inside commit().
+class MockEncoder : public IEncoder {
+public:
+    MockEncoder()
+        : paused_(false)
+        , sem_(0) {
+    }
+
+    void pause() {
+        paused_ = true;
+    }
+
+    void resume() {
+        paused_ = false;
+        sem_.post();
+    }
+
+    virtual size_t alignment() const {
+        return 8;
+    }
+
+    virtual void set(size_t, const core::Slice<uint8_t>&) {
+    }
+
+    virtual void commit() {
+        if (paused_) {
+            sem_.pend();
+        }
+    }
+
+    virtual void reset() {
+    }
+
+private:
+    core::Atomic paused_;
+    core::Semaphore sem_;
+};
+
+// Counts packets written by Writer.
+class PacketCounter : public packet::IWriter {
+public:
+    PacketCounter()
+        : n_source(0)
+        , n_repair(0) {
+    }
+
+    virtual void write(const packet::PacketPtr& pp) {
+        if (pp->flags() & packet::Packet::FlagAudio) {
+            n_source++;
+        } else if (pp->flags() & packet::Packet::FlagRepair) {
+            n_repair++;
+        } else {
+            FAIL("unexpected packet type");
+        }
+    }
+
+    size_t n_source;
+    size_t n_repair;
+};
+
+packet::PacketPtr make_packet(size_t sn) {
+    packet::PacketPtr pp = new (packet_pool) packet::Packet(packet_pool);
+    CHECK(pp);
+
+    core::Slice<uint8_t> bp = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+    CHECK(bp);
+
+    CHECK(source_composer.prepare(*pp, bp, RTPPayloadSize));
+
+    pp->set_data(bp);
+    pp->add_flags(packet::Packet::FlagAudio);
+
+    pp->rtp()->seqnum = packet::seqnum_t(sn);
+
+    return pp;
+}
+
+void wait_encoded(Writer& writer, size_t n_blocks) {
+    for (size_t n = 0; n < MaxWaitSteps; n++) {
+        if (writer.n_blocks_encoded() >= n_blocks) {
+            break;
+        }
+        core::sleep_for(WaitStep);
+    }
+    UNSIGNED_LONGS_EQUAL(n_blocks, writer.n_blocks_encoded());
+}
+
+} // namespace
+
+TEST_GROUP(writer) {
+    Config config;
+
+    void setup() {
+        config.codec = ReedSolomon8m;
+        config.n_source_packets = NumSourcePackets;
+        config.n_repair_packets = NumRepairPackets;
+    }
+};
+
+TEST(writer, encode_in_place) {
+    MockEncoder encoder;
+    PacketCounter counter;
+
+    Writer writer(config, FECPayloadSize, encoder, counter, source_composer,
+                  repair_composer, packet_pool, buffer_pool, allocator);
+
+    for (size_t i = 0; i < NumSourcePackets; ++i) {
+        writer.write(make_packet(i));
+    }
+
+    UNSIGNED_LONGS_EQUAL(NumSourcePackets, counter.n_source);
+    UNSIGNED_LONGS_EQUAL(NumRepairPackets, counter.n_repair);
+
+    UNSIGNED_LONGS_EQUAL(1, writer.n_blocks_encoded());
+    UNSIGNED_LONGS_EQUAL(0, writer.n_blocks_dropped());
+}
+
+TEST(writer, encoding_thread) {
+    MockEncoder encoder;
+    PacketCounter counter;
+
+    Writer writer(config, FECPayloadSize, encoder, counter, source_composer,
+                  repair_composer, packet_pool, buffer_pool, allocator);
+
+    CHECK(writer.start_encoding_thread(2));
+
+    encoder.pause();
+
+    for (size_t i = 0; i < NumSourcePackets; ++i) {
+        writer.write(make_packet(i));
+    }
+
+    // source packets are not delayed by encoding
+    UNSIGNED_LONGS_EQUAL(NumSourcePackets, counter.n_source);
+    UNSIGNED_LONGS_EQUAL(0, counter.n_repair);
+
+    encoder.resume();
+    wait_encoded(writer, 1);
+
+    // repair packets are forwarded by the next write
+    writer.write(make_packet(NumSourcePackets));
+
+    UNSIGNED_LONGS_EQUAL(NumSourcePackets + 1, counter.n_source);
+    UNSIGNED_LONGS_EQUAL(NumRepairPackets, counter.n_repair);
+
+    UNSIGNED_LONGS_EQUAL(0, writer.n_blocks_dropped());
+    UNSIGNED_LONGS_EQUAL(1, writer.max_queued_blocks());
+}
+
+TEST(writer, encoding_queue_full) {
+    MockEncoder encoder;
+    PacketCounter counter;
+
+    Writer writer(config, FECPayloadSize, encoder, counter, source_composer,
+                  repair_composer, packet_pool, buffer_pool, allocator);
+
+    CHECK(writer.start_encoding_thread(1));
+
+    encoder.pause();
+
+    for (size_t i = 0; i < NumSourcePackets * 3; ++i) {
+        writer.write(make_packet(i));
+    }
+
+    UNSIGNED_LONGS_EQUAL(NumSourcePackets * 3, counter.n_source);
+    UNSIGNED_LONGS_EQUAL(0, counter.n_repair);
+
+    UNSIGNED_LONGS_EQUAL(2, writer.n_blocks_dropped());
+    UNSIGNED_LONGS_EQUAL(1, writer.max_queued_blocks());
+
+    encoder.resume();
+    wait_encoded(writer, 1);
+
+    writer.write(make_packet(NumSourcePackets * 3));
+
+    UNSIGNED_LONGS_EQUAL(NumRepairPackets, counter.n_repair);
+}
+
+} // namespace fec
+} // namespace roc
@@ -46,7 +46,8 @@ public:
            size_t frame_size)
         : samples_(samples)
         , sz_(len)
-        , frame_size_(frame_size) {
+        , frame_size_(frame_size)
+        , zero_copy_(false) {
         packet::Address addr;
         CHECK(packet::parse_address("127.0.0.1:0", addr));
         sndr_ = roc_sender_new(&config);
@@ -65,26 +66,46 @@ public:
         roc_sender_delete(sndr_);
     }
 
+    void enable_zero_copy() {
+        zero_copy_ = true;
+    }
+
 private:
     virtual void run() {
         for (size_t off = 0; off < sz_; off += frame_size_) {
             if (off + frame_size_ > sz_) {
                 off = sz_ - frame_size_;
             }
-            const ssize_t ret = roc_sender_write(sndr_, samples_ + off, frame_size_);
-            LONGS_EQUAL(frame_size_, ret);
+            LONGS_EQUAL(frame_size_, write(samples_ + off, frame_size_));
+        }
+    }
+
+    ssize_t write(const float* samples, size_t n_samples) {
+        if (!zero_copy_) {
+            return roc_sender_write(sndr_, samples, n_samples);
         }
+
+        size_t max_samples = 0;
+        float* buffer = roc_sender_begin_write(sndr_, &max_samples);
+        CHECK(buffer);
+        CHECK(max_samples >= n_samples);
+
+        memcpy(buffer, samples, n_samples * sizeof(float));
+
+        return roc_sender_end_write(sndr_, buffer, n_samples);
     }
 
     roc_sender* sndr_;
     float* samples_;
     const size_t sz_;
     const size_t frame_size_;
+    bool zero_copy_;
 };
 
 class Receiver {
 public:
-    Receiver(roc_receiver_config& config) {
+    Receiver(roc_receiver_config& config)
+        : zero_copy_(false) {
         CHECK(packet::parse_address("127.0.0.1:0", source_addr_));
         CHECK(packet::parse_address("127.0.0.1:0", repair_addr_));
         recv_ = roc_receiver_new(&config);
@@ -100,6 +121,10 @@ public:
         roc_receiver_delete(recv_);
     }
 
+    void enable_zero_copy() {
+        zero_copy_ = true;
+    }
+
     packet::Address source_addr() {
         return source_addr_;
     }
@@ -109,11 +134,24 @@ public:
     }
 
     ssize_t read(float* samples, const size_t n_samples) {
-        return roc_receiver_read(recv_, samples, n_samples);
+        if (!zero_copy_) {
+            return roc_receiver_read(recv_, samples, n_samples);
+        }
+
+        const float* buffer = roc_receiver_begin_read(recv_, n_samples);
+        if (!buffer) {
+            return -1;
+        }
+
+        memcpy(samples, buffer, n_samples * sizeof(float));
+        roc_receiver_end_read(recv_, buffer);
+
+        return (ssize_t)n_samples;
     }
 
 private:
     roc_receiver* recv_;
+    bool zero_copy_;
 
     packet::Address source_addr_;
     packet::Address repair_addr_;
@@ -296,6 +334,93 @@ TEST(sender_receiver, simple) {
     sndr.join();
 }
 
+TEST(sender_receiver, preallocated) {
+    sender_conf.packet_pool_size = packet_num * 2;
+    sender_conf.frame_pool_size = 1;
+
+    receiver_conf.packet_pool_size = packet_num * 2;
+    receiver_conf.frame_pool_size = 1;
+    receiver_conf.max_packets = packet_num * 4;
+
+    Receiver recv(receiver_conf);
+
+    Sender sndr(sender_conf, recv.source_addr(), recv.repair_addr(), s2send, total_sz,
+                frame_size);
+
+    sndr.start();
+    check_sample_arrays(recv, s2send, total_sz);
+    sndr.join();
+}
+
+TEST(sender_receiver, small_frames) {
+    // writes and reads are split into several frames
+    sender_conf.max_frame_size = frame_size / 4;
+    receiver_conf.max_frame_size = 256;
+
+    Receiver recv(receiver_conf);
+
+    Sender sndr(sender_conf, recv.source_addr(), recv.repair_addr(), s2send, total_sz,
+                frame_size);
+
+    sndr.start();
+    check_sample_arrays(recv, s2send, total_sz);
+    sndr.join();
+}
+
+TEST(sender_receiver, zero_copy) {
+    Receiver recv(receiver_conf);
+    recv.enable_zero_copy();
+
+    Sender sndr(sender_conf, recv.source_addr(), recv.repair_addr(), s2send, total_sz,
+                frame_size);
+    sndr.enable_zero_copy();
+
+    sndr.start();
+    check_sample_arrays(recv, s2send, total_sz);
+    sndr.join();
+}
+
+TEST(sender_receiver, frame_too_small) {
+    receiver_conf.max_frame_size = 1;
+    CHECK(!roc_receiver_new(&receiver_conf));
+
+    sender_conf.max_frame_size = 1;
+    CHECK(!roc_sender_new(&sender_conf));
+}
+
+TEST(sender_receiver, frame_smaller_than_resampler_window) {
+    receiver_conf.max_frame_size = 64;
+
+    roc_receiver* recv = roc_receiver_new(&receiver_conf);
+    CHECK(recv);
+    roc_receiver_delete(recv);
+
+    receiver_conf.flags &= ~(unsigned)ROC_FLAG_DISABLE_RESAMPLER;
+    CHECK(!roc_receiver_new(&receiver_conf));
+}
+
+TEST(sender_receiver, packet_too_small) {
+    // payload alone takes two bytes per sample
+    receiver_conf.max_packet_size = packet_len;
+    CHECK(!roc_receiver_new(&receiver_conf));
+
+    sender_conf.max_packet_size = packet_len;
+    CHECK(!roc_sender_new(&sender_conf));
+}
+
+TEST(sender_receiver, alloc_failures_and_trim) {
+    roc_receiver* recv = roc_receiver_new(&receiver_conf);
+    CHECK(recv);
+
+    roc_receiver_stats stats;
+    CHECK(roc_receiver_get_stats(recv, &stats) == 0);
+    LONGS_EQUAL(0, stats.n_alloc_failures);
+
+    roc_receiver_trim(recv);
+
+    roc_receiver_delete(recv);
+}
+
 #ifdef ROC_TARGET_OPENFEC
 TEST(sender_receiver, losses) {
     Receiver recv(receiver_conf);
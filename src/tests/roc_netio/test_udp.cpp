@@ -11,6 +11,7 @@
 
 #include "roc_core/buffer_pool.h"
 #include "roc_core/heap_allocator.h"
+#include "roc_core/time.h"
 #include "roc_netio/transceiver.h"
 #include "roc_packet/concurrent_queue.h"
 #include "roc_packet/packet_pool.h"
@@ -23,6 +24,8 @@ namespace {
 
 enum { NumIterations = 20, NumPackets = 10, BufferSize = 125 };
 
+const core::nanoseconds_t BurstDelay = 100000000;
+
 core::HeapAllocator allocator;
 core::BufferPool<uint8_t> buffer_pool(allocator, BufferSize, 1);
 packet::PacketPool packet_pool(allocator, 1);
@@ -145,6 +148,110 @@ TEST(udp, one_sender_one_receiver_separate_threads) {
     rx.join();
 }
 
+TEST(udp, one_sender_one_receiver_batched) {
+    packet::ConcurrentQueue rx_queue(0, true);
+
+    packet::Address tx_addr = new_address();
+    packet::Address rx_addr = new_address();
+
+    Transceiver tx(packet_pool, buffer_pool, allocator);
+    CHECK(tx.valid());
+
+    packet::IWriter* tx_sender = tx.add_udp_sender(tx_addr);
+    CHECK(tx_sender);
+
+    UDPReceiverConfig rx_config;
+    rx_config.batch_size = NumPackets / 3;
+
+    Transceiver rx(packet_pool, buffer_pool, allocator);
+    CHECK(rx.valid());
+
+    UDPReceiver* rx_receiver = rx.add_udp_receiver(rx_addr, rx_config, rx_queue);
+    CHECK(rx_receiver);
+
+    tx.start();
+
+    for (int i = 0; i < NumIterations; i++) {
+        for (int p = 0; p < NumPackets; p++) {
+            tx_sender->write(new_packet(tx_addr, rx_addr, p));
+        }
+        if (i == 0) {
+            // first burst is sent before the event loop is started, so it's
+            // waiting in the socket buffer and is read by full batches
+            core::sleep_for(BurstDelay);
+            rx.start();
+        }
+        for (int p = 0; p < NumPackets; p++) {
+            check_packet(rx_queue.read(), tx_addr, rx_addr, p);
+        }
+    }
+
+    tx.stop();
+    tx.join();
+
+    rx.stop();
+    rx.join();
+
+    UDPReceiverStats stats = rx_receiver->stats();
+
+    LONGS_EQUAL(NumIterations * NumPackets, stats.n_packets);
+    CHECK(stats.n_batches < stats.n_packets);
+    CHECK(stats.max_batch_size > 1);
+    CHECK(stats.max_batch_size <= rx_config.batch_size);
+}
+
+TEST(udp, one_sender_one_receiver_batched_sender) {
+    packet::ConcurrentQueue rx_queue(0, true);
+
+    packet::Address tx_addr = new_address();
+    packet::Address rx_addr = new_address();
+
+    UDPSenderConfig tx_config;
+    tx_config.batch_size = NumPackets / 3;
+    tx_config.enable_gso = true;
+
+    Transceiver tx(packet_pool, buffer_pool, allocator);
+    CHECK(tx.valid());
+
+    UDPSender* tx_sender = tx.add_udp_sender(tx_addr, tx_config);
+    CHECK(tx_sender);
+
+    Transceiver rx(packet_pool, buffer_pool, allocator);
+    CHECK(rx.valid());
+
+    CHECK(rx.add_udp_receiver(rx_addr, rx_queue));
+
+    rx.start();
+
+    for (int i = 0; i < NumIterations; i++) {
+        for (int p = 0; p < NumPackets; p++) {
+            tx_sender->write(new_packet(tx_addr, rx_addr, p));
+        }
+        if (i == 0) {
+            // first burst is queued before the event loop is started, so it's
+            // guaranteed to be sent by more than one packet per batch
+            tx.start();
+        }
+        for (int p = 0; p < NumPackets; p++) {
+            check_packet(rx_queue.read(), tx_addr, rx_addr, p);
+        }
+    }
+
+    tx.stop();
+    tx.join();
+
+    UDPSenderStats stats = tx_sender->stats();
+
+    LONGS_EQUAL(NumIterations * NumPackets, stats.n_packets);
+    CHECK(stats.n_messages > 0);
+    CHECK(stats.n_messages <= stats.n_packets);
+    CHECK(stats.max_batch_size > 1);
+    CHECK(stats.max_batch_size <= tx_config.batch_size);
+
+    rx.stop();
+    rx.join();
+}
+
 TEST(udp, one_sender_multiple_receivers) {
     packet::ConcurrentQueue rx_queue1(0, true);
     packet::ConcurrentQueue rx_queue2(0, true);
@@ -56,6 +56,20 @@ TEST(address, eq) {
     CHECK(addr1 != addr4);
 }
 
+TEST(address, hash) {
+    Address addr1;
+    CHECK(parse_address("1.2.3.4:123", addr1));
+
+    Address addr2;
+    CHECK(parse_address("1.2.3.4:123", addr2));
+
+    Address addr3;
+    CHECK(parse_address("1.2.3.4:456", addr3));
+
+    CHECK(addr1.hash() == addr2.hash());
+    CHECK(addr1.hash() != addr3.hash());
+}
+
 TEST(address, min_port) {
     Address addr;
     CHECK(parse_address("1.2.3.4:0", addr));
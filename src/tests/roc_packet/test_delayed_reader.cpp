@@ -41,7 +41,7 @@ TEST_GROUP(delayed_reader) {
 
 TEST(delayed_reader, no_delay) {
     ConcurrentQueue queue(0, false);
-    DelayedReader dr(queue, 0);
+    DelayedReader dr(queue, 0, allocator);
 
     CHECK(!dr.read());
 
@@ -54,7 +54,7 @@ TEST(delayed_reader, no_delay) {
 
 TEST(delayed_reader, delay1) {
     ConcurrentQueue queue(0, false);
-    DelayedReader dr(queue, NumSamples * (NumPackets - 1));
+    DelayedReader dr(queue, NumSamples * (NumPackets - 1), allocator);
 
     PacketPtr packets[NumPackets];
 
@@ -81,7 +81,7 @@ TEST(delayed_reader, delay1) {
 
 TEST(delayed_reader, delay2) {
     ConcurrentQueue queue(0, false);
-    DelayedReader dr(queue, NumSamples * (NumPackets - 1));
+    DelayedReader dr(queue, NumSamples * (NumPackets - 1), allocator);
 
     PacketPtr packets[NumPackets];
 
@@ -99,7 +99,7 @@ TEST(delayed_reader, delay2) {
 
 TEST(delayed_reader, late_duplicates) {
     ConcurrentQueue queue(0, false);
-    DelayedReader dr(queue, NumSamples * (NumPackets - 1));
+    DelayedReader dr(queue, NumSamples * (NumPackets - 1), allocator);
 
     PacketPtr packets[NumPackets];
 
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_allocator.h"
+#include "roc_core/thread.h"
+#include "roc_packet/mpsc_queue.h"
+#include "roc_packet/packet_pool.h"
+
+namespace roc {
+namespace packet {
+
+namespace {
+
+core::HeapAllocator allocator;
+PacketPool pool(allocator, 1);
+
+PacketPtr new_packet(seqnum_t sn) {
+    PacketPtr packet = new (pool) Packet(pool);
+    CHECK(packet);
+
+    packet->add_flags(Packet::FlagRTP);
+    packet->rtp()->seqnum = sn;
+
+    return packet;
+}
+
+class Producer : public core::Thread {
+public:
+    Producer(MPSCQueue& queue, seqnum_t first, size_t n_packets)
+        : queue_(queue)
+        , first_(first)
+        , n_packets_(n_packets) {
+    }
+
+private:
+    virtual void run() {
+        for (size_t n = 0; n < n_packets_; n++) {
+            queue_.write(new_packet(seqnum_t(first_ + n)));
+        }
+    }
+
+    MPSCQueue& queue_;
+    seqnum_t first_;
+    size_t n_packets_;
+};
+
+} // namespace
+
+TEST_GROUP(mpsc_queue) {};
+
+TEST(mpsc_queue, empty) {
+    MPSCQueue queue(allocator, 4);
+
+    CHECK(!queue.read());
+
+    LONGS_EQUAL(0, queue.size());
+    LONGS_EQUAL(4, queue.max_size());
+}
+
+TEST(mpsc_queue, max_size_rounding) {
+    MPSCQueue queue(allocator, 5);
+
+    LONGS_EQUAL(8, queue.max_size());
+}
+
+TEST(mpsc_queue, two_packets) {
+    MPSCQueue queue(allocator, 4);
+
+    PacketPtr p1 = new_packet(1);
+    PacketPtr p2 = new_packet(2);
+
+    queue.write(p1);
+    queue.write(p2);
+
+    LONGS_EQUAL(2, queue.size());
+
+    CHECK(queue.read() == p1);
+
+    LONGS_EQUAL(1, queue.size());
+
+    CHECK(queue.read() == p2);
+
+    LONGS_EQUAL(0, queue.size());
+
+    CHECK(!queue.read());
+}
+
+TEST(mpsc_queue, wrap_around) {
+    enum { NumPackets = 10, NumIterations = 20 };
+
+    MPSCQueue queue(allocator, 4);
+
+    for (size_t i = 0; i < NumIterations; i++) {
+        for (size_t n = 0; n < 3; n++) {
+            queue.write(new_packet(seqnum_t(i * 3 + n)));
+        }
+
+        LONGS_EQUAL(3, queue.size());
+
+        for (size_t n = 0; n < 3; n++) {
+            PacketPtr pp = queue.read();
+            CHECK(pp);
+            LONGS_EQUAL(i * 3 + n, pp->rtp()->seqnum);
+        }
+
+        CHECK(!queue.read());
+    }
+}
+
+TEST(mpsc_queue, max_size) {
+    MPSCQueue queue(allocator, 2);
+
+    PacketPtr p1 = new_packet(1);
+    PacketPtr p2 = new_packet(2);
+    PacketPtr p3 = new_packet(3);
+
+    queue.write(p1);
+    queue.write(p2);
+    queue.write(p3);
+
+    LONGS_EQUAL(2, queue.size());
+
+    CHECK(queue.read() == p1);
+
+    LONGS_EQUAL(1, queue.size());
+
+    queue.write(p3);
+
+    LONGS_EQUAL(2, queue.size());
+
+    CHECK(queue.read() == p2);
+    CHECK(queue.read() == p3);
+    CHECK(!queue.read());
+}
+
+TEST(mpsc_queue, read_batch) {
+    enum { NumPackets = 10, BatchSize = 4 };
+
+    MPSCQueue queue(allocator, 16);
+
+    PacketPtr packets[NumPackets];
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        packets[n] = new_packet(seqnum_t(n));
+        queue.write(packets[n]);
+    }
+
+    PacketPtr batch[BatchSize];
+    size_t pos = 0;
+
+    while (size_t n_read = queue.read_batch(batch, BatchSize)) {
+        CHECK(n_read <= BatchSize);
+
+        for (size_t n = 0; n < n_read; n++) {
+            CHECK(batch[n] == packets[pos++]);
+        }
+    }
+
+    LONGS_EQUAL(NumPackets, pos);
+    LONGS_EQUAL(0, queue.size());
+}
+
+TEST(mpsc_queue, wait) {
+    MPSCQueue queue(allocator, 4);
+
+    PacketPtr p = new_packet(1);
+
+    queue.write(p);
+
+    queue.wait();
+
+    CHECK(queue.read() == p);
+}
+
+TEST(mpsc_queue, destroy_non_empty) {
+    PacketPtr p = new_packet(1);
+
+    {
+        MPSCQueue queue(allocator, 4);
+        queue.write(p);
+
+        LONGS_EQUAL(2, p->getref());
+    }
+
+    LONGS_EQUAL(1, p->getref());
+}
+
+TEST(mpsc_queue, multiple_producers) {
+    enum { NumProducers = 4, NumPackets = 1000 };
+
+    MPSCQueue queue(allocator, NumProducers * NumPackets);
+
+    Producer p1(queue, 0 * NumPackets, NumPackets);
+    Producer p2(queue, 1 * NumPackets, NumPackets);
+    Producer p3(queue, 2 * NumPackets, NumPackets);
+    Producer p4(queue, 3 * NumPackets, NumPackets);
+
+    p1.start();
+    p2.start();
+    p3.start();
+    p4.start();
+
+    size_t next[NumProducers] = {};
+
+    for (size_t n = 0; n < NumProducers * NumPackets; n++) {
+        queue.wait();
+
+        PacketPtr pp = queue.read();
+        CHECK(pp);
+
+        const size_t producer = pp->rtp()->seqnum / NumPackets;
+        CHECK(producer < NumProducers);
+
+        // packets from the same producer should preserve order
+        LONGS_EQUAL(producer * NumPackets + next[producer], pp->rtp()->seqnum);
+        next[producer]++;
+    }
+
+    CHECK(!queue.read());
+
+    p1.join();
+    p2.join();
+    p3.join();
+    p4.join();
+}
+
+} // namespace packet
+} // namespace roc
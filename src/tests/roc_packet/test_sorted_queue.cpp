@@ -36,7 +36,7 @@ TEST_GROUP(sorted_queue) {
 };
 
 TEST(sorted_queue, empty) {
-    SortedQueue queue(0);
+    SortedQueue queue(allocator, 0);
 
     CHECK(!queue.tail());
     CHECK(!queue.head());
@@ -47,7 +47,7 @@ TEST(sorted_queue, empty) {
 }
 
 TEST(sorted_queue, two_packets) {
-    SortedQueue queue(0);
+    SortedQueue queue(allocator, 0);
 
     PacketPtr p1 = new_packet(1);
     PacketPtr p2 = new_packet(2);
@@ -82,7 +82,7 @@ TEST(sorted_queue, two_packets) {
 TEST(sorted_queue, many_packets) {
     enum { NumPackets = 10 };
 
-    SortedQueue queue(0);
+    SortedQueue queue(allocator, 0);
 
     PacketPtr packets[NumPackets];
 
@@ -107,7 +107,7 @@ TEST(sorted_queue, many_packets) {
 }
 
 TEST(sorted_queue, out_of_order) {
-    SortedQueue queue(0);
+    SortedQueue queue(allocator, 0);
 
     PacketPtr p1 = new_packet(1);
     PacketPtr p2 = new_packet(2);
@@ -139,7 +139,7 @@ TEST(sorted_queue, out_of_order) {
 }
 
 TEST(sorted_queue, one_duplicate) {
-    SortedQueue queue(0);
+    SortedQueue queue(allocator, 0);
 
     PacketPtr p1 = new_packet(1);
     PacketPtr p2 = new_packet(1);
@@ -148,6 +148,7 @@ TEST(sorted_queue, one_duplicate) {
     queue.write(p2);
 
     LONGS_EQUAL(1, queue.size());
+    LONGS_EQUAL(1, queue.n_duplicates());
 
     CHECK(queue.tail() == p1);
     CHECK(queue.head() == p1);
@@ -165,19 +166,21 @@ TEST(sorted_queue, one_duplicate) {
 TEST(sorted_queue, many_duplicates) {
     const size_t NumPackets = 10;
 
-    SortedQueue queue(0);
+    SortedQueue queue(allocator, 0);
 
     for (seqnum_t n = 0; n < NumPackets; n++) {
         queue.write(new_packet(n));
     }
 
     LONGS_EQUAL(NumPackets, queue.size());
+    LONGS_EQUAL(0, queue.n_duplicates());
 
     for (seqnum_t n = 0; n < NumPackets; n++) {
         queue.write(new_packet(n));
     }
 
     LONGS_EQUAL(NumPackets, queue.size());
+    LONGS_EQUAL(NumPackets, queue.n_duplicates());
 
     for (seqnum_t n = 0; n < NumPackets; n++) {
         CHECK(queue.read()->rtp()->seqnum == n);
@@ -187,7 +190,7 @@ TEST(sorted_queue, many_duplicates) {
 }
 
 TEST(sorted_queue, max_size) {
-    SortedQueue queue(2);
+    SortedQueue queue(allocator, 2);
 
     PacketPtr p1 = new_packet(1);
     PacketPtr p2 = new_packet(2);
@@ -217,7 +220,7 @@ TEST(sorted_queue, max_size) {
 TEST(sorted_queue, overflow_ordered1) {
     const seqnum_t sn = seqnum_t(-1);
 
-    SortedQueue queue(0);
+    SortedQueue queue(allocator, 0);
 
     PacketPtr p1 = new_packet(seqnum_t(sn - 10));
     PacketPtr p2 = new_packet(sn);
@@ -241,7 +244,7 @@ TEST(sorted_queue, overflow_ordered1) {
 TEST(sorted_queue, overflow_ordered2) {
     const seqnum_t sn = seqnum_t(-1) >> 1;
 
-    SortedQueue queue(0);
+    SortedQueue queue(allocator, 0);
 
     PacketPtr p1 = new_packet(seqnum_t(sn - 10));
     PacketPtr p2 = new_packet(sn);
@@ -265,7 +268,7 @@ TEST(sorted_queue, overflow_ordered2) {
 TEST(sorted_queue, overflow_sorting) {
     const seqnum_t sn = seqnum_t(-1);
 
-    SortedQueue queue(0);
+    SortedQueue queue(allocator, 0);
 
     PacketPtr p1 = new_packet(seqnum_t(sn - 10));
     PacketPtr p2 = new_packet(sn);
@@ -289,7 +292,7 @@ TEST(sorted_queue, overflow_sorting) {
 TEST(sorted_queue, overflow_out_of_order) {
     const seqnum_t sn = seqnum_t(-1);
 
-    SortedQueue queue(0);
+    SortedQueue queue(allocator, 0);
 
     PacketPtr p1 = new_packet(seqnum_t(sn - 10));
     PacketPtr p2 = new_packet(sn);
@@ -316,5 +319,104 @@ TEST(sorted_queue, overflow_out_of_order) {
     CHECK(!queue.read());
 }
 
+TEST(sorted_queue, many_packets_reversed) {
+    enum { NumPackets = 1000 };
+
+    const seqnum_t sn = seqnum_t(-1) - NumPackets / 2;
+
+    SortedQueue queue(allocator, 0);
+
+    for (seqnum_t n = 0; n < NumPackets; n++) {
+        queue.write(new_packet(seqnum_t(sn + NumPackets - 1 - n)));
+    }
+
+    LONGS_EQUAL(NumPackets, queue.size());
+
+    CHECK(queue.head()->rtp()->seqnum == sn);
+    CHECK(queue.tail()->rtp()->seqnum == seqnum_t(sn + NumPackets - 1));
+
+    for (seqnum_t n = 0; n < NumPackets; n++) {
+        CHECK(queue.read()->rtp()->seqnum == seqnum_t(sn + n));
+    }
+
+    LONGS_EQUAL(0, queue.size());
+}
+
+TEST(sorted_queue, gaps) {
+    enum { NumPackets = 10, Gap = 100 };
+
+    SortedQueue queue(allocator, 0);
+
+    for (seqnum_t n = 0; n < NumPackets; n++) {
+        queue.write(new_packet(seqnum_t(n * Gap)));
+    }
+
+    LONGS_EQUAL(NumPackets, queue.size());
+
+    for (seqnum_t n = 0; n < NumPackets; n++) {
+        CHECK(queue.head()->rtp()->seqnum == seqnum_t(n * Gap));
+        CHECK(queue.tail()->rtp()->seqnum == seqnum_t((NumPackets - 1) * Gap));
+
+        CHECK(queue.read()->rtp()->seqnum == seqnum_t(n * Gap));
+    }
+
+    LONGS_EQUAL(0, queue.size());
+
+    CHECK(!queue.head());
+    CHECK(!queue.tail());
+}
+
+TEST(sorted_queue, too_large_range) {
+    SortedQueue queue(allocator, 0);
+
+    PacketPtr p1 = new_packet(0);
+    PacketPtr p2 = new_packet(seqnum_t(-1) >> 1);
+    PacketPtr p3 = new_packet((seqnum_t(-1) >> 1) + 1);
+
+    queue.write(p1);
+    queue.write(p2);
+
+    LONGS_EQUAL(2, queue.size());
+
+    queue.write(p3);
+
+    LONGS_EQUAL(2, queue.size());
+
+    CHECK(queue.read() == p1);
+    CHECK(queue.read() == p2);
+    CHECK(!queue.read());
+}
+
+TEST(sorted_queue, large_gap_then_drain) {
+    enum { Gap = 30000, NumPackets = 100 };
+
+    SortedQueue queue(allocator, 0);
+
+    PacketPtr p1 = new_packet(0);
+    PacketPtr p2 = new_packet(Gap);
+
+    queue.write(p1);
+    queue.write(p2);
+
+    LONGS_EQUAL(2, queue.size());
+
+    CHECK(queue.read() == p1);
+    CHECK(queue.read() == p2);
+
+    LONGS_EQUAL(0, queue.size());
+
+    for (seqnum_t n = 0; n < NumPackets; n++) {
+        queue.write(new_packet(seqnum_t(Gap + NumPackets - n)));
+    }
+
+    LONGS_EQUAL(NumPackets, queue.size());
+
+    for (seqnum_t n = 0; n < NumPackets; n++) {
+        CHECK(queue.read()->rtp()->seqnum == seqnum_t(Gap + 1 + n));
+    }
+
+    CHECK(!queue.read());
+}
+
 } // namespace packet
 } // namespace roc
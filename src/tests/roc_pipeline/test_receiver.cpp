@@ -11,6 +11,7 @@
 
 #include "roc_core/buffer_pool.h"
 #include "roc_core/heap_allocator.h"
+#include "roc_core/tracer.h"
 #include "roc_packet/packet_pool.h"
 #include "roc_packet/parse_address.h"
 #include "roc_pipeline/receiver.h"
@@ -71,6 +72,7 @@ TEST_GROUP(receiver) {
     void setup() {
         config.sample_rate = SampleRate;
         config.channels = ChMask;
+        config.stats_interval = 0;
 
         config.default_session.channels = ChMask;
         config.default_session.samples_per_packet = SamplesPerPacket;
@@ -243,6 +245,37 @@ TEST(receiver, initial_latency_timeout) {
     UNSIGNED_LONGS_EQUAL(0, receiver.num_sessions());
 }
 
+TEST(receiver, initial_latency_timeout_rate_conversion) {
+    enum { OutputRate = SampleRate * 2, NumFrames = Timeout * 2 / SamplesPerFrame };
+
+    // timeout is measured in samples of session payload type, which are
+    // twice longer than output samples
+    config.sample_rate = OutputRate;
+
+    Receiver receiver(config, format_map, packet_pool, byte_buffer_pool,
+                      sample_buffer_pool, allocator);
+
+    CHECK(receiver.valid());
+    CHECK(receiver.add_port(port1));
+
+    PacketWriter packet_writer(receiver, rtp_composer, pcm_encoder, packet_pool,
+                               byte_buffer_pool, PayloadType, src1, port1.address);
+
+    FrameReader frame_reader(receiver, sample_buffer_pool);
+
+    packet_writer.write_packets(1, SamplesPerPacket, ChMask);
+
+    for (size_t nf = 0; nf < NumFrames; nf++) {
+        frame_reader.skip_zeros(SamplesPerFrame * NumCh);
+
+        UNSIGNED_LONGS_EQUAL(1, receiver.num_sessions());
+    }
+
+    frame_reader.skip_zeros(SamplesPerFrame * NumCh);
+
+    UNSIGNED_LONGS_EQUAL(0, receiver.num_sessions());
+}
+
 TEST(receiver, timeout) {
     enum { NumPackets = Latency / SamplesPerPacket };
 
@@ -299,6 +332,41 @@ TEST(receiver, two_sessions_synchronous) {
     }
 }
 
+TEST(receiver, three_sessions_parallel) {
+    config.num_threads = 2;
+
+    Receiver receiver(config, format_map, packet_pool, byte_buffer_pool,
+                      sample_buffer_pool, allocator);
+
+    CHECK(receiver.valid());
+    CHECK(receiver.add_port(port1));
+
+    packet::Address src3 = new_address(5);
+
+    PacketWriter packet_writer1(receiver, rtp_composer, pcm_encoder, packet_pool,
+                                byte_buffer_pool, PayloadType, src1, port1.address);
+
+    PacketWriter packet_writer2(receiver, rtp_composer, pcm_encoder, packet_pool,
+                                byte_buffer_pool, PayloadType, src2, port1.address);
+
+    PacketWriter packet_writer3(receiver, rtp_composer, pcm_encoder, packet_pool,
+                                byte_buffer_pool, PayloadType, src3, port1.address);
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        packet_writer1.write_packets(1, SamplesPerPacket, ChMask);
+        packet_writer2.write_packets(1, SamplesPerPacket, ChMask);
+        packet_writer3.write_packets(1, SamplesPerPacket, ChMask);
+    }
+
+    FrameReader frame_reader(receiver, sample_buffer_pool);
+
+    for (size_t nf = 0; nf < ManyPackets * FramesPerPacket; nf++) {
+        frame_reader.read_samples(SamplesPerFrame * NumCh, 3);
+
+        UNSIGNED_LONGS_EQUAL(3, receiver.num_sessions());
+    }
+}
+
 TEST(receiver, two_sessions_overlapping) {
     Receiver receiver(config, format_map, packet_pool, byte_buffer_pool,
                       sample_buffer_pool, allocator);
@@ -904,6 +972,209 @@ TEST(receiver, bad_packet_old_session) {
     }
 }
 
+TEST(receiver, stats) {
+    enum { DelayedPackets = 5, DuplicatePackets = 3 };
+
+    Receiver receiver(config, format_map, packet_pool, byte_buffer_pool,
+                      sample_buffer_pool, allocator);
+
+    CHECK(receiver.valid());
+    CHECK(receiver.add_port(port1));
+
+    ReceiverStats stats = receiver.stats();
+
+    UNSIGNED_LONGS_EQUAL(0, stats.n_sessions);
+    UNSIGNED_LONGS_EQUAL(0, stats.n_packets_received);
+    UNSIGNED_LONGS_EQUAL(0, stats.n_frames);
+
+    PacketWriter packet_writer(receiver, rtp_composer, pcm_encoder, packet_pool,
+                               byte_buffer_pool, PayloadType, src1, port1.address);
+
+    packet_writer.write_packets(ManyPackets - DelayedPackets, SamplesPerPacket, ChMask);
+
+    packet_writer.shift_to(0, SamplesPerPacket, ChMask);
+    packet_writer.write_packets(DuplicatePackets, SamplesPerPacket, ChMask);
+
+    packet_writer.shift_to(ManyPackets, SamplesPerPacket, ChMask);
+    packet_writer.write_packets(ManyPackets, SamplesPerPacket, ChMask);
+
+    FrameReader frame_reader(receiver, sample_buffer_pool);
+
+    for (size_t nf = 0; nf < (ManyPackets - DelayedPackets) * FramesPerPacket; nf++) {
+        frame_reader.read_samples(SamplesPerFrame * NumCh, 1);
+    }
+
+    stats = receiver.stats();
+
+    UNSIGNED_LONGS_EQUAL(1, stats.n_sessions);
+    UNSIGNED_LONGS_EQUAL(ManyPackets * 2 - DelayedPackets + DuplicatePackets,
+                         stats.n_packets_received);
+    UNSIGNED_LONGS_EQUAL(DuplicatePackets, stats.sessions.n_packets_duplicate);
+    UNSIGNED_LONGS_EQUAL(0, stats.sessions.n_packets_late);
+    UNSIGNED_LONGS_EQUAL(0, stats.sessions.n_samples_concealed);
+    UNSIGNED_LONGS_EQUAL((ManyPackets - DelayedPackets) * FramesPerPacket,
+                         stats.n_frames);
+
+    for (size_t nf = 0; nf < DelayedPackets * FramesPerPacket; nf++) {
+        frame_reader.read_samples(SamplesPerFrame * NumCh, 0);
+    }
+
+    packet_writer.shift_to(ManyPackets - DelayedPackets, SamplesPerPacket, ChMask);
+    packet_writer.write_packets(DelayedPackets, SamplesPerPacket, ChMask);
+
+    for (size_t nf = 0; nf < ManyPackets * FramesPerPacket; nf++) {
+        frame_reader.read_samples(SamplesPerFrame * NumCh, 1);
+    }
+
+    // late packets are dropped when there are no more packets before them
+    frame_reader.read_samples(SamplesPerFrame * NumCh, 0);
+
+    stats = receiver.stats();
+
+    UNSIGNED_LONGS_EQUAL(ManyPackets * 2 + DuplicatePackets, stats.n_packets_received);
+    UNSIGNED_LONGS_EQUAL(DelayedPackets, stats.sessions.n_packets_late);
+    UNSIGNED_LONGS_EQUAL(DelayedPackets * SamplesPerPacket + SamplesPerFrame,
+                         stats.sessions.n_samples_concealed);
+    UNSIGNED_LONGS_EQUAL(0, stats.sessions.n_packets_repaired);
+    DOUBLES_EQUAL(1.0, (double)stats.sessions.resampler_scaling, 1e-6);
+    CHECK(stats.mix_time > 0);
+}
+
+TEST(receiver, stats_interval) {
+    enum { IntervalFrames = 4 };
+
+    config.stats_interval = SamplesPerFrame * IntervalFrames;
+
+    Receiver receiver(config, format_map, packet_pool, byte_buffer_pool,
+                      sample_buffer_pool, allocator);
+
+    CHECK(receiver.valid());
+    CHECK(receiver.add_port(port1));
+
+    PacketWriter packet_writer(receiver, rtp_composer, pcm_encoder, packet_pool,
+                               byte_buffer_pool, PayloadType, src1, port1.address);
+
+    packet_writer.write_packets(ManyPackets, SamplesPerPacket, ChMask);
+
+    FrameReader frame_reader(receiver, sample_buffer_pool);
+
+    // first frame is timed
+    frame_reader.read_samples(SamplesPerFrame * NumCh, 1);
+
+    ReceiverStats stats = receiver.stats();
+
+    UNSIGNED_LONGS_EQUAL(1, stats.n_sessions);
+    UNSIGNED_LONGS_EQUAL(1, stats.n_frames);
+    UNSIGNED_LONGS_EQUAL(1, stats.n_timed_frames);
+
+    // stats are not updated until interval elapses
+    for (size_t nf = 1; nf < IntervalFrames; nf++) {
+        frame_reader.read_samples(SamplesPerFrame * NumCh, 1);
+
+        stats = receiver.stats();
+
+        UNSIGNED_LONGS_EQUAL(1, stats.n_frames);
+        UNSIGNED_LONGS_EQUAL(1, stats.n_timed_frames);
+    }
+
+    frame_reader.read_samples(SamplesPerFrame * NumCh, 1);
+
+    stats = receiver.stats();
+
+    UNSIGNED_LONGS_EQUAL(IntervalFrames + 1, stats.n_frames);
+    UNSIGNED_LONGS_EQUAL(2, stats.n_timed_frames);
+
+#ifndef ROC_DISABLE_HISTOGRAMS
+    core::HistogramSnapshot snapshot;
+
+    CHECK(receiver.latency(ReceiverStage_Frame, snapshot));
+    UNSIGNED_LONGS_EQUAL(IntervalFrames + 1, snapshot.count());
+
+    CHECK(receiver.latency(ReceiverStage_Mix, snapshot));
+    UNSIGNED_LONGS_EQUAL(2, snapshot.count());
+#endif
+}
+
+TEST(receiver, latency) {
+    Receiver receiver(config, format_map, packet_pool, byte_buffer_pool,
+                      sample_buffer_pool, allocator);
+
+    CHECK(receiver.valid());
+    CHECK(receiver.add_port(port1));
+
+    PacketWriter packet_writer(receiver, rtp_composer, pcm_encoder, packet_pool,
+                               byte_buffer_pool, PayloadType, src1, port1.address);
+
+    packet_writer.write_packets(ManyPackets, SamplesPerPacket, ChMask);
+
+    FrameReader frame_reader(receiver, sample_buffer_pool);
+
+    for (size_t nf = 0; nf < ManyPackets * FramesPerPacket; nf++) {
+        frame_reader.read_samples(SamplesPerFrame * NumCh, 1);
+    }
+
+    core::HistogramSnapshot snapshot;
+
+#ifndef ROC_DISABLE_HISTOGRAMS
+    CHECK(receiver.latency(ReceiverStage_Fetch, snapshot));
+    UNSIGNED_LONGS_EQUAL(ManyPackets * FramesPerPacket, snapshot.count());
+
+    CHECK(receiver.latency(ReceiverStage_Mix, snapshot));
+    UNSIGNED_LONGS_EQUAL(ManyPackets * FramesPerPacket, snapshot.count());
+
+    CHECK(receiver.latency(ReceiverStage_Update, snapshot));
+    UNSIGNED_LONGS_EQUAL(ManyPackets * FramesPerPacket, snapshot.count());
+
+    CHECK(receiver.latency(ReceiverStage_Session, snapshot));
+    UNSIGNED_LONGS_EQUAL(ManyPackets * FramesPerPacket, snapshot.count());
+
+    CHECK(receiver.latency(ReceiverStage_Depacketize, snapshot));
+    CHECK(snapshot.count() > 0);
+
+    CHECK(receiver.latency(ReceiverStage_Frame, snapshot));
+    UNSIGNED_LONGS_EQUAL(ManyPackets * FramesPerPacket, snapshot.count());
+    CHECK(snapshot.quantile(0.999) >= snapshot.quantile(0.5));
+    CHECK(snapshot.quantile(0.5) > 0);
+#else
+    CHECK(!receiver.latency(ReceiverStage_Frame, snapshot));
+#endif
+}
+
+TEST(receiver, trace) {
+    Receiver receiver(config, format_map, packet_pool, byte_buffer_pool,
+                      sample_buffer_pool, allocator);
+
+    CHECK(receiver.valid());
+    CHECK(receiver.add_port(port1));
+
+    CHECK(core::tracer().start(ManyPackets * 10));
+
+    PacketWriter packet_writer(receiver, rtp_composer, pcm_encoder, packet_pool,
+                               byte_buffer_pool, PayloadType, src1, port1.address);
+
+    packet_writer.write_packets(ManyPackets, SamplesPerPacket, ChMask);
+
+    FrameReader frame_reader(receiver, sample_buffer_pool);
+
+    for (size_t nf = 0; nf < ManyPackets * FramesPerPacket; nf++) {
+        frame_reader.read_samples(SamplesPerFrame * NumCh, 1);
+    }
+
+    core::tracer().stop();
+
+    const char* names[] = { "enqueue", "route", "queue", "depacketize" };
+
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        size_t n_events = 0;
+        for (size_t n = 0; n < core::tracer().num_events(); n++) {
+            if (strcmp(core::tracer().event(n).name, names[i]) == 0) {
+                n_events++;
+            }
+        }
+        UNSIGNED_LONGS_EQUAL(ManyPackets, n_events);
+    }
+}
+
 TEST(receiver, status) {
     Receiver receiver(config, format_map, packet_pool, byte_buffer_pool,
                       sample_buffer_pool, allocator);
@@ -153,5 +153,69 @@ TEST(sender, frame_size_large) {
     CHECK(!queue.read());
 }
 
+TEST(sender, stats) {
+    packet::ConcurrentQueue queue(0, false);
+
+    Sender sender(config, queue, queue, format_map, packet_pool, byte_buffer_pool,
+                  allocator);
+
+    CHECK(sender.valid());
+
+    SenderStats stats = sender.stats();
+
+    UNSIGNED_LONGS_EQUAL(0, stats.n_frames);
+    UNSIGNED_LONGS_EQUAL(0, stats.n_source_packets);
+
+    FrameWriter frame_writer(sender, sample_buffer_pool);
+
+    for (size_t nf = 0; nf < ManyFrames; nf++) {
+        frame_writer.write_samples(SamplesPerFrame * NumCh);
+    }
+
+    stats = sender.stats();
+
+    UNSIGNED_LONGS_EQUAL(ManyFrames, stats.n_frames);
+    UNSIGNED_LONGS_EQUAL(ManyFrames / FramesPerPacket, stats.n_source_packets);
+    UNSIGNED_LONGS_EQUAL(0, stats.n_repair_packets);
+    CHECK(stats.write_time > 0);
+
+    while (queue.read()) {
+    }
+}
+
+TEST(sender, latency) {
+    packet::ConcurrentQueue queue(0, false);
+
+    Sender sender(config, queue, queue, format_map, packet_pool, byte_buffer_pool,
+                  allocator);
+
+    CHECK(sender.valid());
+
+    FrameWriter frame_writer(sender, sample_buffer_pool);
+
+    for (size_t nf = 0; nf < ManyFrames; nf++) {
+        frame_writer.write_samples(SamplesPerFrame * NumCh);
+    }
+
+    core::HistogramSnapshot snapshot;
+
+#ifndef ROC_DISABLE_HISTOGRAMS
+    CHECK(sender.latency(SenderStage_Frame, snapshot));
+    UNSIGNED_LONGS_EQUAL(ManyFrames, snapshot.count());
+
+    CHECK(sender.latency(SenderStage_Send, snapshot));
+    UNSIGNED_LONGS_EQUAL(ManyFrames / FramesPerPacket, snapshot.count());
+
+    // FEC is disabled
+    CHECK(sender.latency(SenderStage_FEC, snapshot));
+    UNSIGNED_LONGS_EQUAL(0, snapshot.count());
+#else
+    CHECK(!sender.latency(SenderStage_Frame, snapshot));
+#endif
+
+    while (queue.read()) {
+    }
+}
+
 } // namespace pipeline
 } // namespace roc
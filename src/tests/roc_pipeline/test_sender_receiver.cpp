@@ -41,6 +41,8 @@ enum {
     SourcePackets = 5,
     RepairPackets = 10,
 
+    ParityRepairPackets = 5,
+
     Latency = SamplesPerPacket * (SourcePackets + RepairPackets),
     Timeout = Latency * 20,
 
@@ -55,7 +57,13 @@ enum {
     FlagInterleaving = (1 << 1),
 
     // enable packet loss on sender
-    FlagLoss = (1 << 2)
+    FlagLoss = (1 << 2),
+
+    // use XOR parity instead of Reed-Solomon
+    FlagParity = (1 << 3),
+
+    // use random linear code instead of Reed-Solomon
+    FlagRLC = (1 << 4)
 };
 
 core::HeapAllocator allocator;
@@ -77,6 +85,15 @@ TEST_GROUP(sender_receiver) {
         repair_port.address = new_address(2);
         repair_port.protocol = Proto_RSm8_Repair;
 
+        if (sender_flags & FlagParity) {
+            source_port.protocol = Proto_RTP_Parity_Source;
+            repair_port.protocol = Proto_Parity_Repair;
+        }
+        if (sender_flags & FlagRLC) {
+            source_port.protocol = Proto_RTP_RLC_Source;
+            repair_port.protocol = Proto_RLC_Repair;
+        }
+
         packet::ConcurrentQueue queue(0, false);
 
         Sender sender(sender_config(sender_flags, source_port, repair_port),
@@ -181,7 +198,15 @@ TEST_GROUP(sender_receiver) {
     fec::Config fec_config(int flags) {
         fec::Config config;
 
-        if (flags & FlagFEC) {
+        if ((flags & FlagFEC) && (flags & FlagParity)) {
+            config.codec = fec::XORParity;
+            config.n_source_packets = SourcePackets;
+            config.n_repair_packets = ParityRepairPackets;
+        } else if ((flags & FlagFEC) && (flags & FlagRLC)) {
+            config.codec = fec::RandomLinear;
+            config.n_source_packets = SourcePackets;
+            config.n_repair_packets = RepairPackets;
+        } else if (flags & FlagFEC) {
             config.codec = fec::ReedSolomon8m;
             config.n_source_packets = SourcePackets;
             config.n_repair_packets = RepairPackets;
@@ -201,7 +226,6 @@ TEST(sender_receiver, interleaving) {
     send_receive(FlagInterleaving, 0);
 }
 
-#ifdef ROC_TARGET_OPENFEC
 TEST(sender_receiver, fec_sender) {
     send_receive(FlagFEC, 0);
 }
@@ -221,7 +245,22 @@ TEST(sender_receiver, fec_interleaving) {
 TEST(sender_receiver, fec_loss) {
     send_receive(FlagFEC | FlagLoss, FlagFEC);
 }
-#endif //! ROC_TARGET_OPENFEC
+
+TEST(sender_receiver, fec_parity) {
+    send_receive(FlagFEC | FlagParity, FlagFEC | FlagParity);
+}
+
+TEST(sender_receiver, fec_parity_loss) {
+    send_receive(FlagFEC | FlagParity | FlagLoss, FlagFEC | FlagParity);
+}
+
+TEST(sender_receiver, fec_rlc) {
+    send_receive(FlagFEC | FlagRLC, FlagFEC | FlagRLC);
+}
+
+TEST(sender_receiver, fec_rlc_loss) {
+    send_receive(FlagFEC | FlagRLC | FlagLoss, FlagFEC | FlagRLC);
+}
 
 } // namespace pipeline
 } // namespace roc
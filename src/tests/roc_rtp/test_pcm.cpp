@@ -32,6 +32,12 @@ packet::PacketPool packet_pool(allocator, 1);
 TEST_GROUP(pcm) {
     audio::sample_t output[MaxSamples];
 
+    void setup() {
+        for (size_t i = 0; i < MaxSamples; i++) {
+            output[i] = 0.0f;
+        }
+    }
+
     template <class Sample, size_t NumCh>
     packet::PacketPtr new_packet(size_t num_samples) {
         packet::PacketPtr pp = new (packet_pool) packet::Packet(packet_pool);
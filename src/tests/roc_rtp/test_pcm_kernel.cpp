@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2017 Mikhail Baranov
+ * Copyright (c) 2017 Victor Gaydov
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/macros.h"
+#include "roc_core/random.h"
+#include "roc_core/stddefs.h"
+#include "roc_packet/packet.h"
+#include "roc_rtp/pcm_helpers.h"
+#include "roc_rtp/pcm_kernel.h"
+
+namespace roc {
+namespace rtp {
+
+namespace {
+
+enum { MaxSamples = 256 };
+
+const PCMKernel kernels[] = { PCMKernel_Generic, PCMKernel_SSE2, PCMKernel_NEON };
+
+} // namespace
+
+TEST_GROUP(pcm_kernel) {
+    audio::sample_t samples[MaxSamples];
+    int16_t packed[MaxSamples];
+
+    void setup() {
+        for (size_t n = 0; n < MaxSamples; n++) {
+            samples[n] = audio::sample_t(core::random(0, 65534)) / (1 << 15) - 1;
+            packed[n] = pcm_pack<int16_t>(samples[n]);
+        }
+    }
+
+    void check_pack(PCMKernel kernel, size_t n_samples) {
+        int16_t out[MaxSamples];
+        memset(out, 0, sizeof(out));
+
+        pcm_kernel_pack_s16(kernel)(out, samples, n_samples);
+
+        for (size_t n = 0; n < MaxSamples; n++) {
+            LONGS_EQUAL(n < n_samples ? packed[n] : 0, out[n]);
+        }
+    }
+
+    void check_unpack(PCMKernel kernel, size_t n_samples) {
+        audio::sample_t out[MaxSamples];
+        memset(out, 0, sizeof(out));
+
+        pcm_kernel_unpack_s16(kernel)(out, packed, n_samples);
+
+        for (size_t n = 0; n < MaxSamples; n++) {
+            const double expected = n < n_samples ? (double)pcm_unpack(packed[n]) : 0;
+            DOUBLES_EQUAL(expected, (double)out[n], 0);
+        }
+    }
+};
+
+TEST(pcm_kernel, generic_always_supported) {
+    CHECK(pcm_kernel_supported(PCMKernel_Generic));
+}
+
+TEST(pcm_kernel, pack) {
+    for (size_t k = 0; k < ROC_ARRAY_SIZE(kernels); k++) {
+        if (!pcm_kernel_supported(kernels[k])) {
+            continue;
+        }
+        for (size_t n_samples = 0; n_samples <= MaxSamples; n_samples++) {
+            check_pack(kernels[k], n_samples);
+        }
+    }
+}
+
+TEST(pcm_kernel, unpack) {
+    for (size_t k = 0; k < ROC_ARRAY_SIZE(kernels); k++) {
+        if (!pcm_kernel_supported(kernels[k])) {
+            continue;
+        }
+        for (size_t n_samples = 0; n_samples <= MaxSamples; n_samples++) {
+            check_unpack(kernels[k], n_samples);
+        }
+    }
+}
+
+TEST(pcm_kernel, round_trip) {
+    int16_t out_packed[MaxSamples];
+    pcm_pack_s16(out_packed, samples, MaxSamples);
+
+    audio::sample_t out_samples[MaxSamples];
+    pcm_unpack_s16(out_samples, out_packed, MaxSamples);
+
+    for (size_t n = 0; n < MaxSamples; n++) {
+        DOUBLES_EQUAL((double)samples[n], (double)out_samples[n], 1.0 / (1 << 15));
+    }
+}
+
+} // namespace rtp
+} // namespace roc
@@ -9,6 +9,7 @@
 
 #include "roc_core/heap_allocator.h"
 #include "roc_core/log.h"
+#include "roc_core/tracer.h"
 #include "roc_netio/transceiver.h"
 #include "roc_packet/address_to_str.h"
 #include "roc_packet/parse_address.h"
@@ -22,7 +23,7 @@ using namespace roc;
 
 namespace {
 
-enum { MaxPacketSize = 2048, MaxFrameSize = 65 * 1024 };
+enum { MaxPacketSize = 2048, MaxFrameSize = 65 * 1024, MaxTraceEvents = 64 * 1024 };
 
 bool check_ge(const char* option, int value, int min_value) {
     if (value < min_value) {
@@ -43,6 +44,7 @@ int main(int argc, char** argv) {
     }
 
     core::set_log_level(LogLevel(LogError + args.verbose_given));
+    core::set_log_async(true);
 
     sndio::init();
 
@@ -83,6 +85,18 @@ int main(int argc, char** argv) {
         repair_port.protocol = pipeline::Proto_LDPC_Repair;
         break;
 
+    case fec_arg_parity:
+        config.default_session.fec.codec = fec::XORParity;
+        source_port.protocol = pipeline::Proto_RTP_Parity_Source;
+        repair_port.protocol = pipeline::Proto_Parity_Repair;
+        break;
+
+    case fec_arg_rlc:
+        config.default_session.fec.codec = fec::RandomLinear;
+        source_port.protocol = pipeline::Proto_RTP_RLC_Source;
+        repair_port.protocol = pipeline::Proto_RLC_Repair;
+        break;
+
     default:
         break;
     }
@@ -142,6 +156,13 @@ int main(int argc, char** argv) {
         config.default_session.resampler.frame_size = (size_t)args.resampler_frame_arg;
     }
 
+    if (args.threads_given) {
+        if (!check_ge("threads", args.threads_arg, 0)) {
+            return 1;
+        }
+        config.num_threads = (size_t)args.threads_arg;
+    }
+
     core::HeapAllocator allocator;
 
     core::BufferPool<uint8_t> byte_buffer_pool(allocator, MaxPacketSize, 1);
@@ -196,6 +217,13 @@ int main(int argc, char** argv) {
         return 1;
     }
 
+    if (args.trace_given) {
+        if (!core::tracer().start(MaxTraceEvents)) {
+            roc_log(LogError, "can't start tracing");
+            return 1;
+        }
+    }
+
     trx.start();
 
     player.start();
@@ -204,5 +232,14 @@ int main(int argc, char** argv) {
     trx.stop();
     trx.join();
 
+    if (args.trace_given) {
+        core::tracer().stop();
+
+        if (!core::tracer().dump(args.trace_arg)) {
+            roc_log(LogError, "can't write trace file: %s", args.trace_arg);
+            return 1;
+        }
+    }
+
     return 0;
 }
@@ -43,6 +43,7 @@ int main(int argc, char** argv) {
     }
 
     core::set_log_level(LogLevel(LogError + args.verbose_given));
+    core::set_log_async(true);
 
     sndio::init();
 
@@ -91,6 +92,18 @@ int main(int argc, char** argv) {
         config.repair_port.protocol = pipeline::Proto_LDPC_Repair;
         break;
 
+    case fec_arg_parity:
+        config.fec.codec = fec::XORParity;
+        config.source_port.protocol = pipeline::Proto_RTP_Parity_Source;
+        config.repair_port.protocol = pipeline::Proto_Parity_Repair;
+        break;
+
+    case fec_arg_rlc:
+        config.fec.codec = fec::RandomLinear;
+        config.source_port.protocol = pipeline::Proto_RTP_RLC_Source;
+        config.repair_port.protocol = pipeline::Proto_RLC_Repair;
+        break;
+
     default:
         break;
     }
@@ -111,6 +124,13 @@ int main(int argc, char** argv) {
         config.fec.n_repair_packets = (size_t)args.nbrpr_arg;
     }
 
+    if (args.fec_queue_given) {
+        if (!check_ge("fec-queue", args.fec_queue_arg, 0)) {
+            return 1;
+        }
+        config.fec_encoding_queue = (size_t)args.fec_queue_arg;
+    }
+
     config.interleaving = (args.interleaving_arg == interleaving_arg_yes);
     config.timing = (args.timing_arg == timing_arg_yes);
 